@@ -0,0 +1,108 @@
+// Record encoding benchmark for LocalDatabase
+//
+// Saves the same set of items under each encoding (indented JSON, compact
+// JSON, CBOR, MessagePack), then reports bytes on disk and save/load
+// throughput. The append-only log engine is the default because it has no
+// per-write fsync, so the numbers reflect encoding cost rather than disk
+// latency; pass "files" to measure the file-per-entity layout instead.
+//
+// Usage: invelog_bench_encoding [items] [files|log]
+
+#include "Category.h"
+#include "Item.h"
+#include "LocalDatabase.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint64_t bytesOnDisk(const std::string& directory) {
+    uint64_t total = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().filename() != "wal.log") {
+            total += entry.file_size();
+        }
+    }
+    return total;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void runEncoding(const std::string& label, LocalDatabase::Encoding encoding, LocalDatabase::StorageMode mode,
+                 const std::vector<std::shared_ptr<Item>>& items, uint64_t& baselineBytes) {
+    std::string directory = "./bench_encoding_data";
+    std::filesystem::remove_all(directory);
+
+    LocalDatabase db(directory, mode);
+    db.setEncoding(encoding);
+    if (!db.connect()) {
+        std::cerr << "Failed to open " << directory << std::endl;
+        std::exit(1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& item : items) {
+        db.saveItem(item);
+    }
+    double saveSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t loaded = 0;
+    for (const auto& item : items) {
+        if (db.loadItem(item->getId())) {
+            ++loaded;
+        }
+    }
+    double loadSeconds = secondsSince(start);
+    db.disconnect();
+
+    uint64_t bytes = bytesOnDisk(directory);
+    if (baselineBytes == 0) {
+        baselineBytes = bytes;
+    }
+    std::filesystem::remove_all(directory);
+
+    std::cout << std::left << std::setw(14) << label
+              << std::right << std::setw(12) << bytes
+              << std::setw(8) << std::fixed << std::setprecision(2)
+              << (static_cast<double>(bytes) / baselineBytes) << "x"
+              << std::setw(14) << std::setprecision(0) << (items.size() / saveSeconds)
+              << std::setw(14) << (loaded / loadSeconds) << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t itemCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    std::string engine = argc > 2 ? argv[2] : "log";
+    auto mode = (engine == "files") ? LocalDatabase::StorageMode::FILE_PER_ENTITY
+                                    : LocalDatabase::StorageMode::APPEND_LOG;
+
+    auto category = std::make_shared<Category>("Passives", "Resistors, capacitors and inductors");
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(itemCount);
+    for (size_t i = 0; i < itemCount; ++i) {
+        items.push_back(std::make_shared<Item>("Resistor " + std::to_string(i) + " Ohm", category,
+                                               static_cast<int>(i % 500), "1/4W metal film, 1% tolerance"));
+    }
+
+    std::cout << itemCount << " items, " << engine << " storage" << std::endl;
+    std::cout << std::left << std::setw(14) << "encoding"
+              << std::right << std::setw(12) << "bytes" << std::setw(9) << "size"
+              << std::setw(14) << "saves/sec" << std::setw(14) << "loads/sec" << std::endl;
+
+    uint64_t baselineBytes = 0;
+    runEncoding("pretty json", LocalDatabase::Encoding::PRETTY_JSON, mode, items, baselineBytes);
+    runEncoding("compact json", LocalDatabase::Encoding::COMPACT_JSON, mode, items, baselineBytes);
+    runEncoding("cbor", LocalDatabase::Encoding::CBOR, mode, items, baselineBytes);
+    runEncoding("msgpack", LocalDatabase::Encoding::MESSAGEPACK, mode, items, baselineBytes);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Entity collection accessor microbenchmark
+//
+// Compares the previous by-value getters (which copied a vector of shared_ptr,
+// one atomic increment + decrement per element per call) against the const
+// reference views and count accessors. The threaded run has every thread read
+// the same container, where refcount traffic on shared control blocks also
+// causes cache-line contention.
+//
+// Usage: invelog_bench_entity_views [items] [calls] [threads]
+
+#include "Container.h"
+#include "Item.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// What every call used to cost: a full copy of the member vector
+std::vector<std::shared_ptr<Item>> legacyGetAllItems(const Container& container) {
+    return container.getAllItems();
+}
+
+template <typename Fn>
+double measureThreaded(const std::string& label, long callsPerThread, int threads, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([callsPerThread, &fn]() {
+            volatile size_t sink = 0;
+            for (long i = 0; i < callsPerThread; ++i) {
+                sink = sink + fn();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = (callsPerThread * threads) / seconds;
+    std::cout << std::left << std::setw(36) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << rate
+              << " calls/sec" << std::endl;
+    return rate;
+}
+
+void runSuite(const Container& container, long calls, int threads) {
+    long perThread = calls / threads;
+
+    double copy = measureThreaded("by-value copy + iterate", perThread, threads, [&container]() {
+        size_t n = 0;
+        for (const auto& item : legacyGetAllItems(container)) {
+            n += item->getQuantity();
+        }
+        return n;
+    });
+    double view = measureThreaded("const-ref view + iterate", perThread, threads, [&container]() {
+        size_t n = 0;
+        for (const auto& item : container.getAllItems()) {
+            n += item->getQuantity();
+        }
+        return n;
+    });
+    double sizeCopy = measureThreaded("by-value copy .size()", perThread, threads, [&container]() {
+        return legacyGetAllItems(container).size();
+    });
+    double count = measureThreaded("itemCount()", perThread, threads, [&container]() {
+        return container.itemCount();
+    });
+
+    std::cout << "Speedup: iterate " << std::setprecision(1) << (view / copy) << "x, "
+              << "count " << (count / sizeCopy) << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long itemCount = (argc > 1) ? std::atol(argv[1]) : 1000;
+    long calls = (argc > 2) ? std::atol(argv[2]) : 100000;
+    int threads = (argc > 3) ? std::atoi(argv[3]) : 4;
+
+    auto container = std::make_shared<Container>("Bench", ContainerType::INVENTORY);
+    for (long i = 0; i < itemCount; ++i) {
+        container->addItem(std::make_shared<Item>("Item" + std::to_string(i), nullptr, 1));
+    }
+
+    // Verify the view takes no references: use_count must not move while it is held
+    const auto& probe = container->getAllItems().front();
+    long baseline = probe.use_count();
+    const auto& view = container->getAllItems();
+    long viewCount = view.front().use_count();
+    auto copy = legacyGetAllItems(*container);
+    long copyCount = probe.use_count();
+
+    std::cout << "Refcount increments per call (" << itemCount << " items): by-value "
+              << (copyCount - baseline) * itemCount << ", view " << (viewCount - baseline) * itemCount
+              << std::endl;
+
+    std::cout << "\nSingle thread (" << calls << " calls)" << std::endl;
+    std::cout << "----------------------------------------------------------------" << std::endl;
+    runSuite(*container, calls, 1);
+
+    std::cout << "\nConcurrent readers (" << threads << " threads)" << std::endl;
+    std::cout << "----------------------------------------------------------------" << std::endl;
+    runSuite(*container, calls, threads);
+
+    return 0;
+}
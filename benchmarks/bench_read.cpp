@@ -0,0 +1,117 @@
+// Read-path benchmark for LocalDatabase: std::ifstream vs. memory mapping
+//
+// Generates a dataset once, then for each read mode times a bulk
+// loadAllItems() and a pass of single loadItem() calls. Loads run on one
+// thread so the numbers compare the read paths rather than the thread pool.
+// Every pass reads the same files with a warm page cache, so the difference
+// is copying and stream overhead rather than disk.
+//
+// Usage: invelog_bench_read [items] [files|log]
+
+#include "Category.h"
+#include "Item.h"
+#include "LocalDatabase.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<UUID> generateDataset(const std::string& directory, LocalDatabase::StorageMode mode, size_t itemCount) {
+    LocalDatabase db(directory, mode);
+    if (!db.connect()) {
+        std::cerr << "Failed to open " << directory << std::endl;
+        std::exit(1);
+    }
+
+    auto category = std::make_shared<Category>("Passives", "Resistors, capacitors and inductors");
+    db.saveCategory(category);
+
+    std::vector<UUID> ids(itemCount);
+    // Save from several threads so the write-ahead log can group-commit
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 16; ++t) {
+        writers.emplace_back([&]() {
+            for (size_t i = next++; i < itemCount; i = next++) {
+                auto item = std::make_shared<Item>("Resistor " + std::to_string(i) + " Ohm", category,
+                                                   static_cast<int>(i % 500), "1/4W metal film, 1% tolerance");
+                ids[i] = item->getId();
+                db.saveItem(item);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    db.disconnect();
+    return ids;
+}
+
+void runReadMode(const std::string& label, LocalDatabase::ReadMode readMode, const std::string& directory,
+                 LocalDatabase::StorageMode mode, const std::vector<UUID>& ids) {
+    LocalDatabase db(directory, mode);
+    db.setLoadThreads(1);
+    db.setReadMode(readMode);
+    if (!db.connect()) {
+        std::cerr << "Failed to open " << directory << std::endl;
+        std::exit(1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bulk = db.loadAllItems().size();
+    double bulkSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t single = 0;
+    for (const auto& id : ids) {
+        if (db.loadItem(id)) {
+            ++single;
+        }
+    }
+    double singleSeconds = secondsSince(start);
+    db.disconnect();
+
+    std::cout << std::left << std::setw(10) << label
+              << std::right << std::setw(12) << std::fixed << std::setprecision(1) << (bulkSeconds * 1000.0)
+              << std::setw(14) << std::setprecision(0) << (bulk / bulkSeconds)
+              << std::setw(14) << (single / singleSeconds) << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t itemCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::string engine = argc > 2 ? argv[2] : "files";
+    auto mode = (engine == "log") ? LocalDatabase::StorageMode::APPEND_LOG
+                                  : LocalDatabase::StorageMode::FILE_PER_ENTITY;
+    std::string directory = "./bench_read_data";
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Generating " << itemCount << " items, " << engine << " storage..." << std::endl;
+    std::vector<UUID> ids = generateDataset(directory, mode, itemCount);
+
+    // Warm the page cache so both modes measure the same thing
+    runReadMode("(warm-up)", LocalDatabase::ReadMode::STREAM, directory, mode, ids);
+
+    std::cout << std::left << std::setw(10) << "read mode"
+              << std::right << std::setw(12) << "bulk ms" << std::setw(14) << "bulk/sec"
+              << std::setw(14) << "single/sec" << std::endl;
+    runReadMode("ifstream", LocalDatabase::ReadMode::STREAM, directory, mode, ids);
+    runReadMode("mmap", LocalDatabase::ReadMode::MEMORY_MAP, directory, mode, ids);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
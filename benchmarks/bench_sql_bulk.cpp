@@ -0,0 +1,96 @@
+// Bulk save benchmark for SQLDatabase (SQLite)
+//
+// Saves the same items twice into a fresh database file: once with one
+// saveItem() call per item (one autocommit statement each), then with a
+// single saveItems() call, which writes multi-row upserts of batchSize rows
+// inside one transaction. Both runs insert into an empty table.
+//
+// Usage: invelog_bench_sql_bulk [items] [batchSize]
+
+#include "Category.h"
+#include "Item.h"
+#include "SQLDatabase.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kDatabaseFile = "./bench_sql_bulk.db";
+
+void removeDatabase() {
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::filesystem::remove(std::string(kDatabaseFile) + suffix);
+    }
+}
+
+template <typename Fn>
+void run(const std::string& label, int batchSize, size_t items, size_t statements, Fn save) {
+    removeDatabase();
+    SQLDatabase::ConnectionConfig config;
+    config.type = SQLDatabase::SQLType::SQLITE;
+    config.database = kDatabaseFile;
+    config.batchSize = batchSize;
+    SQLDatabase db(config);
+    if (!db.connect()) {
+        std::cerr << "Failed to open " << kDatabaseFile << std::endl;
+        std::exit(1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!save(db)) {
+        std::cerr << label << " failed" << std::endl;
+        std::exit(1);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    db.disconnect();
+    removeDatabase();
+
+    std::cout << std::left << std::setw(20) << label
+              << std::right << std::setw(12) << statements
+              << std::setw(12) << std::fixed << std::setprecision(0) << (seconds * 1000.0)
+              << std::setw(14) << (items / seconds) << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t itemCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int batchSize = argc > 2 ? std::atoi(argv[2]) : 500;
+    if (batchSize < 1) batchSize = 1;
+
+    auto category = std::make_shared<Category>("Passives", "Resistors, capacitors and inductors");
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(itemCount);
+    for (size_t i = 0; i < itemCount; ++i) {
+        items.push_back(std::make_shared<Item>("Resistor " + std::to_string(i) + " Ohm", category,
+                                               static_cast<int>(i % 500), "1/4W metal film, 1% tolerance"));
+    }
+
+    std::cout << itemCount << " items, batch size " << batchSize << std::endl;
+    std::cout << std::left << std::setw(20) << "method"
+              << std::right << std::setw(12) << "statements" << std::setw(12) << "ms"
+              << std::setw(14) << "items/sec" << std::endl;
+
+    run("saveItem per row", batchSize, itemCount, itemCount, [&](SQLDatabase& db) {
+        for (const auto& item : items) {
+            if (!db.saveItem(item)) return false;
+        }
+        return true;
+    });
+
+    // Full batches, then the remainder in power-of-two chunks
+    size_t statements = itemCount / batchSize;
+    for (size_t rest = itemCount % batchSize; rest > 0; rest &= rest - 1) {
+        ++statements;
+    }
+    run("saveItems", batchSize, itemCount, statements, [&](SQLDatabase& db) {
+        return db.saveItems(items);
+    });
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Cold-start benchmark: InventoryManager::initialize() over a generated
+// LocalDatabase directory.
+//
+// Generates a dataset (items, plus containers, locations, projects and
+// categories in proportion), then times initialize() with sequential loading
+// (one load thread, entity types one after another) against the parallel
+// loader. Both runs read the same files with a warm page cache, so the
+// difference is listing, parsing and construction cost rather than disk.
+//
+// Usage: invelog_bench_startup [items] [threads] [dataDirectory]
+
+#include "Category.h"
+#include "Container.h"
+#include "InventoryManager.h"
+#include "Item.h"
+#include "LocalDatabase.h"
+#include "Location.h"
+#include "Project.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Save from several threads so the write-ahead log can group-commit
+template <typename Fn>
+void saveConcurrently(size_t count, Fn save) {
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 16; ++t) {
+        writers.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                save(i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+}
+
+void generateDataset(const std::string& directory, size_t itemCount) {
+    LocalDatabase db(directory);
+    if (!db.connect()) {
+        std::cerr << "Failed to open " << directory << std::endl;
+        std::exit(1);
+    }
+
+    size_t categoryCount = std::max<size_t>(1, itemCount / 100);
+    size_t locationCount = std::max<size_t>(1, itemCount / 200);
+    size_t containerCount = std::max<size_t>(1, itemCount / 20);
+    size_t projectCount = std::max<size_t>(1, itemCount / 500);
+
+    std::vector<std::shared_ptr<Category>> categories;
+    for (size_t i = 0; i < categoryCount; ++i) {
+        categories.push_back(std::make_shared<Category>("Category " + std::to_string(i), "Generated"));
+    }
+    std::vector<std::shared_ptr<Location>> locations;
+    for (size_t i = 0; i < locationCount; ++i) {
+        locations.push_back(std::make_shared<Location>("Location " + std::to_string(i), "1 Bench Street"));
+    }
+    std::vector<std::shared_ptr<Container>> containers;
+    for (size_t i = 0; i < containerCount; ++i) {
+        auto container = std::make_shared<Container>("Bin " + std::to_string(i), ContainerType::INVENTORY, "Generated");
+        container->setLocation(locations[i % locationCount]);
+        containers.push_back(container);
+    }
+    std::vector<std::shared_ptr<Item>> items;
+    for (size_t i = 0; i < itemCount; ++i) {
+        auto item = std::make_shared<Item>("Part " + std::to_string(i), categories[i % categoryCount],
+                                           static_cast<int>(i % 50) + 1, "Generated benchmark item");
+        containers[i % containerCount]->addItem(item);
+        items.push_back(item);
+    }
+
+    saveConcurrently(categoryCount, [&](size_t i) { db.saveCategory(categories[i]); });
+    saveConcurrently(locationCount, [&](size_t i) { db.saveLocation(locations[i]); });
+    saveConcurrently(containerCount, [&](size_t i) { db.saveContainer(containers[i]); });
+    saveConcurrently(projectCount, [&](size_t i) {
+        db.saveProject(std::make_shared<Project>("Project " + std::to_string(i), "Generated"));
+    });
+    saveConcurrently(itemCount, [&](size_t i) { db.saveItem(items[i]); });
+    db.disconnect();
+}
+
+double timeInitialize(const std::string& directory, size_t loadThreads, size_t& loadedItems) {
+    auto db = std::make_shared<LocalDatabase>(directory);
+    db->setLoadThreads(loadThreads);
+    InventoryManager manager(db);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!manager.initialize()) {
+        std::cerr << "initialize() failed" << std::endl;
+        std::exit(1);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    loadedItems = manager.getAllItems().size();
+    db->disconnect();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t itemCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+    std::string directory = argc > 3 ? argv[3] : "./bench_startup_data";
+    bool generated = false;
+
+    if (!std::filesystem::exists(directory + "/items")) {
+        std::cout << "Generating " << itemCount << " items in " << directory << "..." << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        generateDataset(directory, itemCount);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Generated in " << std::fixed << std::setprecision(1) << seconds << " s" << std::endl;
+        generated = true;
+    } else {
+        std::cout << "Reusing existing dataset in " << directory << std::endl;
+    }
+
+    size_t loaded = 0;
+    // Warm the page cache so both runs measure the same thing
+    timeInitialize(directory, 1, loaded);
+
+    double sequential = timeInitialize(directory, 1, loaded);
+    std::cout << std::left << std::setw(28) << "sequential load" << std::right << std::setw(10)
+              << std::fixed << std::setprecision(1) << sequential << " ms (" << loaded << " items)" << std::endl;
+
+    double parallel = timeInitialize(directory, threads, loaded);
+    std::cout << std::left << std::setw(28) << "parallel load" << std::right << std::setw(10)
+              << parallel << " ms (" << loaded << " items, "
+              << (threads == 0 ? std::thread::hardware_concurrency() : threads) << " threads)" << std::endl;
+
+    std::cout << "Speedup: " << std::setprecision(1) << (sequential / parallel) << "x" << std::endl;
+
+    if (generated) {
+        std::filesystem::remove_all(directory);
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+// UUID generation microbenchmark
+//
+// Compares IDs/sec of the previous generator (shared mt19937_64 + stringstream
+// formatting) against the per-thread binary generator for V4 and V7, both for
+// raw generation and generation + text formatting.
+//
+// Usage: invelog_bench_uuid [count] [threads]
+
+#include "UUID.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Reference copy of the original string-based generator
+std::string legacyGenerateUUIDv4() {
+    static std::random_device rd;
+    static std::mt19937_64 gen(rd());
+    static std::uniform_int_distribution<uint64_t> dis;
+
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+    
+    uint64_t part1 = dis(gen);
+    uint64_t part2 = dis(gen);
+    
+    ss << std::setw(8) << (part1 >> 32);
+    ss << "-";
+    ss << std::setw(4) << ((part1 >> 16) & 0xFFFF);
+    ss << "-";
+    ss << std::setw(4) << (0x4000 | ((part1 & 0x0FFF)));
+    ss << "-";
+    ss << std::setw(4) << (0x8000 | ((part2 >> 48) & 0x3FFF));
+    ss << "-";
+    ss << std::setw(12) << (part2 & 0xFFFFFFFFFFFF);
+    
+    return ss.str();
+}
+
+template <typename Fn>
+double measure(const std::string& label, long count, Fn fn) {
+    volatile size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; ++i) {
+        sink = sink + fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = count / seconds;
+    std::cout << std::left << std::setw(36) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << rate
+              << " IDs/sec" << std::endl;
+    return rate;
+}
+
+template <typename Fn>
+double measureThreaded(const std::string& label, long countPerThread, int threads, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([countPerThread, &fn]() {
+            volatile size_t sink = 0;
+            for (long i = 0; i < countPerThread; ++i) {
+                sink = sink + fn();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = (countPerThread * threads) / seconds;
+    std::cout << std::left << std::setw(36) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << rate
+              << " IDs/sec" << std::endl;
+    return rate;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long count = (argc > 1) ? std::atol(argv[1]) : 1000000;
+    int threads = (argc > 2) ? std::atoi(argv[2]) : 4;
+    
+    std::cout << "UUID generation benchmark (" << count << " IDs)" << std::endl;
+    std::cout << "----------------------------------------------------------------" << std::endl;
+    
+    double legacy = measure("legacy v4 (stringstream)", count,
+        []() { return legacyGenerateUUIDv4().size(); });
+    double v4 = measure("v4 binary", count,
+        []() { return static_cast<size_t>(UUID::generateV4().getLow()); });
+    double v4Text = measure("v4 binary + toString", count,
+        []() { return UUID::generateV4().toString().size(); });
+    double v7 = measure("v7 binary", count,
+        []() { return static_cast<size_t>(UUID::generateV7().getHigh()); });
+    measure("v7 binary + toChars", count, []() {
+        char buffer[UUID::kStringLength];
+        UUID::generateV7().toChars(buffer);
+        return static_cast<size_t>(buffer[0]);
+    });
+    
+    std::cout << "\nConcurrent generation (" << threads << " threads)" << std::endl;
+    std::cout << "----------------------------------------------------------------" << std::endl;
+    // The legacy generator is not thread-safe, so it is only measured single-threaded
+    measureThreaded("v4 binary", count / threads, threads,
+        []() { return static_cast<size_t>(UUID::generateV4().getLow()); });
+    measureThreaded("v7 binary", count / threads, threads,
+        []() { return static_cast<size_t>(UUID::generateV7().getHigh()); });
+    
+    std::cout << "\nSpeedup vs legacy: v4 " << std::setprecision(1) << (v4 / legacy) << "x, "
+              << "v4+text " << (v4Text / legacy) << "x, "
+              << "v7 " << (v7 / legacy) << "x" << std::endl;
+    
+    return 0;
+}
@@ -91,6 +91,19 @@ public:
     std::vector<std::shared_ptr<ActivityLog>> loadActivityLogsForItem(const UUID& itemId) override;
     std::vector<std::shared_ptr<ActivityLog>> loadRecentActivityLogs(int limit) override;
     
+    // Item batches go out as one request each (POST <items>/batch and
+    // <items>/batch/delete); other entity types use the per-entity defaults
+    bool saveItems(const std::vector<std::shared_ptr<Item>>& items) override;
+    bool deleteItems(const std::vector<UUID>& ids) override;
+    
+    // Paged loads GET <endpoint>?limit=N&cursor=<after> and take the next
+    // cursor from the X-Next-Cursor response header
+    Page<Item> loadItemPage(const UUID& after, size_t limit) override;
+    Page<Container> loadContainerPage(const UUID& after, size_t limit) override;
+    Page<Location> loadLocationPage(const UUID& after, size_t limit) override;
+    Page<Project> loadProjectPage(const UUID& after, size_t limit) override;
+    Page<Category> loadCategoryPage(const UUID& after, size_t limit) override;
+    
     // API-specific operations
     bool testConnection();
     std::string getAPIVersion();
@@ -98,7 +111,8 @@ public:
     void setCustomHeader(const std::string& key, const std::string& value);
     void removeCustomHeader(const std::string& key);
     
-    // Batch operations for efficiency
+    // Batch operations for efficiency. deleteBatch posts {"ids": [...]} to
+    // /<entityType>/batch/delete.
     bool saveBatch(const std::vector<std::shared_ptr<Item>>& items);
     bool deleteBatch(const std::vector<UUID>& ids, const std::string& entityType);
     
@@ -139,6 +153,10 @@ private:
     std::shared_ptr<Category> deserializeCategory(const std::string& json);
     std::shared_ptr<ActivityLog> deserializeActivityLog(const std::string& json);
     
+    template <typename T>
+    Page<T> loadPage(const std::string& endpoint, const UUID& after, size_t limit,
+                     std::shared_ptr<T> (APIDatabase::*deserialize)(const std::string&));
+    
     // Error handling
     void handleAPIError(int statusCode, const std::string& response);
     bool retryRequest(std::function<bool()> request);
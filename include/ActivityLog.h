@@ -29,6 +29,14 @@ public:
                 const std::string& description = "",
                 const std::string& userId = "system");
     
+    // Constructor that restores a saved entry (for deserialization)
+    ActivityLog(const UUID& id,
+                ActivityType type,
+                std::shared_ptr<Item> item,
+                const std::string& description,
+                const std::string& userId,
+                std::chrono::system_clock::time_point timestamp);
+    
     UUID getId() const;
     ActivityType getType() const;
     std::string getDescription() const;
@@ -0,0 +1,121 @@
+#ifndef ACTIVITYLOGSTORE_H
+#define ACTIVITYLOGSTORE_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "UUID.h"
+
+// Append-only, time-partitioned store for activity log entries.
+//
+// Entries go to one segment file per UTC day (or hour) under the store
+// directory, named e.g. 2024-05-01.seg or 2024-05-01T13.seg. Each record is
+// length-prefixed and checksummed. Entries are immutable, so there are no
+// updates or tombstones; old data is removed a whole segment at a time with
+// dropBefore().
+//
+// open() scans the segments and builds in-memory indexes by time, item and
+// user, so "last N" and "history for item X" read only the matching records
+// instead of scanning every file. A torn record at the end of a segment is
+// truncated.
+class ActivityLogStore {
+public:
+    enum class Partition {
+        DAILY,
+        HOURLY
+    };
+
+    struct Entry {
+        UUID id = UUID::nil();
+        int64_t timestamp = 0;          // Milliseconds since the Unix epoch
+        UUID itemId = UUID::nil();      // Nil if the entry is not about an item
+        std::string userId;             // At most 255 bytes
+        std::string payload;            // Opaque to the store
+    };
+
+    explicit ActivityLogStore(const std::string& directory, Partition partition = Partition::DAILY);
+    ~ActivityLogStore();
+
+    bool open();
+    void close();
+
+    // Returns once the entry is fsynced. Appending an ID that is already
+    // stored is a no-op that returns true.
+    bool append(const Entry& entry);
+    // Appends under one lock, then flushes and fsyncs once for the batch
+    bool append(const std::vector<Entry>& entries);
+
+    // Newest first; limit 0 means no limit
+    std::vector<Entry> recent(size_t limit);
+    std::vector<Entry> forItem(const UUID& itemId, size_t limit = 0);
+    std::vector<Entry> forUser(const std::string& userId, size_t limit = 0);
+    // Entries with from <= timestamp < to, newest first
+    std::vector<Entry> between(int64_t from, int64_t to, size_t limit = 0);
+    // Every entry, oldest first
+    std::vector<Entry> all();
+
+    bool contains(const UUID& id) const;
+    size_t size() const;
+    size_t segmentCount() const;
+
+    // Deletes every segment that ends at or before timestamp; returns how many
+    size_t dropBefore(int64_t timestamp);
+
+    static int64_t toMillis(std::chrono::system_clock::time_point timePoint);
+
+private:
+    struct Segment {
+        std::string path;
+        int64_t start;
+        int64_t end;
+        uint64_t size;
+        bool dropped;
+    };
+
+    struct Location {
+        UUID id = UUID::nil();
+        uint32_t segment;
+        uint64_t offset;         // Start of the record header
+        uint32_t length;         // Header + user ID + payload
+        int64_t timestamp;
+    };
+
+    std::string directory_;
+    Partition partition_;
+    bool open_;
+
+    std::vector<Segment> segments_;
+    std::map<int64_t, uint32_t> segmentsByStart_;
+    std::ofstream writer_;
+    uint32_t writerSegment_;
+    std::vector<uint32_t> unsynced_;     // Segments appended to since the last fsync
+    bool createdSegment_;                // A segment file was created since then
+
+    // Indexes hold sequence numbers into entries_, each sorted by timestamp
+    std::vector<Location> entries_;
+    std::vector<uint32_t> timeline_;
+    std::unordered_map<UUID, std::vector<uint32_t>> byItem_;
+    std::unordered_map<std::string, std::vector<uint32_t>> byUser_;
+    std::unordered_set<UUID> ids_;
+    mutable std::mutex mutex_;
+
+    bool scanSegment(uint32_t segment);
+    bool appendLocked(const Entry& entry);
+    bool flushLocked();
+    void indexEntry(const Entry& entry, const Location& location);
+    void insertByTime(std::vector<uint32_t>& sequence, uint32_t seq);
+    bool segmentFor(int64_t timestamp, uint32_t& segment);
+    uint32_t addSegment(const std::string& path, int64_t start, int64_t end);
+    std::vector<Entry> readNewestFirst(const std::vector<uint32_t>& sequence, size_t limit);
+    std::vector<Entry> readEntries(const std::vector<uint32_t>& seqs);
+    static std::string segmentName(int64_t start, int64_t span);
+    static bool parseSegmentName(const std::string& name, int64_t& start, int64_t& end);
+};
+
+#endif // ACTIVITYLOGSTORE_H
@@ -5,11 +5,15 @@
 #include <vector>
 #include <memory>
 #include "UUID.h"
+#include "Versioned.h"
 
-class Category {
+class Category : public Versioned {
 public:
     explicit Category(const std::string& name, const std::string& description = "");
     
+    // Constructor that allows specifying the UUID (for deserialization)
+    Category(const UUID& id, const std::string& name, const std::string& description = "");
+    
     UUID getId() const;
     std::string getName() const;
     std::string getDescription() const;
@@ -20,7 +24,8 @@ public:
     // Support for subcategories
     void addSubcategory(std::shared_ptr<Category> subcategory);
     void removeSubcategory(const UUID& subcategoryId);
-    std::vector<std::shared_ptr<Category>> getSubcategories() const;
+    const std::vector<std::shared_ptr<Category>>& getSubcategories() const;
+    size_t subcategoryCount() const;
     
 private:
     UUID id_;
@@ -5,9 +5,11 @@
 #include <vector>
 #include <memory>
 #include "UUID.h"
+#include "Versioned.h"
 
 class Item;
 class Location;
+class EntityObserver;
 
 enum class ContainerType {
     INVENTORY,      // Main storage container
@@ -15,12 +17,18 @@ enum class ContainerType {
     SUBCONTAINER    // Nested container
 };
 
-class Container : public std::enable_shared_from_this<Container> {
+class Container : public std::enable_shared_from_this<Container>, public Versioned {
 public:
     Container(const std::string& name, 
               ContainerType type = ContainerType::INVENTORY,
               const std::string& description = "");
     
+    // Constructor that allows specifying the UUID (for deserialization)
+    Container(const UUID& id,
+              const std::string& name,
+              ContainerType type = ContainerType::INVENTORY,
+              const std::string& description = "");
+    
     UUID getId() const;
     std::string getName() const;
     std::string getDescription() const;
@@ -37,18 +45,25 @@ public:
     void addItem(std::shared_ptr<Item> item);
     void removeItem(const UUID& itemId);
     std::shared_ptr<Item> getItem(const UUID& itemId) const;
-    std::vector<std::shared_ptr<Item>> getAllItems() const;
+    const std::vector<std::shared_ptr<Item>>& getAllItems() const;
+    size_t itemCount() const;
+    // Replaces the item list without duplicate checks (for deserialization)
+    void setItems(std::vector<std::shared_ptr<Item>> items);
     
     // Subcontainer management
     void addSubcontainer(std::shared_ptr<Container> subcontainer);
     void removeSubcontainer(const UUID& subcontainerId);
     std::shared_ptr<Container> getSubcontainer(const UUID& subcontainerId) const;
-    std::vector<std::shared_ptr<Container>> getAllSubcontainers() const;
+    const std::vector<std::shared_ptr<Container>>& getAllSubcontainers() const;
+    size_t subcontainerCount() const;
     
     // Search functionality
     std::vector<std::shared_ptr<Item>> findItemsByName(const std::string& name) const;
     std::vector<std::shared_ptr<Item>> findItemsByCategory(const UUID& categoryId) const;
     
+    // Change notifications (not owned; nullptr disables)
+    void setObserver(EntityObserver* observer);
+    
 private:
     UUID id_;
     std::string name_;
@@ -58,6 +73,7 @@ private:
     std::shared_ptr<Container> parentContainer_;
     std::vector<std::shared_ptr<Item>> items_;
     std::vector<std::shared_ptr<Container>> subcontainers_;
+    EntityObserver* observer_;
 };
 
 #endif // CONTAINER_H
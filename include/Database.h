@@ -1,6 +1,7 @@
 #ifndef DATABASE_H
 #define DATABASE_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include <string>
@@ -14,6 +15,28 @@ class Project;
 class Category;
 class ActivityLog;
 
+// Every entity a backend holds, with references between them resolved.
+// Activity logs are reachable through Item::getActivityHistory().
+struct EntitySnapshot {
+    std::vector<std::shared_ptr<Item>> items;
+    std::vector<std::shared_ptr<Container>> containers;
+    std::vector<std::shared_ptr<Location>> locations;
+    std::vector<std::shared_ptr<Project>> projects;
+    std::vector<std::shared_ptr<Category>> categories;
+};
+
+// One page of a collection, in ascending ID order. next is the cursor for
+// the following page: pass it as `after`. It is nil on the last page.
+// ok is false if the backend failed to read the page; entities and next
+// are then empty, and the caller should report an error rather than the
+// end of the collection.
+template <typename T>
+struct Page {
+    std::vector<std::shared_ptr<T>> entities;
+    UUID next = UUID::nil();
+    bool ok = true;
+};
+
 // Abstract base class for database operations
 class IDatabase {
 public:
@@ -58,6 +81,171 @@ public:
     virtual bool saveActivityLog(std::shared_ptr<ActivityLog> log) = 0;
     virtual std::vector<std::shared_ptr<ActivityLog>> loadActivityLogsForItem(const UUID& itemId) = 0;
     virtual std::vector<std::shared_ptr<ActivityLog>> loadRecentActivityLogs(int limit) = 0;
+    
+    // Bulk load used at startup. Backends that can resolve references should
+    // override this; the default just loads each entity type.
+    virtual bool loadSnapshot(EntitySnapshot& snapshot) {
+        snapshot.items = loadAllItems();
+        snapshot.containers = loadAllContainers();
+        snapshot.locations = loadAllLocations();
+        snapshot.projects = loadAllProjects();
+        snapshot.categories = loadAllCategories();
+        return true;
+    }
+    
+    // Batch operations. The defaults call the single-entity methods one by
+    // one; backends override them to share one transaction, sync or request
+    // across the batch. Saves return false if any entity failed. Loads skip
+    // IDs that are not found; results are not necessarily in ID order. The
+    // defaults return no references, like the single-entity loads, while
+    // backend batch loads link one level of them, as loadAll*() do: an
+    // item's category and container, a container's location, parent,
+    // subcontainers and items, a location's or project's containers, a
+    // category's subcategories. Backend batch deletes
+    // treat a missing ID as already deleted, while the defaults report it
+    // as deleteX() does.
+    virtual bool saveItems(const std::vector<std::shared_ptr<Item>>& items) {
+        return forEach(items, [this](const std::shared_ptr<Item>& item) { return saveItem(item); });
+    }
+    virtual std::vector<std::shared_ptr<Item>> loadItems(const std::vector<UUID>& ids) {
+        return loadEach(ids, [this](const UUID& id) { return loadItem(id); });
+    }
+    virtual bool deleteItems(const std::vector<UUID>& ids) {
+        return forEach(ids, [this](const UUID& id) { return deleteItem(id); });
+    }
+    
+    virtual bool saveContainers(const std::vector<std::shared_ptr<Container>>& containers) {
+        return forEach(containers, [this](const std::shared_ptr<Container>& container) {
+            return saveContainer(container);
+        });
+    }
+    virtual std::vector<std::shared_ptr<Container>> loadContainers(const std::vector<UUID>& ids) {
+        return loadEach(ids, [this](const UUID& id) { return loadContainer(id); });
+    }
+    virtual bool deleteContainers(const std::vector<UUID>& ids) {
+        return forEach(ids, [this](const UUID& id) { return deleteContainer(id); });
+    }
+    
+    virtual bool saveLocations(const std::vector<std::shared_ptr<Location>>& locations) {
+        return forEach(locations, [this](const std::shared_ptr<Location>& location) {
+            return saveLocation(location);
+        });
+    }
+    virtual std::vector<std::shared_ptr<Location>> loadLocations(const std::vector<UUID>& ids) {
+        return loadEach(ids, [this](const UUID& id) { return loadLocation(id); });
+    }
+    virtual bool deleteLocations(const std::vector<UUID>& ids) {
+        return forEach(ids, [this](const UUID& id) { return deleteLocation(id); });
+    }
+    
+    virtual bool saveProjects(const std::vector<std::shared_ptr<Project>>& projects) {
+        return forEach(projects, [this](const std::shared_ptr<Project>& project) { return saveProject(project); });
+    }
+    virtual std::vector<std::shared_ptr<Project>> loadProjects(const std::vector<UUID>& ids) {
+        return loadEach(ids, [this](const UUID& id) { return loadProject(id); });
+    }
+    virtual bool deleteProjects(const std::vector<UUID>& ids) {
+        return forEach(ids, [this](const UUID& id) { return deleteProject(id); });
+    }
+    
+    virtual bool saveCategories(const std::vector<std::shared_ptr<Category>>& categories) {
+        return forEach(categories, [this](const std::shared_ptr<Category>& category) {
+            return saveCategory(category);
+        });
+    }
+    virtual std::vector<std::shared_ptr<Category>> loadCategories(const std::vector<UUID>& ids) {
+        return loadEach(ids, [this](const UUID& id) { return loadCategory(id); });
+    }
+    virtual bool deleteCategories(const std::vector<UUID>& ids) {
+        return forEach(ids, [this](const UUID& id) { return deleteCategory(id); });
+    }
+    
+    virtual bool saveActivityLogs(const std::vector<std::shared_ptr<ActivityLog>>& logs) {
+        return forEach(logs, [this](const std::shared_ptr<ActivityLog>& log) { return saveActivityLog(log); });
+    }
+    
+    // Paged loads: up to limit entities with IDs greater than after (nil =
+    // from the start), in ascending ID order, with references linked like
+    // the batch loads. The defaults load everything and slice it, for every
+    // page, so they are only a fallback for backends that cannot page;
+    // backends override them to read only the page.
+    virtual Page<Item> loadItemPage(const UUID& after, size_t limit);
+    virtual Page<Container> loadContainerPage(const UUID& after, size_t limit);
+    virtual Page<Location> loadLocationPage(const UUID& after, size_t limit);
+    virtual Page<Project> loadProjectPage(const UUID& after, size_t limit);
+    virtual Page<Category> loadCategoryPage(const UUID& after, size_t limit);
+    
+    // Unit of work. Between begin and commit, a backend that supports it
+    // holds the calling thread's writes back and applies them together on
+    // commit, or drops them on rollback. The defaults write straight
+    // through: begin and commit succeed, and rollback returns false because
+    // nothing can be undone. Prefer the UnitOfWork scope below.
+    virtual bool beginTransaction() { return true; }
+    virtual bool commitTransaction() { return true; }
+    virtual bool rollbackTransaction() { return false; }
+    
+protected:
+    template <typename T, typename Fn>
+    static bool forEach(const std::vector<T>& values, Fn fn) {
+        bool ok = true;
+        for (const auto& value : values) {
+            ok &= fn(value);
+        }
+        return ok;
+    }
+    
+    template <typename Fn>
+    static auto loadEach(const std::vector<UUID>& ids, Fn load) -> std::vector<decltype(load(ids.front()))> {
+        std::vector<decltype(load(ids.front()))> loaded;
+        loaded.reserve(ids.size());
+        for (const auto& id : ids) {
+            if (auto entity = load(id)) {
+                loaded.push_back(std::move(entity));
+            }
+        }
+        return loaded;
+    }
+};
+
+// Scoped unit of work: begins a transaction on construction and rolls it
+// back on destruction unless commit() was called.
+//
+//     UnitOfWork work(*database);
+//     database->saveItems(items);
+//     database->deleteContainers(emptied);
+//     work.commit();
+class UnitOfWork {
+public:
+    explicit UnitOfWork(IDatabase& database)
+        : database_(database), active_(database.beginTransaction()) {}
+    
+    ~UnitOfWork() {
+        if (active_) {
+            database_.rollbackTransaction();
+        }
+    }
+    
+    UnitOfWork(const UnitOfWork&) = delete;
+    UnitOfWork& operator=(const UnitOfWork&) = delete;
+    
+    // False if beginTransaction() failed, or after commit()/rollback()
+    bool isActive() const { return active_; }
+    
+    bool commit() {
+        if (!active_) return false;
+        active_ = false;
+        return database_.commitTransaction();
+    }
+    
+    bool rollback() {
+        if (!active_) return false;
+        active_ = false;
+        return database_.rollbackTransaction();
+    }
+    
+private:
+    IDatabase& database_;
+    bool active_;
 };
 
 #endif // DATABASE_H
@@ -0,0 +1,29 @@
+#ifndef ENTITYOBSERVER_H
+#define ENTITYOBSERVER_H
+
+#include <memory>
+#include <string>
+
+class Item;
+class Container;
+class Location;
+class Category;
+
+// Receives change notifications from entity mutators so owners (e.g.
+// InventoryManager) can keep derived state such as indexes up to date.
+// Callbacks run after the entity has been updated and get the previous value.
+class EntityObserver {
+public:
+    virtual ~EntityObserver() = default;
+    
+    virtual void onItemNameChanged(const Item& /*item*/, const std::string& /*oldName*/) {}
+    virtual void onItemDescriptionChanged(const Item& /*item*/, const std::string& /*oldDescription*/) {}
+    virtual void onItemCategoryChanged(const Item& /*item*/,
+                                       const std::shared_ptr<Category>& /*oldCategory*/) {}
+    virtual void onItemContainerChanged(const Item& /*item*/,
+                                        const std::shared_ptr<Container>& /*oldContainer*/) {}
+    virtual void onContainerLocationChanged(const Container& /*container*/,
+                                            const std::shared_ptr<Location>& /*oldLocation*/) {}
+};
+
+#endif // ENTITYOBSERVER_H
@@ -0,0 +1,96 @@
+#ifndef ENTITYREGISTRY_H
+#define ENTITYREGISTRY_H
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "UUID.h"
+
+// ID-indexed collection of entities.
+// Keeps entities in a dense vector (for iteration) plus a UUID -> slot hash
+// index, so lookup, insert and delete are all O(1). Deletes swap the last
+// entity into the freed slot, so iteration order is not insertion order.
+template <typename T>
+class EntityRegistry {
+public:
+    using Pointer = std::shared_ptr<T>;
+
+    // Returns false for null entities or IDs that are already registered
+    bool add(const Pointer& entity) {
+        if (!entity) {
+            return false;
+        }
+
+        auto inserted = index_.emplace(entity->getId(), entities_.size());
+        if (!inserted.second) {
+            return false;
+        }
+
+        entities_.push_back(entity);
+        return true;
+    }
+
+    bool remove(const UUID& id) {
+        auto it = index_.find(id);
+        if (it == index_.end()) {
+            return false;
+        }
+
+        size_t slot = it->second;
+        size_t last = entities_.size() - 1;
+        if (slot != last) {
+            entities_[slot] = std::move(entities_[last]);
+            index_[entities_[slot]->getId()] = slot;
+        }
+
+        entities_.pop_back();
+        index_.erase(it);
+        return true;
+    }
+
+    Pointer get(const UUID& id) const {
+        auto it = index_.find(id);
+        return (it != index_.end()) ? entities_[it->second] : nullptr;
+    }
+
+    bool contains(const UUID& id) const {
+        return index_.find(id) != index_.end();
+    }
+
+    const std::vector<Pointer>& all() const {
+        return entities_;
+    }
+
+    size_t size() const {
+        return entities_.size();
+    }
+
+    bool empty() const {
+        return entities_.empty();
+    }
+
+    void reserve(size_t count) {
+        entities_.reserve(count);
+        index_.reserve(count);
+    }
+
+    void clear() {
+        entities_.clear();
+        index_.clear();
+    }
+
+    // Replaces the contents; null entities and duplicate IDs are dropped
+    void assign(const std::vector<Pointer>& entities) {
+        clear();
+        reserve(entities.size());
+        for (const auto& entity : entities) {
+            add(entity);
+        }
+    }
+
+private:
+    std::vector<Pointer> entities_;
+    std::unordered_map<UUID, size_t> index_;
+};
+
+#endif // ENTITYREGISTRY_H
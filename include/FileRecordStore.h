@@ -0,0 +1,91 @@
+#ifndef FILERECORDSTORE_H
+#define FILERECORDSTORE_H
+
+#include "RecordStore.h"
+#include "WriteAheadLog.h"
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// One file per record: <dataDirectory>/<type>/<uuid>.json
+// This is the original LocalDatabase layout and stays the default.
+//
+// The sharded layout spreads files over two levels of subdirectories,
+// <type>/ab/cd/<uuid>.json, named after the last four hex digits of the
+// UUID. Those are random for both V4 and V7 IDs (a V7 prefix is a
+// timestamp), so no directory grows past a few hundred thousand entries
+// before the data set reaches the tens of billions. migrate() converts a
+// directory between the two layouts.
+//
+// Files are replaced atomically (write to <file>.tmp, then rename) so a crash
+// never leaves a half-written record. With the write-ahead log enabled
+// (default) every put/remove is first group-committed to
+// <dataDirectory>/wal.log and replayed on open if the process died before
+// the data files were synced.
+class FileRecordStore : public RecordStore {
+public:
+    enum class Layout {
+        FLAT,               // <type>/<uuid>.json
+        SHARDED             // <type>/ab/cd/<uuid>.json
+    };
+
+    FileRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types,
+                    bool writeAheadLog = true, Layout layout = Layout::FLAT);
+    ~FileRecordStore() override;
+
+    bool open() override;
+    void close() override;
+
+    bool put(const std::string& type, const UUID& id, const std::string& payload) override;
+    bool get(const std::string& type, const UUID& id, std::string& payload) override;
+    bool remove(const std::string& type, const UUID& id) override;
+    std::vector<UUID> list(const std::string& type) override;
+
+    // The whole batch is group-committed to the write-ahead log with one fsync
+    bool writeBatch(const std::vector<Write>& writes) override;
+    // One partition per top-level shard directory when sharded
+    size_t partitionCount(const std::string& type) override;
+    std::vector<UUID> listPartition(const std::string& type, size_t partition) override;
+    // Skips the stream: large files are memory-mapped, small ones read in one call
+    bool read(const std::string& type, const UUID& id, const RecordReader& reader) override;
+
+    // nullptr when the write-ahead log is disabled or the store is closed
+    const WriteAheadLog* getWriteAheadLog() const;
+    Layout getLayout() const;
+
+    // Moves every record file under dataDirectory into the given layout,
+    // whichever layout each file is in now, then replays any pending
+    // write-ahead log into it. Safe to re-run after an interruption.
+    // The directory must not be open elsewhere while this runs. If moved
+    // is set, it receives the number of files moved.
+    static bool migrate(const std::string& dataDirectory, const std::vector<std::string>& types, Layout layout,
+                        size_t* moved = nullptr);
+
+    static constexpr size_t kShardCount = 256;
+
+private:
+    std::string dataDirectory_;
+    std::vector<std::string> types_;
+    bool useWriteAheadLog_;
+    Layout layout_;
+    std::unique_ptr<WriteAheadLog> wal_;
+
+    // Written since the last checkpoint; synced before the WAL is truncated
+    std::set<std::string> unsyncedPaths_;
+    // Shard directories known to exist, so writes skip the check
+    std::set<std::string> createdShards_;
+    std::mutex writeMutex_;
+
+    bool apply(const WriteAheadLog::Record& record);
+    bool syncWrittenFiles();
+    bool writeFileAtomic(const std::string& path, const std::string& payload);
+    bool ensureDirectoryExists(const std::string& path);
+    std::string getFilePath(const std::string& type, const UUID& id) const;
+    static std::string recordPath(const std::string& directory, const std::string& type, const UUID& id,
+                                  Layout layout);
+    static void collectIds(const std::string& directory, int depth, std::vector<UUID>& ids);
+};
+
+#endif // FILERECORDSTORE_H
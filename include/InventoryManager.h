@@ -1,13 +1,24 @@
 #ifndef INVENTORYMANAGER_H
 #define INVENTORYMANAGER_H
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include "UUID.h"
 #include "Database.h"
 #include "ActivityLog.h"
 #include "Container.h"
+#include "EntityRegistry.h"
+#include "EntityObserver.h"
+#include "SecondaryIndex.h"
+#include "SearchIndex.h"
+#include "WriteBehindQueue.h"
 
 class Item;
 class Location;
@@ -16,14 +27,42 @@ class Category;
 class ActivityLog;
 
 // Main facade class for managing the inventory system
-class InventoryManager {
+class InventoryManager : private EntityObserver {
 public:
     explicit InventoryManager(std::shared_ptr<IDatabase> database);
+    ~InventoryManager() override;
+    
+    // Registered entities point back at this manager for change notifications
+    InventoryManager(const InventoryManager&) = delete;
+    InventoryManager& operator=(const InventoryManager&) = delete;
     
     // Initialization
     bool initialize();
     bool shutdown();
     
+    // Persistence. Every entity carries a version (see Versioned); those
+    // changed since they were last written, including through pointers the
+    // manager handed out, are dirty. flush() writes only the dirty ones, one
+    // batch per entity type in a unit of work; shutdown() flushes too.
+    bool flush();
+    size_t dirtyCount() const;
+    
+    // Calls flush() every interval on a background thread until stopped or
+    // shut down. Manager methods serialize with it; code that changes
+    // entities directly while it runs must hold lock().
+    void startBackgroundFlush(std::chrono::milliseconds interval);
+    void stopBackgroundFlush();
+    std::unique_lock<std::recursive_mutex> lock() const;
+    
+    // Write-behind mode: mutations still apply in memory at once, but their
+    // writes go to a WriteBehindQueue instead of the database. flush() and
+    // shutdown() wait until everything queued is stored; disabling flushes
+    // first and returns to writing through.
+    void enableWriteBehind(const WriteBehindQueue::Options& options);
+    void enableWriteBehind();
+    bool disableWriteBehind();
+    const WriteBehindQueue* getWriteBehindQueue() const;
+    
     // Item management
     std::shared_ptr<Item> createItem(const std::string& name,
                                      std::shared_ptr<Category> category,
@@ -31,8 +70,12 @@ public:
                                      const std::string& description = "");
     bool deleteItem(const UUID& itemId);
     std::shared_ptr<Item> getItem(const UUID& itemId);
-    std::vector<std::shared_ptr<Item>> getAllItems();
-    std::vector<std::shared_ptr<Item>> searchItems(const std::string& query);
+    // The getAll* accessors return the registry's own list, not a copy, and
+    // do not lock: while other threads may use the manager (background
+    // flush, server workers), hold lock() for as long as the list is used.
+    const std::vector<std::shared_ptr<Item>>& getAllItems() const;
+    // Ranked full-text search over names and descriptions; limit == 0 means no limit
+    std::vector<std::shared_ptr<Item>> searchItems(const std::string& query, size_t limit = 0);
     
     // Container management
     std::shared_ptr<Container> createContainer(const std::string& name,
@@ -40,28 +83,28 @@ public:
                                               const std::string& description = "");
     bool deleteContainer(const UUID& containerId);
     std::shared_ptr<Container> getContainer(const UUID& containerId);
-    std::vector<std::shared_ptr<Container>> getAllContainers();
+    const std::vector<std::shared_ptr<Container>>& getAllContainers() const;
     
     // Location management
     std::shared_ptr<Location> createLocation(const std::string& name,
                                             const std::string& address = "");
     bool deleteLocation(const UUID& locationId);
     std::shared_ptr<Location> getLocation(const UUID& locationId);
-    std::vector<std::shared_ptr<Location>> getAllLocations();
+    const std::vector<std::shared_ptr<Location>>& getAllLocations() const;
     
     // Project management
     std::shared_ptr<Project> createProject(const std::string& name,
                                           const std::string& description = "");
     bool deleteProject(const UUID& projectId);
     std::shared_ptr<Project> getProject(const UUID& projectId);
-    std::vector<std::shared_ptr<Project>> getAllProjects();
+    const std::vector<std::shared_ptr<Project>>& getAllProjects() const;
     
     // Category management
     std::shared_ptr<Category> createCategory(const std::string& name,
                                             const std::string& description = "");
     bool deleteCategory(const UUID& categoryId);
     std::shared_ptr<Category> getCategory(const UUID& categoryId);
-    std::vector<std::shared_ptr<Category>> getAllCategories();
+    const std::vector<std::shared_ptr<Category>>& getAllCategories() const;
     
     // Item operations
     bool moveItem(const UUID& itemId, const UUID& toContainerId);
@@ -74,7 +117,8 @@ public:
     std::vector<std::shared_ptr<ActivityLog>> getItemHistory(const UUID& itemId);
     std::vector<std::shared_ptr<ActivityLog>> getRecentActivity(int limit = 50);
     
-    // Search and query
+    // Search and query. With duplicate names, findItemByName returns the
+    // item that was added (or loaded) first.
     std::shared_ptr<Item> findItemByName(const std::string& name);
     std::vector<std::shared_ptr<Item>> findItemsByCategory(const UUID& categoryId);
     std::vector<std::shared_ptr<Item>> findItemsInLocation(const UUID& locationId);
@@ -82,15 +126,57 @@ public:
     
 private:
     std::shared_ptr<IDatabase> database_;
+    mutable std::recursive_mutex mutex_;
+    
+    // Background flush
+    std::thread flushThread_;
+    std::mutex flushMutex_;
+    std::condition_variable flushWake_;
+    bool flushStop_;
+    
+    std::unique_ptr<WriteBehindQueue> writeBehind_;
+    
+    // Cached data, indexed by ID for O(1) lookup and delete
+    EntityRegistry<Item> items_;
+    EntityRegistry<Container> containers_;
+    EntityRegistry<Location> locations_;
+    EntityRegistry<Project> projects_;
+    EntityRegistry<Category> categories_;
+    
+    // Secondary indexes, kept current through EntityObserver callbacks
+    SecondaryIndex<std::string> itemsByName_;
+    SecondaryIndex<UUID> itemsByCategory_;
+    SecondaryIndex<UUID> itemsByContainer_;
+    SecondaryIndex<UUID> containersByLocation_;
+    SearchIndex searchIndex_;
+    
+    // Order in which items were indexed, to break ties between equal names
+    std::unordered_map<UUID, uint64_t> itemSequence_;
+    uint64_t nextItemSequence_;
+    
+    // Index maintenance
+    void indexItem(const std::shared_ptr<Item>& item);
+    void unindexItem(const std::shared_ptr<Item>& item);
+    void indexContainer(const std::shared_ptr<Container>& container);
+    void unindexContainer(const std::shared_ptr<Container>& container);
+    void rebuildIndexes();
+    void detachObservers();
+    std::vector<std::shared_ptr<Item>> resolveItems(const SecondaryIndex<UUID>::IdSet* ids) const;
     
-    // Cached data
-    std::vector<std::shared_ptr<Item>> items_;
-    std::vector<std::shared_ptr<Container>> containers_;
-    std::vector<std::shared_ptr<Location>> locations_;
-    std::vector<std::shared_ptr<Project>> projects_;
-    std::vector<std::shared_ptr<Category>> categories_;
+    // EntityObserver
+    void onItemNameChanged(const Item& item, const std::string& oldName) override;
+    void onItemDescriptionChanged(const Item& item, const std::string& oldDescription) override;
+    void onItemCategoryChanged(const Item& item, const std::shared_ptr<Category>& oldCategory) override;
+    void onItemContainerChanged(const Item& item, const std::shared_ptr<Container>& oldContainer) override;
+    void onContainerLocationChanged(const Container& container,
+                                    const std::shared_ptr<Location>& oldLocation) override;
     
     // Helper methods
+    template <typename T>
+    void persist(const std::shared_ptr<T>& entity, bool (IDatabase::*save)(std::shared_ptr<T>));
+    void persistActivity(const std::shared_ptr<ActivityLog>& log);
+    void unpersist(const UUID& id, void (WriteBehindQueue::*remove)(const UUID&),
+                   bool (IDatabase::*erase)(const UUID&));
     void logActivity(ActivityType type, std::shared_ptr<Item> item, 
                     const std::string& description, const std::string& userId);
     bool saveAll();
@@ -7,11 +7,13 @@
 #include <vector>
 #include "UUID.h"
 #include "Category.h"
+#include "Versioned.h"
 
 class Container;
 class ActivityLog;
+class EntityObserver;
 
-class Item {
+class Item : public Versioned {
 public:
     Item(const std::string& name, 
          std::shared_ptr<Category> category,
@@ -43,12 +45,20 @@ public:
     
     // Activity logging
     void addActivity(std::shared_ptr<ActivityLog> activity);
-    std::vector<std::shared_ptr<ActivityLog>> getActivityHistory() const;
+    const std::vector<std::shared_ptr<ActivityLog>>& getActivityHistory() const;
+    size_t activityCount() const;
     
     // Check-in/Check-out tracking
     bool isCheckedOut() const;
     std::chrono::system_clock::time_point getLastCheckOutTime() const;
     
+    // Change notifications (not owned; nullptr disables)
+    void setObserver(EntityObserver* observer);
+    
+    // A copy of the item's own fields for writing out: references are
+    // shared, the activity history is left out and no observer is set
+    std::shared_ptr<Item> snapshot() const;
+    
 private:
     UUID id_;
     std::string name_;
@@ -59,6 +69,7 @@ private:
     std::vector<std::shared_ptr<ActivityLog>> activityHistory_;
     bool checkedOut_;
     std::chrono::system_clock::time_point lastCheckOutTime_;
+    EntityObserver* observer_;
 };
 
 #endif // ITEM_H
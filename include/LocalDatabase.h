@@ -2,13 +2,46 @@
 #define LOCALDATABASE_H
 
 #include "Database.h"
+#include "RecordStore.h"
+#include "ActivityLogStore.h"
+#include <nlohmann/json_fwd.hpp>
+#include <memory>
 #include <string>
 #include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
 
 // Local file-based database implementation
 class LocalDatabase : public IDatabase {
 public:
-    explicit LocalDatabase(const std::string& dataDirectory);
+    enum class StorageMode {
+        FILE_PER_ENTITY,    // <dir>/<type>/<uuid>.json (default)
+        SHARDED_FILES,      // <dir>/<type>/ab/cd/<uuid>.json, see FileRecordStore
+        APPEND_LOG          // <dir>/<type>.log, see LogRecordStore
+    };
+    
+    // How records are written. Reads detect the encoding per record, so a
+    // directory may hold a mix (e.g. old pretty JSON next to new CBOR).
+    enum class Encoding {
+        PRETTY_JSON,        // Indented JSON (default for FILE_PER_ENTITY)
+        COMPACT_JSON,       // Single-line JSON (default for APPEND_LOG)
+        CBOR,               // Binary, tagged with a leading format byte
+        MESSAGEPACK         // Binary, tagged with a leading format byte
+    };
+    
+    // How records are read back
+    enum class ReadMode {
+        MEMORY_MAP,         // Parse straight from a read-only mapping (default)
+        STREAM              // Copy through std::ifstream first
+    };
+    
+    explicit LocalDatabase(const std::string& dataDirectory,
+                           StorageMode mode = StorageMode::FILE_PER_ENTITY);
     ~LocalDatabase() override;
     
     bool connect() override;
@@ -45,19 +78,148 @@ public:
     bool deleteCategory(const UUID& id) override;
     std::vector<std::shared_ptr<Category>> loadAllCategories() override;
     
-    // Activity log operations
+    // Activity log operations. Logs live in an ActivityLogStore under
+    // <dir>/activity/; loaded logs have their item set, but not their
+    // containers or project.
     bool saveActivityLog(std::shared_ptr<ActivityLog> log) override;
     std::vector<std::shared_ptr<ActivityLog>> loadActivityLogsForItem(const UUID& itemId) override;
     std::vector<std::shared_ptr<ActivityLog>> loadRecentActivityLogs(int limit) override;
     
+    // Batch operations. Saves encode on the load pool and reach the record
+    // store as one writeBatch (one lock and flush per log, or one WAL sync
+    // for the whole batch); loads read the requested records and the
+    // records they refer to, like loadAll*.
+    bool saveItems(const std::vector<std::shared_ptr<Item>>& items) override;
+    std::vector<std::shared_ptr<Item>> loadItems(const std::vector<UUID>& ids) override;
+    bool deleteItems(const std::vector<UUID>& ids) override;
+    bool saveContainers(const std::vector<std::shared_ptr<Container>>& containers) override;
+    std::vector<std::shared_ptr<Container>> loadContainers(const std::vector<UUID>& ids) override;
+    bool deleteContainers(const std::vector<UUID>& ids) override;
+    bool saveLocations(const std::vector<std::shared_ptr<Location>>& locations) override;
+    std::vector<std::shared_ptr<Location>> loadLocations(const std::vector<UUID>& ids) override;
+    bool deleteLocations(const std::vector<UUID>& ids) override;
+    bool saveProjects(const std::vector<std::shared_ptr<Project>>& projects) override;
+    std::vector<std::shared_ptr<Project>> loadProjects(const std::vector<UUID>& ids) override;
+    bool deleteProjects(const std::vector<UUID>& ids) override;
+    bool saveCategories(const std::vector<std::shared_ptr<Category>>& categories) override;
+    std::vector<std::shared_ptr<Category>> loadCategories(const std::vector<UUID>& ids) override;
+    bool deleteCategories(const std::vector<UUID>& ids) override;
+    bool saveActivityLogs(const std::vector<std::shared_ptr<ActivityLog>>& logs) override;
+    
+    // Paged loads walk a sorted index of the type's IDs and read only the
+    // records on the page, linked one level deep like the batch loads.
+    Page<Item> loadItemPage(const UUID& after, size_t limit) override;
+    Page<Container> loadContainerPage(const UUID& after, size_t limit) override;
+    Page<Location> loadLocationPage(const UUID& after, size_t limit) override;
+    Page<Project> loadProjectPage(const UUID& after, size_t limit) override;
+    Page<Category> loadCategoryPage(const UUID& after, size_t limit) override;
+    
+    // While a transaction is open, the calling thread's saves and deletes
+    // are staged in memory. Commit hands them to the record store as one
+    // batch, then appends the staged activity logs; rollback drops them.
+    // Reads, including the thread's own, see committed data only, and a
+    // staged delete succeeds even if the record does not exist. The batch
+    // is not atomic across a crash: a prefix of it may survive.
+    bool beginTransaction() override;
+    bool commitTransaction() override;
+    bool rollbackTransaction() override;
+    
+    // Two-phase bulk load: every record is decoded with its persisted ID,
+    // then references are linked through ID tables in one pass per type.
+    // loadAll* read only their own type plus the records it refers to (see
+    // readLinkedItems() and the others), so they restore no activity history.
+    bool loadSnapshot(EntitySnapshot& snapshot) override;
+    
+    // Threads used by bulk loads: 0 = one per hardware thread (default),
+    // 1 = fully sequential. Takes effect on the next connect().
+    void setLoadThreads(size_t threads);
+    size_t getLoadThreads() const;
+    
+    void setEncoding(Encoding encoding);
+    Encoding getEncoding() const;
+    
+    void setReadMode(ReadMode mode);
+    ReadMode getReadMode() const;
+    
+    // Segment size for activity logs; takes effect on the next connect()
+    void setActivityPartition(ActivityLogStore::Partition partition);
+    
+    StorageMode getStorageMode() const;
+    
+    // Moves the record files in dataDirectory to FILE_PER_ENTITY or
+    // SHARDED_FILES, setting moved (if given) to the number of files moved.
+    // The database must not be connected while this runs.
+    static bool migrateLayout(const std::string& dataDirectory, StorageMode mode, size_t* moved = nullptr);
+    RecordStore* getRecordStore() const;
+    ActivityLogStore* getActivityLogStore() const;
+    
 private:
     std::string dataDirectory_;
+    StorageMode storageMode_;
+    Encoding encoding_;
+    ReadMode readMode_;
+    std::unique_ptr<RecordStore> store_;
+    std::unique_ptr<ActivityLogStore> activityStore_;
     bool connected_;
+    size_t loadThreads_;
+    std::unique_ptr<ThreadPool> loadPool_;
+    
+    // Writes staged by an open transaction, per thread
+    struct PendingWork {
+        std::vector<RecordStore::Write> writes;
+        std::vector<ActivityLogStore::Entry> activity;
+    };
+    std::mutex pendingMutex_;
+    std::unordered_map<std::thread::id, PendingWork> pending_;
+    
+    // Sorted IDs per type for the paged loads, listed on the first page and
+    // kept current by writes, so a page is a lookup rather than a listing
+    std::mutex pageIndexMutex_;
+    std::unordered_map<std::string, std::set<UUID>> pageIndex_;
     
     // Helper methods
     bool ensureDirectoryExists(const std::string& path);
-    std::string getFilePath(const std::string& type, const UUID& id) const;
-    bool fileExists(const std::string& path) const;
+    std::string encodeRecord(const nlohmann::json& j) const;
+    bool writeRecord(const std::string& type, const UUID& id, const nlohmann::json& j);
+    bool removeRecord(const std::string& type, const UUID& id);
+    bool writeRecords(std::vector<RecordStore::Write> writes);
+    template <typename T>
+    bool saveRecords(const std::string& type, const std::vector<std::shared_ptr<T>>& entities,
+                     nlohmann::json (*encode)(const T&));
+    bool removeRecords(const std::string& type, const std::vector<UUID>& ids);
+    PendingWork* pendingWork();
+    std::vector<UUID> pageIds(const std::string& type, const UUID& after, size_t limit, UUID& next);
+    void updatePageIndex(const std::vector<RecordStore::Write>& writes, bool applied);
+    bool readRecord(const std::string& type, const UUID& id, nlohmann::json& j);
+    bool appendActivityRecord(const UUID& id, int64_t timestamp, const nlohmann::json& j);
+    bool appendActivityEntries(std::vector<ActivityLogStore::Entry> entries);
+    ActivityLogStore::Entry makeActivityEntry(const UUID& id, int64_t timestamp, const nlohmann::json& j) const;
+    bool migrateLegacyActivityLogs();
+    std::vector<std::shared_ptr<ActivityLog>> buildActivityLogs(
+        const std::vector<ActivityLogStore::Entry>& entries);
+    template <typename Row>
+    std::vector<Row> loadRows(const std::string& type,
+                              Row (*decode)(const UUID&, const nlohmann::json&));
+    std::vector<UUID> listIds(const std::string& type);
+    template <typename Row>
+    std::vector<Row> readRows(const std::string& type, const std::vector<UUID>& ids,
+                              Row (*decode)(const UUID&, const nlohmann::json&));
+    template <typename Row>
+    void readMissing(const std::string& type, std::vector<Row>& rows, const std::vector<UUID>& ids,
+                     Row (*decode)(const UUID&, const nlohmann::json&));
+    
+    // Targeted loads: the requested records plus the records they refer to,
+    // read by ID and linked one level deep, which is what callers read
+    // through them (names, counts). Projects also get the items of their
+    // containers' subcontainers, for their item totals.
+    std::vector<std::shared_ptr<Item>> readLinkedItems(const std::vector<UUID>& ids);
+    std::vector<std::shared_ptr<Container>> readLinkedContainers(const std::vector<UUID>& ids);
+    std::vector<std::shared_ptr<Location>> readLinkedLocations(const std::vector<UUID>& ids);
+    std::vector<std::shared_ptr<Project>> readLinkedProjects(const std::vector<UUID>& ids);
+    std::vector<std::shared_ptr<Category>> readLinkedCategories(const std::vector<UUID>& ids);
+    template <typename T>
+    Page<T> readPage(const std::string& type, const UUID& after, size_t limit,
+                     std::vector<std::shared_ptr<T>> (LocalDatabase::*read)(const std::vector<UUID>&));
 };
 
 #endif // LOCALDATABASE_H
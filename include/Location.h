@@ -5,13 +5,17 @@
 #include <vector>
 #include <memory>
 #include "UUID.h"
+#include "Versioned.h"
 
 class Container;
 
-class Location : public std::enable_shared_from_this<Location> {
+class Location : public std::enable_shared_from_this<Location>, public Versioned {
 public:
     Location(const std::string& name, const std::string& address = "");
     
+    // Constructor that allows specifying the UUID (for deserialization)
+    Location(const UUID& id, const std::string& name, const std::string& address = "");
+    
     UUID getId() const;
     std::string getName() const;
     std::string getAddress() const;
@@ -22,7 +26,8 @@ public:
     void addContainer(std::shared_ptr<Container> container);
     void removeContainer(const UUID& containerId);
     std::shared_ptr<Container> getContainer(const UUID& containerId) const;
-    std::vector<std::shared_ptr<Container>> getAllContainers() const;
+    const std::vector<std::shared_ptr<Container>>& getAllContainers() const;
+    size_t containerCount() const;
     
 private:
     UUID id_;
@@ -0,0 +1,95 @@
+#ifndef LOGRECORDSTORE_H
+#define LOGRECORDSTORE_H
+
+#include "RecordStore.h"
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class MappedFile;
+
+// Append-only log storage: one <dataDirectory>/<type>.log file per entity type.
+//
+// Each record is length-prefixed:
+//   u32 payload length | u8 op (put/delete) | u64 id high | u64 id low |
+//   u32 CRC-32 of op+id+payload | payload
+// Saves and deletes only ever append. An in-memory ID -> offset index is
+// rebuilt by scanning the log on open; a torn or corrupt tail left by a crash
+// is truncated away. Superseded records are reclaimed by compaction, which
+// rewrites the live records to a new file and renames it over the old one.
+//
+// The open-time scan and read() work on a read-only memory mapping of the
+// log; get() still reads through a stream. list() returns IDs in log order
+// so a bulk load walks the file front to back.
+class LogRecordStore : public RecordStore {
+public:
+    struct Options {
+        uint64_t compactionMinBytes = 1024 * 1024;  // Logs smaller than this are never compacted
+        double compactionGarbageRatio = 0.5;         // Compact once this fraction of a log is dead
+    };
+
+    LogRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types);
+    LogRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types,
+                   const Options& options);
+    ~LogRecordStore() override;
+
+    bool open() override;
+    void close() override;
+
+    bool put(const std::string& type, const UUID& id, const std::string& payload) override;
+    bool get(const std::string& type, const UUID& id, std::string& payload) override;
+    bool remove(const std::string& type, const UUID& id) override;
+    std::vector<UUID> list(const std::string& type) override;
+    // Appends the whole batch under one lock and flushes each log once
+    bool writeBatch(const std::vector<Write>& writes) override;
+    bool read(const std::string& type, const UUID& id, const RecordReader& reader) override;
+
+    // Rewrites the log keeping only live records
+    bool compact(const std::string& type);
+    uint64_t logSize(const std::string& type) const;
+    uint64_t garbageBytes(const std::string& type) const;
+
+    static constexpr size_t kHeaderSize = 25;
+
+private:
+    struct RecordLocation {
+        uint64_t offset;    // Start of the payload
+        uint32_t length;
+    };
+
+    struct Log {
+        std::string path;
+        std::ofstream writer;
+        std::ifstream reader;
+        // Replaced when a read falls past its end; readers keep the old one alive
+        std::shared_ptr<MappedFile> map;
+        std::unordered_map<UUID, RecordLocation> index;
+        uint64_t size = 0;
+        uint64_t liveBytes = 0;
+    };
+
+    std::string dataDirectory_;
+    Options options_;
+    std::map<std::string, Log> logs_;
+    mutable std::mutex mutex_;
+    bool open_;
+
+    bool openLog(Log& log);
+    bool scanLog(Log& log);
+    bool putLocked(Log& log, const UUID& id, const std::string& payload);
+    bool removeLocked(Log& log, const UUID& id);
+    bool append(Log& log, uint8_t op, const UUID& id, const std::string& payload);
+    bool flush(Log& log);
+    bool readPayload(Log& log, const RecordLocation& location, std::string& payload);
+    bool compactLocked(Log& log);
+    void maybeCompact(Log& log);
+    Log* findLog(const std::string& type);
+    const Log* findLog(const std::string& type) const;
+};
+
+#endif // LOGRECORDSTORE_H
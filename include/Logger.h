@@ -0,0 +1,162 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class LogLevel {
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR,
+    OFF
+};
+
+// Process-wide asynchronous log output.
+//
+// Each thread that logs gets its own fixed-size ring buffer of records. A
+// thread only ever appends to its own ring and the writer thread only ever
+// takes from it, so logging takes no lock and never waits on I/O: a record
+// costs one string move and two atomic operations. The writer drains the
+// rings every pollInterval (sooner when one fills past half) and writes the
+// records out in one pass, flushing the stream once per pass rather than
+// once per line. A thread whose ring is full drops the record and counts it
+// in getDroppedCount() instead of blocking.
+//
+// Records from different threads are not ordered against each other. The
+// sink is never destroyed, so logging from static destructors is safe; what
+// is buffered at exit is written by an atexit handler.
+class LogSink {
+public:
+    static LogSink& instance();
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    // Records below the level are discarded by Logger before they are built
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+    bool isEnabled(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::OFF;
+    }
+
+    // nullptr (the default) writes DEBUG and INFO to stdout, WARN and ERROR
+    // to stderr. The stream must outlive its use; flush() before replacing it.
+    void setOutput(std::ostream* out);
+
+    // Queues a record; component must be a string literal
+    void write(LogLevel level, const char* component, std::string message);
+
+    // Blocks until every record queued by the calling thread, and any other
+    // thread's records queued before the call, has been written
+    void flush();
+
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Record {
+        std::chrono::system_clock::time_point time;
+        LogLevel level = LogLevel::INFO;
+        const char* component = "";
+        std::string message;
+    };
+
+    // Single-producer, single-consumer ring owned by one logging thread
+    struct Ring {
+        explicit Ring(size_t capacity);
+
+        bool push(Record&& record);
+        template <typename Fn>
+        size_t drain(Fn&& fn);
+
+        std::vector<Record> slots;
+        size_t mask;
+        std::atomic<size_t> head{0};        // Next slot the producer fills
+        std::atomic<size_t> tail{0};        // Next slot the writer takes
+        std::atomic<bool> closed{false};    // Owning thread has exited
+    };
+
+    static constexpr size_t kRingCapacity = 1024;
+    static constexpr std::chrono::milliseconds kPollInterval{20};
+
+    std::atomic<LogLevel> level_;
+    std::atomic<uint64_t> dropped_;
+
+    std::mutex ringsMutex_;                 // Taken once per thread, to register its ring
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::mutex writerMutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::ostream* output_;
+    uint64_t flushRequested_;
+    uint64_t flushCompleted_;
+    std::thread writer_;
+
+    LogSink();
+
+    Ring& localRing();
+    void run();
+    void writeRecord(std::ostream* output, const Record& record);
+};
+
+// Named, leveled front end to LogSink. Loggers are cheap to construct and
+// usually live as a file-level constant:
+//
+//     static const Logger logger("LocalDatabase");
+//     logger.error() << "Error saving item: " << e.what();
+//
+// A line is submitted when the expression ends. When its level is disabled
+// nothing is formatted, but the arguments are still evaluated; guard
+// expensive ones with isEnabled().
+class Logger {
+public:
+    class Line {
+    public:
+        Line(const Logger& logger, LogLevel level);
+        ~Line();
+
+        Line(const Line&) = delete;
+        Line& operator=(const Line&) = delete;
+
+        template <typename T>
+        Line& operator<<(const T& value) {
+            if (stream_) {
+                *stream_ << value;
+            }
+            return *this;
+        }
+
+    private:
+        const Logger& logger_;
+        LogLevel level_;
+        std::optional<std::ostringstream> stream_;
+    };
+
+    // component must be a string literal; records keep the pointer
+    explicit Logger(const char* component);
+
+    bool isEnabled(LogLevel level) const;
+    const char* getComponent() const;
+
+    Line debug() const;
+    Line info() const;
+    Line warn() const;
+    Line error() const;
+    Line at(LogLevel level) const;
+
+private:
+    const char* component_;
+};
+
+#endif // LOGGER_H
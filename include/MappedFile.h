@@ -0,0 +1,46 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file.
+//
+// Records can be parsed straight out of the page cache instead of being
+// copied through stream buffers. The mapping is a snapshot of the file's
+// size at open(); bytes appended later need a new mapping. An empty file
+// maps to data() == nullptr, size() == 0.
+class MappedFile {
+public:
+    enum class Access {
+        NORMAL,
+        SEQUENTIAL          // Hint read-ahead for a front-to-back scan
+    };
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path, Access access = Access::NORMAL);
+    void close();
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+
+    // Changes the read-ahead hint for an open mapping
+    void advise(Access access);
+
+private:
+    const char* data_;
+    size_t size_;
+    bool open_;
+#ifdef _WIN32
+    void* file_;
+    void* mapping_;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -6,6 +6,7 @@
 #include <memory>
 #include <chrono>
 #include "UUID.h"
+#include "Versioned.h"
 
 class Container;
 class Item;
@@ -18,11 +19,16 @@ enum class ProjectStatus {
     CANCELLED
 };
 
-class Project {
+class Project : public Versioned {
 public:
     Project(const std::string& name, 
             const std::string& description = "");
     
+    // Constructor that allows specifying the UUID (for deserialization)
+    Project(const UUID& id,
+            const std::string& name,
+            const std::string& description = "");
+    
     UUID getId() const;
     std::string getName() const;
     std::string getDescription() const;
@@ -41,7 +47,8 @@ public:
     void addContainer(std::shared_ptr<Container> container);
     void removeContainer(const UUID& containerId);
     std::shared_ptr<Container> getContainer(const UUID& containerId) const;
-    std::vector<std::shared_ptr<Container>> getAllContainers() const;
+    const std::vector<std::shared_ptr<Container>>& getAllContainers() const;
+    size_t containerCount() const;
     
     // Item allocation tracking
     std::vector<std::shared_ptr<Item>> getAllAllocatedItems() const;
@@ -0,0 +1,73 @@
+#ifndef RECORDSTORE_H
+#define RECORDSTORE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "UUID.h"
+
+// Storage engine behind LocalDatabase.
+// Stores opaque serialized records keyed by entity type ("items",
+// "containers", ...) and ID. LocalDatabase owns the encoding; the store only
+// decides how bytes are laid out on disk.
+class RecordStore {
+public:
+    virtual ~RecordStore() = default;
+
+    virtual bool open() = 0;
+    virtual void close() = 0;
+
+    virtual bool put(const std::string& type, const UUID& id, const std::string& payload) = 0;
+    virtual bool get(const std::string& type, const UUID& id, std::string& payload) = 0;
+    virtual bool remove(const std::string& type, const UUID& id) = 0;
+    virtual std::vector<UUID> list(const std::string& type) = 0;
+
+    // Stores that spread a type over several directories list each part on
+    // its own, so bulk loads can walk them in parallel. The union of all
+    // partitions equals list().
+    virtual size_t partitionCount(const std::string& /*type*/) {
+        return 1;
+    }
+    virtual std::vector<UUID> listPartition(const std::string& type, size_t partition) {
+        return partition == 0 ? list(type) : std::vector<UUID>();
+    }
+
+    // One put (or remove) in a batch
+    struct Write {
+        std::string type;
+        UUID id;
+        std::string payload;
+        bool remove = false;
+    };
+
+    // Applies writes in order; false if any of them failed. Removing a
+    // record that does not exist is not a failure here. The default applies
+    // them one at a time; stores override it to sync or flush once per batch.
+    virtual bool writeBatch(const std::vector<Write>& writes) {
+        bool ok = true;
+        for (const auto& write : writes) {
+            if (write.remove) {
+                remove(write.type, write.id);
+            } else {
+                ok &= put(write.type, write.id, write.payload);
+            }
+        }
+        return ok;
+    }
+
+    // Hands the record's bytes to reader, without copying them where the
+    // store can serve them from a memory mapping. The bytes are only valid
+    // during the call.
+    using RecordReader = std::function<void(const char* data, size_t size)>;
+    virtual bool read(const std::string& type, const UUID& id, const RecordReader& reader) {
+        std::string payload;
+        if (!get(type, id, payload)) {
+            return false;
+        }
+        reader(payload.data(), payload.size());
+        return true;
+    }
+};
+
+#endif // RECORDSTORE_H
@@ -0,0 +1,96 @@
+#ifndef SQLCONNECTION_H
+#define SQLCONNECTION_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "UUID.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+// One connection used by SQLDatabase.
+//
+// SQLITE is a real embedded connection (requires a USE_SQLITE build).
+// Statements are prepared once per SQL string and cached for the life of
+// the connection. The other servers have no client library wired in yet:
+// a LOGGING connection prints each statement, reports success and returns
+// no rows, which is what SQLDatabase did for every backend before.
+//
+// Not thread-safe; SQLDatabase serialises access to each connection.
+class SQLConnection {
+public:
+    enum class Backend {
+        SQLITE,
+        LOGGING
+    };
+
+    // A cached prepared statement. Binds are 1-based, columns 0-based, as in
+    // SQLite. Reset (bindings cleared) when the handle goes out of scope.
+    class Statement {
+    public:
+        ~Statement();
+        Statement(Statement&& other) noexcept;
+        Statement(const Statement&) = delete;
+        Statement& operator=(const Statement&) = delete;
+        Statement& operator=(Statement&&) = delete;
+
+        bool isValid() const;
+
+        Statement& bind(int index, const std::string& value);
+        Statement& bind(int index, int64_t value);
+        Statement& bind(int index, int value);
+        Statement& bind(int index, const UUID& id);     // NULL for the nil UUID
+        Statement& bindNull(int index);
+
+        // Steps to the next row; false when done or on error (see succeeded())
+        bool next();
+        // Runs a statement that returns no rows
+        bool run();
+        bool succeeded() const;
+
+        bool isNull(int column) const;
+        std::string text(int column) const;
+        int64_t int64(int column) const;
+        int integer(int column) const;
+        UUID uuid(int column) const;                    // Nil for NULL
+
+    private:
+        friend class SQLConnection;
+        Statement(SQLConnection* connection, sqlite3_stmt* statement);
+
+        SQLConnection* connection_;
+        sqlite3_stmt* statement_;
+        bool failed_;
+    };
+
+    explicit SQLConnection(Backend backend = Backend::SQLITE);
+    ~SQLConnection();
+
+    SQLConnection(const SQLConnection&) = delete;
+    SQLConnection& operator=(const SQLConnection&) = delete;
+
+    // For SQLite, target is the database file path
+    bool open(const std::string& target, int busyTimeoutSeconds = 30);
+    void close();
+    bool isOpen() const;
+    Backend getBackend() const;
+
+    // Runs one or more statements that return no rows
+    bool execute(const std::string& sql);
+    // Returns a cached statement; check isValid() before use
+    Statement prepare(const std::string& sql);
+
+    std::string lastError() const;
+    size_t cachedStatementCount() const;
+
+private:
+    Backend backend_;
+    sqlite3* db_;
+    bool open_;
+    std::unordered_map<std::string, sqlite3_stmt*> statements_;
+
+    void reportError(const std::string& context) const;
+};
+
+#endif // SQLCONNECTION_H
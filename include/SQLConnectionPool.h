@@ -0,0 +1,123 @@
+#ifndef SQLCONNECTIONPOOL_H
+#define SQLCONNECTIONPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SQLConnection;
+
+// Bounded pool of SQLConnections.
+//
+// Connections are opened lazily, up to maxConnections. acquire() hands out a
+// Lease that returns its connection to the pool when it goes out of scope;
+// when every connection is in use it waits up to checkoutTimeout and then
+// returns an empty lease. A connection that has sat idle for longer than
+// healthCheckAfter is checked before it is handed out again, and replaced
+// with a fresh one if the check fails.
+//
+// Create pools with std::make_shared: leases keep the pool alive, so a lease
+// may safely outlive close().
+class SQLConnectionPool : public std::enable_shared_from_this<SQLConnectionPool> {
+public:
+    using Factory = std::function<std::unique_ptr<SQLConnection>()>;
+    using HealthCheck = std::function<bool(SQLConnection&)>;
+
+    struct Options {
+        size_t maxConnections = 10;
+        std::chrono::milliseconds checkoutTimeout{30000};
+        std::chrono::milliseconds healthCheckAfter{60000};
+    };
+
+    // Counters are totals since the pool was created
+    struct Metrics {
+        size_t maxConnections = 0;
+        size_t open = 0;                    // In use + idle
+        size_t inUse = 0;
+        size_t idle = 0;
+        size_t waiting = 0;                 // Callers blocked in acquire()
+        size_t peakInUse = 0;
+        uint64_t checkouts = 0;
+        uint64_t timeouts = 0;
+        uint64_t healthCheckFailures = 0;
+        uint64_t totalWaitMicros = 0;
+        uint64_t maxWaitMicros = 0;
+    };
+
+    class Lease {
+    public:
+        Lease();
+        ~Lease();
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        // A lease on a connection that belongs to someone else; releasing it
+        // does nothing
+        static Lease borrow(SQLConnection* connection);
+
+        explicit operator bool() const;
+        SQLConnection* get() const;
+        SQLConnection* operator->() const;
+        SQLConnection& operator*() const;
+
+        // Closes the connection on release instead of reusing it
+        void discard();
+        // Returns the connection to the pool now
+        void release();
+
+    private:
+        friend class SQLConnectionPool;
+        Lease(std::shared_ptr<SQLConnectionPool> pool, std::unique_ptr<SQLConnection> connection);
+
+        std::shared_ptr<SQLConnectionPool> pool_;
+        std::unique_ptr<SQLConnection> owned_;
+        SQLConnection* connection_;
+        bool discard_;
+    };
+
+    SQLConnectionPool(Factory factory, HealthCheck healthCheck, const Options& options);
+    SQLConnectionPool(Factory factory, HealthCheck healthCheck);
+    ~SQLConnectionPool();
+
+    SQLConnectionPool(const SQLConnectionPool&) = delete;
+    SQLConnectionPool& operator=(const SQLConnectionPool&) = delete;
+
+    // Empty lease on timeout, on a closed pool, or if the factory fails
+    Lease acquire();
+    Lease acquire(std::chrono::milliseconds timeout);
+
+    // Closes idle connections now and leased ones as they come back; pending
+    // and later acquire() calls fail
+    void close();
+
+    Metrics getMetrics() const;
+    const Options& getOptions() const;
+
+private:
+    struct IdleConnection {
+        std::unique_ptr<SQLConnection> connection;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    Factory factory_;
+    HealthCheck healthCheck_;
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<IdleConnection> idle_;      // Most recently returned last
+    size_t open_;
+    bool closed_;
+    Metrics metrics_;
+
+    void giveBack(std::unique_ptr<SQLConnection> connection, bool discard);
+};
+
+#endif // SQLCONNECTIONPOOL_H
@@ -2,15 +2,33 @@
 #define SQLDATABASE_H
 
 #include "Database.h"
+#include "SQLConnectionPool.h"
+#include <functional>
 #include <string>
-#include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
 
-// Forward declaration for database connection
-// This will be implemented with actual SQL library (e.g., libpq, MySQL Connector)
 class SQLConnection;
 
-// SQL database implementation supporting PostgreSQL, MySQL, SQLite
+// SQL database implementation supporting PostgreSQL, MySQL, SQLite.
+//
+// SQLite is fully implemented (USE_SQLITE builds): the database runs in WAL
+// journal mode, and every save/load/delete goes through a prepared
+// statement that is cached on the connection. Batch saves write many rows
+// per multi-row upsert inside one transaction. The other servers have no
+// client library wired in yet; they accept writes and return no rows.
+//
+// Every operation leases a connection from a pool of up to maxConnections,
+// so calls from different threads run side by side (WAL lets readers
+// proceed while one writer commits). beginTransaction() pins a connection to
+// the calling thread; that thread's operations use it until commit or
+// rollback. A ":memory:" SQLite database is private to its connection, so
+// it always gets a pool of one.
+//
+// Single-record loads return the entity with its stored ID and fields but
+// no references; loadSnapshot()/loadAll* link references across tables.
 class SQLDatabase : public IDatabase {
 public:
     enum class SQLType {
@@ -29,7 +47,9 @@ public:
         std::string password;
         std::string connectionString; // For custom connection strings
         int maxConnections = 10;
-        int connectionTimeout = 30; // seconds
+        int connectionTimeout = 30; // seconds, for checkout and for locks
+        int healthCheckInterval = 60; // seconds idle before a connection is re-checked
+        int batchSize = 500; // rows per multi-row INSERT in the batch saves
         bool useSSL = false;
     };
     
@@ -75,33 +95,79 @@ public:
     std::vector<std::shared_ptr<ActivityLog>> loadActivityLogsForItem(const UUID& itemId) override;
     std::vector<std::shared_ptr<ActivityLog>> loadRecentActivityLogs(int limit) override;
     
+    // One SELECT per table, then references are linked in memory
+    bool loadSnapshot(EntitySnapshot& snapshot) override;
+    
+    // Batch operations. Saves and deletes run in one transaction per call (a
+    // savepoint when the calling thread already has one open). Each
+    // statement covers up to batchSize rows: a multi-row upsert, or an
+    // id IN (...) list for loads and deletes. Loads then link references
+    // with a few more IN-list queries over the loaded IDs.
+    bool saveItems(const std::vector<std::shared_ptr<Item>>& items) override;
+    std::vector<std::shared_ptr<Item>> loadItems(const std::vector<UUID>& ids) override;
+    bool deleteItems(const std::vector<UUID>& ids) override;
+    bool saveContainers(const std::vector<std::shared_ptr<Container>>& containers) override;
+    std::vector<std::shared_ptr<Container>> loadContainers(const std::vector<UUID>& ids) override;
+    bool deleteContainers(const std::vector<UUID>& ids) override;
+    bool saveLocations(const std::vector<std::shared_ptr<Location>>& locations) override;
+    std::vector<std::shared_ptr<Location>> loadLocations(const std::vector<UUID>& ids) override;
+    bool deleteLocations(const std::vector<UUID>& ids) override;
+    bool saveProjects(const std::vector<std::shared_ptr<Project>>& projects) override;
+    std::vector<std::shared_ptr<Project>> loadProjects(const std::vector<UUID>& ids) override;
+    bool deleteProjects(const std::vector<UUID>& ids) override;
+    bool saveCategories(const std::vector<std::shared_ptr<Category>>& categories) override;
+    std::vector<std::shared_ptr<Category>> loadCategories(const std::vector<UUID>& ids) override;
+    bool deleteCategories(const std::vector<UUID>& ids) override;
+    bool saveActivityLogs(const std::vector<std::shared_ptr<ActivityLog>>& logs) override;
+    
+    // Paged loads select one page by primary key (id > after ORDER BY id)
+    // and link it one level deep like the batch loads
+    Page<Item> loadItemPage(const UUID& after, size_t limit) override;
+    Page<Container> loadContainerPage(const UUID& after, size_t limit) override;
+    Page<Location> loadLocationPage(const UUID& after, size_t limit) override;
+    Page<Project> loadProjectPage(const UUID& after, size_t limit) override;
+    Page<Category> loadCategoryPage(const UUID& after, size_t limit) override;
+    
     // SQL-specific operations
     bool initializeSchema();
     bool migrateSchema(int fromVersion, int toVersion);
     int getSchemaVersion();
     bool executeQuery(const std::string& query);
-    bool beginTransaction();
-    bool commitTransaction();
-    bool rollbackTransaction();
+    
+    // A real SQL transaction on a connection pinned to the calling thread
+    bool beginTransaction() override;
+    bool commitTransaction() override;
+    bool rollbackTransaction() override;
+    
+    // Zeroed metrics while disconnected
+    SQLConnectionPool::Metrics getPoolMetrics() const;
     
 private:
     ConnectionConfig config_;
-    SQLConnection* connection_;
+    std::shared_ptr<SQLConnectionPool> pool_;
     bool connected_;
+    // Connections pinned by beginTransaction(), by thread
+    std::unordered_map<std::thread::id, SQLConnectionPool::Lease> transactions_;
     mutable std::mutex connectionMutex_;
     
     // Helper methods
     std::string getConnectionString() const;
-    bool createTables();
-    bool createIndexes();
-    std::string escapeString(const std::string& str) const;
+    std::unique_ptr<SQLConnection> openConnection() const;
+    // The calling thread's transaction connection, or one from the pool
+    SQLConnectionPool::Lease acquireConnection();
+    bool initializeSchema(SQLConnection& connection);
+    int readSchemaVersion(SQLConnection& connection);
+    bool createTables(SQLConnection& connection);
+    bool createIndexes(SQLConnection& connection);
+    bool endTransaction(const char* sql);
+    bool writeBatch(const char* name, const std::function<bool(SQLConnection&)>& write);
+    bool writeProjects(SQLConnection& connection, const std::vector<std::shared_ptr<Project>>& projects);
+    bool writeCategories(SQLConnection& connection, const std::vector<std::shared_ptr<Category>>& categories);
+    size_t batchSize() const;
     std::string getSQLTypeString() const;
-    
-    // Query builders
-    std::string buildInsertQuery(const std::string& table, const std::map<std::string, std::string>& values);
-    std::string buildUpdateQuery(const std::string& table, const std::map<std::string, std::string>& values, const std::string& where);
-    std::string buildSelectQuery(const std::string& table, const std::vector<std::string>& columns, const std::string& where = "");
-    std::string buildDeleteQuery(const std::string& table, const std::string& where);
+    bool savepoint(SQLConnection& connection, const char* name);
+    bool releaseSavepoint(SQLConnection& connection, const char* name, bool ok);
+    std::vector<std::shared_ptr<ActivityLog>> readActivityLogs(const std::string& sql, const UUID& itemId, int limit);
 };
 
 #endif // SQLDATABASE_H
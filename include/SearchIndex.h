@@ -0,0 +1,60 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "UUID.h"
+
+// Inverted full-text index over item names and descriptions.
+// Text is case-folded (ASCII) and split into alphanumeric tokens. Every query
+// token must match a document token, either exactly, as a prefix, or (for
+// tokens of 3+ characters) as a substring via the trigram index. Shorter
+// tokens only match as prefixes, which keeps one- and two-letter queries off
+// the full vocabulary. Results are ranked, name matches outranking
+// description matches. Safe for concurrent readers and writers.
+class SearchIndex {
+public:
+    struct Hit {
+        UUID id;
+        int score;
+    };
+
+    // Adds or replaces the document for this ID
+    void add(const UUID& id, const std::string& name, const std::string& description);
+    void remove(const UUID& id);
+    bool contains(const UUID& id) const;
+    size_t size() const;
+    void clear();
+
+    // Best matches first; limit == 0 returns every match
+    std::vector<Hit> search(const std::string& query, size_t limit = 0) const;
+
+    static std::string fold(std::string_view text);
+    static std::vector<std::string> tokenize(std::string_view text);
+
+private:
+    using IdSet = std::unordered_set<UUID>;
+
+    struct Document {
+        std::string name;                    // Folded, for tie-breaking
+        std::vector<std::string> nameTerms;
+        std::vector<std::string> descriptionTerms;
+    };
+
+    void removeLocked(const UUID& id);
+    int scoreDocument(const Document& document, const std::vector<std::string>& terms,
+                      const std::string& foldedQuery) const;
+    IdSet candidatesFor(const std::string& term) const;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<UUID, Document> documents_;
+    std::map<std::string, IdSet> terms_;    // Ordered for prefix range scans
+    std::unordered_map<std::string, IdSet> trigrams_;
+};
+
+#endif // SEARCHINDEX_H
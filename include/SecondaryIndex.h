@@ -0,0 +1,54 @@
+#ifndef SECONDARYINDEX_H
+#define SECONDARYINDEX_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include "UUID.h"
+
+// Non-unique index from an attribute value to the IDs of entities holding it.
+// Lookups cost O(1) plus the size of the result.
+template <typename Key>
+class SecondaryIndex {
+public:
+    using IdSet = std::unordered_set<UUID>;
+
+    void insert(const Key& key, const UUID& id) {
+        entries_[key].insert(id);
+    }
+
+    void erase(const Key& key, const UUID& id) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return;
+        }
+
+        it->second.erase(id);
+        if (it->second.empty()) {
+            entries_.erase(it);
+        }
+    }
+
+    void eraseKey(const Key& key) {
+        entries_.erase(key);
+    }
+
+    // Returns nullptr when no entity has this key
+    const IdSet* find(const Key& key) const {
+        auto it = entries_.find(key);
+        return (it != entries_.end()) ? &it->second : nullptr;
+    }
+
+    size_t count(const Key& key) const {
+        auto it = entries_.find(key);
+        return (it != entries_.end()) ? it->second.size() : 0;
+    }
+
+    void clear() {
+        entries_.clear();
+    }
+
+private:
+    std::unordered_map<Key, IdSet> entries_;
+};
+
+#endif // SECONDARYINDEX_H
@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads.
+//
+// parallelFor() splits [0, count) into contiguous shards, runs them on the
+// workers and blocks until every shard has finished. The calling thread
+// runs the first shard itself, so a pool of N threads gives N + 1-way
+// parallelism and parallelFor() never deadlocks waiting on a busy pool.
+// If fn throws, parallelFor() still waits for every shard, then rethrows
+// the first exception on the calling thread.
+// Do not call parallelFor() from inside a pool task.
+class ThreadPool {
+public:
+    // 0 threads = one per hardware thread, minus the caller
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const;
+
+    // fn(begin, end) is called once per shard; shards hold at least minShard indices
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                     size_t minShard = 1);
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    bool stopping_;
+
+    void workerLoop();
+};
+
+#endif // THREADPOOL_H
@@ -3,26 +3,69 @@
 
 // Prevent Windows UUID type conflict
 #define WIN32_NO_STATUS
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include <string_view>
 
+// 128-bit identifier stored as two 64-bit words (16 bytes, trivially copyable).
+// The canonical 8-4-4-4-12 text form is only produced/parsed at serialization
+// boundaries via toString()/fromString(); comparisons are a two-word compare.
 class UUID {
 public:
+    enum class Version {
+        V4,     // Random
+        V7      // Unix-millisecond timestamp prefix, monotonically increasing
+    };
+    
+    static constexpr std::size_t kStringLength = 36;
+    
     UUID();
     explicit UUID(const std::string& uuid);
-    
+    UUID(uint64_t high, uint64_t low);
+
     std::string toString() const;
-    bool operator==(const UUID& other) const;
-    bool operator!=(const UUID& other) const;
-    
+    void toChars(char* buffer) const;  // Writes exactly kStringLength chars, no terminator
+    uint64_t getHigh() const { return high_; }
+    uint64_t getLow() const { return low_; }
+    bool isNil() const { return high_ == 0 && low_ == 0; }
+    int getVersion() const { return static_cast<int>((high_ >> 12) & 0xF); }
+    std::size_t hash() const noexcept;
+
+    bool operator==(const UUID& other) const { return high_ == other.high_ && low_ == other.low_; }
+    bool operator!=(const UUID& other) const { return !(*this == other); }
+    bool operator<(const UUID& other) const {
+        return high_ < other.high_ || (high_ == other.high_ && low_ < other.low_);
+    }
+    bool operator>(const UUID& other) const { return other < *this; }
+    bool operator<=(const UUID& other) const { return !(other < *this); }
+    bool operator>=(const UUID& other) const { return !(*this < other); }
+
+    // Generates an ID using the process-wide default version (V4 unless changed).
+    // Thread-safe: each thread draws from its own PRNG state.
     static UUID generate();
-    static UUID fromString(const std::string& uuid);
+    static UUID generateV4();
+    static UUID generateV7();
+    static void setDefaultVersion(Version version);
+    static Version getDefaultVersion();
     
+    // Parses the canonical text form; returns the nil UUID if the input is malformed
+    static UUID fromString(std::string_view uuid);
+    static UUID nil();
+
 private:
-    std::string uuid_;
-    static std::string generateUUIDv4();
+    uint64_t high_;
+    uint64_t low_;
 };
 
+namespace std {
+    template <>
+    struct hash<UUID> {
+        std::size_t operator()(const UUID& uuid) const noexcept {
+            return uuid.hash();
+        }
+    };
+}
+
 #endif // UUID_H
@@ -0,0 +1,25 @@
+#ifndef VERSIONED_H
+#define VERSIONED_H
+
+#include <cstdint>
+
+// Change tracking for persisted entities. Every mutator calls touch(), which
+// bumps the version; an owner that writes the entity records the version it
+// wrote with markSaved(). An entity is dirty until the version it was last
+// saved at catches up with its current one, so a change made while a save is
+// in flight keeps it dirty.
+class Versioned {
+public:
+    uint64_t getVersion() const { return version_; }
+    bool isDirty() const { return savedVersion_ != version_; }
+    void markSaved(uint64_t version) { savedVersion_ = version; }
+
+protected:
+    void touch() { ++version_; }
+
+private:
+    uint64_t version_ = 1;
+    uint64_t savedVersion_ = 0;     // New entities start dirty
+};
+
+#endif // VERSIONED_H
@@ -0,0 +1,93 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "UUID.h"
+
+// Write-ahead log with group commit.
+//
+// commit() appends a mutation to the log and returns once it is durable and
+// has been applied to the data files. Concurrent callers are batched: one
+// caller becomes the leader, writes every queued record, issues a single
+// fsync for the whole batch, then applies the batch in log order. The others
+// just wait for their record to be marked done.
+//
+// Applied records stay in the log until a checkpoint (when the log grows past
+// checkpointBytes, and on close) syncs the data files and truncates the log.
+// open() replays whatever a crash left behind, stopping at the first torn or
+// corrupt record. A batch that fails to write or sync is truncated off the
+// log so later batches stay replayable; if that truncate fails as well, the
+// log refuses further commits until it is reopened.
+class WriteAheadLog {
+public:
+    enum class Op : uint8_t {
+        PUT = 1,
+        REMOVE = 2
+    };
+
+    struct Record {
+        Op op;
+        std::string type;
+        UUID id;
+        std::string payload;
+    };
+
+    using ApplyFn = std::function<bool(const Record&)>;
+    using SyncFn = std::function<bool()>;
+
+    WriteAheadLog(const std::string& path, ApplyFn apply, SyncFn sync,
+                  uint64_t checkpointBytes = 4 * 1024 * 1024);
+    ~WriteAheadLog();
+
+    bool open();
+    void close();
+
+    // Blocks until the record is durable and applied; false if either step failed
+    bool commit(Record record);
+    // Commits the records in order in one group, so they share a single fsync;
+    // false if any of them failed
+    bool commit(std::vector<Record> records);
+
+    // Number of fsyncs issued on the log file so far
+    uint64_t syncCount() const;
+    // Records waiting for the current leader to pick them up
+    size_t pendingCount() const;
+
+    // fsync a file or directory by path (directories are a no-op on Windows)
+    static bool syncPath(const std::string& path);
+
+private:
+    struct Pending {
+        Record record;
+        bool done = false;
+        bool ok = false;
+    };
+
+    std::string path_;
+    ApplyFn apply_;
+    SyncFn sync_;
+    uint64_t checkpointBytes_;
+
+    int fd_;
+    uint64_t size_;     // Bytes of whole, synced batches in the log
+    bool open_;
+    bool failed_;       // The log may hold a partial batch; commits are refused
+    bool flushing_;
+    std::vector<std::shared_ptr<Pending>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable flushed_;
+    std::atomic<uint64_t> syncCount_;
+
+    bool replay();
+    bool writeBatch(const std::vector<std::shared_ptr<Pending>>& batch);
+    bool checkpoint();
+};
+
+#endif // WRITEAHEADLOG_H
@@ -0,0 +1,125 @@
+#ifndef WRITEBEHINDQUEUE_H
+#define WRITEBEHINDQUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Database.h"
+
+// Background persistence for an IDatabase.
+//
+// save() and remove*() return as soon as the write is queued; a worker
+// thread writes queued work in batches, one unit of work per batch. Writes
+// to the same entity coalesce while they wait: only the latest save or
+// delete of an ID is kept, so an entity changed ten times between batches is
+// written once. The worker starts a batch once work has waited maxDelay, or
+// as soon as the queue is half full or a flush() is waiting.
+//
+// The queue holds at most capacity entities (activity logs included); a
+// producer that would exceed it blocks until the worker has taken a batch.
+// A batch that fails is put back, behind any newer write of the same ID, and
+// retried after retryDelay.
+//
+// Saved entities are written as they are when the worker gets to them, on
+// the worker thread, so callers queue snapshots (copies) rather than live
+// objects they keep mutating.
+class WriteBehindQueue {
+public:
+    struct Options {
+        size_t capacity = 10000;
+        std::chrono::milliseconds maxDelay{50};
+        std::chrono::milliseconds retryDelay{1000};
+    };
+
+    // Counters are totals since the queue was created
+    struct Stats {
+        size_t pending = 0;
+        uint64_t queued = 0;            // save/remove calls
+        uint64_t coalesced = 0;         // Calls that replaced a queued write
+        uint64_t written = 0;           // Entities written by successful batches
+        uint64_t batches = 0;
+        uint64_t failedBatches = 0;
+        uint64_t blockedProducers = 0;  // Calls that waited for capacity
+    };
+
+    WriteBehindQueue(std::shared_ptr<IDatabase> database, const Options& options);
+    explicit WriteBehindQueue(std::shared_ptr<IDatabase> database);
+    // Writes what is queued (one attempt), then stops the worker
+    ~WriteBehindQueue();
+
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+
+    void save(std::shared_ptr<Item> item);
+    void save(std::shared_ptr<Container> container);
+    void save(std::shared_ptr<Location> location);
+    void save(std::shared_ptr<Project> project);
+    void save(std::shared_ptr<Category> category);
+    void save(std::shared_ptr<ActivityLog> log);
+
+    void removeItem(const UUID& id);
+    void removeContainer(const UUID& id);
+    void removeLocation(const UUID& id);
+    void removeProject(const UUID& id);
+    void removeCategory(const UUID& id);
+
+    // Blocks until everything queued before the call is written. Returns
+    // false if a batch failed in the meantime; the failed work stays queued.
+    bool flush();
+
+    Stats getStats() const;
+    const Options& getOptions() const;
+
+private:
+    // Latest queued write per ID; an ID is in at most one of the two
+    template <typename T>
+    struct Writes {
+        std::unordered_map<UUID, std::shared_ptr<T>> saves;
+        std::unordered_set<UUID> deletes;
+
+        size_t size() const { return saves.size() + deletes.size(); }
+    };
+
+    struct Batch {
+        Writes<Item> items;
+        Writes<Container> containers;
+        Writes<Location> locations;
+        Writes<Project> projects;
+        Writes<Category> categories;
+        std::vector<std::shared_ptr<ActivityLog>> activity;
+    };
+
+    std::shared_ptr<IDatabase> database_;
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_;      // Worker: work queued, flush requested or stopping
+    std::condition_variable space_;     // Producers: a batch was taken
+    std::condition_variable written_;   // flush(): a batch finished
+    Batch pending_;
+    size_t pendingCount_;
+    uint64_t queuedSeq_;                // Sequence number of the latest write
+    uint64_t writtenSeq_;               // Every write up to this one is stored
+    uint64_t flushSeq_;                 // Highest sequence a flush() waits for
+    bool stopping_;
+    Stats stats_;
+    std::thread worker_;
+
+    template <typename T>
+    void queueSave(Writes<T> Batch::*writes, std::shared_ptr<T> entity);
+    template <typename T>
+    void queueRemove(Writes<T> Batch::*writes, const UUID& id);
+    void waitForSpace(std::unique_lock<std::mutex>& lock);
+    void run();
+    bool writeBatch(const Batch& batch);
+    void requeue(Batch& failed);
+};
+
+#endif // WRITEBEHINDQUEUE_H
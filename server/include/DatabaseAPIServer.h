@@ -12,6 +12,7 @@
 #include "routes/CategoryRoutes.h"
 #include "routes/ActivityLogRoutes.h"
 #include "../include/Database.h"
+#include "../include/SearchIndex.h"
 
 /**
  * @brief Database API Server (Main Server Coordinator)
@@ -40,6 +41,7 @@ private:
     
     // Components
     std::unique_ptr<HTTPServer> httpServer;
+    std::shared_ptr<SearchIndex> searchIndex;
     std::unique_ptr<Authenticator> authenticator;
     std::unique_ptr<ItemRoutes> itemRoutes;
     std::unique_ptr<ContainerRoutes> containerRoutes;
@@ -51,6 +53,7 @@ private:
     // Initialization
     void registerAllRoutes();
     void setupAuthenticationMiddleware();
+    void buildSearchIndex();
     HTTPResponse handleSearch(const HTTPRequest& req);
 };
 
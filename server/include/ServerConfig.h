@@ -1,11 +1,12 @@
 #ifndef SERVER_CONFIG_H
 #define SERVER_CONFIG_H
 
+#include <cstdint>
 #include <string>
 
 /**
  * @brief Server Configuration
- * 
+ *
  * Holds configuration settings for the database server.
  */
 struct ServerConfig {
@@ -13,9 +14,16 @@ struct ServerConfig {
     bool authRequired;
     std::string apiKey;
     bool enableCORS;
-    int maxRequestSize;
-    int timeoutSeconds;
-    
+    int maxRequestSize;             // Larger request bodies are rejected with 413
+    int timeoutSeconds;             // Socket read and write timeout
+    uint32_t accessLogSampling;     // Log 1 in N requests; 0 disables the access log
+
+    // Connection handling
+    int workerThreads;              // 0 = one per hardware thread, at least 8
+    int maxQueuedConnections;       // Waiting for a worker; beyond this, 503. 0 = unbounded
+    int keepAliveMaxCount;          // Requests served on one connection before it is closed
+    int keepAliveTimeoutSeconds;    // Idle time before a kept-alive connection is closed
+
     // Default configuration
     ServerConfig()
         : port(8080),
@@ -23,7 +31,12 @@ struct ServerConfig {
           apiKey(""),
           enableCORS(true),
           maxRequestSize(10 * 1024 * 1024),  // 10 MB
-          timeoutSeconds(30) {}
+          timeoutSeconds(30),
+          accessLogSampling(1),
+          workerThreads(0),
+          maxQueuedConnections(256),
+          keepAliveMaxCount(100),
+          keepAliveTimeoutSeconds(5) {}
 };
 
 #endif // SERVER_CONFIG_H
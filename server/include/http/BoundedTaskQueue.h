@@ -0,0 +1,55 @@
+#ifndef BOUNDED_TASK_QUEUE_H
+#define BOUNDED_TASK_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed worker pool with a bounded connection queue
+ *
+ * Replaces httplib's default pool, whose queue grows without limit.
+ * Connections that arrive while maxQueued are already waiting go to one
+ * overflow thread, where isShedding() is true, so HTTPServer answers their
+ * requests with 503. When the overflow lane holds maxQueued too, enqueue()
+ * fails and the connection is closed unanswered. Both count as rejected.
+ * A maxQueued of 0 leaves the queue unbounded.
+ */
+class BoundedTaskQueue {
+public:
+    BoundedTaskQueue(size_t threads, size_t maxQueued, std::atomic<uint64_t>& rejected);
+    ~BoundedTaskQueue();
+
+    BoundedTaskQueue(const BoundedTaskQueue&) = delete;
+    BoundedTaskQueue& operator=(const BoundedTaskQueue&) = delete;
+
+    // False once shut down, or when both lanes are full
+    bool enqueue(std::function<void()> fn);
+
+    // Runs what is already queued, then joins every thread
+    void shutdown();
+
+    // True on the overflow thread
+    static bool isShedding();
+
+private:
+    size_t maxQueued_;
+    std::atomic<uint64_t>& rejected_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::condition_variable overflowAvailable_;
+    std::deque<std::function<void()>> queue_;
+    std::deque<std::function<void()>> overflow_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+    std::thread overflowWorker_;
+
+    void work(std::deque<std::function<void()>>& lane, std::condition_variable& ready);
+};
+
+#endif // BOUNDED_TASK_QUEUE_H
@@ -1,26 +1,51 @@
 #ifndef HTTP_REQUEST_H
 #define HTTP_REQUEST_H
 
+#include <array>
+#include <cstddef>
 #include <string>
-#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 /**
  * @brief HTTP Request structure
  * 
  * Represents an incoming HTTP request with method, path, headers, and body.
+ * 
+ * The body, headers and query parameters are views into buffers owned by
+ * whoever built the request; HTTPServer points them at cpp-httplib's
+ * request, so nothing is copied. They are valid only for the duration of
+ * the handler call: a handler that keeps any of them must copy it.
  */
 struct HTTPRequest {
+    using Fields = std::vector<std::pair<std::string_view, std::string_view>>;
+    
     std::string method;                           // GET, POST, PUT, DELETE, etc.
     std::string path;                             // /api/items, /api/containers, etc.
-    std::map<std::string, std::string> headers;   // HTTP headers
-    std::map<std::string, std::string> queryParams; // Query parameters
-    std::string body;                             // Request body (typically JSON)
+    Fields headers;                               // HTTP headers; names match case-insensitively
+    Fields queryParams;                           // Query parameters
+    std::string_view body;                        // Request body (typically JSON)
+    
+    // Path parameters bound by the router, e.g. "id" for /api/items/:id.
+    // Values are kept as offsets into path, so they stay valid in copies;
+    // names point into the router and live as long as the route does.
+    static constexpr size_t kMaxPathParams = 8;
+    struct PathParam {
+        std::string_view name;
+        size_t offset = 0;
+        size_t length = 0;
+    };
+    std::array<PathParam, kMaxPathParams> pathParams{};
+    size_t pathParamCount = 0;
     
     // Helper methods
-    bool hasHeader(const std::string& name) const;
-    std::string getHeader(const std::string& name, const std::string& defaultValue = "") const;
-    bool hasQueryParam(const std::string& name) const;
-    std::string getQueryParam(const std::string& name, const std::string& defaultValue = "") const;
+    bool hasHeader(std::string_view name) const;
+    std::string getHeader(std::string_view name, std::string_view defaultValue = "") const;
+    bool hasQueryParam(std::string_view name) const;
+    std::string getQueryParam(std::string_view name, std::string_view defaultValue = "") const;
+    bool hasPathParam(std::string_view name) const;
+    std::string_view getPathParam(std::string_view name) const;   // Empty if not bound
 };
 
 #endif // HTTP_REQUEST_H
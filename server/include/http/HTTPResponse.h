@@ -1,37 +1,53 @@
 #ifndef HTTP_RESPONSE_H
 #define HTTP_RESPONSE_H
 
+#include <functional>
 #include <string>
-#include <map>
+#include <utility>
+#include <vector>
 
 /**
  * @brief HTTP Response structure
  * 
  * Represents an HTTP response with status code, headers, and body.
+ * 
+ * Bodies are taken by value and moved through to the connection, so a
+ * handler that passes its serialized JSON with std::move never copies it.
+ * A large body can instead be streamed: see streamed().
  */
 struct HTTPResponse {
+    // Produces a streamed body: called until it returns false, each time
+    // appending the next chunk to its argument (the last call may append
+    // one too). It runs after the handler has returned, so it must own
+    // everything it uses. Throwing aborts the connection.
+    using ChunkSource = std::function<bool(std::string& chunk)>;
+    
     int statusCode;                               // 200, 201, 400, 404, 500, etc.
-    std::map<std::string, std::string> headers;   // HTTP headers
+    std::vector<std::pair<std::string, std::string>> headers;   // HTTP headers, one entry per name
     std::string body;                             // Response body (typically JSON)
+    ChunkSource stream;                           // If set, sent with chunked encoding instead of body
     
     // Constructor with defaults
     HTTPResponse();
-    HTTPResponse(int status, const std::string& body);
+    HTTPResponse(int status, std::string body);
     
     // Helper methods
-    void setHeader(const std::string& name, const std::string& value);
+    void setHeader(const std::string& name, const std::string& value);   // Replaces an existing value
+    const std::string* getHeader(const std::string& name) const;         // nullptr if not set
     void setContentType(const std::string& contentType);
     void enableCORS();
     
     // Factory methods for common responses
-    static HTTPResponse ok(const std::string& body, const std::string& contentType = "application/json");
-    static HTTPResponse created(const std::string& body, const std::string& contentType = "application/json");
+    static HTTPResponse ok(std::string body, const std::string& contentType = "application/json");
+    static HTTPResponse created(std::string body, const std::string& contentType = "application/json");
+    static HTTPResponse streamed(ChunkSource source, const std::string& contentType = "application/json");
     static HTTPResponse noContent();
     static HTTPResponse badRequest(const std::string& message);
     static HTTPResponse unauthorized(const std::string& message = "Unauthorized");
     static HTTPResponse notFound(const std::string& message = "Not found");
     static HTTPResponse notImplemented(const std::string& message = "Not implemented");
     static HTTPResponse internalError(const std::string& message = "Internal server error");
+    static HTTPResponse serviceUnavailable(const std::string& message = "Service unavailable");
 };
 
 #endif // HTTP_RESPONSE_H
@@ -1,22 +1,36 @@
 #ifndef HTTP_SERVER_H
 #define HTTP_SERVER_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include "RouteHandler.h"
+#include "Router.h"
+#include "ServerConfig.h"
 
 /**
  * @brief HTTP Server
  * 
  * Manages HTTP server lifecycle, route registration, and request routing.
  * Wraps the underlying HTTP library (cpp-httplib).
+ * 
+ * Connections are served by a fixed pool of worker threads. Accepted
+ * connections wait in a queue of at most maxQueuedConnections; once it is
+ * full, new connections are answered with 503 and closed instead of
+ * waiting, so a saturated server keeps its latency bounded.
+ * 
+ * Routes are matched by a Router, a segment trie, in one lookup per
+ * request. Patterns may name parameters (/api/items/:id); handlers read
+ * them with HTTPRequest::getPathParam().
  */
 class HTTPServer {
 public:
     HTTPServer(int port = 8080);
+    explicit HTTPServer(const ServerConfig& config);
     ~HTTPServer();
     
     // Server lifecycle
@@ -28,28 +42,46 @@ public:
     void setPort(int port);
     int getPort() const;
     
-    // Route registration
+    // Applies on the next start()
+    void setConfig(const ServerConfig& config);
+    const ServerConfig& getConfig() const;
+    
+    // Connections answered with 503, or closed, because the queue was full
+    uint64_t getRejectedCount() const;
+    
+    // Access log: one line per request, through the "HTTPServer" logger at
+    // INFO. 1 logs every request, N about one in N, 0 turns it off.
+    void setAccessLogSampling(uint32_t sampleEvery);
+    uint32_t getAccessLogSampling() const;
+    
+    // Route registration. Patterns are literal segments and parameters
+    // (":name", or ".*" for an unnamed one); see Router.
     void addRoute(const std::string& method, const std::string& path, RouteHandler handler);
     void removeRoute(const std::string& method, const std::string& path);
     
     // Direct request handling (for testing without starting server)
-    HTTPResponse handleRequest(const HTTPRequest& request);
+    HTTPResponse handleRequest(HTTPRequest request);
     
 private:
     int port_;
     bool running_;
     mutable std::mutex mutex_;
     std::thread serverThread_;
+    std::atomic<uint32_t> accessLogSampling_;
+    std::atomic<uint64_t> rejected_;
+    ServerConfig config_;
     
-    // Route table: method -> path -> handler
-    std::map<std::string, std::map<std::string, RouteHandler>> routes_;
+    // Route table, read by every request and written only at registration
+    mutable std::shared_mutex routesMutex_;
+    Router router_;
     
     // Internal HTTP library instance (implementation detail)
     class HTTPServerImpl;
     std::unique_ptr<HTTPServerImpl> impl_;
     
     // Helper methods
-    RouteHandler findHandler(const std::string& method, const std::string& path);
+    void installDispatch();
+    HTTPResponse route(HTTPRequest& request);
     std::string extractPathSegment(const std::string& path, int segmentIndex);
 };
 
@@ -0,0 +1,66 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "RouteHandler.h"
+
+/**
+ * @brief Request router
+ *
+ * Routes are kept in one trie per method, with an edge per path segment.
+ * A pattern segment is a literal, a named parameter (":id"), or ".*", an
+ * unnamed parameter kept for older patterns. match() walks the path once,
+ * segment by segment, without allocating: literal children are found by
+ * binary search, and a literal match wins over a parameter at the same
+ * depth. If the literal branch dead-ends, the matcher backs up and tries
+ * the parameter, so /api/items/batch and /api/items/:id can coexist.
+ *
+ * Empty segments are ignored, so "/api/items/" matches "/api/items".
+ * Not thread-safe; HTTPServer guards it with a shared lock.
+ */
+class Router {
+public:
+    Router();
+    ~Router();
+
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    // Replaces an existing route with the same method and pattern. Returns
+    // false if the pattern has more than HTTPRequest::kMaxPathParams parameters.
+    bool add(const std::string& method, const std::string& pattern, RouteHandler handler);
+    bool remove(const std::string& method, const std::string& pattern);
+
+    // Returns the handler for request.method and request.path and binds the
+    // request's path parameters, or returns nullptr. The handler stays valid
+    // until the route is removed or replaced.
+    const RouteHandler* match(HTTPRequest& request) const;
+
+    size_t size() const;
+
+private:
+    struct Node {
+        std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;   // Sorted by segment
+        std::unique_ptr<Node> param;
+        RouteHandler handler;                   // Set if a route ends here
+        std::vector<std::string> paramNames;    // Of that route, in path order
+    };
+
+    struct Capture {
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> methods_;
+    size_t size_;
+
+    Node* root(std::string_view method) const;
+    static const Node* matchNode(const Node& node, std::string_view path, size_t pos,
+                                 Capture* captures, size_t depth);
+};
+
+#endif // ROUTER_H
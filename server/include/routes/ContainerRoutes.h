@@ -14,6 +14,8 @@
  * - POST /api/containers - Create container
  * - PUT /api/containers/:id - Update container
  * - DELETE /api/containers/:id - Delete container
+ * - GET /api/containers/:id/items - List items in a container
+ * - GET /api/containers/:id/subcontainers - List direct subcontainers
  */
 class ContainerRoutes {
 public:
@@ -26,6 +28,8 @@ public:
     HTTPResponse handleCreate(const HTTPRequest& request);
     HTTPResponse handleUpdate(const HTTPRequest& request);
     HTTPResponse handleDelete(const HTTPRequest& request);
+    HTTPResponse handleGetItems(const HTTPRequest& request);
+    HTTPResponse handleGetSubContainers(const HTTPRequest& request);
     
 private:
     std::shared_ptr<IDatabase> database_;
@@ -4,6 +4,7 @@
 #include <memory>
 #include "../http/RouteHandler.h"
 #include "../../include/Database.h"
+#include "../../include/SearchIndex.h"
 
 /**
  * @brief Item API Routes
@@ -17,10 +18,15 @@
  * - POST /api/items/:id/move - Move item to container
  * - POST /api/items/:id/checkout - Check out item
  * - POST /api/items/:id/checkin - Check in item
+ * - POST /api/items/batch - Create or update an array of items
+ * - POST /api/items/batch/delete - Delete {"ids": [...]}
+ * 
+ * When a search index is supplied, item writes keep it up to date.
  */
 class ItemRoutes {
 public:
-    explicit ItemRoutes(std::shared_ptr<IDatabase> database);
+    explicit ItemRoutes(std::shared_ptr<IDatabase> database,
+                        std::shared_ptr<SearchIndex> searchIndex = nullptr);
     ~ItemRoutes() = default;
     
     // Route handlers
@@ -32,12 +38,16 @@ public:
     HTTPResponse handleMove(const HTTPRequest& request);
     HTTPResponse handleCheckout(const HTTPRequest& request);
     HTTPResponse handleCheckin(const HTTPRequest& request);
+    HTTPResponse handleBatchSave(const HTTPRequest& request);
+    HTTPResponse handleBatchDelete(const HTTPRequest& request);
     
 private:
     std::shared_ptr<IDatabase> database_;
+    std::shared_ptr<SearchIndex> searchIndex_;
     
     // Helper methods
-    std::string extractIdFromPath(const std::string& path);
+    std::string extractIdFromPath(const HTTPRequest& request);
+    void indexItem(const std::shared_ptr<Item>& item);
 };
 
 #endif // ITEM_ROUTES_H
@@ -14,6 +14,7 @@
  * - POST /api/locations - Create location
  * - PUT /api/locations/:id - Update location
  * - DELETE /api/locations/:id - Delete location
+ * - GET /api/locations/:id/containers - List containers at a location
  */
 class LocationRoutes {
 public:
@@ -26,6 +27,7 @@ public:
     HTTPResponse handleCreate(const HTTPRequest& request);
     HTTPResponse handleUpdate(const HTTPRequest& request);
     HTTPResponse handleDelete(const HTTPRequest& request);
+    HTTPResponse handleGetContainers(const HTTPRequest& request);
     
 private:
     std::shared_ptr<IDatabase> database_;
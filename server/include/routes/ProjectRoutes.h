@@ -14,6 +14,7 @@
  * - POST /api/projects - Create project
  * - PUT /api/projects/:id - Update project
  * - DELETE /api/projects/:id - Delete project
+ * - GET /api/projects/:id/containers - List containers allocated to a project
  */
 class ProjectRoutes {
 public:
@@ -26,6 +27,7 @@ public:
     HTTPResponse handleCreate(const HTTPRequest& request);
     HTTPResponse handleUpdate(const HTTPRequest& request);
     HTTPResponse handleDelete(const HTTPRequest& request);
+    HTTPResponse handleGetContainers(const HTTPRequest& request);
     
 private:
     std::shared_ptr<IDatabase> database_;
@@ -1,7 +1,19 @@
 #ifndef ROUTE_HELPERS_H
 #define ROUTE_HELPERS_H
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
 #include <string>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <string_view>
+#include "../http/HTTPRequest.h"
+#include "../http/HTTPResponse.h"
+#include "../serialization/JSONSerializer.h"
+#include "../../include/Database.h"
 #include "../../include/UUID.h"
 
 /**
@@ -29,11 +41,174 @@ namespace RouteHelpers {
             uuidStr = uuidStr.substr(0, queryPos);
         }
         
-        try {
-            return UUID::fromString(uuidStr);
-        } catch (const std::exception& e) {
+        UUID id = UUID::fromString(uuidStr);
+        if (id.isNil()) {
             throw std::invalid_argument("Invalid UUID in path: " + uuidStr);
         }
+        return id;
+    }
+    
+    /**
+     * @brief Extract UUID from a path parameter bound by the router
+     * @param request The routed request (e.g., "/api/containers/:id/items")
+     * @param param Name of the path parameter holding the UUID
+     * @return UUID extracted from the parameter, or from the last path
+     *         segment if the route does not bind one
+     * @throws std::invalid_argument if the UUID cannot be parsed
+     */
+    inline UUID extractUUID(const HTTPRequest& request, std::string_view param = "id") {
+        std::string_view value = request.getPathParam(param);
+        if (value.empty()) {
+            return extractUUID(request.path);
+        }
+        
+        UUID id = UUID::fromString(std::string(value));
+        if (id.isNil()) {
+            throw std::invalid_argument("Invalid UUID in path: " + std::string(value));
+        }
+        return id;
+    }
+    
+    /**
+     * @brief Reload a parent's children with their own references linked
+     *
+     * Batch loads link one level, so the children of a loaded parent carry
+     * no references of their own. Loading them again by ID fills those in.
+     *
+     * @param load Called as load(ids), returning the children found
+     * @return The children found, in the parent's order
+     */
+    template <typename T, typename Load>
+    std::vector<std::shared_ptr<T>> reloadChildren(const std::vector<std::shared_ptr<T>>& children, Load load) {
+        std::vector<UUID> ids;
+        ids.reserve(children.size());
+        for (const auto& child : children) {
+            ids.push_back(child->getId());
+        }
+        
+        // Batch loads do not promise an order
+        std::unordered_map<UUID, std::shared_ptr<T>> loaded;
+        for (auto& child : load(ids)) {
+            loaded.emplace(child->getId(), std::move(child));
+        }
+        std::vector<std::shared_ptr<T>> ordered;
+        ordered.reserve(loaded.size());
+        for (const auto& id : ids) {
+            auto it = loaded.find(id);
+            if (it != loaded.end()) {
+                ordered.push_back(it->second);
+            }
+        }
+        return ordered;
+    }
+    
+    constexpr size_t kMaxPageSize = 1000;       // Larger limits are clamped
+    constexpr size_t kStreamPageSize = 256;     // Entities loaded per streamed chunk
+    
+    /**
+     * @brief Split a comma-separated query value, dropping empty names
+     */
+    inline std::vector<std::string> splitList(std::string_view value) {
+        std::vector<std::string> names;
+        size_t start = 0;
+        while (start <= value.size()) {
+            size_t end = value.find(',', start);
+            if (end == std::string_view::npos) end = value.size();
+            if (end > start) {
+                names.emplace_back(value.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return names;
+    }
+    
+    /**
+     * @brief Respond with a collection, paged or streamed
+     *
+     * Query parameters: limit (1 to kMaxPageSize), cursor (the X-Next-Cursor
+     * of the previous page) and fields (comma-separated, see JSONSerializer).
+     * With a limit, responds with one page and sets X-Next-Cursor if more
+     * follow. Without one, streams every entity after the cursor as a single
+     * JSON array, loading and serializing kStreamPageSize at a time.
+     *
+     * @param load Called as load(after, limit), returning a Page<T>; it is
+     *        kept for the length of the stream, so it must own what it uses
+     */
+    template <typename T, typename Load>
+    HTTPResponse listCollection(const HTTPRequest& request, Load load) {
+        size_t limit = 0;
+        if (request.hasQueryParam("limit")) {
+            std::string value = request.getQueryParam("limit");
+            char* end = nullptr;
+            unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+            if (value.empty() || value[0] == '-' || *end != '\0' || parsed == 0) {
+                return HTTPResponse::badRequest("Invalid limit: " + value);
+            }
+            limit = std::min<unsigned long>(parsed, kMaxPageSize);
+        }
+        
+        UUID after = UUID::nil();
+        if (request.hasQueryParam("cursor")) {
+            std::string value = request.getQueryParam("cursor");
+            after = UUID::fromString(value);
+            if (after.isNil()) {
+                return HTTPResponse::badRequest("Invalid cursor: " + value);
+            }
+        }
+        std::vector<std::string> fields = splitList(request.getQueryParam("fields"));
+        
+        if (limit > 0) {
+            Page<T> page = load(after, limit);
+            if (!page.ok) {
+                return HTTPResponse::internalError("Failed to load page");
+            }
+            HTTPResponse response = HTTPResponse::ok(JSONSerializer::serialize(page.entities, fields));
+            if (!page.next.isNil()) {
+                response.setHeader("X-Next-Cursor", page.next.toString());
+            }
+            return response;
+        }
+        
+        // The first page is loaded before the status line goes out, so a
+        // failing database still gets an error status. A later page that
+        // fails aborts the connection instead of ending the array early.
+        struct Stream {
+            Load load;
+            std::vector<std::string> fields;
+            Page<T> page;
+            bool opened = false;
+            bool empty = true;
+        };
+        Page<T> first = load(after, kStreamPageSize);
+        if (!first.ok) {
+            return HTTPResponse::internalError("Failed to load page");
+        }
+        auto stream = std::make_shared<Stream>(Stream{std::move(load), std::move(fields), std::move(first)});
+        
+        return HTTPResponse::streamed([stream](std::string& chunk) {
+            if (!stream->opened) {
+                chunk += '[';
+                stream->opened = true;
+            }
+            std::string json = JSONSerializer::serialize(stream->page.entities, stream->fields);
+            if (json.size() > 2) {
+                if (!stream->empty) {
+                    chunk += ',';
+                }
+                chunk.append(json, 1, json.size() - 2);
+                stream->empty = false;
+            }
+            
+            if (stream->page.next.isNil()) {
+                chunk += ']';
+                return false;
+            }
+            stream->page = stream->load(stream->page.next, kStreamPageSize);
+            if (!stream->page.ok) {
+                throw std::runtime_error("Failed to load page");
+            }
+            return true;
+        });
     }
 }
 
@@ -2,7 +2,9 @@
 #define JSON_DESERIALIZER_H
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <vector>
 
 // Forward declarations
 class Item;
@@ -20,22 +22,25 @@ class ActivityLog;
 class JSONDeserializer {
 public:
     // Single entity deserialization
-    static std::shared_ptr<Item> deserializeItem(const std::string& json);
-    static std::shared_ptr<Container> deserializeContainer(const std::string& json);
-    static std::shared_ptr<Location> deserializeLocation(const std::string& json);
-    static std::shared_ptr<Project> deserializeProject(const std::string& json);
-    static std::shared_ptr<Category> deserializeCategory(const std::string& json);
-    static std::shared_ptr<ActivityLog> deserializeActivityLog(const std::string& json);
+    static std::shared_ptr<Item> deserializeItem(std::string_view json);
+    static std::shared_ptr<Container> deserializeContainer(std::string_view json);
+    static std::shared_ptr<Location> deserializeLocation(std::string_view json);
+    static std::shared_ptr<Project> deserializeProject(std::string_view json);
+    static std::shared_ptr<Category> deserializeCategory(std::string_view json);
+    static std::shared_ptr<ActivityLog> deserializeActivityLog(std::string_view json);
+    
+    // Array of items; throws if any element is invalid
+    static std::vector<std::shared_ptr<Item>> deserializeItems(std::string_view json);
     
     // Update existing entities from JSON
-    static void updateItem(std::shared_ptr<Item> item, const std::string& json);
-    static void updateContainer(std::shared_ptr<Container> container, const std::string& json);
-    static void updateLocation(std::shared_ptr<Location> location, const std::string& json);
-    static void updateProject(std::shared_ptr<Project> project, const std::string& json);
-    static void updateCategory(std::shared_ptr<Category> category, const std::string& json);
+    static void updateItem(std::shared_ptr<Item> item, std::string_view json);
+    static void updateContainer(std::shared_ptr<Container> container, std::string_view json);
+    static void updateLocation(std::shared_ptr<Location> location, std::string_view json);
+    static void updateProject(std::shared_ptr<Project> project, std::string_view json);
+    static void updateCategory(std::shared_ptr<Category> category, std::string_view json);
     
     // Validation
-    static bool isValidJSON(const std::string& json);
+    static bool isValidJSON(std::string_view json);
 };
 
 #endif // JSON_DESERIALIZER_H
@@ -28,13 +28,20 @@ public:
     static std::string serialize(std::shared_ptr<Category> category);
     static std::string serialize(std::shared_ptr<ActivityLog> log);
     
-    // Array serialization
-    static std::string serialize(const std::vector<std::shared_ptr<Item>>& items);
-    static std::string serialize(const std::vector<std::shared_ptr<Container>>& containers);
-    static std::string serialize(const std::vector<std::shared_ptr<Location>>& locations);
-    static std::string serialize(const std::vector<std::shared_ptr<Project>>& projects);
-    static std::string serialize(const std::vector<std::shared_ptr<Category>>& categories);
-    static std::string serialize(const std::vector<std::shared_ptr<ActivityLog>>& logs);
+    // Array serialization. Non-empty fields keeps only those fields of each
+    // element; unknown names are skipped.
+    static std::string serialize(const std::vector<std::shared_ptr<Item>>& items,
+                                 const std::vector<std::string>& fields = {});
+    static std::string serialize(const std::vector<std::shared_ptr<Container>>& containers,
+                                 const std::vector<std::string>& fields = {});
+    static std::string serialize(const std::vector<std::shared_ptr<Location>>& locations,
+                                 const std::vector<std::string>& fields = {});
+    static std::string serialize(const std::vector<std::shared_ptr<Project>>& projects,
+                                 const std::vector<std::string>& fields = {});
+    static std::string serialize(const std::vector<std::shared_ptr<Category>>& categories,
+                                 const std::vector<std::string>& fields = {});
+    static std::string serialize(const std::vector<std::shared_ptr<ActivityLog>>& logs,
+                                 const std::vector<std::string>& fields = {});
     
     // Error response serialization
     static std::string serializeError(const std::string& message);
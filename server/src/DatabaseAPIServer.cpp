@@ -1,10 +1,16 @@
 #include "../include/DatabaseAPIServer.h"
 #include "../include/serialization/JSONSerializer.h"
+#include "../../include/Item.h"
+#include "../../include/Logger.h"
 #include <nlohmann/json.hpp>
-#include <iostream>
+
+namespace {
+    const Logger logger("DatabaseAPIServer");
+}
 
 DatabaseAPIServer::DatabaseAPIServer(std::shared_ptr<IDatabase> db, const ServerConfig& config)
-    : database(db), config(config), httpServer(std::make_unique<HTTPServer>(config.port)) {
+    : database(db), config(config), httpServer(std::make_unique<HTTPServer>(config)),
+      searchIndex(std::make_shared<SearchIndex>()) {
     
     // Initialize authenticator if auth is required
     if (config.authRequired && !config.apiKey.empty()) {
@@ -14,7 +20,7 @@ DatabaseAPIServer::DatabaseAPIServer(std::shared_ptr<IDatabase> db, const Server
     }
     
     // Initialize route handlers
-    itemRoutes = std::make_unique<ItemRoutes>(database);
+    itemRoutes = std::make_unique<ItemRoutes>(database, searchIndex);
     containerRoutes = std::make_unique<ContainerRoutes>(database);
     locationRoutes = std::make_unique<LocationRoutes>(database);
     projectRoutes = std::make_unique<ProjectRoutes>(database);
@@ -27,6 +33,7 @@ DatabaseAPIServer::~DatabaseAPIServer() {
 }
 
 void DatabaseAPIServer::start() {
+    buildSearchIndex();
     registerAllRoutes();
     
     // TODO: Implement middleware support in HTTPServer
@@ -35,14 +42,14 @@ void DatabaseAPIServer::start() {
     // }
     
     httpServer->start();
-    std::cout << "Database API Server started on port " << config.port << std::endl;
-    std::cout << "Authentication: " << (config.authRequired ? "Enabled" : "Disabled") << std::endl;
-    std::cout << "CORS: " << (config.enableCORS ? "Enabled" : "Disabled") << std::endl;
+    logger.info() << "Database API Server started on port " << config.port;
+    logger.info() << "Authentication: " << (config.authRequired ? "Enabled" : "Disabled");
+    logger.info() << "CORS: " << (config.enableCORS ? "Enabled" : "Disabled");
 }
 
 void DatabaseAPIServer::stop() {
     httpServer->stop();
-    std::cout << "Database API Server stopped" << std::endl;
+    logger.info() << "Database API Server stopped";
 }
 
 bool DatabaseAPIServer::isRunning() const {
@@ -61,78 +68,79 @@ void DatabaseAPIServer::registerAllRoutes() {
     // Item routes
     httpServer->addRoute("GET", "/api/items", 
         [this](const HTTPRequest& req) { return itemRoutes->handleGetAll(req); });
-    httpServer->addRoute("GET", "/api/items/.*", 
+    httpServer->addRoute("GET", "/api/items/:id", 
         [this](const HTTPRequest& req) { return itemRoutes->handleGetById(req); });
     httpServer->addRoute("POST", "/api/items", 
         [this](const HTTPRequest& req) { return itemRoutes->handleCreate(req); });
-    httpServer->addRoute("PUT", "/api/items/.*", 
+    httpServer->addRoute("POST", "/api/items/batch", 
+        [this](const HTTPRequest& req) { return itemRoutes->handleBatchSave(req); });
+    httpServer->addRoute("POST", "/api/items/batch/delete", 
+        [this](const HTTPRequest& req) { return itemRoutes->handleBatchDelete(req); });
+    httpServer->addRoute("PUT", "/api/items/:id", 
         [this](const HTTPRequest& req) { return itemRoutes->handleUpdate(req); });
-    httpServer->addRoute("DELETE", "/api/items/.*", 
+    httpServer->addRoute("DELETE", "/api/items/:id", 
         [this](const HTTPRequest& req) { return itemRoutes->handleDelete(req); });
     
     // Container routes
     httpServer->addRoute("GET", "/api/containers", 
         [this](const HTTPRequest& req) { return containerRoutes->handleGetAll(req); });
-    httpServer->addRoute("GET", "/api/containers/.*", 
+    httpServer->addRoute("GET", "/api/containers/:id", 
         [this](const HTTPRequest& req) { return containerRoutes->handleGetById(req); });
     httpServer->addRoute("POST", "/api/containers", 
         [this](const HTTPRequest& req) { return containerRoutes->handleCreate(req); });
-    httpServer->addRoute("PUT", "/api/containers/.*", 
+    httpServer->addRoute("PUT", "/api/containers/:id", 
         [this](const HTTPRequest& req) { return containerRoutes->handleUpdate(req); });
-    httpServer->addRoute("DELETE", "/api/containers/.*", 
+    httpServer->addRoute("DELETE", "/api/containers/:id", 
         [this](const HTTPRequest& req) { return containerRoutes->handleDelete(req); });
-    // TODO: Implement handleGetItems and handleGetSubContainers in ContainerRoutes
-    // httpServer->addRoute("GET", "/api/containers/.*/items", 
-    //     [this](const HTTPRequest& req) { return containerRoutes->handleGetItems(req); });
-    // httpServer->addRoute("GET", "/api/containers/.*/subcontainers", 
-    //     [this](const HTTPRequest& req) { return containerRoutes->handleGetSubContainers(req); });
+    httpServer->addRoute("GET", "/api/containers/:id/items", 
+        [this](const HTTPRequest& req) { return containerRoutes->handleGetItems(req); });
+    httpServer->addRoute("GET", "/api/containers/:id/subcontainers", 
+        [this](const HTTPRequest& req) { return containerRoutes->handleGetSubContainers(req); });
     
     // Location routes
     httpServer->addRoute("GET", "/api/locations", 
         [this](const HTTPRequest& req) { return locationRoutes->handleGetAll(req); });
-    httpServer->addRoute("GET", "/api/locations/.*", 
+    httpServer->addRoute("GET", "/api/locations/:id", 
         [this](const HTTPRequest& req) { return locationRoutes->handleGetById(req); });
     httpServer->addRoute("POST", "/api/locations", 
         [this](const HTTPRequest& req) { return locationRoutes->handleCreate(req); });
-    httpServer->addRoute("PUT", "/api/locations/.*", 
+    httpServer->addRoute("PUT", "/api/locations/:id", 
         [this](const HTTPRequest& req) { return locationRoutes->handleUpdate(req); });
-    httpServer->addRoute("DELETE", "/api/locations/.*", 
+    httpServer->addRoute("DELETE", "/api/locations/:id", 
         [this](const HTTPRequest& req) { return locationRoutes->handleDelete(req); });
-    // TODO: Implement handleGetContainers in LocationRoutes
-    // httpServer->addRoute("GET", "/api/locations/.*/containers", 
-    //     [this](const HTTPRequest& req) { return locationRoutes->handleGetContainers(req); });
+    httpServer->addRoute("GET", "/api/locations/:id/containers", 
+        [this](const HTTPRequest& req) { return locationRoutes->handleGetContainers(req); });
     
     // Project routes
     httpServer->addRoute("GET", "/api/projects", 
         [this](const HTTPRequest& req) { return projectRoutes->handleGetAll(req); });
-    httpServer->addRoute("GET", "/api/projects/.*", 
+    httpServer->addRoute("GET", "/api/projects/:id", 
         [this](const HTTPRequest& req) { return projectRoutes->handleGetById(req); });
     httpServer->addRoute("POST", "/api/projects", 
         [this](const HTTPRequest& req) { return projectRoutes->handleCreate(req); });
-    httpServer->addRoute("PUT", "/api/projects/.*", 
+    httpServer->addRoute("PUT", "/api/projects/:id", 
         [this](const HTTPRequest& req) { return projectRoutes->handleUpdate(req); });
-    httpServer->addRoute("DELETE", "/api/projects/.*", 
+    httpServer->addRoute("DELETE", "/api/projects/:id", 
         [this](const HTTPRequest& req) { return projectRoutes->handleDelete(req); });
-    // TODO: Implement handleGetContainers in ProjectRoutes
-    // httpServer->addRoute("GET", "/api/projects/.*/containers", 
-    //     [this](const HTTPRequest& req) { return projectRoutes->handleGetContainers(req); });
+    httpServer->addRoute("GET", "/api/projects/:id/containers", 
+        [this](const HTTPRequest& req) { return projectRoutes->handleGetContainers(req); });
     
     // Category routes
     httpServer->addRoute("GET", "/api/categories", 
         [this](const HTTPRequest& req) { return categoryRoutes->handleGetAll(req); });
-    httpServer->addRoute("GET", "/api/categories/.*", 
+    httpServer->addRoute("GET", "/api/categories/:id", 
         [this](const HTTPRequest& req) { return categoryRoutes->handleGetById(req); });
     httpServer->addRoute("POST", "/api/categories", 
         [this](const HTTPRequest& req) { return categoryRoutes->handleCreate(req); });
-    httpServer->addRoute("PUT", "/api/categories/.*", 
+    httpServer->addRoute("PUT", "/api/categories/:id", 
         [this](const HTTPRequest& req) { return categoryRoutes->handleUpdate(req); });
-    httpServer->addRoute("DELETE", "/api/categories/.*", 
+    httpServer->addRoute("DELETE", "/api/categories/:id", 
         [this](const HTTPRequest& req) { return categoryRoutes->handleDelete(req); });
     
     // Activity log routes
     httpServer->addRoute("GET", "/api/logs", 
         [this](const HTTPRequest& req) { return activityLogRoutes->handleGetRecent(req); });
-    httpServer->addRoute("GET", "/api/logs/item/.*", 
+    httpServer->addRoute("GET", "/api/logs/item/:itemId", 
         [this](const HTTPRequest& req) { return activityLogRoutes->handleGetByItemId(req); });
     // TODO: Implement handleGetByUserId and handleGetByDateRange in ActivityLogRoutes
     // httpServer->addRoute("GET", "/api/logs/user", 
@@ -164,19 +172,45 @@ void DatabaseAPIServer::setupAuthenticationMiddleware() {
     */
 }
 
+void DatabaseAPIServer::buildSearchIndex() {
+    searchIndex->clear();
+    for (const auto& item : database->loadAllItems()) {
+        searchIndex->add(item->getId(), item->getName(), item->getDescription());
+    }
+    logger.info() << "Search index built: " << searchIndex->size() << " items";
+}
+
 HTTPResponse DatabaseAPIServer::handleSearch(const HTTPRequest& req) {
     try {
         if (!req.hasQueryParam("query")) {
             return HTTPResponse::badRequest(JSONSerializer::serializeError("query parameter required"));
         }
         
-        // TODO: Implement searchItems in IDatabase interface
-        // std::string query = req.getQueryParam("query");
-        // auto results = database->searchItems(query);
-        // std::string json = JSONSerializer::serialize(results);
-        // return HTTPResponse::ok(json, "application/json");
+        std::string query = req.getQueryParam("query");
+        
+        // Optional ?limit=N, 0 returns every match
+        size_t limit = 50;
+        if (req.hasQueryParam("limit")) {
+            try {
+                int requested = std::stoi(req.getQueryParam("limit"));
+                if (requested < 0) {
+                    throw std::invalid_argument("negative limit");
+                }
+                limit = static_cast<size_t>(requested);
+            } catch (const std::exception&) {
+                return HTTPResponse::badRequest(JSONSerializer::serializeError("Invalid limit parameter"));
+            }
+        }
+        
+        // The index only holds IDs; load the ranked hits from the database
+        std::vector<std::shared_ptr<Item>> results;
+        for (const auto& hit : searchIndex->search(query, limit)) {
+            if (auto item = database->loadItem(hit.id)) {
+                results.push_back(item);
+            }
+        }
         
-        return HTTPResponse::notImplemented(JSONSerializer::serializeError("Search not yet implemented"));
+        return HTTPResponse::ok(JSONSerializer::serialize(results), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -0,0 +1,82 @@
+#include "http/BoundedTaskQueue.h"
+
+namespace {
+    // Set on the thread that answers connections the queue had no room for
+    thread_local bool shedding = false;
+}
+
+BoundedTaskQueue::BoundedTaskQueue(size_t threads, size_t maxQueued, std::atomic<uint64_t>& rejected)
+    : maxQueued_(maxQueued), rejected_(rejected), stopping_(false) {
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this]() { work(queue_, available_); });
+    }
+    overflowWorker_ = std::thread([this]() {
+        shedding = true;
+        work(overflow_, overflowAvailable_);
+    });
+}
+
+BoundedTaskQueue::~BoundedTaskQueue() {
+    shutdown();
+}
+
+bool BoundedTaskQueue::enqueue(std::function<void()> fn) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_) {
+        return false;
+    }
+
+    if (maxQueued_ == 0 || queue_.size() < maxQueued_) {
+        queue_.push_back(std::move(fn));
+        lock.unlock();
+        available_.notify_one();
+        return true;
+    }
+
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    if (overflow_.size() >= maxQueued_) {
+        return false;
+    }
+    overflow_.push_back(std::move(fn));
+    lock.unlock();
+    overflowAvailable_.notify_one();
+    return true;
+}
+
+void BoundedTaskQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    available_.notify_all();
+    overflowAvailable_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    overflowWorker_.join();
+}
+
+bool BoundedTaskQueue::isShedding() {
+    return shedding;
+}
+
+// Runs queued connections until shutdown; what is queued then still runs
+void BoundedTaskQueue::work(std::deque<std::function<void()>>& lane, std::condition_variable& ready) {
+    while (true) {
+        std::function<void()> fn;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready.wait(lock, [&]() { return stopping_ || !lane.empty(); });
+            if (lane.empty()) {
+                return;
+            }
+            fn = std::move(lane.front());
+            lane.pop_front();
+        }
+        fn();
+    }
+}
@@ -1,19 +1,63 @@
 #include "../include/http/HTTPRequest.h"
+#include <algorithm>
+#include <cctype>
 
-bool HTTPRequest::hasHeader(const std::string& name) const {
-    return headers.find(name) != headers.end();
+namespace {
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+               });
+    }
+
+    bool equals(std::string_view a, std::string_view b) {
+        return a == b;
+    }
+
+    // Requests carry a handful of fields, so a scan beats building an index
+    template <typename Equal>
+    const std::string_view* findField(const HTTPRequest::Fields& fields, std::string_view name, Equal equal) {
+        for (const auto& [key, value] : fields) {
+            if (equal(key, name)) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+}
+
+bool HTTPRequest::hasHeader(std::string_view name) const {
+    return findField(headers, name, equalsIgnoreCase) != nullptr;
+}
+
+std::string HTTPRequest::getHeader(std::string_view name, std::string_view defaultValue) const {
+    const std::string_view* value = findField(headers, name, equalsIgnoreCase);
+    return std::string(value ? *value : defaultValue);
+}
+
+bool HTTPRequest::hasQueryParam(std::string_view name) const {
+    return findField(queryParams, name, equals) != nullptr;
 }
 
-std::string HTTPRequest::getHeader(const std::string& name, const std::string& defaultValue) const {
-    auto it = headers.find(name);
-    return (it != headers.end()) ? it->second : defaultValue;
+std::string HTTPRequest::getQueryParam(std::string_view name, std::string_view defaultValue) const {
+    const std::string_view* value = findField(queryParams, name, equals);
+    return std::string(value ? *value : defaultValue);
 }
 
-bool HTTPRequest::hasQueryParam(const std::string& name) const {
-    return queryParams.find(name) != queryParams.end();
+bool HTTPRequest::hasPathParam(std::string_view name) const {
+    for (size_t i = 0; i < pathParamCount; i++) {
+        if (pathParams[i].name == name) {
+            return true;
+        }
+    }
+    return false;
 }
 
-std::string HTTPRequest::getQueryParam(const std::string& name, const std::string& defaultValue) const {
-    auto it = queryParams.find(name);
-    return (it != queryParams.end()) ? it->second : defaultValue;
+std::string_view HTTPRequest::getPathParam(std::string_view name) const {
+    for (size_t i = 0; i < pathParamCount; i++) {
+        if (pathParams[i].name == name) {
+            return std::string_view(path).substr(pathParams[i].offset, pathParams[i].length);
+        }
+    }
+    return std::string_view();
 }
@@ -1,38 +1,62 @@
 #include "../include/http/HTTPResponse.h"
 
 HTTPResponse::HTTPResponse() : statusCode(200) {
-    headers["Content-Type"] = "application/json";
-    headers["Access-Control-Allow-Origin"] = "*";
+    headers.reserve(4);
+    headers.emplace_back("Content-Type", "application/json");
+    headers.emplace_back("Access-Control-Allow-Origin", "*");
 }
 
-HTTPResponse::HTTPResponse(int status, const std::string& responseBody)
-    : statusCode(status), body(responseBody) {
-    headers["Content-Type"] = "application/json";
-    headers["Access-Control-Allow-Origin"] = "*";
+HTTPResponse::HTTPResponse(int status, std::string responseBody)
+    : statusCode(status), body(std::move(responseBody)) {
+    headers.reserve(4);
+    headers.emplace_back("Content-Type", "application/json");
+    headers.emplace_back("Access-Control-Allow-Origin", "*");
 }
 
 void HTTPResponse::setHeader(const std::string& name, const std::string& value) {
-    headers[name] = value;
+    for (auto& header : headers) {
+        if (header.first == name) {
+            header.second = value;
+            return;
+        }
+    }
+    headers.emplace_back(name, value);
+}
+
+const std::string* HTTPResponse::getHeader(const std::string& name) const {
+    for (const auto& header : headers) {
+        if (header.first == name) {
+            return &header.second;
+        }
+    }
+    return nullptr;
 }
 
 void HTTPResponse::setContentType(const std::string& contentType) {
-    headers["Content-Type"] = contentType;
+    setHeader("Content-Type", contentType);
 }
 
 void HTTPResponse::enableCORS() {
-    headers["Access-Control-Allow-Origin"] = "*";
-    headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
-    headers["Access-Control-Allow-Headers"] = "Content-Type, X-API-Key, Authorization";
+    setHeader("Access-Control-Allow-Origin", "*");
+    setHeader("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
+    setHeader("Access-Control-Allow-Headers", "Content-Type, X-API-Key, Authorization");
+}
+
+HTTPResponse HTTPResponse::ok(std::string body, const std::string& contentType) {
+    HTTPResponse response(200, std::move(body));
+    response.setContentType(contentType);
+    return response;
 }
 
-HTTPResponse HTTPResponse::ok(const std::string& body, const std::string& contentType) {
-    HTTPResponse response(200, body);
+HTTPResponse HTTPResponse::created(std::string body, const std::string& contentType) {
+    HTTPResponse response(201, std::move(body));
     response.setContentType(contentType);
     return response;
 }
 
-HTTPResponse HTTPResponse::created(const std::string& body, const std::string& contentType) {
-    HTTPResponse response(201, body);
+HTTPResponse HTTPResponse::streamed(ChunkSource source, const std::string& contentType) {
+    HTTPResponse response(200, "");
+    response.stream = std::move(source);
     response.setContentType(contentType);
     return response;
 }
@@ -60,3 +84,7 @@ HTTPResponse HTTPResponse::notImplemented(const std::string& message) {
 HTTPResponse HTTPResponse::internalError(const std::string& message) {
     return HTTPResponse(500, "{\"error\":\"" + message + "\"}");
 }
+
+HTTPResponse HTTPResponse::serviceUnavailable(const std::string& message) {
+    return HTTPResponse(503, "{\"error\":\"" + message + "\"}");
+}
@@ -1,11 +1,37 @@
 #include "http/HTTPServer.h"
+#include "http/BoundedTaskQueue.h"
 #include "http/HTTPRequest.h"
 #include "http/HTTPResponse.h"
+#include "Logger.h"
 #include <httplib.h>
-#include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <shared_mutex>
 #include <vector>
 
+namespace {
+    const Logger logger("HTTPServer");
+    
+    // Hands httplib's connections to a BoundedTaskQueue
+    class HttplibTaskQueue : public httplib::TaskQueue {
+    public:
+        HttplibTaskQueue(size_t threads, size_t maxQueued, std::atomic<uint64_t>& rejected)
+            : queue_(threads, maxQueued, rejected) {}
+        
+        bool enqueue(std::function<void()> fn) override {
+            return queue_.enqueue(std::move(fn));
+        }
+        
+        void shutdown() override {
+            queue_.shutdown();
+        }
+        
+    private:
+        BoundedTaskQueue queue_;
+    };
+}
+
 // Internal implementation using cpp-httplib
 class HTTPServer::HTTPServerImpl {
 public:
@@ -17,7 +43,21 @@ public:
 HTTPServer::HTTPServer(int port)
     : port_(port)
     , running_(false)
+    , accessLogSampling_(1)
+    , rejected_(0)
     , impl_(std::make_unique<HTTPServerImpl>()) {
+    config_.port = port;
+    installDispatch();
+}
+
+HTTPServer::HTTPServer(const ServerConfig& config)
+    : port_(config.port)
+    , running_(false)
+    , accessLogSampling_(config.accessLogSampling)
+    , rejected_(0)
+    , config_(config)
+    , impl_(std::make_unique<HTTPServerImpl>()) {
+    installDispatch();
 }
 
 HTTPServer::~HTTPServer() {
@@ -31,13 +71,40 @@ bool HTTPServer::start() {
         return false;
     }
     
-    std::cout << "Starting HTTP server on port " << port_ << "..." << std::endl;
+    logger.info() << "Starting HTTP server on port " << port_ << "...";
+    
+    // Connection handling from the config
+    httplib::Server& server = *impl_->server;
+    server.set_read_timeout(config_.timeoutSeconds, 0);
+    server.set_write_timeout(config_.timeoutSeconds, 0);
+    server.set_keep_alive_max_count(static_cast<size_t>(std::max(config_.keepAliveMaxCount, 1)));
+    server.set_keep_alive_timeout(config_.keepAliveTimeoutSeconds);
+    server.set_payload_max_length(static_cast<size_t>(std::max(config_.maxRequestSize, 0)));
+    
+    size_t threads = config_.workerThreads > 0
+        ? static_cast<size_t>(config_.workerThreads)
+        : std::max<size_t>(8, std::thread::hardware_concurrency());
+    size_t maxQueued = static_cast<size_t>(std::max(config_.maxQueuedConnections, 0));
+    server.new_task_queue = [this, threads, maxQueued]() {
+        return new HttplibTaskQueue(threads, maxQueued, rejected_);
+    };
+    server.set_pre_routing_handler([](const httplib::Request&, httplib::Response& res) {
+        if (!BoundedTaskQueue::isShedding()) {
+            return httplib::Server::HandlerResponse::Unhandled;
+        }
+        HTTPResponse response = HTTPResponse::serviceUnavailable("Server is busy, retry later");
+        res.status = response.statusCode;
+        res.set_header("Retry-After", "1");
+        res.set_header("Connection", "close");
+        res.set_content(std::move(response.body), "application/json");
+        return httplib::Server::HandlerResponse::Handled;
+    });
     
     // Start server in a separate thread
     serverThread_ = std::thread([this]() {
         running_ = true;
         if (!impl_->server->listen("0.0.0.0", port_)) {
-            std::cerr << "Failed to start server on port " << port_ << std::endl;
+            logger.error() << "Failed to start server on port " << port_;
             std::lock_guard<std::mutex> lock(mutex_);
             running_ = false;
         }
@@ -53,7 +120,7 @@ void HTTPServer::stop() {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (running_) {
-        std::cout << "Stopping HTTP server..." << std::endl;
+        logger.info() << "Stopping HTTP server...";
         impl_->server->stop();
         if (serverThread_.joinable()) {
             serverThread_.join();
@@ -71,6 +138,7 @@ void HTTPServer::setPort(int port) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!running_) {
         port_ = port;
+        config_.port = port;
     }
 }
 
@@ -78,96 +146,112 @@ int HTTPServer::getPort() const {
     return port_;
 }
 
-// Helper function to check if pattern matches path
-static bool pathMatches(const std::string& pattern, const std::string& path) {
-    std::vector<std::string> patternSegments;
-    std::vector<std::string> pathSegments;
-    
-    // Split pattern by '/'
-    size_t start = 0;
-    while (start < pattern.length()) {
-        while (start < pattern.length() && pattern[start] == '/') start++;
-        if (start >= pattern.length()) break;
-        
-        size_t end = pattern.find('/', start);
-        if (end == std::string::npos) end = pattern.length();
-        
-        patternSegments.push_back(pattern.substr(start, end - start));
-        start = end;
-    }
-    
-    // Split path by '/'
-    start = 0;
-    while (start < path.length()) {
-        while (start < path.length() && path[start] == '/') start++;
-        if (start >= path.length()) break;
-        
-        size_t end = path.find('/', start);
-        if (end == std::string::npos) end = path.length();
-        
-        pathSegments.push_back(path.substr(start, end - start));
-        start = end;
-    }
-    
-    if (patternSegments.size() != pathSegments.size()) {
-        return false;
-    }
-    
-    for (size_t i = 0; i < patternSegments.size(); i++) {
-        if (patternSegments[i][0] == ':') {
-            continue;
-        }
-        if (patternSegments[i] != pathSegments[i]) {
-            return false;
-        }
+void HTTPServer::setConfig(const ServerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        config_ = config;
+        port_ = config.port;
+        accessLogSampling_.store(config.accessLogSampling, std::memory_order_relaxed);
     }
-    
-    return true;
+}
+
+const ServerConfig& HTTPServer::getConfig() const {
+    return config_;
+}
+
+uint64_t HTTPServer::getRejectedCount() const {
+    return rejected_.load(std::memory_order_relaxed);
+}
+
+void HTTPServer::setAccessLogSampling(uint32_t sampleEvery) {
+    accessLogSampling_.store(sampleEvery, std::memory_order_relaxed);
+}
+
+uint32_t HTTPServer::getAccessLogSampling() const {
+    return accessLogSampling_.load(std::memory_order_relaxed);
 }
 
 void HTTPServer::addRoute(const std::string& method, const std::string& path, RouteHandler handler) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    routes_[method][path] = handler;
+    std::unique_lock<std::shared_mutex> lock(routesMutex_);
     
-    auto wrapHandler = [handler](const httplib::Request& req, httplib::Response& res) {
-        // Log incoming request
-        std::cout << "[" << req.method << "] " << req.path;
-        if (!req.params.empty()) {
-            std::cout << " (with query params)";
-        }
-        std::cout << std::endl;
+    if (!router_.add(method, path, std::move(handler))) {
+        logger.error() << "Route " << method << ' ' << path << " has more than "
+                       << HTTPRequest::kMaxPathParams << " parameters; not registered";
+    }
+}
+
+void HTTPServer::removeRoute(const std::string& method, const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(routesMutex_);
+    router_.remove(method, path);
+}
+
+HTTPResponse HTTPServer::handleRequest(HTTPRequest request) {
+    return route(request);
+}
+
+// Private helper methods
+void HTTPServer::installDispatch() {
+    // One catch-all per method hands every request to the router, so
+    // httplib never walks its own list of regexes
+    auto dispatch = [this](const httplib::Request& req, httplib::Response& res) {
+        // Sampling counts per thread, so workers never contend on a counter
+        thread_local uint32_t requestCount = 0;
+        uint32_t sampling = accessLogSampling_.load(std::memory_order_relaxed);
+        bool logAccess = sampling > 0 && ++requestCount % sampling == 0 && logger.isEnabled(LogLevel::INFO);
+        auto started = logAccess ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
         
+        // The request views httplib's buffers, which outlive the handler call
         HTTPRequest request;
         request.method = req.method;
         request.path = req.path;
         request.body = req.body;
         
+        request.headers.reserve(req.headers.size());
         for (const auto& [key, value] : req.headers) {
-            request.headers[key] = value;
+            request.headers.emplace_back(key, value);
         }
         
+        request.queryParams.reserve(req.params.size());
         for (const auto& [key, value] : req.params) {
-            request.queryParams[key] = value;
+            request.queryParams.emplace_back(key, value);
         }
         
-        HTTPResponse response = handler(request);
+        HTTPResponse response = route(request);
         
-        // Log response status
-        std::cout << "    → " << response.statusCode << " " 
-                  << (response.statusCode < 300 ? "✓" : (response.statusCode < 400 ? "→" : "✗"))
-                  << std::endl;
+        if (logAccess) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - started).count();
+            logger.info() << req.method << ' ' << req.path << ' ' << response.statusCode << ' ' << micros << "us";
+        }
         
         res.status = response.statusCode;
         
-        std::string contentType = "application/json";
-        auto it = response.headers.find("Content-Type");
-        if (it != response.headers.end()) {
-            contentType = it->second;
+        const std::string* header = response.getHeader("Content-Type");
+        std::string contentType = header ? *header : "application/json";
+        if (response.stream) {
+            // httplib pulls chunks as the socket accepts them, so at most
+            // one chunk of the body is held at a time
+            res.set_chunked_content_provider(contentType,
+                [source = std::move(response.stream)](size_t, httplib::DataSink& sink) {
+                    try {
+                        std::string chunk;
+                        bool more = source(chunk);
+                        if (!chunk.empty() && !sink.write(chunk.data(), chunk.size())) {
+                            return false;
+                        }
+                        if (!more) {
+                            sink.done();
+                        }
+                        return true;
+                    } catch (const std::exception& e) {
+                        logger.error() << "Streamed response aborted: " << e.what();
+                        return false;
+                    }
+                });
+        } else {
+            res.set_content(std::move(response.body), contentType);
         }
         
-        res.set_content(response.body, contentType);
-        
         for (const auto& [key, value] : response.headers) {
             if (key != "Content-Type") {
                 res.set_header(key, value);
@@ -175,42 +259,22 @@ void HTTPServer::addRoute(const std::string& method, const std::string& path, Ro
         }
     };
     
-    // Convert .* wildcard pattern to cpp-httplib regex format
-    // e.g., "/api/items/.*" becomes R"(/api/items/([^/]+))"
-    std::string cppHttplibPath = path;
-    if (path.find(".*") != std::string::npos) {
-        // Replace .* with a regex capture group for any characters
-        size_t pos = path.find(".*");
-        cppHttplibPath = path.substr(0, pos) + R"(([^/]+))";
-    }
-    
-    if (method == "GET") {
-        impl_->server->Get(cppHttplibPath, wrapHandler);
-    } else if (method == "POST") {
-        impl_->server->Post(cppHttplibPath, wrapHandler);
-    } else if (method == "PUT") {
-        impl_->server->Put(cppHttplibPath, wrapHandler);
-    } else if (method == "DELETE") {
-        impl_->server->Delete(cppHttplibPath, wrapHandler);
-    } else if (method == "PATCH") {
-        impl_->server->Patch(cppHttplibPath, wrapHandler);
-    }
+    httplib::Server& server = *impl_->server;
+    server.Get(".*", dispatch);
+    server.Post(".*", dispatch);
+    server.Put(".*", dispatch);
+    server.Delete(".*", dispatch);
+    server.Patch(".*", dispatch);
 }
 
-void HTTPServer::removeRoute(const std::string& method, const std::string& path) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto methodIt = routes_.find(method);
-    if (methodIt != routes_.end()) {
-        methodIt->second.erase(path);
-        if (methodIt->second.empty()) {
-            routes_.erase(methodIt);
+HTTPResponse HTTPServer::route(HTTPRequest& request) {
+    RouteHandler handler;
+    {
+        std::shared_lock<std::shared_mutex> lock(routesMutex_);
+        if (const RouteHandler* matched = router_.match(request)) {
+            handler = *matched;
         }
     }
-}
-
-HTTPResponse HTTPServer::handleRequest(const HTTPRequest& request) {
-    RouteHandler handler = findHandler(request.method, request.path);
     
     if (handler) {
         return handler(request);
@@ -219,28 +283,6 @@ HTTPResponse HTTPServer::handleRequest(const HTTPRequest& request) {
     return HTTPResponse::notFound("Route not found");
 }
 
-RouteHandler HTTPServer::findHandler(const std::string& method, const std::string& path) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto methodIt = routes_.find(method);
-    if (methodIt == routes_.end()) {
-        return nullptr;
-    }
-    
-    auto pathIt = methodIt->second.find(path);
-    if (pathIt != methodIt->second.end()) {
-        return pathIt->second;
-    }
-    
-    for (const auto& [pattern, handler] : methodIt->second) {
-        if (pathMatches(pattern, path)) {
-            return handler;
-        }
-    }
-    
-    return nullptr;
-}
-
 std::string HTTPServer::extractPathSegment(const std::string& path, int segmentIndex) {
     size_t start = 0;
     int currentIndex = 0;
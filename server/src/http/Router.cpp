@@ -0,0 +1,157 @@
+#include "http/Router.h"
+#include <algorithm>
+
+namespace {
+    std::vector<std::string_view> splitSegments(std::string_view path) {
+        std::vector<std::string_view> segments;
+        size_t start = 0;
+        while (start < path.size()) {
+            size_t end = path.find('/', start);
+            if (end == std::string_view::npos) end = path.size();
+            if (end > start) {
+                segments.push_back(path.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return segments;
+    }
+
+    bool isParam(std::string_view segment) {
+        return segment[0] == ':' || segment == ".*";
+    }
+
+    template <typename Children>
+    auto findChild(Children& children, std::string_view segment) {
+        auto it = std::lower_bound(children.begin(), children.end(), segment,
+                                   [](const auto& child, std::string_view key) { return child.first < key; });
+        return (it != children.end() && it->first == segment) ? it : children.end();
+    }
+}
+
+Router::Router() : size_(0) {}
+
+Router::~Router() = default;
+
+bool Router::add(const std::string& method, const std::string& pattern, RouteHandler handler) {
+    auto segments = splitSegments(pattern);
+    size_t params = std::count_if(segments.begin(), segments.end(), isParam);
+    if (params > HTTPRequest::kMaxPathParams) {
+        return false;
+    }
+
+    Node* node = root(method);
+    if (!node) {
+        methods_.emplace_back(method, std::make_unique<Node>());
+        node = methods_.back().second.get();
+    }
+
+    std::vector<std::string> names;
+    for (auto segment : segments) {
+        if (isParam(segment)) {
+            if (!node->param) {
+                node->param = std::make_unique<Node>();
+            }
+            node = node->param.get();
+            names.emplace_back(segment[0] == ':' ? segment.substr(1) : std::string_view());
+            continue;
+        }
+
+        auto& children = node->children;
+        auto it = findChild(children, segment);
+        if (it == children.end()) {
+            it = std::lower_bound(children.begin(), children.end(), segment,
+                                  [](const auto& child, std::string_view key) { return child.first < key; });
+            it = children.emplace(it, std::string(segment), std::make_unique<Node>());
+        }
+        node = it->second.get();
+    }
+
+    if (!node->handler) {
+        ++size_;
+    }
+    node->handler = std::move(handler);
+    node->paramNames = std::move(names);
+    return true;
+}
+
+bool Router::remove(const std::string& method, const std::string& pattern) {
+    Node* node = root(method);
+    for (auto segment : splitSegments(pattern)) {
+        if (!node) break;
+        if (isParam(segment)) {
+            node = node->param.get();
+        } else {
+            auto it = findChild(node->children, segment);
+            node = it != node->children.end() ? it->second.get() : nullptr;
+        }
+    }
+
+    // Emptied branches are left in place; routes are rarely removed
+    if (!node || !node->handler) {
+        return false;
+    }
+    node->handler = nullptr;
+    node->paramNames.clear();
+    --size_;
+    return true;
+}
+
+const RouteHandler* Router::match(HTTPRequest& request) const {
+    const Node* node = root(request.method);
+    if (!node) {
+        return nullptr;
+    }
+
+    Capture captures[HTTPRequest::kMaxPathParams];
+    const Node* matched = matchNode(*node, request.path, 0, captures, 0);
+    if (!matched) {
+        return nullptr;
+    }
+
+    request.pathParamCount = matched->paramNames.size();
+    for (size_t i = 0; i < request.pathParamCount; i++) {
+        request.pathParams[i].name = matched->paramNames[i];
+        request.pathParams[i].offset = captures[i].offset;
+        request.pathParams[i].length = captures[i].length;
+    }
+    return &matched->handler;
+}
+
+size_t Router::size() const {
+    return size_;
+}
+
+// Private helper methods
+Router::Node* Router::root(std::string_view method) const {
+    for (const auto& entry : methods_) {
+        if (entry.first == method) {
+            return entry.second.get();
+        }
+    }
+    return nullptr;
+}
+
+const Router::Node* Router::matchNode(const Node& node, std::string_view path, size_t pos,
+                                      Capture* captures, size_t depth) {
+    while (pos < path.size() && path[pos] == '/') pos++;
+    if (pos >= path.size()) {
+        return node.handler ? &node : nullptr;
+    }
+
+    size_t end = path.find('/', pos);
+    if (end == std::string_view::npos) end = path.size();
+    std::string_view segment = path.substr(pos, end - pos);
+
+    auto it = findChild(node.children, segment);
+    if (it != node.children.end()) {
+        if (const Node* matched = matchNode(*it->second, path, end, captures, depth)) {
+            return matched;
+        }
+    }
+
+    if (node.param && depth < HTTPRequest::kMaxPathParams) {
+        captures[depth] = {pos, end - pos};
+        return matchNode(*node.param, path, end, captures, depth + 1);
+    }
+    return nullptr;
+}
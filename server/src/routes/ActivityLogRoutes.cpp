@@ -2,15 +2,17 @@
 #include "../include/routes/RouteHelpers.h"
 #include "../include/serialization/JSONSerializer.h"
 #include "../../include/UUID.h"
+#include <cstdlib>
 #include <stdexcept>
+#include <utility>
 
 ActivityLogRoutes::ActivityLogRoutes(std::shared_ptr<IDatabase> db) : database_(db) {}
 
 HTTPResponse ActivityLogRoutes::handleGetRecent(const HTTPRequest& req) {
     try {
-        auto logs = database_->loadRecentActivityLogs(100);
+        auto logs = database_->loadRecentActivityLogs(extractLimitFromQuery(req));
         std::string json = JSONSerializer::serialize(logs);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -18,7 +20,7 @@ HTTPResponse ActivityLogRoutes::handleGetRecent(const HTTPRequest& req) {
 
 HTTPResponse ActivityLogRoutes::handleGetById(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         // Note: IDatabase interface doesn't have loadActivityLog by id
         // We'll need to implement this or return not implemented
         return HTTPResponse::notImplemented(JSONSerializer::serializeError("Get activity log by ID not implemented"));
@@ -29,7 +31,7 @@ HTTPResponse ActivityLogRoutes::handleGetById(const HTTPRequest& req) {
 
 HTTPResponse ActivityLogRoutes::handleGetByItemId(const HTTPRequest& req) {
     try {
-        UUID itemId = RouteHelpers::extractUUID(req.path);
+        UUID itemId = RouteHelpers::extractUUID(req, "itemId");
         auto item = database_->loadItem(itemId);
         
         if (!item) {
@@ -38,7 +40,7 @@ HTTPResponse ActivityLogRoutes::handleGetByItemId(const HTTPRequest& req) {
         
         auto logs = database_->loadActivityLogsForItem(itemId);
         std::string json = JSONSerializer::serialize(logs);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -52,3 +54,13 @@ std::string ActivityLogRoutes::extractIdFromPath(const std::string& path) {
     
     return path.substr(lastSlash + 1);
 }
+
+int ActivityLogRoutes::extractLimitFromQuery(const HTTPRequest& request, int defaultLimit) {
+    std::string value = request.getQueryParam("limit");
+    if (value.empty()) {
+        return defaultLimit;
+    }
+    
+    int limit = std::atoi(value.c_str());
+    return limit > 0 ? limit : defaultLimit;
+}
@@ -4,14 +4,15 @@
 #include "../include/serialization/JSONDeserializer.h"
 #include "../../include/UUID.h"
 #include <stdexcept>
+#include <utility>
 
 CategoryRoutes::CategoryRoutes(std::shared_ptr<IDatabase> db) : database_(db) {}
 
 HTTPResponse CategoryRoutes::handleGetAll(const HTTPRequest& req) {
     try {
-        auto categories = database_->loadAllCategories();
-        std::string json = JSONSerializer::serialize(categories);
-        return HTTPResponse::ok(json, "application/json");
+        return RouteHelpers::listCollection<Category>(req, [db = database_](const UUID& after, size_t limit) {
+            return db->loadCategoryPage(after, limit);
+        });
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -19,7 +20,7 @@ HTTPResponse CategoryRoutes::handleGetAll(const HTTPRequest& req) {
 
 HTTPResponse CategoryRoutes::handleGetById(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto category = database_->loadCategory(id);
         
         if (!category) {
@@ -27,7 +28,7 @@ HTTPResponse CategoryRoutes::handleGetById(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(category);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -42,7 +43,7 @@ HTTPResponse CategoryRoutes::handleCreate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(category);
-        return HTTPResponse::created(json, "application/json");
+        return HTTPResponse::created(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -50,7 +51,7 @@ HTTPResponse CategoryRoutes::handleCreate(const HTTPRequest& req) {
 
 HTTPResponse CategoryRoutes::handleUpdate(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto category = database_->loadCategory(id);
         
         if (!category) {
@@ -64,7 +65,7 @@ HTTPResponse CategoryRoutes::handleUpdate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(category);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -72,7 +73,7 @@ HTTPResponse CategoryRoutes::handleUpdate(const HTTPRequest& req) {
 
 HTTPResponse CategoryRoutes::handleDelete(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         
         if (!database_->deleteCategory(id)) {
             return HTTPResponse::notFound(JSONSerializer::serializeError("Category not found"));
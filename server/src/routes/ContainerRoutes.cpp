@@ -2,16 +2,19 @@
 #include "../include/routes/RouteHelpers.h"
 #include "../include/serialization/JSONSerializer.h"
 #include "../include/serialization/JSONDeserializer.h"
+#include "../../include/Container.h"
+#include "../../include/Item.h"
 #include "../../include/UUID.h"
 #include <stdexcept>
+#include <utility>
 
 ContainerRoutes::ContainerRoutes(std::shared_ptr<IDatabase> db) : database_(db) {}
 
 HTTPResponse ContainerRoutes::handleGetAll(const HTTPRequest& req) {
     try {
-        auto containers = database_->loadAllContainers();
-        std::string json = JSONSerializer::serialize(containers);
-        return HTTPResponse::ok(json, "application/json");
+        return RouteHelpers::listCollection<Container>(req, [db = database_](const UUID& after, size_t limit) {
+            return db->loadContainerPage(after, limit);
+        });
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -19,7 +22,7 @@ HTTPResponse ContainerRoutes::handleGetAll(const HTTPRequest& req) {
 
 HTTPResponse ContainerRoutes::handleGetById(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto container = database_->loadContainer(id);
         
         if (!container) {
@@ -27,7 +30,7 @@ HTTPResponse ContainerRoutes::handleGetById(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(container);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -42,7 +45,7 @@ HTTPResponse ContainerRoutes::handleCreate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(container);
-        return HTTPResponse::created(json, "application/json");
+        return HTTPResponse::created(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -50,7 +53,7 @@ HTTPResponse ContainerRoutes::handleCreate(const HTTPRequest& req) {
 
 HTTPResponse ContainerRoutes::handleUpdate(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto container = database_->loadContainer(id);
         
         if (!container) {
@@ -64,7 +67,7 @@ HTTPResponse ContainerRoutes::handleUpdate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(container);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -72,7 +75,7 @@ HTTPResponse ContainerRoutes::handleUpdate(const HTTPRequest& req) {
 
 HTTPResponse ContainerRoutes::handleDelete(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         
         if (!database_->deleteContainer(id)) {
             return HTTPResponse::notFound(JSONSerializer::serializeError("Container not found"));
@@ -84,6 +87,48 @@ HTTPResponse ContainerRoutes::handleDelete(const HTTPRequest& req) {
     }
 }
 
+HTTPResponse ContainerRoutes::handleGetItems(const HTTPRequest& req) {
+    try {
+        UUID id = RouteHelpers::extractUUID(req);
+        
+        // Single-entity loads leave references unresolved; batch loads link
+        // the container's items, and reloading those links their own
+        auto containers = database_->loadContainers({id});
+        if (containers.empty()) {
+            return HTTPResponse::notFound(JSONSerializer::serializeError("Container not found"));
+        }
+        
+        auto items = RouteHelpers::reloadChildren(containers.front()->getAllItems(),
+                                                  [this](const std::vector<UUID>& ids) {
+                                                      return database_->loadItems(ids);
+                                                  });
+        std::string json = JSONSerializer::serialize(items);
+        return HTTPResponse::ok(std::move(json), "application/json");
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
+    }
+}
+
+HTTPResponse ContainerRoutes::handleGetSubContainers(const HTTPRequest& req) {
+    try {
+        UUID id = RouteHelpers::extractUUID(req);
+        
+        auto containers = database_->loadContainers({id});
+        if (containers.empty()) {
+            return HTTPResponse::notFound(JSONSerializer::serializeError("Container not found"));
+        }
+        
+        auto subcontainers = RouteHelpers::reloadChildren(containers.front()->getAllSubcontainers(),
+                                                          [this](const std::vector<UUID>& ids) {
+                                                              return database_->loadContainers(ids);
+                                                          });
+        std::string json = JSONSerializer::serialize(subcontainers);
+        return HTTPResponse::ok(std::move(json), "application/json");
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
+    }
+}
+
 std::string ContainerRoutes::extractIdFromPath(const std::string& path) {
     size_t lastSlash = path.find_last_of('/');
     if (lastSlash == std::string::npos) {
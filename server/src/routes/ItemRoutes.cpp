@@ -1,18 +1,22 @@
 #include "../include/routes/ItemRoutes.h"
+#include "../include/routes/RouteHelpers.h"
 #include "../include/serialization/JSONSerializer.h"
 #include "../include/serialization/JSONDeserializer.h"
 #include "../../include/Item.h"
 #include "../../include/UUID.h"
 #include <algorithm>
+#include <nlohmann/json.hpp>
+#include <utility>
 
-ItemRoutes::ItemRoutes(std::shared_ptr<IDatabase> database)
-    : database_(database) {}
+ItemRoutes::ItemRoutes(std::shared_ptr<IDatabase> database,
+                       std::shared_ptr<SearchIndex> searchIndex)
+    : database_(database), searchIndex_(searchIndex) {}
 
 HTTPResponse ItemRoutes::handleGetAll(const HTTPRequest& request) {
     try {
-        auto items = database_->loadAllItems();
-        std::string json = JSONSerializer::serialize(items);
-        return HTTPResponse::ok(json);
+        return RouteHelpers::listCollection<Item>(request, [db = database_](const UUID& after, size_t limit) {
+            return db->loadItemPage(after, limit);
+        });
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(std::string("Failed to load items: ") + e.what());
     }
@@ -20,7 +24,7 @@ HTTPResponse ItemRoutes::handleGetAll(const HTTPRequest& request) {
 
 HTTPResponse ItemRoutes::handleGetById(const HTTPRequest& request) {
     try {
-        std::string idStr = extractIdFromPath(request.path);
+        std::string idStr = extractIdFromPath(request);
         if (idStr.empty()) {
             return HTTPResponse::badRequest("Invalid item ID");
         }
@@ -33,7 +37,7 @@ HTTPResponse ItemRoutes::handleGetById(const HTTPRequest& request) {
         }
         
         std::string json = JSONSerializer::serialize(item);
-        return HTTPResponse::ok(json);
+        return HTTPResponse::ok(std::move(json));
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(std::string("Failed to load item: ") + e.what());
     }
@@ -47,8 +51,9 @@ HTTPResponse ItemRoutes::handleCreate(const HTTPRequest& request) {
         }
         
         if (database_->saveItem(item)) {
+            indexItem(item);
             std::string json = JSONSerializer::serialize(item);
-            return HTTPResponse::created(json);
+            return HTTPResponse::created(std::move(json));
         }
         
         return HTTPResponse::internalError("Failed to create item");
@@ -59,7 +64,7 @@ HTTPResponse ItemRoutes::handleCreate(const HTTPRequest& request) {
 
 HTTPResponse ItemRoutes::handleUpdate(const HTTPRequest& request) {
     try {
-        std::string idStr = extractIdFromPath(request.path);
+        std::string idStr = extractIdFromPath(request);
         if (idStr.empty()) {
             return HTTPResponse::badRequest("Invalid item ID");
         }
@@ -80,8 +85,9 @@ HTTPResponse ItemRoutes::handleUpdate(const HTTPRequest& request) {
         // Note: In a full implementation, you'd merge the updates with existing data
         
         if (database_->saveItem(updatedItem)) {
+            indexItem(updatedItem);
             std::string json = JSONSerializer::serialize(updatedItem);
-            return HTTPResponse::ok(json);
+            return HTTPResponse::ok(std::move(json));
         }
         
         return HTTPResponse::internalError("Failed to update item");
@@ -92,7 +98,7 @@ HTTPResponse ItemRoutes::handleUpdate(const HTTPRequest& request) {
 
 HTTPResponse ItemRoutes::handleDelete(const HTTPRequest& request) {
     try {
-        std::string idStr = extractIdFromPath(request.path);
+        std::string idStr = extractIdFromPath(request);
         if (idStr.empty()) {
             return HTTPResponse::badRequest("Invalid item ID");
         }
@@ -100,6 +106,9 @@ HTTPResponse ItemRoutes::handleDelete(const HTTPRequest& request) {
         UUID id = UUID::fromString(idStr);
         
         if (database_->deleteItem(id)) {
+            if (searchIndex_) {
+                searchIndex_->remove(id);
+            }
             return HTTPResponse::noContent();
         }
         
@@ -124,11 +133,78 @@ HTTPResponse ItemRoutes::handleCheckin(const HTTPRequest& request) {
     return HTTPResponse::internalError("Checkin operation not yet implemented");
 }
 
-std::string ItemRoutes::extractIdFromPath(const std::string& path) {
+HTTPResponse ItemRoutes::handleBatchSave(const HTTPRequest& request) {
+    std::vector<std::shared_ptr<Item>> items;
+    try {
+        items = JSONDeserializer::deserializeItems(request.body);
+    } catch (const std::exception& e) {
+        return HTTPResponse::badRequest(std::string("Invalid item data: ") + e.what());
+    }
+    
+    try {
+        if (!database_->saveItems(items)) {
+            return HTTPResponse::internalError("Failed to save items");
+        }
+        for (const auto& item : items) {
+            indexItem(item);
+        }
+        
+        nlohmann::json j;
+        j["saved"] = items.size();
+        return HTTPResponse::ok(j.dump());
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(std::string("Failed to save items: ") + e.what());
+    }
+}
+
+HTTPResponse ItemRoutes::handleBatchDelete(const HTTPRequest& request) {
+    std::vector<UUID> ids;
+    try {
+        nlohmann::json j = nlohmann::json::parse(request.body);
+        for (const auto& value : j.at("ids")) {
+            UUID id = UUID::fromString(value.get<std::string>());
+            if (id.isNil()) {
+                return HTTPResponse::badRequest("Invalid item ID: " + value.get<std::string>());
+            }
+            ids.push_back(id);
+        }
+    } catch (const std::exception& e) {
+        return HTTPResponse::badRequest(std::string("Expected {\"ids\": [...]}: ") + e.what());
+    }
+    
+    try {
+        if (!database_->deleteItems(ids)) {
+            return HTTPResponse::internalError("Failed to delete items");
+        }
+        if (searchIndex_) {
+            for (const auto& id : ids) {
+                searchIndex_->remove(id);
+            }
+        }
+        return HTTPResponse::noContent();
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(std::string("Failed to delete items: ") + e.what());
+    }
+}
+
+std::string ItemRoutes::extractIdFromPath(const HTTPRequest& request) {
+    // Bound by the router for "/api/items/:id"
+    std::string_view id = request.getPathParam("id");
+    if (!id.empty()) {
+        return std::string(id);
+    }
+    
     // Extract ID from path like "/api/items/550e8400-e29b-41d4-a716-446655440000"
+    const std::string& path = request.path;
     size_t lastSlash = path.find_last_of('/');
     if (lastSlash != std::string::npos && lastSlash + 1 < path.length()) {
         return path.substr(lastSlash + 1);
     }
     return "";
 }
+
+void ItemRoutes::indexItem(const std::shared_ptr<Item>& item) {
+    if (searchIndex_) {
+        searchIndex_->add(item->getId(), item->getName(), item->getDescription());
+    }
+}
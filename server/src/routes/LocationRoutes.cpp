@@ -2,16 +2,19 @@
 #include "../include/routes/RouteHelpers.h"
 #include "../include/serialization/JSONSerializer.h"
 #include "../include/serialization/JSONDeserializer.h"
+#include "../../include/Container.h"
+#include "../../include/Location.h"
 #include "../../include/UUID.h"
 #include <stdexcept>
+#include <utility>
 
 LocationRoutes::LocationRoutes(std::shared_ptr<IDatabase> db) : database_(db) {}
 
 HTTPResponse LocationRoutes::handleGetAll(const HTTPRequest& req) {
     try {
-        auto locations = database_->loadAllLocations();
-        std::string json = JSONSerializer::serialize(locations);
-        return HTTPResponse::ok(json, "application/json");
+        return RouteHelpers::listCollection<Location>(req, [db = database_](const UUID& after, size_t limit) {
+            return db->loadLocationPage(after, limit);
+        });
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -19,7 +22,7 @@ HTTPResponse LocationRoutes::handleGetAll(const HTTPRequest& req) {
 
 HTTPResponse LocationRoutes::handleGetById(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto location = database_->loadLocation(id);
         
         if (!location) {
@@ -27,7 +30,7 @@ HTTPResponse LocationRoutes::handleGetById(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(location);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -42,7 +45,7 @@ HTTPResponse LocationRoutes::handleCreate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(location);
-        return HTTPResponse::created(json, "application/json");
+        return HTTPResponse::created(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -50,7 +53,7 @@ HTTPResponse LocationRoutes::handleCreate(const HTTPRequest& req) {
 
 HTTPResponse LocationRoutes::handleUpdate(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto location = database_->loadLocation(id);
         
         if (!location) {
@@ -64,7 +67,7 @@ HTTPResponse LocationRoutes::handleUpdate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(location);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -72,7 +75,7 @@ HTTPResponse LocationRoutes::handleUpdate(const HTTPRequest& req) {
 
 HTTPResponse LocationRoutes::handleDelete(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         
         if (!database_->deleteLocation(id)) {
             return HTTPResponse::notFound(JSONSerializer::serializeError("Location not found"));
@@ -84,6 +87,26 @@ HTTPResponse LocationRoutes::handleDelete(const HTTPRequest& req) {
     }
 }
 
+HTTPResponse LocationRoutes::handleGetContainers(const HTTPRequest& req) {
+    try {
+        UUID id = RouteHelpers::extractUUID(req);
+        
+        auto locations = database_->loadLocations({id});
+        if (locations.empty()) {
+            return HTTPResponse::notFound(JSONSerializer::serializeError("Location not found"));
+        }
+        
+        auto containers = RouteHelpers::reloadChildren(locations.front()->getAllContainers(),
+                                                       [this](const std::vector<UUID>& ids) {
+                                                           return database_->loadContainers(ids);
+                                                       });
+        std::string json = JSONSerializer::serialize(containers);
+        return HTTPResponse::ok(std::move(json), "application/json");
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
+    }
+}
+
 std::string LocationRoutes::extractIdFromPath(const std::string& path) {
     size_t lastSlash = path.find_last_of('/');
     if (lastSlash == std::string::npos) {
@@ -2,16 +2,19 @@
 #include "../include/routes/RouteHelpers.h"
 #include "../include/serialization/JSONSerializer.h"
 #include "../include/serialization/JSONDeserializer.h"
+#include "../../include/Container.h"
+#include "../../include/Project.h"
 #include "../../include/UUID.h"
 #include <stdexcept>
+#include <utility>
 
 ProjectRoutes::ProjectRoutes(std::shared_ptr<IDatabase> db) : database_(db) {}
 
 HTTPResponse ProjectRoutes::handleGetAll(const HTTPRequest& req) {
     try {
-        auto projects = database_->loadAllProjects();
-        std::string json = JSONSerializer::serialize(projects);
-        return HTTPResponse::ok(json, "application/json");
+        return RouteHelpers::listCollection<Project>(req, [db = database_](const UUID& after, size_t limit) {
+            return db->loadProjectPage(after, limit);
+        });
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -19,7 +22,7 @@ HTTPResponse ProjectRoutes::handleGetAll(const HTTPRequest& req) {
 
 HTTPResponse ProjectRoutes::handleGetById(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto project = database_->loadProject(id);
         
         if (!project) {
@@ -27,7 +30,7 @@ HTTPResponse ProjectRoutes::handleGetById(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(project);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
     }
@@ -42,7 +45,7 @@ HTTPResponse ProjectRoutes::handleCreate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(project);
-        return HTTPResponse::created(json, "application/json");
+        return HTTPResponse::created(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -50,7 +53,7 @@ HTTPResponse ProjectRoutes::handleCreate(const HTTPRequest& req) {
 
 HTTPResponse ProjectRoutes::handleUpdate(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         auto project = database_->loadProject(id);
         
         if (!project) {
@@ -64,7 +67,7 @@ HTTPResponse ProjectRoutes::handleUpdate(const HTTPRequest& req) {
         }
         
         std::string json = JSONSerializer::serialize(project);
-        return HTTPResponse::ok(json, "application/json");
+        return HTTPResponse::ok(std::move(json), "application/json");
     } catch (const std::exception& e) {
         return HTTPResponse::badRequest(JSONSerializer::serializeError(e.what()));
     }
@@ -72,7 +75,7 @@ HTTPResponse ProjectRoutes::handleUpdate(const HTTPRequest& req) {
 
 HTTPResponse ProjectRoutes::handleDelete(const HTTPRequest& req) {
     try {
-        UUID id = RouteHelpers::extractUUID(req.path);
+        UUID id = RouteHelpers::extractUUID(req);
         
         if (!database_->deleteProject(id)) {
             return HTTPResponse::notFound(JSONSerializer::serializeError("Project not found"));
@@ -84,6 +87,26 @@ HTTPResponse ProjectRoutes::handleDelete(const HTTPRequest& req) {
     }
 }
 
+HTTPResponse ProjectRoutes::handleGetContainers(const HTTPRequest& req) {
+    try {
+        UUID id = RouteHelpers::extractUUID(req);
+        
+        auto projects = database_->loadProjects({id});
+        if (projects.empty()) {
+            return HTTPResponse::notFound(JSONSerializer::serializeError("Project not found"));
+        }
+        
+        auto containers = RouteHelpers::reloadChildren(projects.front()->getAllContainers(),
+                                                       [this](const std::vector<UUID>& ids) {
+                                                           return database_->loadContainers(ids);
+                                                       });
+        std::string json = JSONSerializer::serialize(containers);
+        return HTTPResponse::ok(std::move(json), "application/json");
+    } catch (const std::exception& e) {
+        return HTTPResponse::internalError(JSONSerializer::serializeError(e.what()));
+    }
+}
+
 std::string ProjectRoutes::extractIdFromPath(const std::string& path) {
     size_t lastSlash = path.find_last_of('/');
     if (lastSlash == std::string::npos) {
@@ -28,38 +28,54 @@ static std::chrono::system_clock::time_point stringToTimePoint(const std::string
     return std::chrono::system_clock::from_time_t(time_t);
 }
 
-std::shared_ptr<Item> JSONDeserializer::deserializeItem(const std::string& jsonStr) {
+static std::shared_ptr<Item> itemFromJson(const json& j) {
+    std::string name = j.value("name", "");
+    std::string description = j.value("description", "");
+    int quantity = j.value("quantity", 1);
+    
+    if (name.empty()) {
+        throw std::runtime_error("Item name is required");
+    }
+    
+    // Check if ID is provided (for updates/creates with specific IDs)
+    if (j.contains("id")) {
+        UUID id = UUID::fromString(j["id"].get<std::string>());
+        return std::make_shared<Item>(id, name, nullptr, quantity, description);
+    }
+    
+    // Create item with auto-generated ID
+    // Note: Category and Container relationships are set via separate endpoints
+    // as they require looking up existing entities in the database
+    return std::make_shared<Item>(name, nullptr, quantity, description);
+}
+
+std::shared_ptr<Item> JSONDeserializer::deserializeItem(std::string_view jsonStr) {
+    try {
+        return itemFromJson(json::parse(jsonStr));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("Failed to parse Item JSON: " + std::string(e.what()));
+    }
+}
+
+std::vector<std::shared_ptr<Item>> JSONDeserializer::deserializeItems(std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
-        
-        std::string name = j.value("name", "");
-        std::string description = j.value("description", "");
-        int quantity = j.value("quantity", 1);
-        
-        if (name.empty()) {
-            throw std::runtime_error("Item name is required");
+        if (!j.is_array()) {
+            throw std::runtime_error("Expected an array of items");
         }
         
-        // Check if ID is provided (for updates/creates with specific IDs)
-        std::shared_ptr<Item> item;
-        if (j.contains("id")) {
-            UUID id = UUID::fromString(j["id"].get<std::string>());
-            item = std::make_shared<Item>(id, name, nullptr, quantity, description);
-        } else {
-            // Create item with auto-generated ID
-            item = std::make_shared<Item>(name, nullptr, quantity, description);
+        std::vector<std::shared_ptr<Item>> items;
+        items.reserve(j.size());
+        for (const auto& element : j) {
+            items.push_back(itemFromJson(element));
         }
-        
-        // Note: Category and Container relationships are set via separate endpoints
-        // as they require looking up existing entities in the database
-        
-        return item;
+        return items;
     } catch (const json::exception& e) {
         throw std::runtime_error("Failed to parse Item JSON: " + std::string(e.what()));
     }
 }
 
-std::shared_ptr<Container> JSONDeserializer::deserializeContainer(const std::string& jsonStr) {
+std::shared_ptr<Container> JSONDeserializer::deserializeContainer(std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -85,7 +101,7 @@ std::shared_ptr<Container> JSONDeserializer::deserializeContainer(const std::str
     }
 }
 
-std::shared_ptr<Location> JSONDeserializer::deserializeLocation(const std::string& jsonStr) {
+std::shared_ptr<Location> JSONDeserializer::deserializeLocation(std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -104,7 +120,7 @@ std::shared_ptr<Location> JSONDeserializer::deserializeLocation(const std::strin
     }
 }
 
-std::shared_ptr<Project> JSONDeserializer::deserializeProject(const std::string& jsonStr) {
+std::shared_ptr<Project> JSONDeserializer::deserializeProject(std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -141,7 +157,7 @@ std::shared_ptr<Project> JSONDeserializer::deserializeProject(const std::string&
     }
 }
 
-std::shared_ptr<Category> JSONDeserializer::deserializeCategory(const std::string& jsonStr) {
+std::shared_ptr<Category> JSONDeserializer::deserializeCategory(std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -160,7 +176,7 @@ std::shared_ptr<Category> JSONDeserializer::deserializeCategory(const std::strin
     }
 }
 
-void JSONDeserializer::updateItem(std::shared_ptr<Item> item, const std::string& jsonStr) {
+void JSONDeserializer::updateItem(std::shared_ptr<Item> item, std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -183,7 +199,7 @@ void JSONDeserializer::updateItem(std::shared_ptr<Item> item, const std::string&
     }
 }
 
-void JSONDeserializer::updateContainer(std::shared_ptr<Container> container, const std::string& jsonStr) {
+void JSONDeserializer::updateContainer(std::shared_ptr<Container> container, std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -203,7 +219,7 @@ void JSONDeserializer::updateContainer(std::shared_ptr<Container> container, con
     }
 }
 
-void JSONDeserializer::updateLocation(std::shared_ptr<Location> location, const std::string& jsonStr) {
+void JSONDeserializer::updateLocation(std::shared_ptr<Location> location, std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -220,7 +236,7 @@ void JSONDeserializer::updateLocation(std::shared_ptr<Location> location, const
     }
 }
 
-void JSONDeserializer::updateProject(std::shared_ptr<Project> project, const std::string& jsonStr) {
+void JSONDeserializer::updateProject(std::shared_ptr<Project> project, std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
@@ -249,7 +265,7 @@ void JSONDeserializer::updateProject(std::shared_ptr<Project> project, const std
     }
 }
 
-void JSONDeserializer::updateCategory(std::shared_ptr<Category> category, const std::string& jsonStr) {
+void JSONDeserializer::updateCategory(std::shared_ptr<Category> category, std::string_view jsonStr) {
     try {
         json j = json::parse(jsonStr);
         
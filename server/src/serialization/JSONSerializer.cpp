@@ -20,197 +20,195 @@ static std::string timePointToString(const std::chrono::system_clock::time_point
     return ss.str();
 }
 
+namespace {
+    json toJson(const Item& item) {
+        json j;
+        j["id"] = item.getId().toString();
+        j["name"] = item.getName();
+        j["description"] = item.getDescription();
+        j["quantity"] = item.getQuantity();
+        j["checked_out"] = item.isCheckedOut();
+        
+        if (item.getCategory()) {
+            j["category_id"] = item.getCategory()->getId().toString();
+            j["category_name"] = item.getCategory()->getName();
+        } else {
+            j["category_id"] = nullptr;
+        }
+        
+        if (item.getCurrentContainer()) {
+            j["container_id"] = item.getCurrentContainer()->getId().toString();
+            j["container_name"] = item.getCurrentContainer()->getName();
+        } else {
+            j["container_id"] = nullptr;
+        }
+        
+        return j;
+    }
+
+    json toJson(const Container& container) {
+        json j;
+        j["id"] = container.getId().toString();
+        j["name"] = container.getName();
+        j["description"] = container.getDescription();
+        j["type"] = static_cast<int>(container.getType());
+        
+        if (container.getLocation()) {
+            j["location_id"] = container.getLocation()->getId().toString();
+            j["location_name"] = container.getLocation()->getName();
+        } else {
+            j["location_id"] = nullptr;
+        }
+        
+        if (container.getParentContainer()) {
+            j["parent_container_id"] = container.getParentContainer()->getId().toString();
+        } else {
+            j["parent_container_id"] = nullptr;
+        }
+        
+        j["item_count"] = container.itemCount();
+        j["subcontainer_count"] = container.subcontainerCount();
+        
+        return j;
+    }
+
+    json toJson(const Location& location) {
+        json j;
+        j["id"] = location.getId().toString();
+        j["name"] = location.getName();
+        j["address"] = location.getAddress();
+        j["container_count"] = location.containerCount();
+        
+        return j;
+    }
+
+    json toJson(const Project& project) {
+        json j;
+        j["id"] = project.getId().toString();
+        j["name"] = project.getName();
+        j["description"] = project.getDescription();
+        j["status"] = static_cast<int>(project.getStatus());
+        j["created_date"] = timePointToString(project.getCreatedDate());
+        j["start_date"] = timePointToString(project.getStartDate());
+        j["end_date"] = timePointToString(project.getEndDate());
+        j["container_count"] = project.containerCount();
+        j["allocated_items"] = project.getTotalItemCount();
+        
+        return j;
+    }
+
+    json toJson(const Category& category) {
+        json j;
+        j["id"] = category.getId().toString();
+        j["name"] = category.getName();
+        j["description"] = category.getDescription();
+        j["subcategory_count"] = category.subcategoryCount();
+        
+        return j;
+    }
+
+    json toJson(const ActivityLog& log) {
+        json j;
+        j["id"] = log.getId().toString();
+        j["type"] = log.getTypeString();
+        j["description"] = log.getDescription();
+        j["user_id"] = log.getUserId();
+        j["timestamp"] = timePointToString(log.getTimestamp());
+        j["quantity_change"] = log.getQuantityChange();
+        
+        if (log.getItem()) {
+            j["item_id"] = log.getItem()->getId().toString();
+            j["item_name"] = log.getItem()->getName();
+        } else {
+            j["item_id"] = nullptr;
+        }
+        
+        return j;
+    }
+
+    // Each entity becomes an object, keeping only the listed fields when
+    // there are any
+    template <typename T>
+    std::string serializeArray(const std::vector<std::shared_ptr<T>>& entities, const std::vector<std::string>& fields) {
+        json j = json::array();
+        for (const auto& entity : entities) {
+            if (!entity) {
+                continue;
+            }
+            json full = toJson(*entity);
+            if (fields.empty()) {
+                j.push_back(std::move(full));
+                continue;
+            }
+            json projected = json::object();
+            for (const auto& field : fields) {
+                auto it = full.find(field);
+                if (it != full.end()) {
+                    projected[field] = std::move(*it);
+                }
+            }
+            j.push_back(std::move(projected));
+        }
+        return j.dump();
+    }
+}
+
 // Single entity serialization
 
 std::string JSONSerializer::serialize(std::shared_ptr<Item> item) {
-    if (!item) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = item->getId().toString();
-    j["name"] = item->getName();
-    j["description"] = item->getDescription();
-    j["quantity"] = item->getQuantity();
-    j["checked_out"] = item->isCheckedOut();
-    
-    if (item->getCategory()) {
-        j["category_id"] = item->getCategory()->getId().toString();
-        j["category_name"] = item->getCategory()->getName();
-    } else {
-        j["category_id"] = nullptr;
-    }
-    
-    if (item->getCurrentContainer()) {
-        j["container_id"] = item->getCurrentContainer()->getId().toString();
-        j["container_name"] = item->getCurrentContainer()->getName();
-    } else {
-        j["container_id"] = nullptr;
-    }
-    
-    return j.dump();
+    return item ? toJson(*item).dump() : "null";
 }
 
 std::string JSONSerializer::serialize(std::shared_ptr<Container> container) {
-    if (!container) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = container->getId().toString();
-    j["name"] = container->getName();
-    j["description"] = container->getDescription();
-    j["type"] = static_cast<int>(container->getType());
-    
-    if (container->getLocation()) {
-        j["location_id"] = container->getLocation()->getId().toString();
-        j["location_name"] = container->getLocation()->getName();
-    } else {
-        j["location_id"] = nullptr;
-    }
-    
-    if (container->getParentContainer()) {
-        j["parent_container_id"] = container->getParentContainer()->getId().toString();
-    } else {
-        j["parent_container_id"] = nullptr;
-    }
-    
-    j["item_count"] = container->getAllItems().size();
-    j["subcontainer_count"] = container->getAllSubcontainers().size();
-    
-    return j.dump();
+    return container ? toJson(*container).dump() : "null";
 }
 
 std::string JSONSerializer::serialize(std::shared_ptr<Location> location) {
-    if (!location) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = location->getId().toString();
-    j["name"] = location->getName();
-    j["address"] = location->getAddress();
-    j["container_count"] = location->getAllContainers().size();
-    
-    return j.dump();
+    return location ? toJson(*location).dump() : "null";
 }
 
 std::string JSONSerializer::serialize(std::shared_ptr<Project> project) {
-    if (!project) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = project->getId().toString();
-    j["name"] = project->getName();
-    j["description"] = project->getDescription();
-    j["status"] = static_cast<int>(project->getStatus());
-    j["created_date"] = timePointToString(project->getCreatedDate());
-    j["start_date"] = timePointToString(project->getStartDate());
-    j["end_date"] = timePointToString(project->getEndDate());
-    j["container_count"] = project->getAllContainers().size();
-    j["allocated_items"] = project->getTotalItemCount();
-    
-    return j.dump();
+    return project ? toJson(*project).dump() : "null";
 }
 
 std::string JSONSerializer::serialize(std::shared_ptr<Category> category) {
-    if (!category) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = category->getId().toString();
-    j["name"] = category->getName();
-    j["description"] = category->getDescription();
-    j["subcategory_count"] = category->getSubcategories().size();
-    
-    return j.dump();
+    return category ? toJson(*category).dump() : "null";
 }
 
 std::string JSONSerializer::serialize(std::shared_ptr<ActivityLog> log) {
-    if (!log) {
-        return "null";
-    }
-    
-    json j;
-    j["id"] = log->getId().toString();
-    j["type"] = log->getTypeString();
-    j["description"] = log->getDescription();
-    j["user_id"] = log->getUserId();
-    j["timestamp"] = timePointToString(log->getTimestamp());
-    j["quantity_change"] = log->getQuantityChange();
-    
-    if (log->getItem()) {
-        j["item_id"] = log->getItem()->getId().toString();
-        j["item_name"] = log->getItem()->getName();
-    } else {
-        j["item_id"] = nullptr;
-    }
-    
-    return j.dump();
+    return log ? toJson(*log).dump() : "null";
 }
 
 // Array serialization
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Item>>& items) {
-    json j = json::array();
-    for (const auto& item : items) {
-        if (item) {
-            j.push_back(json::parse(serialize(item)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Item>>& items,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(items, fields);
 }
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Container>>& containers) {
-    json j = json::array();
-    for (const auto& container : containers) {
-        if (container) {
-            j.push_back(json::parse(serialize(container)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Container>>& containers,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(containers, fields);
 }
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Location>>& locations) {
-    json j = json::array();
-    for (const auto& location : locations) {
-        if (location) {
-            j.push_back(json::parse(serialize(location)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Location>>& locations,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(locations, fields);
 }
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Project>>& projects) {
-    json j = json::array();
-    for (const auto& project : projects) {
-        if (project) {
-            j.push_back(json::parse(serialize(project)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Project>>& projects,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(projects, fields);
 }
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Category>>& categories) {
-    json j = json::array();
-    for (const auto& category : categories) {
-        if (category) {
-            j.push_back(json::parse(serialize(category)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<Category>>& categories,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(categories, fields);
 }
 
-std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<ActivityLog>>& logs) {
-    json j = json::array();
-    for (const auto& log : logs) {
-        if (log) {
-            j.push_back(json::parse(serialize(log)));
-        }
-    }
-    return j.dump();
+std::string JSONSerializer::serialize(const std::vector<std::shared_ptr<ActivityLog>>& logs,
+                                      const std::vector<std::string>& fields) {
+    return serializeArray(logs, fields);
 }
 
 // Error response serialization
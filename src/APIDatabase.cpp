@@ -5,6 +5,7 @@
 #include "Project.h"
 #include "Category.h"
 #include "ActivityLog.h"
+#include "Logger.h"
 
 // Define WIN32_LEAN_AND_MEAN before including httplib to avoid UUID conflict
 #ifdef _WIN32
@@ -14,11 +15,16 @@
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
-#include <iostream>
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 #include <thread>
 #include <chrono>
 
+namespace {
+    const Logger logger("APIDatabase");
+}
+
 // Real HTTP client using cpp-httplib
 class HTTPClient {
 private:
@@ -82,7 +88,7 @@ public:
             }
         }
         
-        std::cout << "HTTP GET: " << url << std::endl;
+        logger.debug() << "HTTP GET: " << url;
         
         httplib::Headers httpHeaders;
         for (const auto& [key, value] : headers) {
@@ -116,7 +122,7 @@ public:
             }
         }
         
-        std::cout << "HTTP POST: " << url << std::endl;
+        logger.debug() << "HTTP POST: " << url;
         
         httplib::Headers httpHeaders;
         for (const auto& [key, value] : headers) {
@@ -150,7 +156,7 @@ public:
             }
         }
         
-        std::cout << "HTTP PUT: " << url << std::endl;
+        logger.debug() << "HTTP PUT: " << url;
         
         httplib::Headers httpHeaders;
         for (const auto& [key, value] : headers) {
@@ -183,7 +189,7 @@ public:
             }
         }
         
-        std::cout << "HTTP DELETE: " << url << std::endl;
+        logger.debug() << "HTTP DELETE: " << url;
         
         httplib::Headers httpHeaders;
         for (const auto& [key, value] : headers) {
@@ -222,25 +228,25 @@ bool APIDatabase::connect() {
         return true;
     }
     
-    std::cout << "Connecting to API: " << config_.baseUrl << std::endl;
+    logger.info() << "Connecting to API: " << config_.baseUrl;
     
     // Test the connection
     if (!testConnection()) {
-        std::cerr << "Failed to connect to API" << std::endl;
+        logger.error() << "Failed to connect to API";
         return false;
     }
     
     // Validate API key if required
     if (config_.authMethod != APIConfig::AuthMethod::NONE) {
         if (!validateAPIKey()) {
-            std::cerr << "API authentication failed" << std::endl;
+            logger.error() << "API authentication failed";
             return false;
         }
     }
     
     connected_ = true;
-    std::cout << "Successfully connected to API" << std::endl;
-    std::cout << "API Version: " << getAPIVersion() << std::endl;
+    logger.info() << "Successfully connected to API";
+    logger.info() << "API Version: " << getAPIVersion();
     
     return true;
 }
@@ -253,7 +259,7 @@ bool APIDatabase::disconnect() {
     }
     
     connected_ = false;
-    std::cout << "Disconnected from API" << std::endl;
+    logger.info() << "Disconnected from API";
     
     return true;
 }
@@ -268,7 +274,7 @@ bool APIDatabase::testConnection() {
         std::string response = httpGet("/health");
         return !response.empty();
     } catch (const std::exception& e) {
-        std::cerr << "Connection test failed: " << e.what() << std::endl;
+        logger.error() << "Connection test failed: " << e.what();
         return false;
     }
 }
@@ -289,7 +295,7 @@ bool APIDatabase::validateAPIKey() {
         // In production, parse JSON response
         return true; // Placeholder
     } catch (const std::exception& e) {
-        std::cerr << "API key validation failed: " << e.what() << std::endl;
+        logger.error() << "API key validation failed: " << e.what();
         return false;
     }
 }
@@ -313,7 +319,7 @@ bool APIDatabase::checkRateLimit() {
     }
     
     if (requestCount_ >= config_.maxRequestsPerMinute) {
-        std::cout << "Rate limit reached, waiting..." << std::endl;
+        logger.warn() << "Rate limit reached, waiting...";
         std::this_thread::sleep_for(std::chrono::seconds(60 - elapsed.count()));
         requestCount_ = 0;
         lastRequestTime_ = std::chrono::steady_clock::now();
@@ -435,29 +441,29 @@ bool APIDatabase::httpDelete(const std::string& endpoint) {
 }
 
 void APIDatabase::handleAPIError(int statusCode, const std::string& response) {
-    std::cerr << "API Error (Status " << statusCode << "): " << response << std::endl;
+    logger.error() << "API Error (Status " << statusCode << "): " << response;
     
     switch (statusCode) {
         case 400:
-            std::cerr << "Bad Request - Check request format" << std::endl;
+            logger.error() << "Bad Request - Check request format";
             break;
         case 401:
-            std::cerr << "Unauthorized - Check API credentials" << std::endl;
+            logger.error() << "Unauthorized - Check API credentials";
             break;
         case 403:
-            std::cerr << "Forbidden - Insufficient permissions" << std::endl;
+            logger.error() << "Forbidden - Insufficient permissions";
             break;
         case 404:
-            std::cerr << "Not Found - Resource doesn't exist" << std::endl;
+            logger.error() << "Not Found - Resource doesn't exist";
             break;
         case 429:
-            std::cerr << "Rate Limit Exceeded" << std::endl;
+            logger.error() << "Rate Limit Exceeded";
             break;
         case 500:
-            std::cerr << "Internal Server Error" << std::endl;
+            logger.error() << "Internal Server Error";
             break;
         case 503:
-            std::cerr << "Service Unavailable" << std::endl;
+            logger.error() << "Service Unavailable";
             break;
     }
 }
@@ -469,7 +475,7 @@ bool APIDatabase::retryRequest(std::function<bool()> request) {
         }
         
         if (attempt < config_.maxRetries - 1) {
-            std::cout << "Retrying request (attempt " << (attempt + 2) << ")" << std::endl;
+            logger.warn() << "Retrying request (attempt " << (attempt + 2) << ")";
             std::this_thread::sleep_for(std::chrono::seconds(1 << attempt)); // Exponential backoff
         }
     }
@@ -792,8 +798,81 @@ bool APIDatabase::deleteBatch(const std::vector<UUID>& ids, const std::string& e
     }
     ss << "]}";
     
-    std::string endpoint = "/" + entityType + "/batch";
-    return httpDelete(endpoint);
+    std::string endpoint = "/" + entityType + "/batch/delete";
+    std::string response = httpPost(endpoint, ss.str());
+    return !response.empty();
+}
+
+bool APIDatabase::saveItems(const std::vector<std::shared_ptr<Item>>& items) {
+    return items.empty() ? isConnected() : saveBatch(items);
+}
+
+bool APIDatabase::deleteItems(const std::vector<UUID>& ids) {
+    return ids.empty() ? isConnected() : deleteBatch(ids, "items");
+}
+
+// Paged loads
+template <typename T>
+Page<T> APIDatabase::loadPage(const std::string& endpoint, const UUID& after, size_t limit,
+                              std::shared_ptr<T> (APIDatabase::*deserialize)(const std::string&)) {
+    Page<T> page;
+    if (limit == 0) return page;
+    page.ok = false;
+    if (!isConnected() || !checkRateLimit()) return page;
+    
+    std::string url = config_.baseUrl + endpoint + "?limit=" + std::to_string(limit);
+    if (!after.isNil()) {
+        url += "&cursor=" + after.toString();
+    }
+    auto response = httpClient_->get(url, getDefaultHeaders());
+    if (response.statusCode < 200 || response.statusCode >= 300) {
+        handleAPIError(response.statusCode, response.body);
+        return page;
+    }
+    
+    try {
+        nlohmann::json body = nlohmann::json::parse(response.body);
+        if (!body.is_array()) return page;
+        for (const auto& element : body) {
+            if (auto entity = (this->*deserialize)(element.dump())) {
+                page.entities.push_back(entity);
+            }
+        }
+    } catch (const std::exception& e) {
+        logger.error() << "Error parsing page from " << endpoint << ": " << e.what();
+        page.entities.clear();
+        return page;
+    }
+    
+    // Header names are case-insensitive
+    for (const auto& [key, value] : response.headers) {
+        if (key.size() == 13 && std::equal(key.begin(), key.end(), "x-next-cursor",
+                                           [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+            page.next = UUID::fromString(value);
+        }
+    }
+    page.ok = true;
+    return page;
+}
+
+Page<Item> APIDatabase::loadItemPage(const UUID& after, size_t limit) {
+    return loadPage<Item>(config_.itemsEndpoint, after, limit, &APIDatabase::deserializeItem);
+}
+
+Page<Container> APIDatabase::loadContainerPage(const UUID& after, size_t limit) {
+    return loadPage<Container>(config_.containersEndpoint, after, limit, &APIDatabase::deserializeContainer);
+}
+
+Page<Location> APIDatabase::loadLocationPage(const UUID& after, size_t limit) {
+    return loadPage<Location>(config_.locationsEndpoint, after, limit, &APIDatabase::deserializeLocation);
+}
+
+Page<Project> APIDatabase::loadProjectPage(const UUID& after, size_t limit) {
+    return loadPage<Project>(config_.projectsEndpoint, after, limit, &APIDatabase::deserializeProject);
+}
+
+Page<Category> APIDatabase::loadCategoryPage(const UUID& after, size_t limit) {
+    return loadPage<Category>(config_.categoriesEndpoint, after, limit, &APIDatabase::deserializeCategory);
 }
 
 // Deserialization using nlohmann/json
@@ -812,7 +891,7 @@ std::shared_ptr<Item> APIDatabase::deserializeItem(const std::string& jsonStr) {
         
         return item;
     } catch (const std::exception& e) {
-        std::cerr << "Item deserialization failed: " << e.what() << std::endl;
+        logger.error() << "Item deserialization failed: " << e.what();
         return nullptr;
     }
 }
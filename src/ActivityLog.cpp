@@ -19,6 +19,24 @@ ActivityLog::ActivityLog(ActivityType type,
       quantityChange_(0) {
 }
 
+ActivityLog::ActivityLog(const UUID& id,
+                         ActivityType type,
+                         std::shared_ptr<Item> item,
+                         const std::string& description,
+                         const std::string& userId,
+                         std::chrono::system_clock::time_point timestamp)
+    : id_(id),
+      type_(type),
+      description_(description),
+      timestamp_(timestamp),
+      userId_(userId),
+      item_(item),
+      fromContainer_(nullptr),
+      toContainer_(nullptr),
+      project_(nullptr),
+      quantityChange_(0) {
+}
+
 UUID ActivityLog::getId() const {
     return id_;
 }
@@ -0,0 +1,538 @@
+#include "ActivityLogStore.h"
+#include "RecordEncoding.h"
+#include "WriteAheadLog.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+    const Logger logger("ActivityLogStore");
+
+    // Header layout: length(4) timestamp(8) idHigh(8) idLow(8) itemHigh(8) itemLow(8) userLength(1) crc(4),
+    // then the user ID, then the payload. length covers the payload only.
+    constexpr size_t kHeaderSize = 49;
+    constexpr int64_t kHourMillis = 3600LL * 1000;
+    constexpr int64_t kDayMillis = 24 * kHourMillis;
+
+    int64_t floorDiv(int64_t value, int64_t divisor) {
+        int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    // Proleptic Gregorian calendar <-> days since 1970-01-01 (no time zone involved)
+    int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+        year -= month <= 2;
+        int64_t era = floorDiv(year, 400);
+        unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+        unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+    }
+
+    void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+        days += 719468;
+        int64_t era = floorDiv(days, 146097);
+        unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+        unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+        day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+        year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+    }
+
+    void encodeHeader(char* header, const ActivityLogStore::Entry& entry) {
+        putU32(header, static_cast<uint32_t>(entry.payload.size()));
+        putU64(header + 4, static_cast<uint64_t>(entry.timestamp));
+        putU64(header + 12, entry.id.getHigh());
+        putU64(header + 20, entry.id.getLow());
+        putU64(header + 28, entry.itemId.getHigh());
+        putU64(header + 36, entry.itemId.getLow());
+        header[44] = static_cast<char>(entry.userId.size());
+        uint32_t crc = crc32(0, header + 4, 41);
+        crc = crc32(crc, entry.userId.data(), entry.userId.size());
+        crc = crc32(crc, entry.payload.data(), entry.payload.size());
+        putU32(header + 45, crc);
+    }
+
+    // Parses one record from a buffer holding the header, user ID and payload
+    bool decodeRecord(const char* record, size_t available, ActivityLogStore::Entry& entry, size_t& length) {
+        if (available < kHeaderSize) {
+            return false;
+        }
+        uint32_t payloadLength = getU32(record);
+        size_t userLength = static_cast<uint8_t>(record[44]);
+        length = kHeaderSize + userLength + payloadLength;
+        if (length > available) {
+            return false;
+        }
+
+        uint32_t crc = crc32(0, record + 4, 41);
+        crc = crc32(crc, record + kHeaderSize, userLength + payloadLength);
+        if (crc != getU32(record + 45)) {
+            return false;
+        }
+
+        entry.timestamp = static_cast<int64_t>(getU64(record + 4));
+        entry.id = UUID(getU64(record + 12), getU64(record + 20));
+        entry.itemId = UUID(getU64(record + 28), getU64(record + 36));
+        entry.userId.assign(record + kHeaderSize, userLength);
+        entry.payload.assign(record + kHeaderSize + userLength, payloadLength);
+        return true;
+    }
+}
+
+ActivityLogStore::ActivityLogStore(const std::string& directory, Partition partition)
+    : directory_(directory), partition_(partition), open_(false), writerSegment_(0), createdSegment_(false) {}
+
+ActivityLogStore::~ActivityLogStore() {
+    close();
+}
+
+bool ActivityLogStore::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) return true;
+
+    try {
+        std::filesystem::create_directories(directory_);
+
+        // Segments sort by start time, so scanning in that order keeps appends to the timeline cheap
+        std::map<int64_t, std::pair<std::string, int64_t>> found;
+        for (const auto& file : std::filesystem::directory_iterator(directory_)) {
+            int64_t start = 0;
+            int64_t end = 0;
+            if (file.path().extension() == ".seg" && parseSegmentName(file.path().filename().string(), start, end)) {
+                found[start] = {file.path().string(), end};
+            }
+        }
+        for (const auto& segment : found) {
+            uint32_t index = addSegment(segment.second.first, segment.first, segment.second.second);
+            if (!scanSegment(index)) {
+                logger.error() << "Failed to read activity segment: " << segment.second.first;
+                return false;
+            }
+        }
+    } catch (const std::exception& e) {
+        logger.error() << "Error opening activity log store: " << e.what();
+        return false;
+    }
+
+    open_ = true;
+    return true;
+}
+
+void ActivityLogStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (writer_.is_open()) writer_.close();
+    unsynced_.clear();
+    createdSegment_ = false;
+    segments_.clear();
+    segmentsByStart_.clear();
+    entries_.clear();
+    timeline_.clear();
+    byItem_.clear();
+    byUser_.clear();
+    ids_.clear();
+    open_ = false;
+}
+
+bool ActivityLogStore::append(const Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) return false;
+    return appendLocked(entry) && flushLocked();
+}
+
+bool ActivityLogStore::append(const std::vector<Entry>& entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) return false;
+
+    bool ok = true;
+    for (const auto& entry : entries) {
+        ok &= appendLocked(entry);
+    }
+    return flushLocked() && ok;
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::recent(size_t limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readNewestFirst(timeline_, limit);
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::forItem(const UUID& itemId, size_t limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byItem_.find(itemId);
+    if (it == byItem_.end()) {
+        return {};
+    }
+    return readNewestFirst(it->second, limit);
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::forUser(const std::string& userId, size_t limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byUser_.find(userId);
+    if (it == byUser_.end()) {
+        return {};
+    }
+    return readNewestFirst(it->second, limit);
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::between(int64_t from, int64_t to, size_t limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto byTimestamp = [this](uint32_t seq, int64_t timestamp) { return entries_[seq].timestamp < timestamp; };
+    auto first = std::lower_bound(timeline_.begin(), timeline_.end(), from, byTimestamp);
+    auto last = std::lower_bound(first, timeline_.end(), to, byTimestamp);
+
+    std::vector<uint32_t> seqs;
+    for (auto it = last; it != first && (limit == 0 || seqs.size() < limit); ) {
+        seqs.push_back(*--it);
+    }
+    return readEntries(seqs);
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::all() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readEntries(timeline_);
+}
+
+bool ActivityLogStore::contains(const UUID& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ids_.count(id) > 0;
+}
+
+size_t ActivityLogStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timeline_.size();
+}
+
+size_t ActivityLogStore::segmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& segment : segments_) {
+        if (!segment.dropped) ++count;
+    }
+    return count;
+}
+
+size_t ActivityLogStore::dropBefore(int64_t timestamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t dropped = 0;
+
+    for (auto it = segmentsByStart_.begin(); it != segmentsByStart_.end(); ) {
+        Segment& segment = segments_[it->second];
+        if (segment.end > timestamp) {
+            break;
+        }
+        if (writer_.is_open() && writerSegment_ == it->second) {
+            writer_.close();
+        }
+        try {
+            std::filesystem::remove(segment.path);
+        } catch (const std::exception& e) {
+            logger.error() << "Error removing activity segment: " << e.what();
+            break;
+        }
+        segment.dropped = true;
+        it = segmentsByStart_.erase(it);
+        ++dropped;
+    }
+
+    if (dropped == 0) {
+        return 0;
+    }
+
+    // Entries in dropped segments leave every index; entries_ keeps their slots
+    auto isDropped = [this](uint32_t seq) { return segments_[entries_[seq].segment].dropped; };
+    for (uint32_t seq : timeline_) {
+        if (isDropped(seq)) {
+            ids_.erase(entries_[seq].id);
+        }
+    }
+    timeline_.erase(std::remove_if(timeline_.begin(), timeline_.end(), isDropped), timeline_.end());
+    for (auto it = byItem_.begin(); it != byItem_.end(); ) {
+        auto& seqs = it->second;
+        seqs.erase(std::remove_if(seqs.begin(), seqs.end(), isDropped), seqs.end());
+        it = seqs.empty() ? byItem_.erase(it) : std::next(it);
+    }
+    for (auto it = byUser_.begin(); it != byUser_.end(); ) {
+        auto& seqs = it->second;
+        seqs.erase(std::remove_if(seqs.begin(), seqs.end(), isDropped), seqs.end());
+        it = seqs.empty() ? byUser_.erase(it) : std::next(it);
+    }
+    return dropped;
+}
+
+int64_t ActivityLogStore::toMillis(std::chrono::system_clock::time_point timePoint) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timePoint.time_since_epoch()).count();
+}
+
+// Private helper methods
+// Buffered; the caller flushes before releasing the lock
+bool ActivityLogStore::appendLocked(const Entry& entry) {
+    if (entry.userId.size() > 255) {
+        logger.error() << "Activity user ID too long: " << entry.userId.size() << " bytes";
+        return false;
+    }
+    if (ids_.count(entry.id)) return true;
+
+    uint32_t segment = 0;
+    if (!segmentFor(entry.timestamp, segment)) {
+        return false;
+    }
+
+    if (!writer_.is_open() || writerSegment_ != segment) {
+        if (writer_.is_open()) writer_.close();
+        writer_.open(segments_[segment].path, std::ios::binary | std::ios::app);
+        writerSegment_ = segment;
+    }
+
+    char header[kHeaderSize];
+    encodeHeader(header, entry);
+    writer_.write(header, kHeaderSize);
+    writer_.write(entry.userId.data(), entry.userId.size());
+    writer_.write(entry.payload.data(), entry.payload.size());
+    if (!writer_) {
+        logger.error() << "Failed to append to activity segment: " << segments_[segment].path;
+        writer_.close();
+        return false;
+    }
+
+    Location location;
+    location.id = entry.id;
+    location.segment = segment;
+    location.offset = segments_[segment].size;
+    location.length = static_cast<uint32_t>(kHeaderSize + entry.userId.size() + entry.payload.size());
+    location.timestamp = entry.timestamp;
+    segments_[segment].size += location.length;
+    if (std::find(unsynced_.begin(), unsynced_.end(), segment) == unsynced_.end()) {
+        unsynced_.push_back(segment);
+    }
+    indexEntry(entry, location);
+    return true;
+}
+
+// Flushes the writer, then fsyncs each segment appended to since the last
+// call (and the directory, if a segment was created), once per batch
+bool ActivityLogStore::flushLocked() {
+    bool ok = true;
+    if (writer_.is_open()) {
+        writer_.flush();
+        if (!writer_) {
+            logger.error() << "Failed to flush activity segment: " << segments_[writerSegment_].path;
+            writer_.close();
+            ok = false;
+        }
+    }
+
+    for (uint32_t segment : unsynced_) {
+        if (!WriteAheadLog::syncPath(segments_[segment].path)) {
+            logger.error() << "Failed to sync activity segment: " << segments_[segment].path;
+            ok = false;
+        }
+    }
+    unsynced_.clear();
+    if (createdSegment_) {
+        if (!WriteAheadLog::syncPath(directory_)) {
+            logger.error() << "Failed to sync activity directory: " << directory_;
+            ok = false;
+        }
+        createdSegment_ = false;
+    }
+    return ok;
+}
+
+bool ActivityLogStore::scanSegment(uint32_t segment) {
+    Segment& info = segments_[segment];
+    std::ifstream in(info.path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    uint64_t fileSize = std::filesystem::file_size(info.path);
+    std::string buffer;
+    buffer.resize(static_cast<size_t>(fileSize));
+    if (fileSize > 0 && !in.read(&buffer[0], static_cast<std::streamsize>(fileSize))) {
+        return false;
+    }
+    in.close();
+
+    uint64_t offset = 0;
+    Entry entry;
+    size_t length = 0;
+    while (decodeRecord(buffer.data() + offset, buffer.size() - offset, entry, length)) {
+        Location location;
+        location.id = entry.id;
+        location.segment = segment;
+        location.offset = offset;
+        location.length = static_cast<uint32_t>(length);
+        location.timestamp = entry.timestamp;
+        if (!ids_.count(entry.id)) {
+            indexEntry(entry, location);
+        }
+        offset += length;
+    }
+    info.size = offset;
+
+    // Drop a torn or corrupt tail so new records append after the last good one
+    if (fileSize > offset) {
+        logger.warn() << "Truncating damaged tail of " << info.path << " at offset " << offset;
+        std::filesystem::resize_file(info.path, offset);
+    }
+    return true;
+}
+
+void ActivityLogStore::indexEntry(const Entry& entry, const Location& location) {
+    uint32_t seq = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(location);
+    ids_.insert(entry.id);
+    insertByTime(timeline_, seq);
+    if (!entry.itemId.isNil()) {
+        insertByTime(byItem_[entry.itemId], seq);
+    }
+    if (!entry.userId.empty()) {
+        insertByTime(byUser_[entry.userId], seq);
+    }
+}
+
+void ActivityLogStore::insertByTime(std::vector<uint32_t>& sequence, uint32_t seq) {
+    int64_t timestamp = entries_[seq].timestamp;
+    // Entries almost always arrive in time order, so this is usually a push_back
+    if (sequence.empty() || entries_[sequence.back()].timestamp <= timestamp) {
+        sequence.push_back(seq);
+        return;
+    }
+    auto position = std::upper_bound(sequence.begin(), sequence.end(), timestamp,
+        [this](int64_t value, uint32_t other) { return value < entries_[other].timestamp; });
+    sequence.insert(position, seq);
+}
+
+bool ActivityLogStore::segmentFor(int64_t timestamp, uint32_t& segment) {
+    // Late entries go to the segment that covers their time, even an old one
+    auto next = segmentsByStart_.upper_bound(timestamp);
+    if (next != segmentsByStart_.begin() && timestamp < segments_[std::prev(next)->second].end) {
+        segment = std::prev(next)->second;
+        return true;
+    }
+
+    // All segments are whole UTC hours or days. If a day would overlap hourly
+    // segments left by an earlier HOURLY store, fall back to an hour.
+    int64_t span = (partition_ == Partition::HOURLY) ? kHourMillis : kDayMillis;
+    int64_t start = floorDiv(timestamp, span) * span;
+    auto overlapping = segmentsByStart_.lower_bound(start);
+    bool overlaps = (overlapping != segmentsByStart_.end() && overlapping->first < start + span) ||
+                    (overlapping != segmentsByStart_.begin() &&
+                     segments_[std::prev(overlapping)->second].end > start);
+    if (overlaps) {
+        span = kHourMillis;
+        start = floorDiv(timestamp, span) * span;
+    }
+
+    std::string path = directory_ + "/" + segmentName(start, span);
+    {
+        std::ofstream create(path, std::ios::binary | std::ios::app);
+        if (!create.is_open()) {
+            logger.error() << "Failed to create activity segment: " << path;
+            return false;
+        }
+    }
+    createdSegment_ = true;
+
+    segment = addSegment(path, start, start + span);
+    return true;
+}
+
+uint32_t ActivityLogStore::addSegment(const std::string& path, int64_t start, int64_t end) {
+    uint32_t index = static_cast<uint32_t>(segments_.size());
+    segments_.push_back({path, start, end, 0, false});
+    segmentsByStart_[start] = index;
+    return index;
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::readNewestFirst(const std::vector<uint32_t>& sequence,
+                                                                       size_t limit) {
+    size_t count = (limit == 0) ? sequence.size() : std::min(limit, sequence.size());
+    std::vector<uint32_t> seqs(sequence.rbegin(), sequence.rbegin() + static_cast<std::ptrdiff_t>(count));
+    return readEntries(seqs);
+}
+
+std::vector<ActivityLogStore::Entry> ActivityLogStore::readEntries(const std::vector<uint32_t>& seqs) {
+    std::vector<Entry> entries(seqs.size());
+    std::vector<bool> ok(seqs.size(), false);
+
+    // Read segment by segment so each file is opened once per query
+    std::vector<size_t> order(seqs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const Location& left = entries_[seqs[a]];
+        const Location& right = entries_[seqs[b]];
+        return left.segment != right.segment ? left.segment < right.segment : left.offset < right.offset;
+    });
+
+    std::ifstream in;
+    uint32_t openSegment = 0;
+    std::string buffer;
+    for (size_t i : order) {
+        const Location& location = entries_[seqs[i]];
+        if (!in.is_open() || openSegment != location.segment) {
+            if (in.is_open()) in.close();
+            in.open(segments_[location.segment].path, std::ios::binary);
+            openSegment = location.segment;
+        }
+
+        buffer.resize(location.length);
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(location.offset));
+        size_t length = 0;
+        if (in.read(&buffer[0], location.length) &&
+            decodeRecord(buffer.data(), buffer.size(), entries[i], length)) {
+            ok[i] = true;
+        } else {
+            logger.error() << "Failed to read activity record from " << segments_[location.segment].path;
+        }
+    }
+
+    std::vector<Entry> result;
+    result.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (ok[i]) {
+            result.push_back(std::move(entries[i]));
+        }
+    }
+    return result;
+}
+
+std::string ActivityLogStore::segmentName(int64_t start, int64_t span) {
+    int64_t days = floorDiv(start, kDayMillis);
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, year, month, day);
+
+    char name[32];
+    if (span == kDayMillis) {
+        std::snprintf(name, sizeof(name), "%04lld-%02u-%02u.seg", static_cast<long long>(year), month, day);
+    } else {
+        unsigned hour = static_cast<unsigned>((start - days * kDayMillis) / kHourMillis);
+        std::snprintf(name, sizeof(name), "%04lld-%02u-%02uT%02u.seg", static_cast<long long>(year), month, day, hour);
+    }
+    return name;
+}
+
+bool ActivityLogStore::parseSegmentName(const std::string& name, int64_t& start, int64_t& end) {
+    long long year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    unsigned hour = 0;
+    char suffix[8] = {0};
+
+    if (std::sscanf(name.c_str(), "%lld-%u-%uT%u.%3s", &year, &month, &day, &hour, suffix) == 5) {
+        start = daysFromCivil(year, month, day) * kDayMillis + hour * kHourMillis;
+        end = start + kHourMillis;
+    } else if (std::sscanf(name.c_str(), "%lld-%u-%u.%3s", &year, &month, &day, suffix) == 4) {
+        start = daysFromCivil(year, month, day) * kDayMillis;
+        end = start + kDayMillis;
+    } else {
+        return false;
+    }
+    return month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour < 24 && std::string(suffix) == "seg";
+}
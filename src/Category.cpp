@@ -5,6 +5,10 @@ Category::Category(const std::string& name, const std::string& description)
     : id_(UUID::generate()), name_(name), description_(description) {
 }
 
+Category::Category(const UUID& id, const std::string& name, const std::string& description)
+    : id_(id), name_(name), description_(description) {
+}
+
 UUID Category::getId() const {
     return id_;
 }
@@ -18,10 +22,12 @@ std::string Category::getDescription() const {
 }
 
 void Category::setName(const std::string& name) {
+    touch();
     name_ = name;
 }
 
 void Category::setDescription(const std::string& description) {
+    touch();
     description_ = description;
 }
 
@@ -35,6 +41,7 @@ void Category::addSubcategory(std::shared_ptr<Category> subcategory) {
         
         if (it == subcategories_.end()) {
             subcategories_.push_back(subcategory);
+            touch();
         }
     }
 }
@@ -47,9 +54,14 @@ void Category::removeSubcategory(const UUID& subcategoryId) {
     
     if (it != subcategories_.end()) {
         subcategories_.erase(it);
+        touch();
     }
 }
 
-std::vector<std::shared_ptr<Category>> Category::getSubcategories() const {
+const std::vector<std::shared_ptr<Category>>& Category::getSubcategories() const {
     return subcategories_;
 }
+
+size_t Category::subcategoryCount() const {
+    return subcategories_.size();
+}
@@ -2,6 +2,7 @@
 #include "Item.h"
 #include "Location.h"
 #include "Category.h"
+#include "EntityObserver.h"
 #include <algorithm>
 
 Container::Container(const std::string& name,
@@ -12,7 +13,21 @@ Container::Container(const std::string& name,
       description_(description),
       type_(type),
       location_(nullptr),
-      parentContainer_(nullptr) {
+      parentContainer_(nullptr),
+      observer_(nullptr) {
+}
+
+Container::Container(const UUID& id,
+                     const std::string& name,
+                     ContainerType type,
+                     const std::string& description)
+    : id_(id),
+      name_(name),
+      description_(description),
+      type_(type),
+      location_(nullptr),
+      parentContainer_(nullptr),
+      observer_(nullptr) {
 }
 
 UUID Container::getId() const {
@@ -40,18 +55,26 @@ std::shared_ptr<Container> Container::getParentContainer() const {
 }
 
 void Container::setName(const std::string& name) {
+    touch();
     name_ = name;
 }
 
 void Container::setDescription(const std::string& description) {
+    touch();
     description_ = description;
 }
 
 void Container::setLocation(std::shared_ptr<Location> location) {
+    touch();
+    std::shared_ptr<Location> oldLocation = std::move(location_);
     location_ = location;
+    if (observer_) {
+        observer_->onContainerLocationChanged(*this, oldLocation);
+    }
 }
 
 void Container::setParentContainer(std::shared_ptr<Container> parent) {
+    touch();
     parentContainer_ = parent;
 }
 
@@ -65,11 +88,21 @@ void Container::addItem(std::shared_ptr<Item> item) {
         
         if (it == items_.end()) {
             items_.push_back(item);
+            touch();
             item->setContainer(shared_from_this());
         }
     }
 }
 
+void Container::setItems(std::vector<std::shared_ptr<Item>> items) {
+    touch();
+    items_ = std::move(items);
+    auto self = shared_from_this();
+    for (const auto& item : items_) {
+        item->setContainer(self);
+    }
+}
+
 void Container::removeItem(const UUID& itemId) {
     auto it = std::find_if(items_.begin(), items_.end(),
         [&itemId](const std::shared_ptr<Item>& i) {
@@ -79,6 +112,7 @@ void Container::removeItem(const UUID& itemId) {
     if (it != items_.end()) {
         (*it)->setContainer(nullptr);
         items_.erase(it);
+        touch();
     }
 }
 
@@ -91,10 +125,14 @@ std::shared_ptr<Item> Container::getItem(const UUID& itemId) const {
     return (it != items_.end()) ? *it : nullptr;
 }
 
-std::vector<std::shared_ptr<Item>> Container::getAllItems() const {
+const std::vector<std::shared_ptr<Item>>& Container::getAllItems() const {
     return items_;
 }
 
+size_t Container::itemCount() const {
+    return items_.size();
+}
+
 void Container::addSubcontainer(std::shared_ptr<Container> subcontainer) {
     if (subcontainer) {
         // Check if subcontainer already exists
@@ -105,6 +143,7 @@ void Container::addSubcontainer(std::shared_ptr<Container> subcontainer) {
         
         if (it == subcontainers_.end()) {
             subcontainers_.push_back(subcontainer);
+            touch();
             subcontainer->setParentContainer(shared_from_this());
         }
     }
@@ -119,6 +158,7 @@ void Container::removeSubcontainer(const UUID& subcontainerId) {
     if (it != subcontainers_.end()) {
         (*it)->setParentContainer(nullptr);
         subcontainers_.erase(it);
+        touch();
     }
 }
 
@@ -131,10 +171,14 @@ std::shared_ptr<Container> Container::getSubcontainer(const UUID& subcontainerId
     return (it != subcontainers_.end()) ? *it : nullptr;
 }
 
-std::vector<std::shared_ptr<Container>> Container::getAllSubcontainers() const {
+const std::vector<std::shared_ptr<Container>>& Container::getAllSubcontainers() const {
     return subcontainers_;
 }
 
+size_t Container::subcontainerCount() const {
+    return subcontainers_.size();
+}
+
 std::vector<std::shared_ptr<Item>> Container::findItemsByName(const std::string& name) const {
     std::vector<std::shared_ptr<Item>> results;
     
@@ -170,3 +214,7 @@ std::vector<std::shared_ptr<Item>> Container::findItemsByCategory(const UUID& ca
     
     return results;
 }
+
+void Container::setObserver(EntityObserver* observer) {
+    observer_ = observer;
+}
@@ -0,0 +1,50 @@
+#include "Database.h"
+#include "Category.h"
+#include "Container.h"
+#include "Item.h"
+#include "Location.h"
+#include "Project.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    template <typename T>
+    Page<T> pageOf(std::vector<std::shared_ptr<T>> entities, const UUID& after, size_t limit, bool connected) {
+        Page<T> page;
+        if (!connected) {
+            page.ok = false;
+            return page;
+        }
+        std::sort(entities.begin(), entities.end(),
+                  [](const std::shared_ptr<T>& a, const std::shared_ptr<T>& b) { return a->getId() < b->getId(); });
+        auto begin = std::upper_bound(entities.begin(), entities.end(), after,
+                                      [](const UUID& id, const std::shared_ptr<T>& entity) { return id < entity->getId(); });
+        size_t count = std::min<size_t>(limit, entities.end() - begin);
+
+        page.entities.assign(std::make_move_iterator(begin), std::make_move_iterator(begin + count));
+        if (count > 0 && begin + count != entities.end()) {
+            page.next = page.entities.back()->getId();
+        }
+        return page;
+    }
+}
+
+Page<Item> IDatabase::loadItemPage(const UUID& after, size_t limit) {
+    return pageOf(loadAllItems(), after, limit, isConnected());
+}
+
+Page<Container> IDatabase::loadContainerPage(const UUID& after, size_t limit) {
+    return pageOf(loadAllContainers(), after, limit, isConnected());
+}
+
+Page<Location> IDatabase::loadLocationPage(const UUID& after, size_t limit) {
+    return pageOf(loadAllLocations(), after, limit, isConnected());
+}
+
+Page<Project> IDatabase::loadProjectPage(const UUID& after, size_t limit) {
+    return pageOf(loadAllProjects(), after, limit, isConnected());
+}
+
+Page<Category> IDatabase::loadCategoryPage(const UUID& after, size_t limit) {
+    return pageOf(loadAllCategories(), after, limit, isConnected());
+}
@@ -0,0 +1,402 @@
+#include "FileRecordStore.h"
+#include "MappedFile.h"
+#include "Logger.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const Logger logger("FileRecordStore");
+
+    // Below this a mapping costs more to set up and tear down than one read
+    constexpr uintmax_t kMapThreshold = 64 * 1024;
+
+    std::string shardName(size_t shard) {
+        const char digits[] = "0123456789abcdef";
+        return std::string{digits[(shard >> 4) & 0xF], digits[shard & 0xF]};
+    }
+}
+
+FileRecordStore::FileRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types,
+                                 bool writeAheadLog, Layout layout)
+    : dataDirectory_(dataDirectory), types_(types), useWriteAheadLog_(writeAheadLog), layout_(layout) {}
+
+FileRecordStore::~FileRecordStore() {
+    close();
+}
+
+bool FileRecordStore::open() {
+    // Create subdirectories for each entity type
+    for (const auto& type : types_) {
+        std::string path = dataDirectory_ + "/" + type;
+        if (!ensureDirectoryExists(path)) {
+            logger.error() << "Failed to create subdirectory: " << path;
+            return false;
+        }
+    }
+
+    if (useWriteAheadLog_ && !wal_) {
+        wal_ = std::make_unique<WriteAheadLog>(
+            dataDirectory_ + "/wal.log",
+            [this](const WriteAheadLog::Record& record) { return apply(record); },
+            [this]() { return syncWrittenFiles(); });
+        if (!wal_->open()) {
+            wal_.reset();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FileRecordStore::close() {
+    if (wal_) {
+        wal_->close();
+        wal_.reset();
+    }
+}
+
+bool FileRecordStore::put(const std::string& type, const UUID& id, const std::string& payload) {
+    if (wal_) {
+        return wal_->commit({WriteAheadLog::Op::PUT, type, id, payload});
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return writeFileAtomic(getFilePath(type, id), payload);
+}
+
+bool FileRecordStore::get(const std::string& type, const UUID& id, std::string& payload) {
+    std::ifstream file(getFilePath(type, id), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    payload = contents.str();
+    return true;
+}
+
+bool FileRecordStore::read(const std::string& type, const UUID& id, const RecordReader& reader) {
+    std::string path = getFilePath(type, id);
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    // Size of the file we opened, which a concurrent rename cannot change
+    long size = (std::fseek(file, 0, SEEK_END) == 0) ? std::ftell(file) : -1;
+    if (size < 0) {
+        std::fclose(file);
+        return false;
+    }
+
+    if (static_cast<uintmax_t>(size) >= kMapThreshold) {
+        std::fclose(file);
+        MappedFile mapped;
+        if (!mapped.open(path)) {
+            return false;
+        }
+        reader(mapped.data(), mapped.size());
+        return true;
+    }
+
+    // Small records: one read into a per-thread buffer, no stream in between
+    thread_local std::string buffer;
+    buffer.resize(static_cast<size_t>(size));
+    std::rewind(file);
+    size_t length = std::fread(&buffer[0], 1, buffer.size(), file);
+    std::fclose(file);
+
+    reader(buffer.data(), length);
+    return true;
+}
+
+bool FileRecordStore::remove(const std::string& type, const UUID& id) {
+    try {
+        std::string filePath = getFilePath(type, id);
+        if (!wal_) {
+            return std::filesystem::remove(filePath);
+        }
+
+        // Only log deletes of records that exist, so the return value stays meaningful
+        if (!std::filesystem::exists(filePath)) {
+            return false;
+        }
+        return wal_->commit({WriteAheadLog::Op::REMOVE, type, id, std::string()});
+    } catch (const std::exception& e) {
+        logger.error() << "Error deleting record: " << e.what();
+        return false;
+    }
+}
+
+bool FileRecordStore::writeBatch(const std::vector<Write>& writes) {
+    if (wal_) {
+        std::vector<WriteAheadLog::Record> records;
+        records.reserve(writes.size());
+        for (const auto& write : writes) {
+            records.push_back({write.remove ? WriteAheadLog::Op::REMOVE : WriteAheadLog::Op::PUT,
+                               write.type, write.id, write.payload});
+        }
+        return wal_->commit(std::move(records));
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    bool ok = true;
+    for (const auto& write : writes) {
+        try {
+            if (write.remove) {
+                std::filesystem::remove(getFilePath(write.type, write.id));
+            } else {
+                ok &= writeFileAtomic(getFilePath(write.type, write.id), write.payload);
+            }
+        } catch (const std::exception& e) {
+            logger.error() << "Error writing record: " << e.what();
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+std::vector<UUID> FileRecordStore::list(const std::string& type) {
+    std::vector<UUID> ids;
+
+    try {
+        std::string directory = dataDirectory_ + "/" + type;
+        if (!std::filesystem::exists(directory)) {
+            return ids;
+        }
+
+        collectIds(directory, layout_ == Layout::SHARDED ? 2 : 0, ids);
+    } catch (const std::exception& e) {
+        logger.error() << "Error listing " << type << ": " << e.what();
+    }
+
+    return ids;
+}
+
+size_t FileRecordStore::partitionCount(const std::string& /*type*/) {
+    return layout_ == Layout::SHARDED ? kShardCount : 1;
+}
+
+std::vector<UUID> FileRecordStore::listPartition(const std::string& type, size_t partition) {
+    if (layout_ != Layout::SHARDED) {
+        return partition == 0 ? list(type) : std::vector<UUID>();
+    }
+
+    std::vector<UUID> ids;
+    try {
+        std::string directory = dataDirectory_ + "/" + type + "/" + shardName(partition);
+        if (std::filesystem::exists(directory)) {
+            collectIds(directory, 1, ids);
+        }
+    } catch (const std::exception& e) {
+        logger.error() << "Error listing " << type << "/" << shardName(partition) << ": " << e.what();
+    }
+
+    return ids;
+}
+
+const WriteAheadLog* FileRecordStore::getWriteAheadLog() const {
+    return wal_.get();
+}
+
+FileRecordStore::Layout FileRecordStore::getLayout() const {
+    return layout_;
+}
+
+bool FileRecordStore::migrate(const std::string& dataDirectory, const std::vector<std::string>& types,
+                              Layout layout, size_t* movedCount) {
+    namespace fs = std::filesystem;
+    size_t moved = 0;
+    if (movedCount) *movedCount = 0;
+
+    for (const auto& type : types) {
+        std::string directory = dataDirectory + "/" + type;
+        size_t movedInType = 0;
+        try {
+            if (!fs::exists(directory)) {
+                continue;
+            }
+
+            // Collect first; renaming while iterating would revisit moved files
+            std::vector<fs::path> files;
+            for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                    files.push_back(entry.path());
+                }
+            }
+
+            for (const auto& file : files) {
+                UUID id = UUID::fromString(file.stem().string());
+                if (id.isNil()) {
+                    continue;
+                }
+
+                fs::path target = recordPath(dataDirectory, type, id, layout);
+                if (target.lexically_normal() == file.lexically_normal()) {
+                    continue;
+                }
+                fs::create_directories(target.parent_path());
+                fs::rename(file, target);
+                ++moved;
+                ++movedInType;
+                if (movedCount) *movedCount = moved;
+            }
+
+            // Drop shard directories left empty, deepest first
+            std::vector<fs::path> directories;
+            for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+                if (entry.is_directory()) {
+                    directories.push_back(entry.path());
+                }
+            }
+            for (auto it = directories.rbegin(); it != directories.rend(); ++it) {
+                if (fs::is_empty(*it)) {
+                    fs::remove(*it);
+                }
+            }
+
+            // A rename is only durable once both directory entries are on disk.
+            // Every source, target and created or removed shard directory is
+            // either still in this tree or was an entry of one that is.
+            if (movedInType > 0) {
+                std::vector<std::string> touched{directory};
+                for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+                    if (entry.is_directory()) {
+                        touched.push_back(entry.path().string());
+                    }
+                }
+                for (auto it = touched.rbegin(); it != touched.rend(); ++it) {
+                    if (!WriteAheadLog::syncPath(*it)) {
+                        logger.error() << "Failed to sync: " << *it;
+                        return false;
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            logger.error() << "Error migrating " << directory << ": " << e.what();
+            return false;
+        }
+    }
+
+    // Records still in the write-ahead log belong to the new layout now
+    FileRecordStore store(dataDirectory, types, true, layout);
+    if (!store.open()) {
+        return false;
+    }
+    store.close();
+    return true;
+}
+
+// Private helper methods
+bool FileRecordStore::apply(const WriteAheadLog::Record& record) {
+    std::string filePath = getFilePath(record.type, record.id);
+
+    // Called by the WAL leader only, so applies never run concurrently
+    try {
+        if (record.op == WriteAheadLog::Op::PUT) {
+            if (!writeFileAtomic(filePath, record.payload)) {
+                return false;
+            }
+            unsyncedPaths_.insert(filePath);
+        } else {
+            std::filesystem::remove(filePath);
+            unsyncedPaths_.erase(filePath);
+        }
+        // The directory entry changed too
+        unsyncedPaths_.insert(std::filesystem::path(filePath).parent_path().string());
+        return true;
+    } catch (const std::exception& e) {
+        logger.error() << "Error applying record: " << e.what();
+        return false;
+    }
+}
+
+bool FileRecordStore::syncWrittenFiles() {
+    bool ok = true;
+    for (const auto& path : unsyncedPaths_) {
+        if (!WriteAheadLog::syncPath(path)) {
+            logger.error() << "Failed to sync: " << path;
+            ok = false;
+        }
+    }
+    unsyncedPaths_.clear();
+    return ok;
+}
+
+bool FileRecordStore::writeFileAtomic(const std::string& path, const std::string& payload) {
+    if (layout_ == Layout::SHARDED) {
+        std::string shard = std::filesystem::path(path).parent_path().string();
+        if (createdShards_.count(shard) == 0) {
+            if (!ensureDirectoryExists(shard)) {
+                logger.error() << "Failed to create shard directory: " << shard;
+                return false;
+            }
+            createdShards_.insert(shard);
+        }
+    }
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            logger.error() << "Failed to open file for writing: " << tempPath;
+            return false;
+        }
+
+        file << payload;
+        file.close();
+        if (file.fail()) {
+            logger.error() << "Failed to write file: " << tempPath;
+            return false;
+        }
+    }
+
+    try {
+        std::filesystem::rename(tempPath, path);
+    } catch (const std::exception& e) {
+        logger.error() << "Error replacing " << path << ": " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
+bool FileRecordStore::ensureDirectoryExists(const std::string& path) {
+    try {
+        return std::filesystem::create_directories(path) || std::filesystem::exists(path);
+    } catch (const std::exception& e) {
+        logger.error() << "Error creating directory: " << e.what();
+        return false;
+    }
+}
+
+std::string FileRecordStore::getFilePath(const std::string& type, const UUID& id) const {
+    return recordPath(dataDirectory_, type, id, layout_);
+}
+
+std::string FileRecordStore::recordPath(const std::string& directory, const std::string& type, const UUID& id,
+                                        Layout layout) {
+    std::string name = id.toString();
+    if (layout == Layout::FLAT) {
+        return directory + "/" + type + "/" + name + ".json";
+    }
+    return directory + "/" + type + "/" + name.substr(32, 2) + "/" + name.substr(34, 2) + "/" + name + ".json";
+}
+
+void FileRecordStore::collectIds(const std::string& directory, int depth, std::vector<UUID>& ids) {
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (depth > 0) {
+            if (entry.is_directory()) {
+                collectIds(entry.path().string(), depth - 1, ids);
+            }
+        } else if (entry.path().extension() == ".json") {
+            UUID id = UUID::fromString(entry.path().stem().string());
+            if (!id.isNil()) {
+                ids.push_back(id);
+            }
+        }
+    }
+}
@@ -5,21 +5,96 @@
 #include "Project.h"
 #include "Category.h"
 #include "ActivityLog.h"
+#include "Logger.h"
 #include <algorithm>
-#include <iostream>
+
+namespace {
+    const Logger logger("InventoryManager");
+
+    // Dirty entities of one type with the versions being written
+    template <typename T>
+    struct DirtySet {
+        std::vector<std::shared_ptr<T>> entities;
+        std::vector<uint64_t> versions;
+        
+        void markSaved() const {
+            for (size_t i = 0; i < entities.size(); ++i) {
+                entities[i]->markSaved(versions[i]);
+            }
+        }
+    };
+    
+    // What the write-behind worker stores: a shallow copy of the entity's
+    // own fields, detached from the manager's observer. Items leave out
+    // their activity history, which is stored with the activity logs.
+    template <typename T>
+    std::shared_ptr<T> snapshot(const T& entity) {
+        return std::make_shared<T>(entity);
+    }
+    
+    std::shared_ptr<Container> snapshot(const Container& container) {
+        auto copy = std::make_shared<Container>(container);
+        copy->setObserver(nullptr);
+        return copy;
+    }
+    
+    std::shared_ptr<Item> snapshot(const Item& item) {
+        return item.snapshot();
+    }
+    
+    template <typename T>
+    DirtySet<T> collectDirty(const EntityRegistry<T>& registry) {
+        DirtySet<T> dirty;
+        for (const auto& entity : registry.all()) {
+            if (entity->isDirty()) {
+                dirty.entities.push_back(entity);
+                dirty.versions.push_back(entity->getVersion());
+            }
+        }
+        return dirty;
+    }
+    
+    template <typename T>
+    size_t countDirty(const EntityRegistry<T>& registry) {
+        return std::count_if(registry.all().begin(), registry.all().end(),
+                             [](const std::shared_ptr<T>& entity) { return entity->isDirty(); });
+    }
+    
+    template <typename T>
+    void markAllSaved(const EntityRegistry<T>& registry) {
+        for (const auto& entity : registry.all()) {
+            entity->markSaved(entity->getVersion());
+        }
+    }
+    
+    // Write-through saves leave the entity clean
+    template <typename T>
+    void markSavedIf(bool saved, const std::shared_ptr<T>& entity) {
+        if (saved) {
+            entity->markSaved(entity->getVersion());
+        }
+    }
+}
 
 InventoryManager::InventoryManager(std::shared_ptr<IDatabase> database)
-    : database_(database) {
+    : database_(database), flushStop_(false), nextItemSequence_(0) {
+}
+
+InventoryManager::~InventoryManager() {
+    stopBackgroundFlush();
+    writeBehind_.reset();
+    detachObservers();
 }
 
 bool InventoryManager::initialize() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (!database_) {
-        std::cerr << "Database not set" << std::endl;
+        logger.error() << "Database not set";
         return false;
     }
     
     if (!database_->connect()) {
-        std::cerr << "Failed to connect to database" << std::endl;
+        logger.error() << "Failed to connect to database";
         return false;
     }
     
@@ -27,10 +102,14 @@ bool InventoryManager::initialize() {
 }
 
 bool InventoryManager::shutdown() {
+    stopBackgroundFlush();
+    
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (!saveAll()) {
-        std::cerr << "Failed to save all data" << std::endl;
+        logger.error() << "Failed to save all data";
         return false;
     }
+    writeBehind_.reset();
     
     if (database_) {
         return database_->disconnect();
@@ -39,37 +118,110 @@ bool InventoryManager::shutdown() {
     return true;
 }
 
+// Persistence
+bool InventoryManager::flush() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return database_ && database_->isConnected() && saveAll();
+}
+
+size_t InventoryManager::dirtyCount() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return countDirty(items_) + countDirty(containers_) + countDirty(locations_) +
+           countDirty(projects_) + countDirty(categories_);
+}
+
+void InventoryManager::startBackgroundFlush(std::chrono::milliseconds interval) {
+    stopBackgroundFlush();
+    
+    flushStop_ = false;
+    flushThread_ = std::thread([this, interval]() {
+        std::unique_lock<std::mutex> wait(flushMutex_);
+        while (!flushWake_.wait_for(wait, interval, [this]() { return flushStop_; })) {
+            wait.unlock();
+            if (!flush()) {
+                logger.warn() << "Background flush failed; dirty entities will be retried";
+            }
+            wait.lock();
+        }
+    });
+}
+
+void InventoryManager::stopBackgroundFlush() {
+    {
+        std::lock_guard<std::mutex> wait(flushMutex_);
+        flushStop_ = true;
+    }
+    flushWake_.notify_all();
+    if (flushThread_.joinable()) {
+        flushThread_.join();
+    }
+}
+
+std::unique_lock<std::recursive_mutex> InventoryManager::lock() const {
+    return std::unique_lock<std::recursive_mutex>(mutex_);
+}
+
+void InventoryManager::enableWriteBehind(const WriteBehindQueue::Options& options) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (writeBehind_ && !writeBehind_->flush()) {
+        logger.error() << "Failed to flush the previous write-behind queue";
+    }
+    writeBehind_ = std::make_unique<WriteBehindQueue>(database_, options);
+}
+
+void InventoryManager::enableWriteBehind() {
+    enableWriteBehind(WriteBehindQueue::Options());
+}
+
+bool InventoryManager::disableWriteBehind() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (!writeBehind_) {
+        return true;
+    }
+    
+    // The queue's destructor makes one more attempt at anything left
+    bool flushed = writeBehind_->flush();
+    writeBehind_.reset();
+    return flushed;
+}
+
+const WriteBehindQueue* InventoryManager::getWriteBehindQueue() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return writeBehind_.get();
+}
+
 // Item management
 std::shared_ptr<Item> InventoryManager::createItem(const std::string& name,
                                                    std::shared_ptr<Category> category,
                                                    int quantity,
                                                    const std::string& description) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = std::make_shared<Item>(name, category, quantity, description);
-    items_.push_back(item);
+    items_.add(item);
+    indexItem(item);
     
     // Log creation
     logActivity(ActivityType::CREATED, item, "Item created", "system");
     
-    database_->saveItem(item);
+    persist(item, &IDatabase::saveItem);
     return item;
 }
 
 bool InventoryManager::deleteItem(const UUID& itemId) {
-    auto it = std::find_if(items_.begin(), items_.end(),
-        [&itemId](const std::shared_ptr<Item>& item) {
-            return item->getId() == itemId;
-        });
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto item = items_.get(itemId);
     
-    if (it != items_.end()) {
-        logActivity(ActivityType::DELETED, *it, "Item deleted", "system");
+    if (item) {
+        logActivity(ActivityType::DELETED, item, "Item deleted", "system");
         
         // Remove from container if present
-        if ((*it)->getCurrentContainer()) {
-            (*it)->getCurrentContainer()->removeItem(itemId);
+        if (item->getCurrentContainer()) {
+            item->getCurrentContainer()->removeItem(itemId);
         }
         
-        database_->deleteItem(itemId);
-        items_.erase(it);
+        unpersist(itemId, &WriteBehindQueue::removeItem, &IDatabase::deleteItem);
+        unindexItem(item);
+        items_.remove(itemId);
         return true;
     }
     
@@ -77,24 +229,22 @@ bool InventoryManager::deleteItem(const UUID& itemId) {
 }
 
 std::shared_ptr<Item> InventoryManager::getItem(const UUID& itemId) {
-    auto it = std::find_if(items_.begin(), items_.end(),
-        [&itemId](const std::shared_ptr<Item>& item) {
-            return item->getId() == itemId;
-        });
-    
-    return (it != items_.end()) ? *it : nullptr;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return items_.get(itemId);
 }
 
-std::vector<std::shared_ptr<Item>> InventoryManager::getAllItems() {
-    return items_;
+const std::vector<std::shared_ptr<Item>>& InventoryManager::getAllItems() const {
+    return items_.all();
 }
 
-std::vector<std::shared_ptr<Item>> InventoryManager::searchItems(const std::string& query) {
+std::vector<std::shared_ptr<Item>> InventoryManager::searchItems(const std::string& query, size_t limit) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     std::vector<std::shared_ptr<Item>> results;
     
-    for (const auto& item : items_) {
-        if (item->getName().find(query) != std::string::npos ||
-            item->getDescription().find(query) != std::string::npos) {
+    auto hits = searchIndex_.search(query, limit);
+    results.reserve(hits.size());
+    for (const auto& hit : hits) {
+        if (auto item = items_.get(hit.id)) {
             results.push_back(item);
         }
     }
@@ -106,26 +256,27 @@ std::vector<std::shared_ptr<Item>> InventoryManager::searchItems(const std::stri
 std::shared_ptr<Container> InventoryManager::createContainer(const std::string& name,
                                                              ContainerType type,
                                                              const std::string& description) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto container = std::make_shared<Container>(name, type, description);
-    containers_.push_back(container);
-    database_->saveContainer(container);
+    containers_.add(container);
+    indexContainer(container);
+    persist(container, &IDatabase::saveContainer);
     return container;
 }
 
 bool InventoryManager::deleteContainer(const UUID& containerId) {
-    auto it = std::find_if(containers_.begin(), containers_.end(),
-        [&containerId](const std::shared_ptr<Container>& container) {
-            return container->getId() == containerId;
-        });
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto container = containers_.get(containerId);
     
-    if (it != containers_.end()) {
+    if (container) {
         // Remove from location if present
-        if ((*it)->getLocation()) {
-            (*it)->getLocation()->removeContainer(containerId);
+        if (container->getLocation()) {
+            container->getLocation()->removeContainer(containerId);
         }
         
-        database_->deleteContainer(containerId);
-        containers_.erase(it);
+        unpersist(containerId, &WriteBehindQueue::removeContainer, &IDatabase::deleteContainer);
+        unindexContainer(container);
+        containers_.remove(containerId);
         return true;
     }
     
@@ -133,36 +284,29 @@ bool InventoryManager::deleteContainer(const UUID& containerId) {
 }
 
 std::shared_ptr<Container> InventoryManager::getContainer(const UUID& containerId) {
-    auto it = std::find_if(containers_.begin(), containers_.end(),
-        [&containerId](const std::shared_ptr<Container>& container) {
-            return container->getId() == containerId;
-        });
-    
-    return (it != containers_.end()) ? *it : nullptr;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return containers_.get(containerId);
 }
 
-std::vector<std::shared_ptr<Container>> InventoryManager::getAllContainers() {
-    return containers_;
+const std::vector<std::shared_ptr<Container>>& InventoryManager::getAllContainers() const {
+    return containers_.all();
 }
 
 // Location management
 std::shared_ptr<Location> InventoryManager::createLocation(const std::string& name,
                                                           const std::string& address) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto location = std::make_shared<Location>(name, address);
-    locations_.push_back(location);
-    database_->saveLocation(location);
+    locations_.add(location);
+    persist(location, &IDatabase::saveLocation);
     return location;
 }
 
 bool InventoryManager::deleteLocation(const UUID& locationId) {
-    auto it = std::find_if(locations_.begin(), locations_.end(),
-        [&locationId](const std::shared_ptr<Location>& location) {
-            return location->getId() == locationId;
-        });
-    
-    if (it != locations_.end()) {
-        database_->deleteLocation(locationId);
-        locations_.erase(it);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (locations_.contains(locationId)) {
+        unpersist(locationId, &WriteBehindQueue::removeLocation, &IDatabase::deleteLocation);
+        locations_.remove(locationId);
         return true;
     }
     
@@ -170,36 +314,29 @@ bool InventoryManager::deleteLocation(const UUID& locationId) {
 }
 
 std::shared_ptr<Location> InventoryManager::getLocation(const UUID& locationId) {
-    auto it = std::find_if(locations_.begin(), locations_.end(),
-        [&locationId](const std::shared_ptr<Location>& location) {
-            return location->getId() == locationId;
-        });
-    
-    return (it != locations_.end()) ? *it : nullptr;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return locations_.get(locationId);
 }
 
-std::vector<std::shared_ptr<Location>> InventoryManager::getAllLocations() {
-    return locations_;
+const std::vector<std::shared_ptr<Location>>& InventoryManager::getAllLocations() const {
+    return locations_.all();
 }
 
 // Project management
 std::shared_ptr<Project> InventoryManager::createProject(const std::string& name,
                                                         const std::string& description) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto project = std::make_shared<Project>(name, description);
-    projects_.push_back(project);
-    database_->saveProject(project);
+    projects_.add(project);
+    persist(project, &IDatabase::saveProject);
     return project;
 }
 
 bool InventoryManager::deleteProject(const UUID& projectId) {
-    auto it = std::find_if(projects_.begin(), projects_.end(),
-        [&projectId](const std::shared_ptr<Project>& project) {
-            return project->getId() == projectId;
-        });
-    
-    if (it != projects_.end()) {
-        database_->deleteProject(projectId);
-        projects_.erase(it);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (projects_.contains(projectId)) {
+        unpersist(projectId, &WriteBehindQueue::removeProject, &IDatabase::deleteProject);
+        projects_.remove(projectId);
         return true;
     }
     
@@ -207,36 +344,29 @@ bool InventoryManager::deleteProject(const UUID& projectId) {
 }
 
 std::shared_ptr<Project> InventoryManager::getProject(const UUID& projectId) {
-    auto it = std::find_if(projects_.begin(), projects_.end(),
-        [&projectId](const std::shared_ptr<Project>& project) {
-            return project->getId() == projectId;
-        });
-    
-    return (it != projects_.end()) ? *it : nullptr;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return projects_.get(projectId);
 }
 
-std::vector<std::shared_ptr<Project>> InventoryManager::getAllProjects() {
-    return projects_;
+const std::vector<std::shared_ptr<Project>>& InventoryManager::getAllProjects() const {
+    return projects_.all();
 }
 
 // Category management
 std::shared_ptr<Category> InventoryManager::createCategory(const std::string& name,
                                                           const std::string& description) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto category = std::make_shared<Category>(name, description);
-    categories_.push_back(category);
-    database_->saveCategory(category);
+    categories_.add(category);
+    persist(category, &IDatabase::saveCategory);
     return category;
 }
 
 bool InventoryManager::deleteCategory(const UUID& categoryId) {
-    auto it = std::find_if(categories_.begin(), categories_.end(),
-        [&categoryId](const std::shared_ptr<Category>& category) {
-            return category->getId() == categoryId;
-        });
-    
-    if (it != categories_.end()) {
-        database_->deleteCategory(categoryId);
-        categories_.erase(it);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (categories_.contains(categoryId)) {
+        unpersist(categoryId, &WriteBehindQueue::removeCategory, &IDatabase::deleteCategory);
+        categories_.remove(categoryId);
         return true;
     }
     
@@ -244,20 +374,17 @@ bool InventoryManager::deleteCategory(const UUID& categoryId) {
 }
 
 std::shared_ptr<Category> InventoryManager::getCategory(const UUID& categoryId) {
-    auto it = std::find_if(categories_.begin(), categories_.end(),
-        [&categoryId](const std::shared_ptr<Category>& category) {
-            return category->getId() == categoryId;
-        });
-    
-    return (it != categories_.end()) ? *it : nullptr;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return categories_.get(categoryId);
 }
 
-std::vector<std::shared_ptr<Category>> InventoryManager::getAllCategories() {
-    return categories_;
+const std::vector<std::shared_ptr<Category>>& InventoryManager::getAllCategories() const {
+    return categories_.all();
 }
 
 // Item operations
 bool InventoryManager::moveItem(const UUID& itemId, const UUID& toContainerId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     auto toContainer = getContainer(toContainerId);
     
@@ -281,37 +408,40 @@ bool InventoryManager::moveItem(const UUID& itemId, const UUID& toContainerId) {
     log->setFromContainer(fromContainer);
     log->setToContainer(toContainer);
     item->addActivity(log);
-    database_->saveActivityLog(log);
-    database_->saveItem(item);
+    persistActivity(log);
+    persist(item, &IDatabase::saveItem);
     
     return true;
 }
 
 bool InventoryManager::checkOutItem(const UUID& itemId, const std::string& userId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     if (!item) {
         return false;
     }
     
     logActivity(ActivityType::CHECK_OUT, item, "Item checked out", userId);
-    database_->saveItem(item);
+    persist(item, &IDatabase::saveItem);
     
     return true;
 }
 
 bool InventoryManager::checkInItem(const UUID& itemId, const std::string& userId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     if (!item) {
         return false;
     }
     
     logActivity(ActivityType::CHECK_IN, item, "Item checked in", userId);
-    database_->saveItem(item);
+    persist(item, &IDatabase::saveItem);
     
     return true;
 }
 
 bool InventoryManager::assignItemToProject(const UUID& itemId, const UUID& projectId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     auto project = getProject(projectId);
     
@@ -323,26 +453,28 @@ bool InventoryManager::assignItemToProject(const UUID& itemId, const UUID& proje
                                              "Item assigned to project: " + project->getName(), "system");
     log->setProject(project);
     item->addActivity(log);
-    database_->saveActivityLog(log);
-    database_->saveItem(item);
+    persistActivity(log);
+    persist(item, &IDatabase::saveItem);
     
     return true;
 }
 
 bool InventoryManager::returnItemFromProject(const UUID& itemId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     if (!item) {
         return false;
     }
     
     logActivity(ActivityType::RETURNED_FROM_PROJECT, item, "Item returned from project", "system");
-    database_->saveItem(item);
+    persist(item, &IDatabase::saveItem);
     
     return true;
 }
 
 // Activity tracking
 std::vector<std::shared_ptr<ActivityLog>> InventoryManager::getItemHistory(const UUID& itemId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto item = getItem(itemId);
     if (!item) {
         return {};
@@ -352,41 +484,51 @@ std::vector<std::shared_ptr<ActivityLog>> InventoryManager::getItemHistory(const
 }
 
 std::vector<std::shared_ptr<ActivityLog>> InventoryManager::getRecentActivity(int limit) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (writeBehind_) {
+        writeBehind_->flush();
+    }
     return database_->loadRecentActivityLogs(limit);
 }
 
 // Search and query
 std::shared_ptr<Item> InventoryManager::findItemByName(const std::string& name) {
-    auto it = std::find_if(items_.begin(), items_.end(),
-        [&name](const std::shared_ptr<Item>& item) {
-            return item->getName() == name;
-        });
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto ids = itemsByName_.find(name);
+    if (!ids) {
+        return nullptr;
+    }
     
-    return (it != items_.end()) ? *it : nullptr;
+    // The set is unordered, so pick the earliest item explicitly
+    const UUID* first = nullptr;
+    for (const auto& id : *ids) {
+        if (!first || itemSequence_.at(id) < itemSequence_.at(*first)) {
+            first = &id;
+        }
+    }
+    return items_.get(*first);
 }
 
 std::vector<std::shared_ptr<Item>> InventoryManager::findItemsByCategory(const UUID& categoryId) {
-    std::vector<std::shared_ptr<Item>> results;
-    
-    for (const auto& item : items_) {
-        if (item->getCategory() && item->getCategory()->getId() == categoryId) {
-            results.push_back(item);
-        }
-    }
-    
-    return results;
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return resolveItems(itemsByCategory_.find(categoryId));
 }
 
 std::vector<std::shared_ptr<Item>> InventoryManager::findItemsInLocation(const UUID& locationId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     std::vector<std::shared_ptr<Item>> results;
-    auto location = getLocation(locationId);
     
-    if (!location) {
+    if (!locations_.contains(locationId)) {
         return results;
     }
     
-    for (const auto& container : location->getAllContainers()) {
-        auto containerItems = container->getAllItems();
+    auto containerIds = containersByLocation_.find(locationId);
+    if (!containerIds) {
+        return results;
+    }
+    
+    for (const auto& containerId : *containerIds) {
+        auto containerItems = resolveItems(itemsByContainer_.find(containerId));
         results.insert(results.end(), containerItems.begin(), containerItems.end());
     }
     
@@ -394,6 +536,7 @@ std::vector<std::shared_ptr<Item>> InventoryManager::findItemsInLocation(const U
 }
 
 std::vector<std::shared_ptr<Item>> InventoryManager::findItemsInProject(const UUID& projectId) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto project = getProject(projectId);
     if (!project) {
         return {};
@@ -403,45 +546,240 @@ std::vector<std::shared_ptr<Item>> InventoryManager::findItemsInProject(const UU
 }
 
 // Helper methods
+template <typename T>
+void InventoryManager::persist(const std::shared_ptr<T>& entity, bool (IDatabase::*save)(std::shared_ptr<T>)) {
+    if (writeBehind_) {
+        // The worker writes a snapshot, so later changes to the entity's own
+        // fields cannot race with it
+        writeBehind_->save(snapshot(*entity));
+        entity->markSaved(entity->getVersion());
+    } else {
+        markSavedIf(((*database_).*save)(entity), entity);
+    }
+}
+
+void InventoryManager::persistActivity(const std::shared_ptr<ActivityLog>& log) {
+    if (writeBehind_) {
+        writeBehind_->save(log);
+    } else {
+        database_->saveActivityLog(log);
+    }
+}
+
+void InventoryManager::unpersist(const UUID& id, void (WriteBehindQueue::*remove)(const UUID&),
+                                 bool (IDatabase::*erase)(const UUID&)) {
+    if (writeBehind_) {
+        ((*writeBehind_).*remove)(id);
+    } else {
+        ((*database_).*erase)(id);
+    }
+}
+
 void InventoryManager::logActivity(ActivityType type, std::shared_ptr<Item> item,
                                    const std::string& description, const std::string& userId) {
     auto log = std::make_shared<ActivityLog>(type, item, description, userId);
     item->addActivity(log);
-    database_->saveActivityLog(log);
+    persistActivity(log);
 }
 
 bool InventoryManager::saveAll() {
+    auto categories = collectDirty(categories_);
+    auto locations = collectDirty(locations_);
+    auto containers = collectDirty(containers_);
+    auto items = collectDirty(items_);
+    auto projects = collectDirty(projects_);
+    if (categories.entities.empty() && locations.entities.empty() && containers.entities.empty() &&
+        items.entities.empty() && projects.entities.empty()) {
+        return !writeBehind_ || writeBehind_->flush();
+    }
+    
+    if (writeBehind_) {
+        for (const auto& category : categories.entities) writeBehind_->save(snapshot(*category));
+        for (const auto& location : locations.entities) writeBehind_->save(snapshot(*location));
+        for (const auto& container : containers.entities) writeBehind_->save(snapshot(*container));
+        for (const auto& item : items.entities) writeBehind_->save(snapshot(*item));
+        for (const auto& project : projects.entities) writeBehind_->save(snapshot(*project));
+        
+        categories.markSaved();
+        locations.markSaved();
+        containers.markSaved();
+        items.markSaved();
+        projects.markSaved();
+        return writeBehind_->flush();
+    }
+    
+    // One batch per entity type inside a single unit of work. Referenced
+    // entities go first, for backends that enforce foreign keys.
+    UnitOfWork work(*database_);
     bool success = true;
     
-    for (const auto& item : items_) {
-        success &= database_->saveItem(item);
+    success &= database_->saveCategories(categories.entities);
+    success &= database_->saveLocations(locations.entities);
+    success &= database_->saveContainers(containers.entities);
+    success &= database_->saveItems(items.entities);
+    success &= database_->saveProjects(projects.entities);
+    
+    // Not active if a unit of work was already open on this thread; the
+    // writes then belong to that one. On failure everything stays dirty.
+    if (!success || (work.isActive() && !work.commit())) {
+        return false;
     }
     
-    for (const auto& container : containers_) {
-        success &= database_->saveContainer(container);
+    categories.markSaved();
+    locations.markSaved();
+    containers.markSaved();
+    items.markSaved();
+    projects.markSaved();
+    return true;
+}
+
+bool InventoryManager::loadAll() {
+    detachObservers();
+    
+    EntitySnapshot snapshot;
+    if (!database_->loadSnapshot(snapshot)) {
+        logger.error() << "Failed to load data from database";
+        return false;
     }
     
-    for (const auto& location : locations_) {
-        success &= database_->saveLocation(location);
+    items_.assign(snapshot.items);
+    containers_.assign(snapshot.containers);
+    locations_.assign(snapshot.locations);
+    projects_.assign(snapshot.projects);
+    categories_.assign(snapshot.categories);
+    
+    rebuildIndexes();
+    
+    // Linking bumped the versions; what was just loaded is what is stored
+    markAllSaved(items_);
+    markAllSaved(containers_);
+    markAllSaved(locations_);
+    markAllSaved(projects_);
+    markAllSaved(categories_);
+    
+    return true;
+}
+
+// Index maintenance
+void InventoryManager::indexItem(const std::shared_ptr<Item>& item) {
+    const UUID& id = item->getId();
+    itemSequence_.emplace(id, nextItemSequence_++);
+    itemsByName_.insert(item->getName(), id);
+    searchIndex_.add(id, item->getName(), item->getDescription());
+    if (item->getCategory()) {
+        itemsByCategory_.insert(item->getCategory()->getId(), id);
+    }
+    if (item->getCurrentContainer()) {
+        itemsByContainer_.insert(item->getCurrentContainer()->getId(), id);
+    }
+    item->setObserver(this);
+}
+
+void InventoryManager::unindexItem(const std::shared_ptr<Item>& item) {
+    const UUID& id = item->getId();
+    item->setObserver(nullptr);
+    itemsByName_.erase(item->getName(), id);
+    itemSequence_.erase(id);
+    searchIndex_.remove(id);
+    if (item->getCategory()) {
+        itemsByCategory_.erase(item->getCategory()->getId(), id);
+    }
+    if (item->getCurrentContainer()) {
+        itemsByContainer_.erase(item->getCurrentContainer()->getId(), id);
+    }
+}
+
+void InventoryManager::indexContainer(const std::shared_ptr<Container>& container) {
+    if (container->getLocation()) {
+        containersByLocation_.insert(container->getLocation()->getId(), container->getId());
     }
+    container->setObserver(this);
+}
+
+void InventoryManager::unindexContainer(const std::shared_ptr<Container>& container) {
+    container->setObserver(nullptr);
+    if (container->getLocation()) {
+        containersByLocation_.erase(container->getLocation()->getId(), container->getId());
+    }
+}
+
+void InventoryManager::rebuildIndexes() {
+    itemsByName_.clear();
+    itemSequence_.clear();
+    itemsByCategory_.clear();
+    itemsByContainer_.clear();
+    containersByLocation_.clear();
+    searchIndex_.clear();
     
-    for (const auto& project : projects_) {
-        success &= database_->saveProject(project);
+    for (const auto& item : items_.all()) {
+        indexItem(item);
     }
     
-    for (const auto& category : categories_) {
-        success &= database_->saveCategory(category);
+    for (const auto& container : containers_.all()) {
+        indexContainer(container);
+    }
+}
+
+void InventoryManager::detachObservers() {
+    for (const auto& item : items_.all()) {
+        item->setObserver(nullptr);
     }
     
-    return success;
+    for (const auto& container : containers_.all()) {
+        container->setObserver(nullptr);
+    }
 }
 
-bool InventoryManager::loadAll() {
-    items_ = database_->loadAllItems();
-    containers_ = database_->loadAllContainers();
-    locations_ = database_->loadAllLocations();
-    projects_ = database_->loadAllProjects();
-    categories_ = database_->loadAllCategories();
+std::vector<std::shared_ptr<Item>> InventoryManager::resolveItems(const SecondaryIndex<UUID>::IdSet* ids) const {
+    std::vector<std::shared_ptr<Item>> results;
+    if (!ids) {
+        return results;
+    }
     
-    return true;
+    results.reserve(ids->size());
+    for (const auto& id : *ids) {
+        if (auto item = items_.get(id)) {
+            results.push_back(item);
+        }
+    }
+    
+    return results;
+}
+
+void InventoryManager::onItemNameChanged(const Item& item, const std::string& oldName) {
+    itemsByName_.erase(oldName, item.getId());
+    itemsByName_.insert(item.getName(), item.getId());
+    searchIndex_.add(item.getId(), item.getName(), item.getDescription());
+}
+
+void InventoryManager::onItemDescriptionChanged(const Item& item, const std::string& /*oldDescription*/) {
+    searchIndex_.add(item.getId(), item.getName(), item.getDescription());
+}
+
+void InventoryManager::onItemCategoryChanged(const Item& item, const std::shared_ptr<Category>& oldCategory) {
+    if (oldCategory) {
+        itemsByCategory_.erase(oldCategory->getId(), item.getId());
+    }
+    if (item.getCategory()) {
+        itemsByCategory_.insert(item.getCategory()->getId(), item.getId());
+    }
+}
+
+void InventoryManager::onItemContainerChanged(const Item& item, const std::shared_ptr<Container>& oldContainer) {
+    if (oldContainer) {
+        itemsByContainer_.erase(oldContainer->getId(), item.getId());
+    }
+    if (item.getCurrentContainer()) {
+        itemsByContainer_.insert(item.getCurrentContainer()->getId(), item.getId());
+    }
+}
+
+void InventoryManager::onContainerLocationChanged(const Container& container,
+                                                  const std::shared_ptr<Location>& oldLocation) {
+    if (oldLocation) {
+        containersByLocation_.erase(oldLocation->getId(), container.getId());
+    }
+    if (container.getLocation()) {
+        containersByLocation_.insert(container.getLocation()->getId(), container.getId());
+    }
 }
@@ -1,6 +1,7 @@
 #include "Item.h"
 #include "Container.h"
 #include "ActivityLog.h"
+#include "EntityObserver.h"
 
 Item::Item(const std::string& name,
            std::shared_ptr<Category> category,
@@ -13,7 +14,8 @@ Item::Item(const std::string& name,
       quantity_(quantity),
       currentContainer_(nullptr),
       checkedOut_(false),
-      lastCheckOutTime_(std::chrono::system_clock::now()) {
+      lastCheckOutTime_(std::chrono::system_clock::now()),
+      observer_(nullptr) {
 }
 
 Item::Item(const UUID& id,
@@ -28,7 +30,8 @@ Item::Item(const UUID& id,
       quantity_(quantity),
       currentContainer_(nullptr),
       checkedOut_(false),
-      lastCheckOutTime_(std::chrono::system_clock::now()) {
+      lastCheckOutTime_(std::chrono::system_clock::now()),
+      observer_(nullptr) {
 }
 
 UUID Item::getId() const {
@@ -56,20 +59,36 @@ std::shared_ptr<Container> Item::getCurrentContainer() const {
 }
 
 void Item::setName(const std::string& name) {
+    touch();
+    std::string oldName = std::move(name_);
     name_ = name;
+    if (observer_) {
+        observer_->onItemNameChanged(*this, oldName);
+    }
 }
 
 void Item::setDescription(const std::string& description) {
+    touch();
+    std::string oldDescription = std::move(description_);
     description_ = description;
+    if (observer_) {
+        observer_->onItemDescriptionChanged(*this, oldDescription);
+    }
 }
 
 void Item::setCategory(std::shared_ptr<Category> category) {
+    touch();
+    std::shared_ptr<Category> oldCategory = std::move(category_);
     category_ = category;
+    if (observer_) {
+        observer_->onItemCategoryChanged(*this, oldCategory);
+    }
 }
 
 void Item::setQuantity(int quantity) {
     if (quantity >= 0) {
         quantity_ = quantity;
+        touch();
     }
 }
 
@@ -78,22 +97,33 @@ void Item::adjustQuantity(int delta) {
     if (quantity_ < 0) {
         quantity_ = 0;
     }
+    touch();
 }
 
 void Item::setContainer(std::shared_ptr<Container> container) {
+    touch();
+    std::shared_ptr<Container> oldContainer = std::move(currentContainer_);
     currentContainer_ = container;
+    if (observer_) {
+        observer_->onItemContainerChanged(*this, oldContainer);
+    }
 }
 
 void Item::addActivity(std::shared_ptr<ActivityLog> activity) {
     if (activity) {
         activityHistory_.push_back(activity);
+        touch();
     }
 }
 
-std::vector<std::shared_ptr<ActivityLog>> Item::getActivityHistory() const {
+const std::vector<std::shared_ptr<ActivityLog>>& Item::getActivityHistory() const {
     return activityHistory_;
 }
 
+size_t Item::activityCount() const {
+    return activityHistory_.size();
+}
+
 bool Item::isCheckedOut() const {
     return checkedOut_;
 }
@@ -101,3 +131,16 @@ bool Item::isCheckedOut() const {
 std::chrono::system_clock::time_point Item::getLastCheckOutTime() const {
     return lastCheckOutTime_;
 }
+
+void Item::setObserver(EntityObserver* observer) {
+    observer_ = observer;
+}
+
+std::shared_ptr<Item> Item::snapshot() const {
+    auto copy = std::make_shared<Item>(id_, name_, category_, quantity_, description_);
+    static_cast<Versioned&>(*copy) = *this;
+    copy->currentContainer_ = currentContainer_;
+    copy->checkedOut_ = checkedOut_;
+    copy->lastCheckOutTime_ = lastCheckOutTime_;
+    return copy;
+}
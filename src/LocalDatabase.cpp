@@ -5,12 +5,19 @@
 #include "Project.h"
 #include "Category.h"
 #include "ActivityLog.h"
+#include "FileRecordStore.h"
+#include "LogRecordStore.h"
+#include "ThreadPool.h"
+#include "EntityRegistry.h"
+#include "Logger.h"
 #include <nlohmann/json.hpp>
 #include <filesystem>
+#include <future>
+#include <iterator>
 #include <fstream>
-#include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <unordered_set>
 
 using json = nlohmann::json;
 
@@ -35,8 +42,480 @@ std::chrono::system_clock::time_point stringToTime(const std::string& timeStr) {
     return std::chrono::system_clock::from_time_t(std::mktime(&tm));
 }
 
-LocalDatabase::LocalDatabase(const std::string& dataDirectory)
-    : dataDirectory_(dataDirectory), connected_(false) {}
+namespace {
+    const Logger logger("LocalDatabase");
+    
+    const std::vector<std::string> kRecordTypes = {
+        "items", "containers", "locations",
+        "projects", "categories",
+        "activity_logs"     // Legacy; moved into the ActivityLogStore on connect()
+    };
+    
+    // Below this many records per thread the hand-off costs more than the parse
+    constexpr size_t kMinRecordsPerShard = 64;
+    
+    // First byte of a binary record. JSON text always starts with '{' or
+    // whitespace, so untagged records are read as JSON.
+    constexpr char kCborTag = '\x01';
+    constexpr char kMessagePackTag = '\x02';
+    
+    void decodePayload(const char* data, size_t size, json& j) {
+        if (size > 0 && data[0] == kCborTag) {
+            j = json::from_cbor(data + 1, data + size);
+        } else if (size > 0 && data[0] == kMessagePackTag) {
+            j = json::from_msgpack(data + 1, data + size);
+        } else {
+            j = json::parse(data, data + size);
+        }
+    }
+    
+    UUID readId(const json& j, const char* key) {
+        auto it = j.find(key);
+        if (it == j.end() || !it->is_string()) {
+            return UUID::nil();
+        }
+        return UUID::fromString(it->get<std::string>());
+    }
+    
+    std::vector<UUID> readIds(const json& j, const char* key) {
+        std::vector<UUID> ids;
+        auto it = j.find(key);
+        if (it == j.end() || !it->is_array()) {
+            return ids;
+        }
+        ids.reserve(it->size());
+        for (const auto& value : *it) {
+            UUID id = UUID::fromString(value.get<std::string>());
+            if (!id.isNil()) {
+                ids.push_back(id);
+            }
+        }
+        return ids;
+    }
+    
+    // Phase one of a bulk load: each record becomes an entity with its
+    // persisted ID plus the IDs it refers to. Phase two links the IDs.
+    struct ItemRow {
+        std::shared_ptr<Item> entity;
+        UUID categoryId;
+        UUID containerId;
+    };
+    
+    struct ContainerRow {
+        std::shared_ptr<Container> entity;
+        UUID locationId;
+        UUID parentId;
+        std::vector<UUID> itemIds;
+        std::vector<UUID> subcontainerIds;
+    };
+    
+    struct LocationRow {
+        std::shared_ptr<Location> entity;
+        std::vector<UUID> containerIds;
+    };
+    
+    struct ProjectRow {
+        std::shared_ptr<Project> entity;
+        std::vector<UUID> containerIds;
+    };
+    
+    struct CategoryRow {
+        std::shared_ptr<Category> entity;
+        std::vector<UUID> subcategoryIds;
+    };
+    
+    // ActivityLog takes its item at construction, so it is built while linking
+    struct ActivityLogRow {
+        UUID id;
+        ActivityType type;
+        std::string description;
+        std::string userId;
+        std::chrono::system_clock::time_point timestamp;
+        int quantityChange;
+        UUID itemId;
+        UUID fromContainerId;
+        UUID toContainerId;
+        UUID projectId;
+    };
+    
+    ItemRow decodeItem(const UUID& id, const json& j) {
+        ItemRow row;
+        row.entity = std::make_shared<Item>(
+            id,
+            j["name"].get<std::string>(),
+            nullptr,
+            j["quantity"].get<int>(),
+            j["description"].get<std::string>()
+        );
+        row.categoryId = readId(j, "category_id");
+        row.containerId = readId(j, "container_id");
+        return row;
+    }
+    
+    ContainerRow decodeContainer(const UUID& id, const json& j) {
+        ContainerRow row;
+        row.entity = std::make_shared<Container>(
+            id,
+            j["name"].get<std::string>(),
+            static_cast<ContainerType>(j["type"].get<int>()),
+            j["description"].get<std::string>()
+        );
+        row.locationId = readId(j, "location_id");
+        row.parentId = readId(j, "parent_id");
+        row.itemIds = readIds(j, "item_ids");
+        row.subcontainerIds = readIds(j, "subcontainer_ids");
+        return row;
+    }
+    
+    LocationRow decodeLocation(const UUID& id, const json& j) {
+        LocationRow row;
+        row.entity = std::make_shared<Location>(
+            id,
+            j["name"].get<std::string>(),
+            j["address"].get<std::string>()
+        );
+        row.containerIds = readIds(j, "container_ids");
+        return row;
+    }
+    
+    ProjectRow decodeProject(const UUID& id, const json& j) {
+        ProjectRow row;
+        row.entity = std::make_shared<Project>(
+            id,
+            j["name"].get<std::string>(),
+            j["description"].get<std::string>()
+        );
+        row.entity->setStatus(static_cast<ProjectStatus>(j["status"].get<int>()));
+        if (j.contains("start_date")) {
+            row.entity->setStartDate(stringToTime(j["start_date"].get<std::string>()));
+        }
+        if (j.contains("end_date")) {
+            row.entity->setEndDate(stringToTime(j["end_date"].get<std::string>()));
+        }
+        row.containerIds = readIds(j, "container_ids");
+        return row;
+    }
+    
+    CategoryRow decodeCategory(const UUID& id, const json& j) {
+        CategoryRow row;
+        row.entity = std::make_shared<Category>(
+            id,
+            j["name"].get<std::string>(),
+            j["description"].get<std::string>()
+        );
+        row.subcategoryIds = readIds(j, "subcategory_ids");
+        return row;
+    }
+    
+    ActivityLogRow decodeActivityLog(const UUID& id, const json& j) {
+        ActivityLogRow row;
+        row.id = id;
+        row.type = static_cast<ActivityType>(j["type"].get<int>());
+        row.description = j["description"].get<std::string>();
+        row.userId = j["user_id"].get<std::string>();
+        row.timestamp = stringToTime(j["timestamp"].get<std::string>());
+        row.quantityChange = j.value("quantity_change", 0);
+        row.itemId = readId(j, "item_id");
+        row.fromContainerId = readId(j, "from_container_id");
+        row.toContainerId = readId(j, "to_container_id");
+        row.projectId = readId(j, "project_id");
+        return row;
+    }
+    
+    // Inverse of the decoders: references are stored as IDs
+    json encodeItem(const Item& item) {
+        json j;
+        j["id"] = item.getId().toString();
+        j["name"] = item.getName();
+        j["description"] = item.getDescription();
+        j["quantity"] = item.getQuantity();
+        j["checked_out"] = item.isCheckedOut();
+        j["last_checkout_time"] = timeToString(item.getLastCheckOutTime());
+        
+        if (item.getCategory()) {
+            j["category_id"] = item.getCategory()->getId().toString();
+        }
+        
+        if (item.getCurrentContainer()) {
+            j["container_id"] = item.getCurrentContainer()->getId().toString();
+        }
+        
+        // The activity history is not stored here: each log records its
+        // item, and loads rebuild the history from the activity store
+        return j;
+    }
+    
+    json encodeContainer(const Container& container) {
+        json j;
+        j["id"] = container.getId().toString();
+        j["name"] = container.getName();
+        j["description"] = container.getDescription();
+        j["type"] = static_cast<int>(container.getType());
+        
+        if (container.getLocation()) {
+            j["location_id"] = container.getLocation()->getId().toString();
+        }
+        
+        if (container.getParentContainer()) {
+            j["parent_id"] = container.getParentContainer()->getId().toString();
+        }
+        
+        // Save item IDs
+        json itemIds = json::array();
+        for (const auto& item : container.getAllItems()) {
+            itemIds.push_back(item->getId().toString());
+        }
+        j["item_ids"] = itemIds;
+        
+        // Save subcontainer IDs
+        json subcontainerIds = json::array();
+        for (const auto& sub : container.getAllSubcontainers()) {
+            subcontainerIds.push_back(sub->getId().toString());
+        }
+        j["subcontainer_ids"] = subcontainerIds;
+        
+        return j;
+    }
+    
+    json encodeLocation(const Location& location) {
+        json j;
+        j["id"] = location.getId().toString();
+        j["name"] = location.getName();
+        j["address"] = location.getAddress();
+        
+        // Save container IDs
+        json containerIds = json::array();
+        for (const auto& container : location.getAllContainers()) {
+            containerIds.push_back(container->getId().toString());
+        }
+        j["container_ids"] = containerIds;
+        
+        return j;
+    }
+    
+    json encodeProject(const Project& project) {
+        json j;
+        j["id"] = project.getId().toString();
+        j["name"] = project.getName();
+        j["description"] = project.getDescription();
+        j["status"] = static_cast<int>(project.getStatus());
+        j["created_date"] = timeToString(project.getCreatedDate());
+        j["start_date"] = timeToString(project.getStartDate());
+        j["end_date"] = timeToString(project.getEndDate());
+        
+        // Save container IDs
+        json containerIds = json::array();
+        for (const auto& container : project.getAllContainers()) {
+            containerIds.push_back(container->getId().toString());
+        }
+        j["container_ids"] = containerIds;
+        
+        return j;
+    }
+    
+    json encodeCategory(const Category& category) {
+        json j;
+        j["id"] = category.getId().toString();
+        j["name"] = category.getName();
+        j["description"] = category.getDescription();
+        
+        // Save subcategory IDs
+        json subcategoryIds = json::array();
+        for (const auto& sub : category.getSubcategories()) {
+            subcategoryIds.push_back(sub->getId().toString());
+        }
+        j["subcategory_ids"] = subcategoryIds;
+        
+        return j;
+    }
+    
+    json encodeActivityLog(const ActivityLog& log) {
+        json j;
+        j["id"] = log.getId().toString();
+        j["type"] = static_cast<int>(log.getType());
+        j["description"] = log.getDescription();
+        j["timestamp"] = timeToString(log.getTimestamp());
+        j["user_id"] = log.getUserId();
+        j["quantity_change"] = log.getQuantityChange();
+        
+        if (log.getItem()) {
+            j["item_id"] = log.getItem()->getId().toString();
+        }
+        
+        if (log.getFromContainer()) {
+            j["from_container_id"] = log.getFromContainer()->getId().toString();
+        }
+        
+        if (log.getToContainer()) {
+            j["to_container_id"] = log.getToContainer()->getId().toString();
+        }
+        
+        if (log.getProject()) {
+            j["project_id"] = log.getProject()->getId().toString();
+        }
+        
+        return j;
+    }
+    
+    std::vector<ActivityLogRow> decodeActivityEntries(const std::vector<ActivityLogStore::Entry>& entries,
+                                                      ThreadPool* pool) {
+        std::vector<ActivityLogRow> slots(entries.size());
+        std::vector<char> decoded(entries.size(), 0);
+        auto decodeRange = [&](size_t begin, size_t end) {
+            json j;
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    decodePayload(entries[i].payload.data(), entries[i].payload.size(), j);
+                    slots[i] = decodeActivityLog(entries[i].id, j);
+                    // The store keeps millisecond timestamps; the record only has seconds
+                    slots[i].timestamp = std::chrono::system_clock::time_point(
+                        std::chrono::milliseconds(entries[i].timestamp));
+                    decoded[i] = 1;
+                } catch (const std::exception& e) {
+                    logger.error() << "Error loading activity log " << entries[i].id.toString() << ": "
+                                   << e.what();
+                }
+            }
+        };
+        
+        if (pool) {
+            pool->parallelFor(entries.size(), decodeRange, kMinRecordsPerShard);
+        } else {
+            decodeRange(0, entries.size());
+        }
+        
+        std::vector<ActivityLogRow> rows;
+        rows.reserve(slots.size());
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (decoded[i]) {
+                rows.push_back(std::move(slots[i]));
+            }
+        }
+        return rows;
+    }
+    
+    template <typename T, typename Row>
+    std::vector<std::shared_ptr<T>> entitiesOf(const std::vector<Row>& rows) {
+        std::vector<std::shared_ptr<T>> entities;
+        entities.reserve(rows.size());
+        for (const auto& row : rows) {
+            entities.push_back(row.entity);
+        }
+        return entities;
+    }
+    
+    template <typename T, typename Row>
+    void fillTable(EntityRegistry<T>& table, const std::vector<Row>& rows) {
+        table.reserve(rows.size());
+        for (const auto& row : rows) {
+            table.add(row.entity);
+        }
+    }
+    
+    // Rows decoded by one load. A snapshot holds every record; a targeted
+    // load holds the requested rows plus the rows they refer to.
+    struct RowSet {
+        std::vector<ItemRow> items;
+        std::vector<ContainerRow> containers;
+        std::vector<LocationRow> locations;
+        std::vector<ProjectRow> projects;
+        std::vector<CategoryRow> categories;
+        std::vector<ActivityLogRow> activity;
+    };
+    
+    // Phase 2 of a load: link references through ID tables, one pass per
+    // entity type. IDs with no row in the set (entity deleted since the
+    // reference was saved, or not read by a targeted load) are dropped.
+    void linkRows(const RowSet& rows) {
+        EntityRegistry<Item> items;
+        EntityRegistry<Container> containers;
+        EntityRegistry<Location> locations;
+        EntityRegistry<Project> projects;
+        EntityRegistry<Category> categories;
+        fillTable(items, rows.items);
+        fillTable(containers, rows.containers);
+        fillTable(locations, rows.locations);
+        fillTable(projects, rows.projects);
+        fillTable(categories, rows.categories);
+        
+        for (const auto& row : rows.categories) {
+            for (const auto& subId : row.subcategoryIds) {
+                row.entity->addSubcategory(categories.get(subId));
+            }
+        }
+        
+        for (const auto& row : rows.containers) {
+            // Saved from getAllItems(), so already free of duplicates
+            std::vector<std::shared_ptr<Item>> contents;
+            contents.reserve(row.itemIds.size());
+            for (const auto& itemId : row.itemIds) {
+                if (auto item = items.get(itemId)) {
+                    contents.push_back(item);
+                }
+            }
+            row.entity->setItems(std::move(contents));
+        
+            for (const auto& subId : row.subcontainerIds) {
+                row.entity->addSubcontainer(containers.get(subId));
+            }
+            if (!row.entity->getParentContainer()) {
+                row.entity->setParentContainer(containers.get(row.parentId));
+            }
+            row.entity->setLocation(locations.get(row.locationId));
+        }
+        
+        for (const auto& row : rows.locations) {
+            for (const auto& containerId : row.containerIds) {
+                row.entity->addContainer(containers.get(containerId));
+            }
+        }
+        
+        for (const auto& row : rows.projects) {
+            for (const auto& containerId : row.containerIds) {
+                row.entity->addContainer(containers.get(containerId));
+            }
+        }
+        
+        for (const auto& row : rows.items) {
+            row.entity->setCategory(categories.get(row.categoryId));
+            if (!row.entity->getCurrentContainer()) {
+                // Not listed by its container; trust the item's own reference
+                if (auto container = containers.get(row.containerId)) {
+                    container->addItem(row.entity);
+                }
+            }
+        }
+        
+        // The activity store reads oldest first, so histories come out in order
+        for (const auto& row : rows.activity) {
+            auto item = items.get(row.itemId);
+            auto log = std::make_shared<ActivityLog>(row.id, row.type, item,
+                                                     row.description, row.userId, row.timestamp);
+            log->setFromContainer(containers.get(row.fromContainerId));
+            log->setToContainer(containers.get(row.toContainerId));
+            log->setProject(projects.get(row.projectId));
+            log->setQuantityChange(row.quantityChange);
+            if (item) {
+                item->addActivity(log);
+            }
+        }
+    }
+}
+
+LocalDatabase::LocalDatabase(const std::string& dataDirectory, StorageMode mode)
+    : dataDirectory_(dataDirectory), storageMode_(mode),
+      encoding_(mode == StorageMode::APPEND_LOG ? Encoding::COMPACT_JSON : Encoding::PRETTY_JSON),
+      readMode_(ReadMode::MEMORY_MAP), connected_(false), loadThreads_(0) {
+    if (storageMode_ == StorageMode::APPEND_LOG) {
+        store_ = std::make_unique<LogRecordStore>(dataDirectory_, kRecordTypes);
+    } else if (storageMode_ == StorageMode::SHARDED_FILES) {
+        store_ = std::make_unique<FileRecordStore>(dataDirectory_, kRecordTypes, true,
+                                                   FileRecordStore::Layout::SHARDED);
+    } else {
+        store_ = std::make_unique<FileRecordStore>(dataDirectory_, kRecordTypes);
+    }
+    activityStore_ = std::make_unique<ActivityLogStore>(dataDirectory_ + "/activity");
+}
 
 LocalDatabase::~LocalDatabase() {
     disconnect();
@@ -48,34 +527,49 @@ bool LocalDatabase::connect() {
     try {
         // Create main data directory
         if (!ensureDirectoryExists(dataDirectory_)) {
-            std::cerr << "Failed to create data directory: " << dataDirectory_ << std::endl;
+            logger.error() << "Failed to create data directory: " << dataDirectory_;
             return false;
         }
         
-        // Create subdirectories for each entity type
-        std::vector<std::string> subdirs = {
-            "items", "containers", "locations", 
-            "projects", "categories", "activity_logs"
-        };
+        if (!store_->open()) {
+            logger.error() << "Failed to open storage in: " << dataDirectory_;
+            return false;
+        }
         
-        for (const auto& subdir : subdirs) {
-            std::string path = dataDirectory_ + "/" + subdir;
-            if (!ensureDirectoryExists(path)) {
-                std::cerr << "Failed to create subdirectory: " << path << std::endl;
-                return false;
-            }
+        if (!activityStore_->open() || !migrateLegacyActivityLogs()) {
+            logger.error() << "Failed to open activity logs in: " << dataDirectory_;
+            store_->close();
+            return false;
+        }
+        
+        if (loadThreads_ != 1) {
+            // The calling thread takes a shard too
+            loadPool_ = std::make_unique<ThreadPool>(loadThreads_ == 0 ? 0 : loadThreads_ - 1);
         }
         
         connected_ = true;
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error connecting to local database: " << e.what() << std::endl;
+        logger.error() << "Error connecting to local database: " << e.what();
         return false;
     }
 }
 
 bool LocalDatabase::disconnect() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.clear();
+    }
+    if (connected_) {
+        store_->close();
+        activityStore_->close();
+    }
+    loadPool_.reset();
     connected_ = false;
+    {
+        std::lock_guard<std::mutex> lock(pageIndexMutex_);
+        pageIndex_.clear();
+    }
     return true;
 }
 
@@ -88,41 +582,9 @@ bool LocalDatabase::saveItem(std::shared_ptr<Item> item) {
     if (!connected_ || !item) return false;
     
     try {
-        json j;
-        j["id"] = item->getId().toString();
-        j["name"] = item->getName();
-        j["description"] = item->getDescription();
-        j["quantity"] = item->getQuantity();
-        j["checked_out"] = item->isCheckedOut();
-        j["last_checkout_time"] = timeToString(item->getLastCheckOutTime());
-        
-        if (item->getCategory()) {
-            j["category_id"] = item->getCategory()->getId().toString();
-        }
-        
-        if (item->getCurrentContainer()) {
-            j["container_id"] = item->getCurrentContainer()->getId().toString();
-        }
-        
-        // Save activity history as array of IDs
-        json activityIds = json::array();
-        for (const auto& activity : item->getActivityHistory()) {
-            activityIds.push_back(activity->getId().toString());
-        }
-        j["activity_ids"] = activityIds;
-        
-        std::string filePath = getFilePath("items", item->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for writing: " << filePath << std::endl;
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
+        return writeRecord("items", item->getId(), encodeItem(*item));
     } catch (const std::exception& e) {
-        std::cerr << "Error saving item: " << e.what() << std::endl;
+        logger.error() << "Error saving item: " << e.what();
         return false;
     }
 }
@@ -131,32 +593,15 @@ std::shared_ptr<Item> LocalDatabase::loadItem(const UUID& id) {
     if (!connected_) return nullptr;
     
     try {
-        std::string filePath = getFilePath("items", id);
-        if (!fileExists(filePath)) {
-            return nullptr;
-        }
-        
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        json j;
+        if (!readRecord("items", id, j)) {
             return nullptr;
         }
         
-        json j;
-        file >> j;
-        file.close();
-        
-        // Create item with basic info
-        // Note: Category and Container need to be resolved by the caller
-        auto item = std::make_shared<Item>(
-            j["name"].get<std::string>(),
-            nullptr,  // Category will be set by caller
-            j["quantity"].get<int>(),
-            j["description"].get<std::string>()
-        );
-        
-        return item;
+        // References (category, container, history) are resolved by loadSnapshot()
+        return decodeItem(id, j).entity;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading item: " << e.what() << std::endl;
+        logger.error() << "Error loading item: " << e.what();
         return nullptr;
     }
 }
@@ -165,38 +610,22 @@ bool LocalDatabase::deleteItem(const UUID& id) {
     if (!connected_) return false;
     
     try {
-        std::string filePath = getFilePath("items", id);
-        return std::filesystem::remove(filePath);
+        return removeRecord("items", id);
     } catch (const std::exception& e) {
-        std::cerr << "Error deleting item: " << e.what() << std::endl;
+        logger.error() << "Error deleting item: " << e.what();
         return false;
     }
 }
 
 std::vector<std::shared_ptr<Item>> LocalDatabase::loadAllItems() {
-    std::vector<std::shared_ptr<Item>> items;
-    if (!connected_) return items;
+    if (!connected_) return {};
     
     try {
-        std::string itemsDir = dataDirectory_ + "/items";
-        if (!std::filesystem::exists(itemsDir)) {
-            return items;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(itemsDir)) {
-            if (entry.path().extension() == ".json") {
-                std::string idStr = entry.path().stem().string();
-                auto item = loadItem(UUID::fromString(idStr));
-                if (item) {
-                    items.push_back(item);
-                }
-            }
-        }
+        return readLinkedItems(listIds("items"));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading all items: " << e.what() << std::endl;
+        logger.error() << "Error loading all items: " << e.what();
+        return {};
     }
-    
-    return items;
 }
 
 // Container operations
@@ -204,45 +633,9 @@ bool LocalDatabase::saveContainer(std::shared_ptr<Container> container) {
     if (!connected_ || !container) return false;
     
     try {
-        json j;
-        j["id"] = container->getId().toString();
-        j["name"] = container->getName();
-        j["description"] = container->getDescription();
-        j["type"] = static_cast<int>(container->getType());
-        
-        if (container->getLocation()) {
-            j["location_id"] = container->getLocation()->getId().toString();
-        }
-        
-        if (container->getParentContainer()) {
-            j["parent_id"] = container->getParentContainer()->getId().toString();
-        }
-        
-        // Save item IDs
-        json itemIds = json::array();
-        for (const auto& item : container->getAllItems()) {
-            itemIds.push_back(item->getId().toString());
-        }
-        j["item_ids"] = itemIds;
-        
-        // Save subcontainer IDs
-        json subcontainerIds = json::array();
-        for (const auto& sub : container->getAllSubcontainers()) {
-            subcontainerIds.push_back(sub->getId().toString());
-        }
-        j["subcontainer_ids"] = subcontainerIds;
-        
-        std::string filePath = getFilePath("containers", container->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
+        return writeRecord("containers", container->getId(), encodeContainer(*container));
     } catch (const std::exception& e) {
-        std::cerr << "Error saving container: " << e.what() << std::endl;
+        logger.error() << "Error saving container: " << e.what();
         return false;
     }
 }
@@ -251,30 +644,14 @@ std::shared_ptr<Container> LocalDatabase::loadContainer(const UUID& id) {
     if (!connected_) return nullptr;
     
     try {
-        std::string filePath = getFilePath("containers", id);
-        if (!fileExists(filePath)) {
-            return nullptr;
-        }
-        
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        json j;
+        if (!readRecord("containers", id, j)) {
             return nullptr;
         }
         
-        json j;
-        file >> j;
-        file.close();
-        
-        auto type = static_cast<ContainerType>(j["type"].get<int>());
-        auto container = std::make_shared<Container>(
-            j["name"].get<std::string>(),
-            type,
-            j["description"].get<std::string>()
-        );
-        
-        return container;
+        return decodeContainer(id, j).entity;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading container: " << e.what() << std::endl;
+        logger.error() << "Error loading container: " << e.what();
         return nullptr;
     }
 }
@@ -283,98 +660,48 @@ bool LocalDatabase::deleteContainer(const UUID& id) {
     if (!connected_) return false;
     
     try {
-        std::string filePath = getFilePath("containers", id);
-        return std::filesystem::remove(filePath);
+        return removeRecord("containers", id);
     } catch (const std::exception& e) {
-        std::cerr << "Error deleting container: " << e.what() << std::endl;
+        logger.error() << "Error deleting container: " << e.what();
         return false;
     }
 }
 
 std::vector<std::shared_ptr<Container>> LocalDatabase::loadAllContainers() {
-    std::vector<std::shared_ptr<Container>> containers;
-    if (!connected_) return containers;
+    if (!connected_) return {};
     
     try {
-        std::string containersDir = dataDirectory_ + "/containers";
-        if (!std::filesystem::exists(containersDir)) {
-            return containers;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(containersDir)) {
-            if (entry.path().extension() == ".json") {
-                std::string idStr = entry.path().stem().string();
-                auto container = loadContainer(UUID::fromString(idStr));
-                if (container) {
-                    containers.push_back(container);
-                }
-            }
-        }
+        return readLinkedContainers(listIds("containers"));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading all containers: " << e.what() << std::endl;
+        logger.error() << "Error loading all containers: " << e.what();
+        return {};
     }
-    
-    return containers;
 }
 
 // Location operations
 bool LocalDatabase::saveLocation(std::shared_ptr<Location> location) {
     if (!connected_ || !location) return false;
     
+    try {
+        return writeRecord("locations", location->getId(), encodeLocation(*location));
+    } catch (const std::exception& e) {
+        logger.error() << "Error saving location: " << e.what();
+        return false;
+    }
+}
+
+std::shared_ptr<Location> LocalDatabase::loadLocation(const UUID& id) {
+    if (!connected_) return nullptr;
+    
     try {
         json j;
-        j["id"] = location->getId().toString();
-        j["name"] = location->getName();
-        j["address"] = location->getAddress();
-        
-        // Save container IDs
-        json containerIds = json::array();
-        for (const auto& container : location->getAllContainers()) {
-            containerIds.push_back(container->getId().toString());
-        }
-        j["container_ids"] = containerIds;
-        
-        std::string filePath = getFilePath("locations", location->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
-    } catch (const std::exception& e) {
-        std::cerr << "Error saving location: " << e.what() << std::endl;
-        return false;
-    }
-}
-
-std::shared_ptr<Location> LocalDatabase::loadLocation(const UUID& id) {
-    if (!connected_) return nullptr;
-    
-    try {
-        std::string filePath = getFilePath("locations", id);
-        if (!fileExists(filePath)) {
-            return nullptr;
-        }
-        
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        if (!readRecord("locations", id, j)) {
             return nullptr;
         }
         
-        json j;
-        file >> j;
-        file.close();
-        
-        auto location = std::make_shared<Location>(
-            j["name"].get<std::string>(),
-            j["address"].get<std::string>()
-        );
-        
-        return location;
+        return decodeLocation(id, j).entity;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading location: " << e.what() << std::endl;
+        logger.error() << "Error loading location: " << e.what();
         return nullptr;
     }
 }
@@ -383,38 +710,22 @@ bool LocalDatabase::deleteLocation(const UUID& id) {
     if (!connected_) return false;
     
     try {
-        std::string filePath = getFilePath("locations", id);
-        return std::filesystem::remove(filePath);
+        return removeRecord("locations", id);
     } catch (const std::exception& e) {
-        std::cerr << "Error deleting location: " << e.what() << std::endl;
+        logger.error() << "Error deleting location: " << e.what();
         return false;
     }
 }
 
 std::vector<std::shared_ptr<Location>> LocalDatabase::loadAllLocations() {
-    std::vector<std::shared_ptr<Location>> locations;
-    if (!connected_) return locations;
+    if (!connected_) return {};
     
     try {
-        std::string locationsDir = dataDirectory_ + "/locations";
-        if (!std::filesystem::exists(locationsDir)) {
-            return locations;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(locationsDir)) {
-            if (entry.path().extension() == ".json") {
-                std::string idStr = entry.path().stem().string();
-                auto location = loadLocation(UUID::fromString(idStr));
-                if (location) {
-                    locations.push_back(location);
-                }
-            }
-        }
+        return readLinkedLocations(listIds("locations"));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading all locations: " << e.what() << std::endl;
+        logger.error() << "Error loading all locations: " << e.what();
+        return {};
     }
-    
-    return locations;
 }
 
 // Project operations
@@ -422,33 +733,9 @@ bool LocalDatabase::saveProject(std::shared_ptr<Project> project) {
     if (!connected_ || !project) return false;
     
     try {
-        json j;
-        j["id"] = project->getId().toString();
-        j["name"] = project->getName();
-        j["description"] = project->getDescription();
-        j["status"] = static_cast<int>(project->getStatus());
-        j["created_date"] = timeToString(project->getCreatedDate());
-        j["start_date"] = timeToString(project->getStartDate());
-        j["end_date"] = timeToString(project->getEndDate());
-        
-        // Save container IDs
-        json containerIds = json::array();
-        for (const auto& container : project->getAllContainers()) {
-            containerIds.push_back(container->getId().toString());
-        }
-        j["container_ids"] = containerIds;
-        
-        std::string filePath = getFilePath("projects", project->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
+        return writeRecord("projects", project->getId(), encodeProject(*project));
     } catch (const std::exception& e) {
-        std::cerr << "Error saving project: " << e.what() << std::endl;
+        logger.error() << "Error saving project: " << e.what();
         return false;
     }
 }
@@ -457,36 +744,14 @@ std::shared_ptr<Project> LocalDatabase::loadProject(const UUID& id) {
     if (!connected_) return nullptr;
     
     try {
-        std::string filePath = getFilePath("projects", id);
-        if (!fileExists(filePath)) {
-            return nullptr;
-        }
-        
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            return nullptr;
-        }
-        
         json j;
-        file >> j;
-        file.close();
-        
-        auto project = std::make_shared<Project>(
-            j["name"].get<std::string>(),
-            j["description"].get<std::string>()
-        );
-        
-        project->setStatus(static_cast<ProjectStatus>(j["status"].get<int>()));
-        if (j.contains("start_date")) {
-            project->setStartDate(stringToTime(j["start_date"].get<std::string>()));
-        }
-        if (j.contains("end_date")) {
-            project->setEndDate(stringToTime(j["end_date"].get<std::string>()));
+        if (!readRecord("projects", id, j)) {
+            return nullptr;
         }
         
-        return project;
+        return decodeProject(id, j).entity;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading project: " << e.what() << std::endl;
+        logger.error() << "Error loading project: " << e.what();
         return nullptr;
     }
 }
@@ -495,38 +760,22 @@ bool LocalDatabase::deleteProject(const UUID& id) {
     if (!connected_) return false;
     
     try {
-        std::string filePath = getFilePath("projects", id);
-        return std::filesystem::remove(filePath);
+        return removeRecord("projects", id);
     } catch (const std::exception& e) {
-        std::cerr << "Error deleting project: " << e.what() << std::endl;
+        logger.error() << "Error deleting project: " << e.what();
         return false;
     }
 }
 
 std::vector<std::shared_ptr<Project>> LocalDatabase::loadAllProjects() {
-    std::vector<std::shared_ptr<Project>> projects;
-    if (!connected_) return projects;
+    if (!connected_) return {};
     
     try {
-        std::string projectsDir = dataDirectory_ + "/projects";
-        if (!std::filesystem::exists(projectsDir)) {
-            return projects;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(projectsDir)) {
-            if (entry.path().extension() == ".json") {
-                std::string idStr = entry.path().stem().string();
-                auto project = loadProject(UUID::fromString(idStr));
-                if (project) {
-                    projects.push_back(project);
-                }
-            }
-        }
+        return readLinkedProjects(listIds("projects"));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading all projects: " << e.what() << std::endl;
+        logger.error() << "Error loading all projects: " << e.what();
+        return {};
     }
-    
-    return projects;
 }
 
 // Category operations
@@ -534,29 +783,9 @@ bool LocalDatabase::saveCategory(std::shared_ptr<Category> category) {
     if (!connected_ || !category) return false;
     
     try {
-        json j;
-        j["id"] = category->getId().toString();
-        j["name"] = category->getName();
-        j["description"] = category->getDescription();
-        
-        // Save subcategory IDs
-        json subcategoryIds = json::array();
-        for (const auto& sub : category->getSubcategories()) {
-            subcategoryIds.push_back(sub->getId().toString());
-        }
-        j["subcategory_ids"] = subcategoryIds;
-        
-        std::string filePath = getFilePath("categories", category->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
+        return writeRecord("categories", category->getId(), encodeCategory(*category));
     } catch (const std::exception& e) {
-        std::cerr << "Error saving category: " << e.what() << std::endl;
+        logger.error() << "Error saving category: " << e.what();
         return false;
     }
 }
@@ -565,28 +794,14 @@ std::shared_ptr<Category> LocalDatabase::loadCategory(const UUID& id) {
     if (!connected_) return nullptr;
     
     try {
-        std::string filePath = getFilePath("categories", id);
-        if (!fileExists(filePath)) {
-            return nullptr;
-        }
-        
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        json j;
+        if (!readRecord("categories", id, j)) {
             return nullptr;
         }
         
-        json j;
-        file >> j;
-        file.close();
-        
-        auto category = std::make_shared<Category>(
-            j["name"].get<std::string>(),
-            j["description"].get<std::string>()
-        );
-        
-        return category;
+        return decodeCategory(id, j).entity;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading category: " << e.what() << std::endl;
+        logger.error() << "Error loading category: " << e.what();
         return nullptr;
     }
 }
@@ -595,38 +810,22 @@ bool LocalDatabase::deleteCategory(const UUID& id) {
     if (!connected_) return false;
     
     try {
-        std::string filePath = getFilePath("categories", id);
-        return std::filesystem::remove(filePath);
+        return removeRecord("categories", id);
     } catch (const std::exception& e) {
-        std::cerr << "Error deleting category: " << e.what() << std::endl;
+        logger.error() << "Error deleting category: " << e.what();
         return false;
     }
 }
 
 std::vector<std::shared_ptr<Category>> LocalDatabase::loadAllCategories() {
-    std::vector<std::shared_ptr<Category>> categories;
-    if (!connected_) return categories;
+    if (!connected_) return {};
     
     try {
-        std::string categoriesDir = dataDirectory_ + "/categories";
-        if (!std::filesystem::exists(categoriesDir)) {
-            return categories;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(categoriesDir)) {
-            if (entry.path().extension() == ".json") {
-                std::string idStr = entry.path().stem().string();
-                auto category = loadCategory(UUID::fromString(idStr));
-                if (category) {
-                    categories.push_back(category);
-                }
-            }
-        }
+        return readLinkedCategories(listIds("categories"));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading all categories: " << e.what() << std::endl;
+        logger.error() << "Error loading all categories: " << e.what();
+        return {};
     }
-    
-    return categories;
 }
 
 // Activity log operations
@@ -634,41 +833,9 @@ bool LocalDatabase::saveActivityLog(std::shared_ptr<ActivityLog> log) {
     if (!connected_ || !log) return false;
     
     try {
-        json j;
-        j["id"] = log->getId().toString();
-        j["type"] = static_cast<int>(log->getType());
-        j["description"] = log->getDescription();
-        j["timestamp"] = timeToString(log->getTimestamp());
-        j["user_id"] = log->getUserId();
-        j["quantity_change"] = log->getQuantityChange();
-        
-        if (log->getItem()) {
-            j["item_id"] = log->getItem()->getId().toString();
-        }
-        
-        if (log->getFromContainer()) {
-            j["from_container_id"] = log->getFromContainer()->getId().toString();
-        }
-        
-        if (log->getToContainer()) {
-            j["to_container_id"] = log->getToContainer()->getId().toString();
-        }
-        
-        if (log->getProject()) {
-            j["project_id"] = log->getProject()->getId().toString();
-        }
-        
-        std::string filePath = getFilePath("activity_logs", log->getId());
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        file << j.dump(4);
-        file.close();
-        return true;
+        return appendActivityRecord(log->getId(), ActivityLogStore::toMillis(log->getTimestamp()), encodeActivityLog(*log));
     } catch (const std::exception& e) {
-        std::cerr << "Error saving activity log: " << e.what() << std::endl;
+        logger.error() << "Error saving activity log: " << e.what();
         return false;
     }
 }
@@ -678,30 +845,9 @@ std::vector<std::shared_ptr<ActivityLog>> LocalDatabase::loadActivityLogsForItem
     if (!connected_) return logs;
     
     try {
-        std::string logsDir = dataDirectory_ + "/activity_logs";
-        if (!std::filesystem::exists(logsDir)) {
-            return logs;
-        }
-        
-        for (const auto& entry : std::filesystem::directory_iterator(logsDir)) {
-            if (entry.path().extension() == ".json") {
-                std::ifstream file(entry.path());
-                if (file.is_open()) {
-                    json j;
-                    file >> j;
-                    file.close();
-                    
-                    // Check if this log is for the requested item
-                    if (j.contains("item_id") && 
-                        j["item_id"].get<std::string>() == itemId.toString()) {
-                        // Note: We'd need full reconstruction here
-                        // For now, just note this matches
-                    }
-                }
-            }
-        }
+        logs = buildActivityLogs(activityStore_->forItem(itemId));
     } catch (const std::exception& e) {
-        std::cerr << "Error loading activity logs for item: " << e.what() << std::endl;
+        logger.error() << "Error loading activity logs for item: " << e.what();
     }
     
     return logs;
@@ -711,26 +857,718 @@ std::vector<std::shared_ptr<ActivityLog>> LocalDatabase::loadRecentActivityLogs(
     std::vector<std::shared_ptr<ActivityLog>> logs;
     if (!connected_) return logs;
     
-    // This would require sorting by timestamp and limiting results
-    // Simplified implementation for now
+    if (limit <= 0) return logs;
+    
+    try {
+        logs = buildActivityLogs(activityStore_->recent(static_cast<size_t>(limit)));
+    } catch (const std::exception& e) {
+        logger.error() << "Error loading recent activity logs: " << e.what();
+    }
     
     return logs;
 }
 
+// Batch operations
+bool LocalDatabase::saveItems(const std::vector<std::shared_ptr<Item>>& items) {
+    return saveRecords("items", items, encodeItem);
+}
+
+std::vector<std::shared_ptr<Item>> LocalDatabase::loadItems(const std::vector<UUID>& ids) {
+    return readLinkedItems(ids);
+}
+
+bool LocalDatabase::deleteItems(const std::vector<UUID>& ids) {
+    return removeRecords("items", ids);
+}
+
+bool LocalDatabase::saveContainers(const std::vector<std::shared_ptr<Container>>& containers) {
+    return saveRecords("containers", containers, encodeContainer);
+}
+
+std::vector<std::shared_ptr<Container>> LocalDatabase::loadContainers(const std::vector<UUID>& ids) {
+    return readLinkedContainers(ids);
+}
+
+bool LocalDatabase::deleteContainers(const std::vector<UUID>& ids) {
+    return removeRecords("containers", ids);
+}
+
+bool LocalDatabase::saveLocations(const std::vector<std::shared_ptr<Location>>& locations) {
+    return saveRecords("locations", locations, encodeLocation);
+}
+
+std::vector<std::shared_ptr<Location>> LocalDatabase::loadLocations(const std::vector<UUID>& ids) {
+    return readLinkedLocations(ids);
+}
+
+bool LocalDatabase::deleteLocations(const std::vector<UUID>& ids) {
+    return removeRecords("locations", ids);
+}
+
+bool LocalDatabase::saveProjects(const std::vector<std::shared_ptr<Project>>& projects) {
+    return saveRecords("projects", projects, encodeProject);
+}
+
+std::vector<std::shared_ptr<Project>> LocalDatabase::loadProjects(const std::vector<UUID>& ids) {
+    return readLinkedProjects(ids);
+}
+
+bool LocalDatabase::deleteProjects(const std::vector<UUID>& ids) {
+    return removeRecords("projects", ids);
+}
+
+bool LocalDatabase::saveCategories(const std::vector<std::shared_ptr<Category>>& categories) {
+    return saveRecords("categories", categories, encodeCategory);
+}
+
+std::vector<std::shared_ptr<Category>> LocalDatabase::loadCategories(const std::vector<UUID>& ids) {
+    return readLinkedCategories(ids);
+}
+
+bool LocalDatabase::deleteCategories(const std::vector<UUID>& ids) {
+    return removeRecords("categories", ids);
+}
+
+bool LocalDatabase::saveActivityLogs(const std::vector<std::shared_ptr<ActivityLog>>& logs) {
+    if (!connected_) return false;
+    
+    bool ok = true;
+    std::vector<ActivityLogStore::Entry> entries;
+    entries.reserve(logs.size());
+    for (const auto& log : logs) {
+        if (!log) {
+            ok = false;
+            continue;
+        }
+        try {
+            entries.push_back(makeActivityEntry(log->getId(), ActivityLogStore::toMillis(log->getTimestamp()),
+                                                encodeActivityLog(*log)));
+        } catch (const std::exception& e) {
+            logger.error() << "Error saving activity log: " << e.what();
+            ok = false;
+        }
+    }
+    
+    return appendActivityEntries(std::move(entries)) && ok;
+}
+
+// Paged loads
+Page<Item> LocalDatabase::loadItemPage(const UUID& after, size_t limit) {
+    return readPage<Item>("items", after, limit, &LocalDatabase::readLinkedItems);
+}
+
+Page<Container> LocalDatabase::loadContainerPage(const UUID& after, size_t limit) {
+    return readPage<Container>("containers", after, limit, &LocalDatabase::readLinkedContainers);
+}
+
+Page<Location> LocalDatabase::loadLocationPage(const UUID& after, size_t limit) {
+    return readPage<Location>("locations", after, limit, &LocalDatabase::readLinkedLocations);
+}
+
+Page<Project> LocalDatabase::loadProjectPage(const UUID& after, size_t limit) {
+    return readPage<Project>("projects", after, limit, &LocalDatabase::readLinkedProjects);
+}
+
+Page<Category> LocalDatabase::loadCategoryPage(const UUID& after, size_t limit) {
+    return readPage<Category>("categories", after, limit, &LocalDatabase::readLinkedCategories);
+}
+
+// Transaction support
+bool LocalDatabase::beginTransaction() {
+    if (!connected_) return false;
+    
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    if (!pending_.emplace(std::this_thread::get_id(), PendingWork()).second) {
+        logger.error() << "Transaction already open on this thread";
+        return false;
+    }
+    return true;
+}
+
+bool LocalDatabase::commitTransaction() {
+    PendingWork work;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        auto it = pending_.find(std::this_thread::get_id());
+        if (it == pending_.end()) return false;
+        work = std::move(it->second);
+        pending_.erase(it);
+    }
+    if (!connected_) return false;
+    
+    try {
+        bool ok = work.writes.empty() || store_->writeBatch(work.writes);
+        updatePageIndex(work.writes, ok);
+        return (work.activity.empty() || activityStore_->append(work.activity)) && ok;
+    } catch (const std::exception& e) {
+        logger.error() << "Error committing transaction: " << e.what();
+        updatePageIndex(work.writes, false);
+        return false;
+    }
+}
+
+bool LocalDatabase::rollbackTransaction() {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    return pending_.erase(std::this_thread::get_id()) > 0;
+}
+
+// Bulk load
+bool LocalDatabase::loadSnapshot(EntitySnapshot& snapshot) {
+    if (!connected_) return false;
+    
+    // Phase 1: decode every record with its persisted ID. Entity types are
+    // independent on disk, so with a load pool they are read side by side.
+    RowSet rows;
+    if (loadPool_) {
+        auto items = std::async(std::launch::async, [this]() { return loadRows("items", decodeItem); });
+        auto containers = std::async(std::launch::async, [this]() { return loadRows("containers", decodeContainer); });
+        auto locations = std::async(std::launch::async, [this]() { return loadRows("locations", decodeLocation); });
+        auto projects = std::async(std::launch::async, [this]() { return loadRows("projects", decodeProject); });
+        auto categories = std::async(std::launch::async, [this]() { return loadRows("categories", decodeCategory); });
+        rows.activity = decodeActivityEntries(activityStore_->all(), loadPool_.get());
+        rows.items = items.get();
+        rows.containers = containers.get();
+        rows.locations = locations.get();
+        rows.projects = projects.get();
+        rows.categories = categories.get();
+    } else {
+        rows.items = loadRows("items", decodeItem);
+        rows.containers = loadRows("containers", decodeContainer);
+        rows.locations = loadRows("locations", decodeLocation);
+        rows.projects = loadRows("projects", decodeProject);
+        rows.categories = loadRows("categories", decodeCategory);
+        rows.activity = decodeActivityEntries(activityStore_->all(), nullptr);
+    }
+    
+    // Phase 2
+    linkRows(rows);
+    
+    snapshot.items = entitiesOf<Item>(rows.items);
+    snapshot.containers = entitiesOf<Container>(rows.containers);
+    snapshot.locations = entitiesOf<Location>(rows.locations);
+    snapshot.projects = entitiesOf<Project>(rows.projects);
+    snapshot.categories = entitiesOf<Category>(rows.categories);
+    return true;
+}
+
+// Targeted loads
+std::vector<std::shared_ptr<Item>> LocalDatabase::readLinkedItems(const std::vector<UUID>& ids) {
+    RowSet rows;
+    rows.items = readRows("items", ids, decodeItem);
+    
+    std::vector<UUID> categoryIds;
+    std::vector<UUID> containerIds;
+    for (const auto& row : rows.items) {
+        categoryIds.push_back(row.categoryId);
+        containerIds.push_back(row.containerId);
+    }
+    readMissing("categories", rows.categories, categoryIds, decodeCategory);
+    readMissing("containers", rows.containers, containerIds, decodeContainer);
+    
+    linkRows(rows);
+    return entitiesOf<Item>(rows.items);
+}
+
+std::vector<std::shared_ptr<Container>> LocalDatabase::readLinkedContainers(const std::vector<UUID>& ids) {
+    RowSet rows;
+    rows.containers = readRows("containers", ids, decodeContainer);
+    size_t requested = rows.containers.size();
+    
+    std::vector<UUID> locationIds;
+    std::vector<UUID> relatedIds;
+    std::vector<UUID> itemIds;
+    for (const auto& row : rows.containers) {
+        locationIds.push_back(row.locationId);
+        relatedIds.push_back(row.parentId);
+        relatedIds.insert(relatedIds.end(), row.subcontainerIds.begin(), row.subcontainerIds.end());
+        itemIds.insert(itemIds.end(), row.itemIds.begin(), row.itemIds.end());
+    }
+    readMissing("locations", rows.locations, locationIds, decodeLocation);
+    readMissing("containers", rows.containers, relatedIds, decodeContainer);
+    readMissing("items", rows.items, itemIds, decodeItem);
+    
+    linkRows(rows);
+    auto containers = entitiesOf<Container>(rows.containers);
+    containers.resize(requested);   // Drop the parents and subcontainers read for linking
+    return containers;
+}
+
+std::vector<std::shared_ptr<Location>> LocalDatabase::readLinkedLocations(const std::vector<UUID>& ids) {
+    RowSet rows;
+    rows.locations = readRows("locations", ids, decodeLocation);
+    
+    std::vector<UUID> containerIds;
+    for (const auto& row : rows.locations) {
+        containerIds.insert(containerIds.end(), row.containerIds.begin(), row.containerIds.end());
+    }
+    readMissing("containers", rows.containers, containerIds, decodeContainer);
+    
+    linkRows(rows);
+    return entitiesOf<Location>(rows.locations);
+}
+
+std::vector<std::shared_ptr<Project>> LocalDatabase::readLinkedProjects(const std::vector<UUID>& ids) {
+    RowSet rows;
+    rows.projects = readRows("projects", ids, decodeProject);
+    
+    std::vector<UUID> containerIds;
+    for (const auto& row : rows.projects) {
+        containerIds.insert(containerIds.end(), row.containerIds.begin(), row.containerIds.end());
+    }
+    readMissing("containers", rows.containers, containerIds, decodeContainer);
+    
+    // Project item counts include one level of subcontainers
+    std::vector<UUID> subcontainerIds;
+    for (const auto& row : rows.containers) {
+        subcontainerIds.insert(subcontainerIds.end(), row.subcontainerIds.begin(), row.subcontainerIds.end());
+    }
+    readMissing("containers", rows.containers, subcontainerIds, decodeContainer);
+    
+    std::vector<UUID> itemIds;
+    for (const auto& row : rows.containers) {
+        itemIds.insert(itemIds.end(), row.itemIds.begin(), row.itemIds.end());
+    }
+    readMissing("items", rows.items, itemIds, decodeItem);
+    
+    linkRows(rows);
+    return entitiesOf<Project>(rows.projects);
+}
+
+std::vector<std::shared_ptr<Category>> LocalDatabase::readLinkedCategories(const std::vector<UUID>& ids) {
+    RowSet rows;
+    rows.categories = readRows("categories", ids, decodeCategory);
+    size_t requested = rows.categories.size();
+    
+    std::vector<UUID> subcategoryIds;
+    for (const auto& row : rows.categories) {
+        subcategoryIds.insert(subcategoryIds.end(), row.subcategoryIds.begin(), row.subcategoryIds.end());
+    }
+    readMissing("categories", rows.categories, subcategoryIds, decodeCategory);
+    
+    linkRows(rows);
+    auto categories = entitiesOf<Category>(rows.categories);
+    categories.resize(requested);
+    return categories;
+}
+
+void LocalDatabase::setLoadThreads(size_t threads) {
+    loadThreads_ = threads;
+}
+
+size_t LocalDatabase::getLoadThreads() const {
+    return loadThreads_;
+}
+
+// Storage
+void LocalDatabase::setActivityPartition(ActivityLogStore::Partition partition) {
+    if (!connected_) {
+        activityStore_ = std::make_unique<ActivityLogStore>(dataDirectory_ + "/activity", partition);
+    }
+}
+
+void LocalDatabase::setEncoding(Encoding encoding) {
+    encoding_ = encoding;
+}
+
+LocalDatabase::Encoding LocalDatabase::getEncoding() const {
+    return encoding_;
+}
+
+void LocalDatabase::setReadMode(ReadMode mode) {
+    readMode_ = mode;
+}
+
+LocalDatabase::ReadMode LocalDatabase::getReadMode() const {
+    return readMode_;
+}
+
+bool LocalDatabase::migrateLayout(const std::string& dataDirectory, StorageMode mode, size_t* moved) {
+    if (mode == StorageMode::APPEND_LOG) {
+        logger.error() << "Migration to the append-only log layout is not supported";
+        return false;
+    }
+    
+    return FileRecordStore::migrate(dataDirectory, kRecordTypes,
+                                    mode == StorageMode::SHARDED_FILES ? FileRecordStore::Layout::SHARDED
+                                                                       : FileRecordStore::Layout::FLAT,
+                                    moved);
+}
+
+LocalDatabase::StorageMode LocalDatabase::getStorageMode() const {
+    return storageMode_;
+}
+
+RecordStore* LocalDatabase::getRecordStore() const {
+    return store_.get();
+}
+
+ActivityLogStore* LocalDatabase::getActivityLogStore() const {
+    return activityStore_.get();
+}
+
 // Private helper methods
 bool LocalDatabase::ensureDirectoryExists(const std::string& path) {
     try {
         return std::filesystem::create_directories(path) || std::filesystem::exists(path);
     } catch (const std::exception& e) {
-        std::cerr << "Error creating directory: " << e.what() << std::endl;
+        logger.error() << "Error creating directory: " << e.what();
         return false;
     }
 }
 
-std::string LocalDatabase::getFilePath(const std::string& type, const UUID& id) const {
-    return dataDirectory_ + "/" + type + "/" + id.toString() + ".json";
+std::string LocalDatabase::encodeRecord(const json& j) const {
+    std::string payload;
+    switch (encoding_) {
+        case Encoding::PRETTY_JSON:
+            payload = j.dump(4);
+            break;
+        case Encoding::COMPACT_JSON:
+            payload = j.dump();
+            break;
+        case Encoding::CBOR:
+            payload.push_back(kCborTag);
+            json::to_cbor(j, payload);
+            break;
+        case Encoding::MESSAGEPACK:
+            payload.push_back(kMessagePackTag);
+            json::to_msgpack(j, payload);
+            break;
+    }
+    return payload;
+}
+
+bool LocalDatabase::writeRecord(const std::string& type, const UUID& id, const json& j) {
+    if (PendingWork* work = pendingWork()) {
+        work->writes.push_back({type, id, encodeRecord(j)});
+        return true;
+    }
+    bool ok = store_->put(type, id, encodeRecord(j));
+    updatePageIndex({{type, id, std::string()}}, ok);
+    return ok;
+}
+
+bool LocalDatabase::removeRecord(const std::string& type, const UUID& id) {
+    if (PendingWork* work = pendingWork()) {
+        work->writes.push_back({type, id, std::string(), true});
+        return true;
+    }
+    bool ok = store_->remove(type, id);
+    updatePageIndex({{type, id, std::string(), true}}, ok);
+    return ok;
+}
+
+bool LocalDatabase::writeRecords(std::vector<RecordStore::Write> writes) {
+    if (PendingWork* work = pendingWork()) {
+        work->writes.insert(work->writes.end(), std::make_move_iterator(writes.begin()),
+                            std::make_move_iterator(writes.end()));
+        return true;
+    }
+    
+    bool ok = false;
+    try {
+        ok = writes.empty() || store_->writeBatch(writes);
+    } catch (const std::exception& e) {
+        logger.error() << "Error writing batch: " << e.what();
+    }
+    updatePageIndex(writes, ok);
+    return ok;
+}
+
+template <typename T>
+bool LocalDatabase::saveRecords(const std::string& type, const std::vector<std::shared_ptr<T>>& entities,
+                                json (*encode)(const T&)) {
+    if (!connected_) return false;
+    
+    // Encoding dominates for large batches; each shard fills its own slots
+    std::vector<RecordStore::Write> slots(entities.size());
+    std::vector<char> encoded(entities.size(), 0);
+    auto encodeRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!entities[i]) continue;
+            try {
+                slots[i] = {type, entities[i]->getId(), encodeRecord(encode(*entities[i]))};
+                encoded[i] = 1;
+            } catch (const std::exception& e) {
+                logger.error() << "Error saving " << type << "/" << entities[i]->getId().toString() << ": "
+                               << e.what();
+            }
+        }
+    };
+    
+    if (loadPool_) {
+        loadPool_->parallelFor(entities.size(), encodeRange, kMinRecordsPerShard);
+    } else {
+        encodeRange(0, entities.size());
+    }
+    
+    bool ok = true;
+    std::vector<RecordStore::Write> writes;
+    writes.reserve(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (encoded[i]) {
+            writes.push_back(std::move(slots[i]));
+        } else {
+            ok = false;
+        }
+    }
+    
+    return writeRecords(std::move(writes)) && ok;
 }
 
-bool LocalDatabase::fileExists(const std::string& path) const {
-    return std::filesystem::exists(path);
-}
\ No newline at end of file
+bool LocalDatabase::removeRecords(const std::string& type, const std::vector<UUID>& ids) {
+    if (!connected_) return false;
+    
+    std::vector<RecordStore::Write> writes;
+    writes.reserve(ids.size());
+    for (const auto& id : ids) {
+        writes.push_back({type, id, std::string(), true});
+    }
+    return writeRecords(std::move(writes));
+}
+
+std::vector<UUID> LocalDatabase::pageIds(const std::string& type, const UUID& after, size_t limit, UUID& next) {
+    std::lock_guard<std::mutex> lock(pageIndexMutex_);
+    auto index = pageIndex_.find(type);
+    if (index == pageIndex_.end()) {
+        // Listed under the lock, so no write can land between the listing
+        // and the index taking over
+        auto listed = listIds(type);
+        index = pageIndex_.emplace(type, std::set<UUID>(listed.begin(), listed.end())).first;
+    }
+    
+    const auto& sorted = index->second;
+    std::vector<UUID> ids;
+    auto it = sorted.upper_bound(after);
+    for (; it != sorted.end() && ids.size() < limit; ++it) {
+        ids.push_back(*it);
+    }
+    next = (it != sorted.end() && !ids.empty()) ? ids.back() : UUID::nil();
+    return ids;
+}
+
+void LocalDatabase::updatePageIndex(const std::vector<RecordStore::Write>& writes, bool applied) {
+    std::lock_guard<std::mutex> lock(pageIndexMutex_);
+    if (pageIndex_.empty()) return;
+    
+    for (const auto& write : writes) {
+        auto index = pageIndex_.find(write.type);
+        if (index == pageIndex_.end()) {
+            continue;
+        }
+        if (!applied) {
+            // Some of the writes may have landed; list again on the next page
+            pageIndex_.erase(index);
+        } else if (write.remove) {
+            index->second.erase(write.id);
+        } else {
+            index->second.insert(write.id);
+        }
+    }
+}
+
+LocalDatabase::PendingWork* LocalDatabase::pendingWork() {
+    // Only the owning thread touches its entry, and map nodes are stable
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    auto it = pending_.find(std::this_thread::get_id());
+    return it == pending_.end() ? nullptr : &it->second;
+}
+
+bool LocalDatabase::readRecord(const std::string& type, const UUID& id, json& j) {
+    if (readMode_ == ReadMode::MEMORY_MAP) {
+        return store_->read(type, id, [&j](const char* data, size_t size) { decodePayload(data, size, j); });
+    }
+    
+    std::string payload;
+    if (!store_->get(type, id, payload)) {
+        return false;
+    }
+    
+    decodePayload(payload.data(), payload.size(), j);
+    return true;
+}
+
+bool LocalDatabase::appendActivityRecord(const UUID& id, int64_t timestamp, const json& j) {
+    ActivityLogStore::Entry entry = makeActivityEntry(id, timestamp, j);
+    if (PendingWork* work = pendingWork()) {
+        work->activity.push_back(std::move(entry));
+        return true;
+    }
+    return activityStore_->append(entry);
+}
+
+bool LocalDatabase::appendActivityEntries(std::vector<ActivityLogStore::Entry> entries) {
+    if (PendingWork* work = pendingWork()) {
+        work->activity.insert(work->activity.end(), std::make_move_iterator(entries.begin()),
+                              std::make_move_iterator(entries.end()));
+        return true;
+    }
+    return entries.empty() || activityStore_->append(entries);
+}
+
+ActivityLogStore::Entry LocalDatabase::makeActivityEntry(const UUID& id, int64_t timestamp, const json& j) const {
+    ActivityLogStore::Entry entry;
+    entry.id = id;
+    entry.timestamp = timestamp;
+    entry.itemId = readId(j, "item_id");
+    entry.userId = j.value("user_id", std::string());
+    entry.payload = encodeRecord(j);
+    return entry;
+}
+
+bool LocalDatabase::migrateLegacyActivityLogs() {
+    // Earlier versions stored activity logs as ordinary "activity_logs" records
+    std::vector<UUID> ids = store_->list("activity_logs");
+    for (const auto& id : ids) {
+        json j;
+        try {
+            if (!readRecord("activity_logs", id, j)) {
+                continue;
+            }
+            int64_t timestamp = ActivityLogStore::toMillis(stringToTime(j["timestamp"].get<std::string>()));
+            if (!appendActivityRecord(id, timestamp, j)) {
+                return false;
+            }
+        } catch (const std::exception& e) {
+            logger.warn() << "Skipping unreadable activity log " << id.toString() << ": " << e.what();
+            continue;
+        }
+        store_->remove("activity_logs", id);
+    }
+    
+    if (!ids.empty()) {
+        logger.info() << "Moved " << ids.size() << " activity logs into " << dataDirectory_ << "/activity";
+    }
+    return true;
+}
+
+std::vector<std::shared_ptr<ActivityLog>> LocalDatabase::buildActivityLogs(
+    const std::vector<ActivityLogStore::Entry>& entries) {
+    std::vector<std::shared_ptr<ActivityLog>> logs;
+    logs.reserve(entries.size());
+    
+    // Each referenced item is read once per call
+    std::unordered_map<UUID, std::shared_ptr<Item>> items;
+    for (const auto& row : decodeActivityEntries(entries, nullptr)) {
+        auto item = items.find(row.itemId);
+        if (item == items.end()) {
+            item = items.emplace(row.itemId, row.itemId.isNil() ? nullptr : loadItem(row.itemId)).first;
+        }
+        
+        auto log = std::make_shared<ActivityLog>(row.id, row.type, item->second,
+                                                 row.description, row.userId, row.timestamp);
+        log->setQuantityChange(row.quantityChange);
+        logs.push_back(std::move(log));
+    }
+    
+    return logs;
+}
+
+template <typename Row>
+std::vector<Row> LocalDatabase::loadRows(const std::string& type,
+                                         Row (*decode)(const UUID&, const json&)) {
+    if (!connected_) return std::vector<Row>();
+    
+    try {
+        return readRows(type, listIds(type), decode);
+    } catch (const std::exception& e) {
+        logger.error() << "Error loading all " << type << ": " << e.what();
+        return std::vector<Row>();
+    }
+}
+
+std::vector<UUID> LocalDatabase::listIds(const std::string& type) {
+    size_t partitions = store_->partitionCount(type);
+    if (partitions <= 1 || !loadPool_) {
+        return store_->list(type);
+    }
+    
+    // Directory listing dominates for sharded layouts, so list shards side by side
+    std::vector<std::vector<UUID>> listed(partitions);
+    loadPool_->parallelFor(partitions, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            listed[p] = store_->listPartition(type, p);
+        }
+    });
+    std::vector<UUID> ids;
+    for (auto& part : listed) {
+        ids.insert(ids.end(), part.begin(), part.end());
+    }
+    return ids;
+}
+
+template <typename Row>
+std::vector<Row> LocalDatabase::readRows(const std::string& type, const std::vector<UUID>& ids,
+                                         Row (*decode)(const UUID&, const json&)) {
+    std::vector<Row> rows;
+    if (!connected_) return rows;
+    
+    // Each shard fills its own slots, so workers never touch the same element
+    std::vector<Row> slots(ids.size());
+    std::vector<char> loaded(ids.size(), 0);
+    auto loadRange = [&](size_t begin, size_t end) {
+        json j;
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                if (readRecord(type, ids[i], j)) {
+                    slots[i] = decode(ids[i], j);
+                    loaded[i] = 1;
+                }
+            } catch (const std::exception& e) {
+                logger.error() << "Error loading " << type << "/" << ids[i].toString() << ": "
+                               << e.what();
+            }
+        }
+    };
+    
+    if (loadPool_) {
+        loadPool_->parallelFor(ids.size(), loadRange, kMinRecordsPerShard);
+    } else {
+        loadRange(0, ids.size());
+    }
+    
+    rows.reserve(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (loaded[i]) {
+            rows.push_back(std::move(slots[i]));
+        }
+    }
+    return rows;
+}
+
+template <typename Row>
+void LocalDatabase::readMissing(const std::string& type, std::vector<Row>& rows, const std::vector<UUID>& ids,
+                                Row (*decode)(const UUID&, const json&)) {
+    std::unordered_set<UUID> present;
+    present.reserve(rows.size() + ids.size());
+    for (const auto& row : rows) {
+        present.insert(row.entity->getId());
+    }
+    
+    std::vector<UUID> missing;
+    for (const auto& id : ids) {
+        if (!id.isNil() && present.insert(id).second) {
+            missing.push_back(id);
+        }
+    }
+    
+    auto read = readRows(type, missing, decode);
+    rows.insert(rows.end(), std::make_move_iterator(read.begin()), std::make_move_iterator(read.end()));
+}
+
+template <typename T>
+Page<T> LocalDatabase::readPage(const std::string& type, const UUID& after, size_t limit,
+                                std::vector<std::shared_ptr<T>> (LocalDatabase::*read)(const std::vector<UUID>&)) {
+    Page<T> page;
+    try {
+        if (connected_) {
+            // The targeted reads keep ID order and skip unreadable records
+            page.entities = (this->*read)(pageIds(type, after, limit, page.next));
+            return page;
+        }
+    } catch (const std::exception& e) {
+        logger.error() << "Error loading a page of " << type << ": " << e.what();
+    }
+    page = Page<T>();
+    page.ok = false;
+    return page;
+}
@@ -6,6 +6,10 @@ Location::Location(const std::string& name, const std::string& address)
     : id_(UUID::generate()), name_(name), address_(address) {
 }
 
+Location::Location(const UUID& id, const std::string& name, const std::string& address)
+    : id_(id), name_(name), address_(address) {
+}
+
 UUID Location::getId() const {
     return id_;
 }
@@ -19,10 +23,12 @@ std::string Location::getAddress() const {
 }
 
 void Location::setName(const std::string& name) {
+    touch();
     name_ = name;
 }
 
 void Location::setAddress(const std::string& address) {
+    touch();
     address_ = address;
 }
 
@@ -36,6 +42,7 @@ void Location::addContainer(std::shared_ptr<Container> container) {
         
         if (it == containers_.end()) {
             containers_.push_back(container);
+            touch();
             container->setLocation(shared_from_this());
         }
     }
@@ -50,6 +57,7 @@ void Location::removeContainer(const UUID& containerId) {
     if (it != containers_.end()) {
         (*it)->setLocation(nullptr);
         containers_.erase(it);
+        touch();
     }
 }
 
@@ -62,6 +70,10 @@ std::shared_ptr<Container> Location::getContainer(const UUID& containerId) const
     return (it != containers_.end()) ? *it : nullptr;
 }
 
-std::vector<std::shared_ptr<Container>> Location::getAllContainers() const {
+const std::vector<std::shared_ptr<Container>>& Location::getAllContainers() const {
     return containers_;
 }
+
+size_t Location::containerCount() const {
+    return containers_.size();
+}
@@ -0,0 +1,448 @@
+#include "LogRecordStore.h"
+#include "MappedFile.h"
+#include "RecordEncoding.h"
+#include "WriteAheadLog.h"
+#include "Logger.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+    const Logger logger("LogRecordStore");
+
+    constexpr uint8_t kOpPut = 1;
+    constexpr uint8_t kOpDelete = 2;
+
+    // Header layout: length(4) op(1) high(8) low(8) crc(4)
+    void encodeHeader(char* header, uint8_t op, const UUID& id, const std::string& payload) {
+        putU32(header, static_cast<uint32_t>(payload.size()));
+        header[4] = static_cast<char>(op);
+        putU64(header + 5, id.getHigh());
+        putU64(header + 13, id.getLow());
+        uint32_t crc = crc32(0, header + 4, 17);
+        crc = crc32(crc, payload.data(), payload.size());
+        putU32(header + 21, crc);
+    }
+}
+
+LogRecordStore::LogRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types)
+    : LogRecordStore(dataDirectory, types, Options()) {}
+
+LogRecordStore::LogRecordStore(const std::string& dataDirectory, const std::vector<std::string>& types,
+                               const Options& options)
+    : dataDirectory_(dataDirectory), options_(options), open_(false) {
+    for (const auto& type : types) {
+        logs_[type].path = dataDirectory_ + "/" + type + ".log";
+    }
+}
+
+LogRecordStore::~LogRecordStore() {
+    close();
+}
+
+bool LogRecordStore::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) return true;
+
+    for (auto& entry : logs_) {
+        if (!openLog(entry.second)) {
+            logger.error() << "Failed to open log: " << entry.second.path;
+            return false;
+        }
+    }
+
+    open_ = true;
+    return true;
+}
+
+void LogRecordStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : logs_) {
+        Log& log = entry.second;
+        if (log.writer.is_open()) log.writer.close();
+        if (log.reader.is_open()) log.reader.close();
+        log.map.reset();
+        log.index.clear();
+        log.size = 0;
+        log.liveBytes = 0;
+    }
+    open_ = false;
+}
+
+bool LogRecordStore::put(const std::string& type, const UUID& id, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Log* log = findLog(type);
+    if (!open_ || !log) return false;
+
+    if (!putLocked(*log, id, payload) || !flush(*log)) {
+        return false;
+    }
+    maybeCompact(*log);
+    return true;
+}
+
+bool LogRecordStore::get(const std::string& type, const UUID& id, std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Log* log = findLog(type);
+    if (!open_ || !log) return false;
+
+    auto it = log->index.find(id);
+    if (it == log->index.end()) {
+        return false;
+    }
+
+    return readPayload(*log, it->second, payload);
+}
+
+bool LogRecordStore::remove(const std::string& type, const UUID& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Log* log = findLog(type);
+    if (!open_ || !log) return false;
+
+    if (!removeLocked(*log, id) || !flush(*log)) {
+        return false;
+    }
+    maybeCompact(*log);
+    return true;
+}
+
+bool LogRecordStore::writeBatch(const std::vector<Write>& writes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) return false;
+
+    bool ok = true;
+    std::vector<Log*> touched;
+    for (const auto& write : writes) {
+        Log* log = findLog(write.type);
+        if (!log) {
+            ok = false;
+            continue;
+        }
+        if (std::find(touched.begin(), touched.end(), log) == touched.end()) {
+            touched.push_back(log);
+        }
+        if (write.remove) {
+            removeLocked(*log, write.id);
+        } else {
+            ok &= putLocked(*log, write.id, write.payload);
+        }
+    }
+
+    // One flush per log for the whole batch
+    for (Log* log : touched) {
+        ok &= flush(*log);
+        maybeCompact(*log);
+    }
+    return ok;
+}
+
+std::vector<UUID> LogRecordStore::list(const std::string& type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<UUID> ids;
+    Log* log = findLog(type);
+    if (!open_ || !log) return ids;
+
+    std::vector<std::pair<uint64_t, UUID>> byOffset;
+    byOffset.reserve(log->index.size());
+    for (const auto& entry : log->index) {
+        byOffset.emplace_back(entry.second.offset, entry.first);
+    }
+    std::sort(byOffset.begin(), byOffset.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    ids.reserve(byOffset.size());
+    for (const auto& entry : byOffset) {
+        ids.push_back(entry.second);
+    }
+    return ids;
+}
+
+bool LogRecordStore::read(const std::string& type, const UUID& id, const RecordReader& reader) {
+    std::shared_ptr<MappedFile> map;
+    RecordLocation location;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Log* log = findLog(type);
+        if (!open_ || !log) return false;
+
+        auto it = log->index.find(id);
+        if (it == log->index.end()) {
+            return false;
+        }
+        location = it->second;
+
+        // Records appended since the last mapping need a fresh one
+        if (!log->map || location.offset + location.length > log->map->size()) {
+            auto remapped = std::make_shared<MappedFile>();
+            if (!remapped->open(log->path) || location.offset + location.length > remapped->size()) {
+                logger.error() << "Failed to map log: " << log->path;
+                return false;
+            }
+            log->map = std::move(remapped);
+        }
+        map = log->map;
+    }
+
+    // Parsing happens outside the lock so bulk loads can read in parallel
+    reader(map->data() + location.offset, location.length);
+    return true;
+}
+
+bool LogRecordStore::compact(const std::string& type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Log* log = findLog(type);
+    if (!open_ || !log) return false;
+    return compactLocked(*log);
+}
+
+uint64_t LogRecordStore::logSize(const std::string& type) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Log* log = findLog(type);
+    return log ? log->size : 0;
+}
+
+uint64_t LogRecordStore::garbageBytes(const std::string& type) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Log* log = findLog(type);
+    return log ? log->size - log->liveBytes : 0;
+}
+
+// Private helper methods
+bool LogRecordStore::openLog(Log& log) {
+    try {
+        std::filesystem::create_directories(dataDirectory_);
+    } catch (const std::exception& e) {
+        logger.error() << "Error creating directory: " << e.what();
+        return false;
+    }
+
+    // Create the file if needed so the reader can open it
+    { std::ofstream touch(log.path, std::ios::binary | std::ios::app); }
+
+    if (!scanLog(log)) {
+        return false;
+    }
+
+    log.writer.open(log.path, std::ios::binary | std::ios::app);
+    log.reader.open(log.path, std::ios::binary);
+    return log.writer.is_open() && log.reader.is_open();
+}
+
+bool LogRecordStore::scanLog(Log& log) {
+    log.index.clear();
+    log.size = 0;
+    log.liveBytes = 0;
+    log.map.reset();
+
+    auto map = std::make_shared<MappedFile>();
+    if (!map->open(log.path, MappedFile::Access::SEQUENTIAL)) {
+        return false;
+    }
+
+    const char* data = map->data();
+    uint64_t fileSize = map->size();
+    uint64_t offset = 0;
+
+    while (offset + kHeaderSize <= fileSize) {
+        const char* header = data + offset;
+        uint32_t length = getU32(header);
+        uint8_t op = static_cast<uint8_t>(header[4]);
+        if (offset + kHeaderSize + length > fileSize) {
+            break;  // Torn write: the payload never made it to disk
+        }
+
+        uint32_t crc = crc32(0, header + 4, 17);
+        crc = crc32(crc, header + kHeaderSize, length);
+        if (crc != getU32(header + 21) || (op != kOpPut && op != kOpDelete)) {
+            break;
+        }
+
+        UUID id(getU64(header + 5), getU64(header + 13));
+        auto existing = log.index.find(id);
+        if (existing != log.index.end()) {
+            log.liveBytes -= kHeaderSize + existing->second.length;
+            log.index.erase(existing);
+        }
+        if (op == kOpPut) {
+            log.index[id] = {offset + kHeaderSize, length};
+            log.liveBytes += kHeaderSize + length;
+        }
+
+        offset += kHeaderSize + length;
+    }
+
+    log.size = offset;
+
+    // Drop a torn or corrupt tail so new records append after the last good one
+    if (fileSize > offset) {
+        map.reset();
+        try {
+            logger.warn() << "Truncating damaged tail of " << log.path << " at offset " << offset;
+            std::filesystem::resize_file(log.path, offset);
+        } catch (const std::exception& e) {
+            logger.error() << "Error recovering log: " << e.what();
+            return false;
+        }
+    } else {
+        // Keep the mapping for reads; they are not front to back
+        map->advise(MappedFile::Access::NORMAL);
+        log.map = std::move(map);
+    }
+
+    return true;
+}
+
+bool LogRecordStore::putLocked(Log& log, const UUID& id, const std::string& payload) {
+    uint64_t payloadOffset = log.size + kHeaderSize;
+    if (!append(log, kOpPut, id, payload)) {
+        return false;
+    }
+
+    auto existing = log.index.find(id);
+    if (existing != log.index.end()) {
+        log.liveBytes -= kHeaderSize + existing->second.length;
+    }
+    log.index[id] = {payloadOffset, static_cast<uint32_t>(payload.size())};
+    log.liveBytes += kHeaderSize + payload.size();
+    return true;
+}
+
+bool LogRecordStore::removeLocked(Log& log, const UUID& id) {
+    auto it = log.index.find(id);
+    if (it == log.index.end()) {
+        return false;
+    }
+
+    // Tombstone; the record it supersedes becomes garbage
+    if (!append(log, kOpDelete, id, std::string())) {
+        return false;
+    }
+
+    log.liveBytes -= kHeaderSize + it->second.length;
+    log.index.erase(it);
+    return true;
+}
+
+bool LogRecordStore::flush(Log& log) {
+    log.writer.flush();
+    if (!log.writer) {
+        logger.error() << "Failed to flush log: " << log.path;
+        log.writer.clear();
+        return false;
+    }
+    return true;
+}
+
+// Buffered; the caller flushes before releasing the lock
+bool LogRecordStore::append(Log& log, uint8_t op, const UUID& id, const std::string& payload) {
+    char header[kHeaderSize];
+    encodeHeader(header, op, id, payload);
+
+    log.writer.write(header, kHeaderSize);
+    log.writer.write(payload.data(), payload.size());
+    if (!log.writer) {
+        logger.error() << "Failed to append to log: " << log.path;
+        log.writer.clear();
+        return false;
+    }
+
+    log.size += kHeaderSize + payload.size();
+    return true;
+}
+
+bool LogRecordStore::readPayload(Log& log, const RecordLocation& location, std::string& payload) {
+    log.reader.clear();
+    log.reader.seekg(static_cast<std::streamoff>(location.offset));
+    payload.resize(location.length);
+    if (location.length > 0 && !log.reader.read(&payload[0], location.length)) {
+        logger.error() << "Failed to read record from log: " << log.path;
+        return false;
+    }
+    return true;
+}
+
+bool LogRecordStore::compactLocked(Log& log) {
+    std::string tempPath = log.path + ".compact";
+    std::unordered_map<UUID, RecordLocation> newIndex;
+    uint64_t offset = 0;
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            logger.error() << "Failed to create compaction file: " << tempPath;
+            return false;
+        }
+
+        char header[kHeaderSize];
+        std::string payload;
+        for (const auto& entry : log.index) {
+            if (!readPayload(log, entry.second, payload)) {
+                return false;
+            }
+            encodeHeader(header, kOpPut, entry.first, payload);
+            out.write(header, kHeaderSize);
+            out.write(payload.data(), payload.size());
+            newIndex[entry.first] = {offset + kHeaderSize, static_cast<uint32_t>(payload.size())};
+            offset += kHeaderSize + payload.size();
+        }
+
+        out.flush();
+        if (!out) {
+            logger.error() << "Failed to write compaction file: " << tempPath;
+            return false;
+        }
+    }
+
+    // The compacted copy must be durable before it replaces the live log
+    if (!WriteAheadLog::syncPath(tempPath)) {
+        logger.error() << "Failed to sync compaction file: " << tempPath;
+        std::filesystem::remove(tempPath);
+        return false;
+    }
+
+    log.writer.close();
+    log.reader.close();
+    log.map.reset();
+
+    try {
+        std::filesystem::rename(tempPath, log.path);
+    } catch (const std::exception& e) {
+        logger.error() << "Error replacing log after compaction: " << e.what();
+        log.writer.open(log.path, std::ios::binary | std::ios::app);
+        log.reader.open(log.path, std::ios::binary);
+        return false;
+    }
+
+    // Persist the rename itself
+    std::string directory = std::filesystem::path(log.path).parent_path().string();
+    if (!WriteAheadLog::syncPath(directory.empty() ? "." : directory)) {
+        logger.error() << "Failed to sync directory after compaction: " << directory;
+    }
+
+    log.writer.open(log.path, std::ios::binary | std::ios::app);
+    log.reader.open(log.path, std::ios::binary);
+    log.index = std::move(newIndex);
+    log.size = offset;
+    log.liveBytes = offset;
+    return log.writer.is_open() && log.reader.is_open();
+}
+
+void LogRecordStore::maybeCompact(Log& log) {
+    if (log.size < options_.compactionMinBytes) {
+        return;
+    }
+
+    uint64_t garbage = log.size - log.liveBytes;
+    if (static_cast<double>(garbage) >= options_.compactionGarbageRatio * static_cast<double>(log.size)) {
+        compactLocked(log);
+    }
+}
+
+LogRecordStore::Log* LogRecordStore::findLog(const std::string& type) {
+    auto it = logs_.find(type);
+    return (it != logs_.end()) ? &it->second : nullptr;
+}
+
+const LogRecordStore::Log* LogRecordStore::findLog(const std::string& type) const {
+    auto it = logs_.find(type);
+    return (it != logs_.end()) ? &it->second : nullptr;
+}
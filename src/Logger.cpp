@@ -0,0 +1,231 @@
+#include "Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    const char* levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG: return "DEBUG";
+            case LogLevel::INFO: return "INFO ";
+            case LogLevel::WARN: return "WARN ";
+            case LogLevel::ERROR: return "ERROR";
+            default: return "";
+        }
+    }
+
+    // Marks the ring closed when its thread exits, so the writer can retire it
+    template <typename Ring>
+    struct RingHandle {
+        std::shared_ptr<Ring> ring;
+
+        ~RingHandle() {
+            if (ring) {
+                ring->closed.store(true, std::memory_order_release);
+            }
+        }
+    };
+}
+
+// Ring
+LogSink::Ring::Ring(size_t capacity) : slots(capacity), mask(capacity - 1) {}
+
+bool LogSink::Ring::push(Record&& record) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) > mask) {
+        return false;
+    }
+
+    slots[h & mask] = std::move(record);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename Fn>
+size_t LogSink::Ring::drain(Fn&& fn) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t h = head.load(std::memory_order_acquire);
+    for (size_t i = t; i != h; ++i) {
+        Record& record = slots[i & mask];
+        fn(record);
+        record.message = std::string();
+    }
+    tail.store(h, std::memory_order_release);
+    return h - t;
+}
+
+// LogSink
+LogSink& LogSink::instance() {
+    // Deliberately leaked: loggers may run during static destruction
+    static LogSink* sink = []() {
+        auto* created = new LogSink();
+        std::atexit([]() { LogSink::instance().flush(); });
+        return created;
+    }();
+    return *sink;
+}
+
+LogSink::LogSink()
+    : level_(LogLevel::INFO), dropped_(0), output_(nullptr), flushRequested_(0), flushCompleted_(0) {
+    writer_ = std::thread([this]() { run(); });
+    writer_.detach();
+}
+
+void LogSink::setLevel(LogLevel level) {
+    level_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel LogSink::getLevel() const {
+    return level_.load(std::memory_order_relaxed);
+}
+
+void LogSink::setOutput(std::ostream* out) {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    output_ = out;
+}
+
+void LogSink::write(LogLevel level, const char* component, std::string message) {
+    Ring& ring = localRing();
+    Record record;
+    record.time = std::chrono::system_clock::now();
+    record.level = level;
+    record.component = component;
+    record.message = std::move(message);
+
+    if (!ring.push(std::move(record))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Wake the writer early rather than let a busy thread fill its ring
+    size_t used = ring.head.load(std::memory_order_relaxed) - ring.tail.load(std::memory_order_relaxed);
+    if (used == kRingCapacity / 2) {
+        wake_.notify_one();
+    }
+}
+
+void LogSink::flush() {
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    uint64_t target = ++flushRequested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [&]() { return flushCompleted_ >= target; });
+}
+
+uint64_t LogSink::getDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+// Private helper methods
+LogSink::Ring& LogSink::localRing() {
+    thread_local RingHandle<Ring> handle;
+    if (!handle.ring) {
+        handle.ring = std::make_shared<Ring>(kRingCapacity);
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        rings_.push_back(handle.ring);
+    }
+    return *handle.ring;
+}
+
+void LogSink::run() {
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    while (true) {
+        wake_.wait_for(lock, kPollInterval, [this]() { return flushRequested_ > flushCompleted_; });
+        uint64_t requested = flushRequested_;
+        std::ostream* output = output_;
+
+        // Rings are drained outside writerMutex_ so flush() callers and
+        // setOutput() never wait on I/O; the output is fixed for the pass
+        lock.unlock();
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> ringsLock(ringsMutex_);
+            rings = rings_;
+        }
+
+        bool wrote = false;
+        for (const auto& ring : rings) {
+            bool closed = ring->closed.load(std::memory_order_acquire);
+            wrote |= ring->drain([&](const Record& record) { writeRecord(output, record); }) > 0;
+            if (closed) {
+                std::lock_guard<std::mutex> ringsLock(ringsMutex_);
+                rings_.erase(std::remove(rings_.begin(), rings_.end(), ring), rings_.end());
+            }
+        }
+        if (wrote) {
+            if (output) {
+                output->flush();
+            } else {
+                std::cout.flush();
+                std::cerr.flush();
+            }
+        }
+
+        lock.lock();
+        if (requested > flushCompleted_) {
+            flushCompleted_ = requested;
+            flushed_.notify_all();
+        }
+    }
+}
+
+void LogSink::writeRecord(std::ostream* output, const Record& record) {
+    std::time_t time = std::chrono::system_clock::to_time_t(record.time);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.time.time_since_epoch()).count() % 1000;
+    std::tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+
+    std::ostream& out = output ? *output : (record.level >= LogLevel::WARN ? std::cerr : std::cout);
+    out << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << millis
+        << std::setfill(' ') << ' ' << levelName(record.level) << " [" << record.component << "] "
+        << record.message << '\n';
+}
+
+// Logger
+Logger::Line::Line(const Logger& logger, LogLevel level) : logger_(logger), level_(level) {
+    if (logger.isEnabled(level)) {
+        stream_.emplace();
+    }
+}
+
+Logger::Line::~Line() {
+    if (stream_) {
+        LogSink::instance().write(level_, logger_.getComponent(), stream_->str());
+    }
+}
+
+Logger::Logger(const char* component) : component_(component) {}
+
+bool Logger::isEnabled(LogLevel level) const {
+    return LogSink::instance().isEnabled(level);
+}
+
+const char* Logger::getComponent() const {
+    return component_;
+}
+
+Logger::Line Logger::debug() const {
+    return Line(*this, LogLevel::DEBUG);
+}
+
+Logger::Line Logger::info() const {
+    return Line(*this, LogLevel::INFO);
+}
+
+Logger::Line Logger::warn() const {
+    return Line(*this, LogLevel::WARN);
+}
+
+Logger::Line Logger::error() const {
+    return Line(*this, LogLevel::ERROR);
+}
+
+Logger::Line Logger::at(LogLevel level) const {
+    return Line(*this, level);
+}
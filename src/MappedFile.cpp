@@ -0,0 +1,141 @@
+#include "MappedFile.h"
+#include "Logger.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    const Logger logger("MappedFile");
+}
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false) {
+#ifdef _WIN32
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path, Access access) {
+    close();
+
+#ifdef _WIN32
+    // FILE_SHARE_DELETE so the file can still be replaced by rename while mapped
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING,
+                              access == Access::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_ = file;
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ > 0) {
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            logger.error() << "Failed to map " << path;
+            close();
+            return false;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_) {
+            logger.error() << "Failed to map " << path;
+            close();
+            return false;
+        }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            logger.error() << "Failed to map " << path;
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const char*>(mapped);
+    }
+    // The mapping keeps the file alive on its own
+    ::close(fd);
+#endif
+
+    open_ = true;
+    if (access != Access::NORMAL) {
+        advise(access);
+    }
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+bool MappedFile::isOpen() const {
+    return open_;
+}
+
+const char* MappedFile::data() const {
+    return data_;
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
+
+void MappedFile::advise(Access access) {
+#ifndef _WIN32
+    if (data_) {
+        ::madvise(const_cast<char*>(data_), size_,
+                  access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_NORMAL);
+    }
+#else
+    (void)access;
+#endif
+}
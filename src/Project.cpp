@@ -13,6 +13,16 @@ Project::Project(const std::string& name, const std::string& description)
       endDate_(std::chrono::system_clock::now()) {
 }
 
+Project::Project(const UUID& id, const std::string& name, const std::string& description)
+    : id_(id),
+      name_(name),
+      description_(description),
+      status_(ProjectStatus::PLANNED),
+      createdDate_(std::chrono::system_clock::now()),
+      startDate_(std::chrono::system_clock::now()),
+      endDate_(std::chrono::system_clock::now()) {
+}
+
 UUID Project::getId() const {
     return id_;
 }
@@ -42,22 +52,27 @@ std::chrono::system_clock::time_point Project::getEndDate() const {
 }
 
 void Project::setName(const std::string& name) {
+    touch();
     name_ = name;
 }
 
 void Project::setDescription(const std::string& description) {
+    touch();
     description_ = description;
 }
 
 void Project::setStatus(ProjectStatus status) {
+    touch();
     status_ = status;
 }
 
 void Project::setStartDate(const std::chrono::system_clock::time_point& date) {
+    touch();
     startDate_ = date;
 }
 
 void Project::setEndDate(const std::chrono::system_clock::time_point& date) {
+    touch();
     endDate_ = date;
 }
 
@@ -71,6 +86,7 @@ void Project::addContainer(std::shared_ptr<Container> container) {
         
         if (it == containers_.end()) {
             containers_.push_back(container);
+            touch();
         }
     }
 }
@@ -83,6 +99,7 @@ void Project::removeContainer(const UUID& containerId) {
     
     if (it != containers_.end()) {
         containers_.erase(it);
+        touch();
     }
 }
 
@@ -95,21 +112,25 @@ std::shared_ptr<Container> Project::getContainer(const UUID& containerId) const
     return (it != containers_.end()) ? *it : nullptr;
 }
 
-std::vector<std::shared_ptr<Container>> Project::getAllContainers() const {
+const std::vector<std::shared_ptr<Container>>& Project::getAllContainers() const {
     return containers_;
 }
 
+size_t Project::containerCount() const {
+    return containers_.size();
+}
+
 std::vector<std::shared_ptr<Item>> Project::getAllAllocatedItems() const {
     std::vector<std::shared_ptr<Item>> allItems;
+    allItems.reserve(getTotalItemCount());
     
     for (const auto& container : containers_) {
-        auto containerItems = container->getAllItems();
+        const auto& containerItems = container->getAllItems();
         allItems.insert(allItems.end(), containerItems.begin(), containerItems.end());
         
         // Also get items from subcontainers
-        auto subcontainers = container->getAllSubcontainers();
-        for (const auto& subcontainer : subcontainers) {
-            auto subItems = subcontainer->getAllItems();
+        for (const auto& subcontainer : container->getAllSubcontainers()) {
+            const auto& subItems = subcontainer->getAllItems();
             allItems.insert(allItems.end(), subItems.begin(), subItems.end());
         }
     }
@@ -121,12 +142,11 @@ int Project::getTotalItemCount() const {
     int count = 0;
     
     for (const auto& container : containers_) {
-        count += container->getAllItems().size();
+        count += static_cast<int>(container->itemCount());
         
         // Count items in subcontainers
-        auto subcontainers = container->getAllSubcontainers();
-        for (const auto& subcontainer : subcontainers) {
-            count += subcontainer->getAllItems().size();
+        for (const auto& subcontainer : container->getAllSubcontainers()) {
+            count += static_cast<int>(subcontainer->itemCount());
         }
     }
     
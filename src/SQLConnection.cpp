@@ -0,0 +1,289 @@
+#include "SQLConnection.h"
+#include "Logger.h"
+
+#ifdef USE_SQLITE
+    #include <sqlite3.h>
+#endif
+
+namespace {
+    const Logger logger("SQLConnection");
+}
+
+// Statement
+SQLConnection::Statement::Statement(SQLConnection* connection, sqlite3_stmt* statement)
+    : connection_(connection), statement_(statement), failed_(false) {}
+
+SQLConnection::Statement::Statement(Statement&& other) noexcept
+    : connection_(other.connection_), statement_(other.statement_), failed_(other.failed_) {
+    other.connection_ = nullptr;
+    other.statement_ = nullptr;
+}
+
+SQLConnection::Statement::~Statement() {
+#ifdef USE_SQLITE
+    if (statement_) {
+        sqlite3_reset(statement_);
+        sqlite3_clear_bindings(statement_);
+    }
+#endif
+}
+
+bool SQLConnection::Statement::isValid() const {
+    return connection_ != nullptr;
+}
+
+SQLConnection::Statement& SQLConnection::Statement::bind(int index, const std::string& value) {
+#ifdef USE_SQLITE
+    if (statement_ && sqlite3_bind_text(statement_, index, value.data(), static_cast<int>(value.size()),
+                                        SQLITE_TRANSIENT) != SQLITE_OK) {
+        failed_ = true;
+    }
+#else
+    (void)index;
+    (void)value;
+#endif
+    return *this;
+}
+
+SQLConnection::Statement& SQLConnection::Statement::bind(int index, int64_t value) {
+#ifdef USE_SQLITE
+    if (statement_ && sqlite3_bind_int64(statement_, index, value) != SQLITE_OK) {
+        failed_ = true;
+    }
+#else
+    (void)index;
+    (void)value;
+#endif
+    return *this;
+}
+
+SQLConnection::Statement& SQLConnection::Statement::bind(int index, int value) {
+    return bind(index, static_cast<int64_t>(value));
+}
+
+SQLConnection::Statement& SQLConnection::Statement::bind(int index, const UUID& id) {
+    if (id.isNil()) {
+        return bindNull(index);
+    }
+    return bind(index, id.toString());
+}
+
+SQLConnection::Statement& SQLConnection::Statement::bindNull(int index) {
+#ifdef USE_SQLITE
+    if (statement_ && sqlite3_bind_null(statement_, index) != SQLITE_OK) {
+        failed_ = true;
+    }
+#else
+    (void)index;
+#endif
+    return *this;
+}
+
+bool SQLConnection::Statement::next() {
+    if (!statement_ || failed_) {
+        return false;
+    }
+
+#ifdef USE_SQLITE
+    int result = sqlite3_step(statement_);
+    if (result == SQLITE_ROW) {
+        return true;
+    }
+    if (result != SQLITE_DONE) {
+        failed_ = true;
+        connection_->reportError("Statement failed");
+    }
+#endif
+    return false;
+}
+
+bool SQLConnection::Statement::run() {
+    if (!connection_ || failed_) {
+        return false;
+    }
+    if (!statement_) {
+        return true;  // Logging connection
+    }
+
+    while (next()) {
+    }
+    return !failed_;
+}
+
+bool SQLConnection::Statement::succeeded() const {
+    return connection_ != nullptr && !failed_;
+}
+
+bool SQLConnection::Statement::isNull(int column) const {
+#ifdef USE_SQLITE
+    return !statement_ || sqlite3_column_type(statement_, column) == SQLITE_NULL;
+#else
+    (void)column;
+    return true;
+#endif
+}
+
+std::string SQLConnection::Statement::text(int column) const {
+#ifdef USE_SQLITE
+    if (statement_) {
+        const unsigned char* value = sqlite3_column_text(statement_, column);
+        if (value) {
+            return std::string(reinterpret_cast<const char*>(value),
+                               static_cast<size_t>(sqlite3_column_bytes(statement_, column)));
+        }
+    }
+#else
+    (void)column;
+#endif
+    return std::string();
+}
+
+int64_t SQLConnection::Statement::int64(int column) const {
+#ifdef USE_SQLITE
+    return statement_ ? sqlite3_column_int64(statement_, column) : 0;
+#else
+    (void)column;
+    return 0;
+#endif
+}
+
+int SQLConnection::Statement::integer(int column) const {
+    return static_cast<int>(int64(column));
+}
+
+UUID SQLConnection::Statement::uuid(int column) const {
+    if (isNull(column)) {
+        return UUID::nil();
+    }
+    return UUID::fromString(text(column));
+}
+
+// Connection
+SQLConnection::SQLConnection(Backend backend)
+    : backend_(backend), db_(nullptr), open_(false) {}
+
+SQLConnection::~SQLConnection() {
+    close();
+}
+
+bool SQLConnection::open(const std::string& target, int busyTimeoutSeconds) {
+    if (open_) {
+        return true;
+    }
+
+    if (backend_ == Backend::LOGGING) {
+        open_ = true;
+        return true;
+    }
+
+#ifdef USE_SQLITE
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(target.c_str(), &db_, flags, nullptr) != SQLITE_OK) {
+        reportError("Failed to open " + target);
+        sqlite3_close(db_);
+        db_ = nullptr;
+        return false;
+    }
+
+    sqlite3_busy_timeout(db_, busyTimeoutSeconds * 1000);
+    open_ = true;
+    return true;
+#else
+    (void)busyTimeoutSeconds;
+    logger.error() << "Cannot open " << target << ": built without SQLite support (USE_SQLITE)";
+    return false;
+#endif
+}
+
+void SQLConnection::close() {
+#ifdef USE_SQLITE
+    for (auto& entry : statements_) {
+        sqlite3_finalize(entry.second);
+    }
+    statements_.clear();
+    if (db_) {
+        sqlite3_close(db_);
+        db_ = nullptr;
+    }
+#endif
+    open_ = false;
+}
+
+bool SQLConnection::isOpen() const {
+    return open_;
+}
+
+SQLConnection::Backend SQLConnection::getBackend() const {
+    return backend_;
+}
+
+bool SQLConnection::execute(const std::string& sql) {
+    if (!open_) {
+        return false;
+    }
+
+    if (backend_ == Backend::LOGGING) {
+        logger.info() << "Executing query: " << sql.substr(0, 50) << "...";
+        return true;
+    }
+
+#ifdef USE_SQLITE
+    char* error = nullptr;
+    if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+        logger.error() << "Query failed: " << (error ? error : "unknown error");
+        sqlite3_free(error);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+SQLConnection::Statement SQLConnection::prepare(const std::string& sql) {
+    if (!open_) {
+        return Statement(nullptr, nullptr);
+    }
+
+    if (backend_ == Backend::LOGGING) {
+        logger.info() << "Executing query: " << sql.substr(0, 50) << "...";
+        return Statement(this, nullptr);
+    }
+
+#ifdef USE_SQLITE
+    auto cached = statements_.find(sql);
+    if (cached != statements_.end()) {
+        return Statement(this, cached->second);
+    }
+
+    sqlite3_stmt* statement = nullptr;
+    if (sqlite3_prepare_v3(db_, sql.c_str(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT,
+                           &statement, nullptr) != SQLITE_OK) {
+        reportError("Failed to prepare statement");
+        return Statement(nullptr, nullptr);
+    }
+
+    statements_.emplace(sql, statement);
+    return Statement(this, statement);
+#else
+    return Statement(nullptr, nullptr);
+#endif
+}
+
+std::string SQLConnection::lastError() const {
+#ifdef USE_SQLITE
+    if (db_) {
+        return sqlite3_errmsg(db_);
+    }
+#endif
+    return std::string();
+}
+
+size_t SQLConnection::cachedStatementCount() const {
+    return statements_.size();
+}
+
+// Private helper methods
+void SQLConnection::reportError(const std::string& context) const {
+    logger.error() << context << ": " << lastError();
+}
@@ -0,0 +1,193 @@
+#include "SQLConnectionPool.h"
+#include "SQLConnection.h"
+#include <algorithm>
+
+// Lease
+
+SQLConnectionPool::Lease::Lease() : connection_(nullptr), discard_(false) {}
+
+SQLConnectionPool::Lease::Lease(std::shared_ptr<SQLConnectionPool> pool, std::unique_ptr<SQLConnection> connection)
+    : pool_(std::move(pool)), owned_(std::move(connection)), connection_(owned_.get()), discard_(false) {}
+
+SQLConnectionPool::Lease::~Lease() {
+    release();
+}
+
+SQLConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::move(other.pool_)), owned_(std::move(other.owned_)),
+      connection_(other.connection_), discard_(other.discard_) {
+    other.connection_ = nullptr;
+    other.discard_ = false;
+}
+
+SQLConnectionPool::Lease& SQLConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = std::move(other.pool_);
+        owned_ = std::move(other.owned_);
+        connection_ = other.connection_;
+        discard_ = other.discard_;
+        other.connection_ = nullptr;
+        other.discard_ = false;
+    }
+    return *this;
+}
+
+SQLConnectionPool::Lease SQLConnectionPool::Lease::borrow(SQLConnection* connection) {
+    Lease lease;
+    lease.connection_ = connection;
+    return lease;
+}
+
+SQLConnectionPool::Lease::operator bool() const {
+    return connection_ != nullptr;
+}
+
+SQLConnection* SQLConnectionPool::Lease::get() const {
+    return connection_;
+}
+
+SQLConnection* SQLConnectionPool::Lease::operator->() const {
+    return connection_;
+}
+
+SQLConnection& SQLConnectionPool::Lease::operator*() const {
+    return *connection_;
+}
+
+void SQLConnectionPool::Lease::discard() {
+    discard_ = true;
+}
+
+void SQLConnectionPool::Lease::release() {
+    if (pool_ && owned_) {
+        pool_->giveBack(std::move(owned_), discard_);
+    }
+    pool_.reset();
+    owned_.reset();
+    connection_ = nullptr;
+    discard_ = false;
+}
+
+// Pool
+
+SQLConnectionPool::SQLConnectionPool(Factory factory, HealthCheck healthCheck, const Options& options)
+    : factory_(std::move(factory)), healthCheck_(std::move(healthCheck)), options_(options),
+      open_(0), closed_(false) {
+    options_.maxConnections = std::max<size_t>(options_.maxConnections, 1);
+    metrics_.maxConnections = options_.maxConnections;
+}
+
+SQLConnectionPool::SQLConnectionPool(Factory factory, HealthCheck healthCheck)
+    : SQLConnectionPool(std::move(factory), std::move(healthCheck), Options()) {}
+
+SQLConnectionPool::~SQLConnectionPool() {
+    close();
+}
+
+SQLConnectionPool::Lease SQLConnectionPool::acquire() {
+    return acquire(options_.checkoutTimeout);
+}
+
+SQLConnectionPool::Lease SQLConnectionPool::acquire(std::chrono::milliseconds timeout) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<SQLConnection> connection;
+    bool check = false;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++metrics_.waiting;
+        bool ready = available_.wait_until(lock, start + timeout, [this]() {
+            return closed_ || !idle_.empty() || open_ < options_.maxConnections;
+        });
+        --metrics_.waiting;
+
+        auto now = std::chrono::steady_clock::now();
+        uint64_t waited = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+        metrics_.totalWaitMicros += waited;
+        metrics_.maxWaitMicros = std::max(metrics_.maxWaitMicros, waited);
+
+        if (closed_) {
+            return Lease();
+        }
+        if (!ready) {
+            ++metrics_.timeouts;
+            return Lease();
+        }
+
+        if (!idle_.empty()) {
+            check = now - idle_.back().since >= options_.healthCheckAfter;
+            connection = std::move(idle_.back().connection);
+            idle_.pop_back();
+        } else {
+            // Reserve the slot; the connection is opened outside the lock
+            ++open_;
+        }
+        ++metrics_.checkouts;
+        ++metrics_.inUse;
+        metrics_.peakInUse = std::max(metrics_.peakInUse, metrics_.inUse);
+    }
+
+    if (connection && check && healthCheck_ && !healthCheck_(*connection)) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++metrics_.healthCheckFailures;
+        }
+        // The slot stays reserved for the replacement
+        connection.reset();
+    }
+
+    if (!connection) {
+        connection = factory_();
+        if (!connection) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --open_;
+                --metrics_.inUse;
+            }
+            available_.notify_one();
+            return Lease();
+        }
+    }
+
+    return Lease(shared_from_this(), std::move(connection));
+}
+
+void SQLConnectionPool::close() {
+    std::vector<IdleConnection> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        open_ -= idle_.size();
+        idle.swap(idle_);
+    }
+    available_.notify_all();
+}
+
+SQLConnectionPool::Metrics SQLConnectionPool::getMetrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metrics metrics = metrics_;
+    metrics.open = open_;
+    metrics.idle = idle_.size();
+    return metrics;
+}
+
+const SQLConnectionPool::Options& SQLConnectionPool::getOptions() const {
+    return options_;
+}
+
+// Private helper methods
+void SQLConnectionPool::giveBack(std::unique_ptr<SQLConnection> connection, bool discard) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --metrics_.inUse;
+        if (closed_ || discard || !connection->isOpen()) {
+            --open_;
+        } else {
+            idle_.push_back({std::move(connection), std::chrono::steady_clock::now()});
+        }
+    }
+    // A discarded connection is closed here, outside the lock
+    connection.reset();
+    available_.notify_one();
+}
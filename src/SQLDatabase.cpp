@@ -1,32 +1,532 @@
 #include "SQLDatabase.h"
+#include "SQLConnection.h"
 #include "Item.h"
 #include "Container.h"
 #include "Location.h"
 #include "Project.h"
 #include "Category.h"
 #include "ActivityLog.h"
-#include <iostream>
+#include "EntityRegistry.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 
-// Placeholder for actual SQL connection
-// In production, this would use libpq, MySQL Connector, or similar
-class SQLConnection {
-public:
-    bool isOpen() const { return open_; }
-    void setOpen(bool open) { open_ = open; }
+namespace {
+    const Logger logger("SQLDatabase");
+
+    // Timestamps are stored as milliseconds since the Unix epoch
+    int64_t toMillis(std::chrono::system_clock::time_point timePoint) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(timePoint.time_since_epoch()).count();
+    }
+    
+    std::chrono::system_clock::time_point fromMillis(int64_t millis) {
+        return std::chrono::system_clock::time_point(std::chrono::milliseconds(millis));
+    }
+    
+    // SQLite's default limit on bound parameters per statement
+    const size_t kMaxParameters = 32766;
+    
+    // One INSERT shape, written for any number of rows:
+    // insert + "(?, ..., ?), (?, ..., ?)" + conflict
+    struct RowInsert {
+        const char* insert;
+        int columns;
+        const char* conflict;
+    };
+    
+    using RowBinder = std::function<void(SQLConnection::Statement&, int base, size_t row)>;
+    
+    // Rows for the next statement: a full batch, or else the largest power
+    // of two that fits what is left, so only a handful of distinct
+    // statements end up in the cache
+    size_t nextChunk(size_t remaining, size_t perStatement) {
+        if (remaining >= perStatement) {
+            return perStatement;
+        }
+        size_t chunk = 1;
+        while (chunk * 2 <= remaining) chunk *= 2;
+        return chunk;
+    }
+    
+    std::string insertSql(const RowInsert& spec, size_t rows) {
+        std::string tuple = "(";
+        for (int column = 0; column < spec.columns; ++column) {
+            tuple += column == 0 ? "?" : ", ?";
+        }
+        tuple += ")";
+        
+        std::string sql = spec.insert;
+        sql.reserve(sql.size() + rows * (tuple.size() + 2) + 400);
+        for (size_t row = 0; row < rows; ++row) {
+            if (row > 0) sql += ", ";
+            sql += tuple;
+        }
+        sql += " ";
+        sql += spec.conflict;
+        return sql;
+    }
+    
+    bool insertRows(SQLConnection& connection, const RowInsert& spec, size_t count, size_t batchSize,
+                    const RowBinder& bindRow) {
+        size_t perStatement = std::max<size_t>(1, std::min(batchSize, kMaxParameters / spec.columns));
+        size_t row = 0;
+        while (row < count) {
+            size_t rows = nextChunk(count - row, perStatement);
+            auto statement = connection.prepare(insertSql(spec, rows));
+            for (size_t i = 0; i < rows; ++i) {
+                bindRow(statement, static_cast<int>(i) * spec.columns, row + i);
+            }
+            if (!statement.run()) {
+                return false;
+            }
+            row += rows;
+        }
+        return true;
+    }
+    
+    // prefix + "(?, ?, ...)" with count placeholders
+    std::string idListSql(const char* prefix, size_t count) {
+        std::string sql = prefix;
+        sql.reserve(sql.size() + count * 3 + 2);
+        sql += "(";
+        for (size_t i = 0; i < count; ++i) {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        sql += ")";
+        return sql;
+    }
+    
+    // Runs prefix + "(?, ...)" over ids in chunks; fn sees each prepared chunk
+    template <typename Fn>
+    bool forIdChunks(SQLConnection& connection, const char* prefix, const std::vector<UUID>& ids,
+                     size_t batchSize, Fn fn) {
+        size_t perStatement = std::max<size_t>(1, std::min(batchSize, kMaxParameters));
+        for (size_t offset = 0; offset < ids.size();) {
+            size_t count = nextChunk(ids.size() - offset, perStatement);
+            auto statement = connection.prepare(idListSql(prefix, count));
+            for (size_t i = 0; i < count; ++i) {
+                statement.bind(static_cast<int>(i) + 1, ids[offset + i]);
+            }
+            if (!fn(statement)) {
+                return false;
+            }
+            offset += count;
+        }
+        return true;
+    }
+    
+    // Runs prefix + "(?, ...)" over ids and calls fn on every row
+    template <typename Fn>
+    bool forEachRow(SQLConnection& connection, const char* prefix, const std::vector<UUID>& ids,
+                    size_t batchSize, Fn fn) {
+        return forIdChunks(connection, prefix, ids, batchSize, [&](SQLConnection::Statement& query) {
+            while (query.next()) {
+                fn(query);
+            }
+            return query.succeeded();
+        });
+    }
+    
+    template <typename T, typename Read>
+    std::vector<std::shared_ptr<T>> selectByIds(SQLConnection& connection, const char* prefix,
+                                                const std::vector<UUID>& ids, size_t batchSize, Read read) {
+        std::vector<std::shared_ptr<T>> loaded;
+        loaded.reserve(ids.size());
+        forEachRow(connection, prefix, ids, batchSize,
+                   [&](const SQLConnection::Statement& row) { loaded.push_back(read(row)); });
+        return loaded;
+    }
+    
+    // Keyset paging: IDs are canonical lowercase text, so text order is ID
+    // order. One extra row is fetched to tell whether another page follows.
+    // A failed query gives an empty page with ok unset.
+    template <typename T, typename Read>
+    Page<T> selectPage(SQLConnection& connection, const char* sql, const UUID& after, size_t limit, Read read) {
+        Page<T> page;
+        if (limit == 0) return page;
+        
+        auto query = connection.prepare(sql);
+        query.bind(1, after.isNil() ? std::string() : after.toString());
+        query.bind(2, static_cast<int64_t>(limit + 1));
+        while (query.next()) {
+            if (page.entities.size() == limit) {
+                page.next = page.entities.back()->getId();
+                break;
+            }
+            page.entities.push_back(read(query));
+        }
+        if (!query.succeeded()) {
+            page = Page<T>();
+            page.ok = false;
+        }
+        return page;
+    }
+    
+    bool deleteByIds(SQLConnection& connection, const char* prefix, const std::vector<UUID>& ids, size_t batchSize) {
+        return forIdChunks(connection, prefix, ids, batchSize,
+                           [](SQLConnection::Statement& statement) { return statement.run(); });
+    }
+    
+    // Upserts keep created_at and any columns they do not list
+    const RowInsert kItemInsert = {
+        "INSERT INTO items (id, name, description, quantity, category_id, container_id, "
+        "checked_out, last_checkout_time) VALUES ", 8, R"(
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, description = excluded.description, quantity = excluded.quantity,
+            category_id = excluded.category_id, container_id = excluded.container_id,
+            checked_out = excluded.checked_out, last_checkout_time = excluded.last_checkout_time,
+            updated_at = CURRENT_TIMESTAMP
+    )"};
+    const char* const kSelectItem = "SELECT id, name, description, quantity FROM items WHERE id = ?1";
+    const char* const kSelectAllItems = "SELECT id, name, description, quantity, category_id, container_id FROM items";
+    const char* const kSelectItems = "SELECT id, name, description, quantity FROM items WHERE id IN ";
+    const char* const kSelectItemRefs = "SELECT id, category_id, container_id FROM items WHERE id IN ";
+    const char* const kSelectContainedItems =
+        "SELECT id, name, description, quantity, container_id FROM items WHERE container_id IN ";
+    const char* const kSelectItemPage =
+        "SELECT id, name, description, quantity FROM items WHERE id > ?1 ORDER BY id LIMIT ?2";
+    const char* const kDeleteItem = "DELETE FROM items WHERE id = ?1";
+    const char* const kDeleteItems = "DELETE FROM items WHERE id IN ";
+    
+    const RowInsert kContainerInsert = {
+        "INSERT INTO containers (id, name, description, type, location_id, parent_container_id) VALUES ", 6, R"(
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, description = excluded.description, type = excluded.type,
+            location_id = excluded.location_id, parent_container_id = excluded.parent_container_id,
+            updated_at = CURRENT_TIMESTAMP
+    )"};
+    const char* const kSelectContainer = "SELECT id, name, description, type FROM containers WHERE id = ?1";
+    const char* const kSelectAllContainers =
+        "SELECT id, name, description, type, location_id, parent_container_id FROM containers";
+    const char* const kSelectContainers = "SELECT id, name, description, type FROM containers WHERE id IN ";
+    const char* const kSelectContainerRefs =
+        "SELECT id, location_id, parent_container_id FROM containers WHERE id IN ";
+    const char* const kSelectSubcontainers =
+        "SELECT id, name, description, type, parent_container_id FROM containers WHERE parent_container_id IN ";
+    const char* const kSelectLocationContainers =
+        "SELECT id, name, description, type, location_id FROM containers WHERE location_id IN ";
+    const char* const kSelectContainerPage =
+        "SELECT id, name, description, type FROM containers WHERE id > ?1 ORDER BY id LIMIT ?2";
+    const char* const kDeleteContainer = "DELETE FROM containers WHERE id = ?1";
+    const char* const kDeleteContainers = "DELETE FROM containers WHERE id IN ";
+    
+    const RowInsert kLocationInsert = {
+        "INSERT INTO locations (id, name, address) VALUES ", 3, R"(
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, address = excluded.address, updated_at = CURRENT_TIMESTAMP
+    )"};
+    const char* const kSelectLocation = "SELECT id, name, address FROM locations WHERE id = ?1";
+    const char* const kSelectAllLocations = "SELECT id, name, address FROM locations";
+    const char* const kSelectLocations = "SELECT id, name, address FROM locations WHERE id IN ";
+    const char* const kSelectLocationPage =
+        "SELECT id, name, address FROM locations WHERE id > ?1 ORDER BY id LIMIT ?2";
+    const char* const kDeleteLocation = "DELETE FROM locations WHERE id = ?1";
+    const char* const kDeleteLocations = "DELETE FROM locations WHERE id IN ";
+    
+    const RowInsert kProjectInsert = {
+        "INSERT INTO projects (id, name, description, status, start_date, end_date) VALUES ", 6, R"(
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, description = excluded.description, status = excluded.status,
+            start_date = excluded.start_date, end_date = excluded.end_date, updated_at = CURRENT_TIMESTAMP
+    )"};
+    const char* const kSelectProject =
+        "SELECT id, name, description, status, start_date, end_date FROM projects WHERE id = ?1";
+    const char* const kSelectAllProjects = "SELECT id, name, description, status, start_date, end_date FROM projects";
+    const char* const kSelectProjects =
+        "SELECT id, name, description, status, start_date, end_date FROM projects WHERE id IN ";
+    const char* const kSelectProjectPage =
+        "SELECT id, name, description, status, start_date, end_date FROM projects WHERE id > ?1 ORDER BY id LIMIT ?2";
+    const char* const kDeleteProject = "DELETE FROM projects WHERE id = ?1";
+    const char* const kDeleteProjects = "DELETE FROM projects WHERE id IN ";
+    const char* const kDeleteProjectContainers = "DELETE FROM project_containers WHERE project_id = ?1";
+    const char* const kDeleteProjectsContainers = "DELETE FROM project_containers WHERE project_id IN ";
+    const RowInsert kProjectContainerInsert = {
+        "INSERT INTO project_containers (project_id, container_id) VALUES ", 2, "ON CONFLICT DO NOTHING"};
+    const char* const kSelectAllProjectContainers = "SELECT project_id, container_id FROM project_containers";
+    const char* const kSelectProjectContainers =
+        "SELECT project_id, container_id FROM project_containers WHERE project_id IN ";
+    
+    // parent_id is owned by the parent's save, so the upsert leaves it alone
+    const RowInsert kCategoryInsert = {
+        "INSERT INTO categories (id, name, description) VALUES ", 3, R"(
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, description = excluded.description, updated_at = CURRENT_TIMESTAMP
+    )"};
+    const char* const kClearSubcategories = "UPDATE categories SET parent_id = NULL WHERE parent_id = ?1";
+    const char* const kSetCategoryParent = "UPDATE categories SET parent_id = ?1 WHERE id = ?2";
+    const char* const kSelectCategory = "SELECT id, name, description FROM categories WHERE id = ?1";
+    const char* const kSelectAllCategories = "SELECT id, name, description, parent_id FROM categories";
+    const char* const kSelectCategories = "SELECT id, name, description FROM categories WHERE id IN ";
+    const char* const kSelectSubcategories =
+        "SELECT id, name, description, parent_id FROM categories WHERE parent_id IN ";
+    const char* const kSelectCategoryPage =
+        "SELECT id, name, description FROM categories WHERE id > ?1 ORDER BY id LIMIT ?2";
+    const char* const kDeleteCategory = "DELETE FROM categories WHERE id = ?1";
+    const char* const kDeleteCategories = "DELETE FROM categories WHERE id IN ";
+    
+    // Activity logs are immutable
+    const RowInsert kActivityLogInsert = {
+        "INSERT INTO activity_logs (id, type, description, timestamp, user_id, item_id, "
+        "from_container_id, to_container_id, project_id, quantity_change) VALUES ", 10,
+        "ON CONFLICT(id) DO NOTHING"};
+    const char* const kActivityLogColumns =
+        "SELECT id, type, description, timestamp, user_id, item_id, from_container_id, to_container_id, "
+        "project_id, quantity_change FROM activity_logs";
+    
+    void bindItem(SQLConnection::Statement& statement, int base, const Item& item) {
+        statement.bind(base + 1, item.getId())
+                 .bind(base + 2, item.getName())
+                 .bind(base + 3, item.getDescription())
+                 .bind(base + 4, item.getQuantity())
+                 .bind(base + 5, item.getCategory() ? item.getCategory()->getId() : UUID::nil())
+                 .bind(base + 6, item.getCurrentContainer() ? item.getCurrentContainer()->getId() : UUID::nil())
+                 .bind(base + 7, item.isCheckedOut() ? 1 : 0)
+                 .bind(base + 8, toMillis(item.getLastCheckOutTime()));
+    }
+    
+    void bindContainer(SQLConnection::Statement& statement, int base, const Container& container) {
+        statement.bind(base + 1, container.getId())
+                 .bind(base + 2, container.getName())
+                 .bind(base + 3, container.getDescription())
+                 .bind(base + 4, static_cast<int>(container.getType()))
+                 .bind(base + 5, container.getLocation() ? container.getLocation()->getId() : UUID::nil())
+                 .bind(base + 6, container.getParentContainer() ? container.getParentContainer()->getId() : UUID::nil());
+    }
+    
+    void bindLocation(SQLConnection::Statement& statement, int base, const Location& location) {
+        statement.bind(base + 1, location.getId())
+                 .bind(base + 2, location.getName())
+                 .bind(base + 3, location.getAddress());
+    }
+    
+    void bindProject(SQLConnection::Statement& statement, int base, const Project& project) {
+        statement.bind(base + 1, project.getId())
+                 .bind(base + 2, project.getName())
+                 .bind(base + 3, project.getDescription())
+                 .bind(base + 4, static_cast<int>(project.getStatus()))
+                 .bind(base + 5, toMillis(project.getStartDate()))
+                 .bind(base + 6, toMillis(project.getEndDate()));
+    }
+    
+    void bindCategory(SQLConnection::Statement& statement, int base, const Category& category) {
+        statement.bind(base + 1, category.getId())
+                 .bind(base + 2, category.getName())
+                 .bind(base + 3, category.getDescription());
+    }
+    
+    void bindActivityLog(SQLConnection::Statement& statement, int base, const ActivityLog& log) {
+        statement.bind(base + 1, log.getId())
+                 .bind(base + 2, static_cast<int>(log.getType()))
+                 .bind(base + 3, log.getDescription())
+                 .bind(base + 4, toMillis(log.getTimestamp()))
+                 .bind(base + 5, log.getUserId())
+                 .bind(base + 6, log.getItem() ? log.getItem()->getId() : UUID::nil())
+                 .bind(base + 7, log.getFromContainer() ? log.getFromContainer()->getId() : UUID::nil())
+                 .bind(base + 8, log.getToContainer() ? log.getToContainer()->getId() : UUID::nil())
+                 .bind(base + 9, log.getProject() ? log.getProject()->getId() : UUID::nil())
+                 .bind(base + 10, log.getQuantityChange());
+    }
+    
+    // Readers for the single-record SELECTs (no references)
+    std::shared_ptr<Item> readItem(const SQLConnection::Statement& row) {
+        return std::make_shared<Item>(row.uuid(0), row.text(1), nullptr, row.integer(3), row.text(2));
+    }
+    
+    std::shared_ptr<Container> readContainer(const SQLConnection::Statement& row) {
+        return std::make_shared<Container>(row.uuid(0), row.text(1),
+                                           static_cast<ContainerType>(row.integer(3)), row.text(2));
+    }
+    
+    std::shared_ptr<Location> readLocation(const SQLConnection::Statement& row) {
+        return std::make_shared<Location>(row.uuid(0), row.text(1), row.text(2));
+    }
+    
+    std::shared_ptr<Project> readProject(const SQLConnection::Statement& row) {
+        auto project = std::make_shared<Project>(row.uuid(0), row.text(1), row.text(2));
+        project->setStatus(static_cast<ProjectStatus>(row.integer(3)));
+        project->setStartDate(fromMillis(row.int64(4)));
+        project->setEndDate(fromMillis(row.int64(5)));
+        return project;
+    }
+    
+    std::shared_ptr<Category> readCategory(const SQLConnection::Statement& row) {
+        return std::make_shared<Category>(row.uuid(0), row.text(1), row.text(2));
+    }
+    
+    template <typename T>
+    std::vector<UUID> idsOf(const std::vector<std::shared_ptr<T>>& entities) {
+        std::vector<UUID> ids;
+        ids.reserve(entities.size());
+        for (const auto& entity : entities) {
+            ids.push_back(entity->getId());
+        }
+        return ids;
+    }
+    
+    template <typename T>
+    std::unordered_map<UUID, std::shared_ptr<T>> byId(const std::vector<std::shared_ptr<T>>& entities) {
+        std::unordered_map<UUID, std::shared_ptr<T>> table;
+        table.reserve(entities.size());
+        for (const auto& entity : entities) {
+            table.emplace(entity->getId(), entity);
+        }
+        return table;
+    }
+    
+    template <typename T>
+    std::shared_ptr<T> lookup(const std::unordered_map<UUID, std::shared_ptr<T>>& table, const UUID& id) {
+        auto it = table.find(id);
+        return it != table.end() ? it->second : nullptr;
+    }
+    
+    // Drops nil IDs and duplicates
+    std::vector<UUID> distinctIds(std::vector<UUID> ids) {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        ids.erase(std::remove(ids.begin(), ids.end(), UUID::nil()), ids.end());
+        return ids;
+    }
+    
+    // Batch loads link one level of references, read with IN-lists over the
+    // loaded IDs, so callers can show the names and counts behind them.
+    // Entities already in the batch are reused; dangling IDs are dropped.
+    void linkItems(SQLConnection& connection, const std::vector<std::shared_ptr<Item>>& items, size_t batchSize) {
+        auto loaded = byId(items);
+        std::vector<std::tuple<std::shared_ptr<Item>, UUID, UUID>> links;
+        std::vector<UUID> categoryIds;
+        std::vector<UUID> containerIds;
+        forEachRow(connection, kSelectItemRefs, idsOf(items), batchSize, [&](const SQLConnection::Statement& row) {
+            links.emplace_back(lookup(loaded, row.uuid(0)), row.uuid(1), row.uuid(2));
+            categoryIds.push_back(row.uuid(1));
+            containerIds.push_back(row.uuid(2));
+        });
+        
+        auto categories = byId(selectByIds<Category>(connection, kSelectCategories, distinctIds(categoryIds),
+                                                     batchSize, readCategory));
+        auto containers = byId(selectByIds<Container>(connection, kSelectContainers, distinctIds(containerIds),
+                                                      batchSize, readContainer));
+        for (const auto& link : links) {
+            const auto& item = std::get<0>(link);
+            item->setCategory(lookup(categories, std::get<1>(link)));
+            if (auto container = lookup(containers, std::get<2>(link))) {
+                container->addItem(item);
+            }
+        }
+    }
+    
+    // Adds each container's subcontainers and items, and with
+    // subcontainerItems the subcontainers' items as well
+    void linkContents(SQLConnection& connection, const std::unordered_map<UUID, std::shared_ptr<Container>>& containers,
+                      size_t batchSize, bool subcontainerItems) {
+        std::vector<UUID> ids;
+        ids.reserve(containers.size());
+        for (const auto& entry : containers) {
+            ids.push_back(entry.first);
+        }
+        
+        auto holders = containers;
+        std::vector<UUID> holderIds = ids;
+        forEachRow(connection, kSelectSubcontainers, ids, batchSize, [&](const SQLConnection::Statement& row) {
+            auto subcontainer = lookup(containers, row.uuid(0));
+            if (!subcontainer) {
+                subcontainer = readContainer(row);
+                if (subcontainerItems) {
+                    holders.emplace(subcontainer->getId(), subcontainer);
+                    holderIds.push_back(subcontainer->getId());
+                }
+            }
+            lookup(containers, row.uuid(4))->addSubcontainer(subcontainer);
+        });
+        forEachRow(connection, kSelectContainedItems, holderIds, batchSize, [&](const SQLConnection::Statement& row) {
+            lookup(holders, row.uuid(4))->addItem(readItem(row));
+        });
+    }
+    
+    void linkContainers(SQLConnection& connection, const std::vector<std::shared_ptr<Container>>& containers,
+                        size_t batchSize) {
+        auto loaded = byId(containers);
+        std::vector<std::tuple<std::shared_ptr<Container>, UUID, UUID>> links;
+        std::vector<UUID> locationIds;
+        std::vector<UUID> parentIds;
+        forEachRow(connection, kSelectContainerRefs, idsOf(containers), batchSize,
+                   [&](const SQLConnection::Statement& row) {
+                       links.emplace_back(lookup(loaded, row.uuid(0)), row.uuid(1), row.uuid(2));
+                       locationIds.push_back(row.uuid(1));
+                       if (!loaded.count(row.uuid(2))) {
+                           parentIds.push_back(row.uuid(2));
+                       }
+                   });
+        
+        linkContents(connection, loaded, batchSize, false);
+        
+        auto locations = byId(selectByIds<Location>(connection, kSelectLocations, distinctIds(locationIds),
+                                                    batchSize, readLocation));
+        auto parents = byId(selectByIds<Container>(connection, kSelectContainers, distinctIds(parentIds),
+                                                   batchSize, readContainer));
+        for (const auto& link : links) {
+            const auto& container = std::get<0>(link);
+            if (auto location = lookup(locations, std::get<1>(link))) {
+                location->addContainer(container);
+            }
+            auto parent = lookup(parents, std::get<2>(link));
+            if (!parent) {
+                parent = lookup(loaded, std::get<2>(link));
+            }
+            if (parent) {
+                parent->addSubcontainer(container);
+            }
+        }
+    }
     
-private:
-    bool open_ = false;
-};
+    void linkLocations(SQLConnection& connection, const std::vector<std::shared_ptr<Location>>& locations,
+                       size_t batchSize) {
+        auto loaded = byId(locations);
+        forEachRow(connection, kSelectLocationContainers, idsOf(locations), batchSize,
+                   [&](const SQLConnection::Statement& row) {
+                       lookup(loaded, row.uuid(4))->addContainer(readContainer(row));
+                   });
+    }
+    
+    void linkProjects(SQLConnection& connection, const std::vector<std::shared_ptr<Project>>& projects,
+                      size_t batchSize) {
+        auto loaded = byId(projects);
+        std::vector<std::pair<UUID, UUID>> links;
+        std::vector<UUID> containerIds;
+        forEachRow(connection, kSelectProjectContainers, idsOf(projects), batchSize,
+                   [&](const SQLConnection::Statement& row) {
+                       links.emplace_back(row.uuid(0), row.uuid(1));
+                       containerIds.push_back(row.uuid(1));
+                   });
+        
+        // Project item totals include one level of subcontainers
+        auto containers = byId(selectByIds<Container>(connection, kSelectContainers, distinctIds(containerIds),
+                                                      batchSize, readContainer));
+        linkContents(connection, containers, batchSize, true);
+        for (const auto& link : links) {
+            lookup(loaded, link.first)->addContainer(lookup(containers, link.second));
+        }
+    }
+    
+    void linkCategories(SQLConnection& connection, const std::vector<std::shared_ptr<Category>>& categories,
+                        size_t batchSize) {
+        auto loaded = byId(categories);
+        forEachRow(connection, kSelectSubcategories, idsOf(categories), batchSize,
+                   [&](const SQLConnection::Statement& row) {
+                       auto subcategory = lookup(loaded, row.uuid(0));
+                       lookup(loaded, row.uuid(3))->addSubcategory(subcategory ? subcategory : readCategory(row));
+                   });
+    }
+}
 
 SQLDatabase::SQLDatabase(const ConnectionConfig& config)
-    : config_(config), connection_(nullptr), connected_(false) {
-    connection_ = new SQLConnection();
-}
+    : config_(config), connected_(false) {}
 
 SQLDatabase::~SQLDatabase() {
     disconnect();
-    delete connection_;
 }
 
 bool SQLDatabase::connect() {
@@ -36,52 +536,78 @@ bool SQLDatabase::connect() {
         return true;
     }
     
-    std::cout << "Connecting to " << getSQLTypeString() << " database..." << std::endl;
-    std::cout << "Connection string: " << getConnectionString() << std::endl;
+    logger.info() << "Connecting to " << getSQLTypeString() << " database...";
+    logger.info() << "Connection string: " << getConnectionString();
     
-    // In production, establish actual database connection here
-    // Example for PostgreSQL using libpq:
-    // connection_ = PQconnectdb(getConnectionString().c_str());
-    // if (PQstatus(connection_) != CONNECTION_OK) {
-    //     std::cerr << "Connection failed: " << PQerrorMessage(connection_) << std::endl;
-    //     return false;
-    // }
+    SQLConnectionPool::Options options;
+    options.maxConnections = static_cast<size_t>(std::max(config_.maxConnections, 1));
+    options.checkoutTimeout = std::chrono::seconds(config_.connectionTimeout);
+    options.healthCheckAfter = std::chrono::seconds(config_.healthCheckInterval);
     
-    // Placeholder: simulate connection
-    connection_->setOpen(true);
-    connected_ = true;
+    // Each connection to an in-memory database would see its own empty database
+    std::string target = getConnectionString();
+    if (config_.type == SQLType::SQLITE && (target.empty() || target == ":memory:")) {
+        options.maxConnections = 1;
+    }
     
-    // Initialize schema if needed
-    if (!initializeSchema()) {
-        std::cerr << "Failed to initialize schema" << std::endl;
-        disconnect();
+    auto pool = std::make_shared<SQLConnectionPool>(
+        [this]() { return openConnection(); },
+        [](SQLConnection& connection) { return connection.execute("SELECT 1"); },
+        options);
+    
+    // The first connection creates the schema before anyone else can see the pool
+    auto connection = pool->acquire();
+    if (!connection) {
+        pool->close();
         return false;
     }
     
-    std::cout << "Successfully connected to database" << std::endl;
+    if (!initializeSchema(*connection)) {
+        logger.error() << "Failed to initialize schema";
+        connection.discard();
+        pool->close();
+        return false;
+    }
+    
+    pool_ = std::move(pool);
+    connected_ = true;
+    
+    logger.info() << "Successfully connected to database";
     return true;
 }
 
 bool SQLDatabase::disconnect() {
-    std::lock_guard<std::mutex> lock(connectionMutex_);
-    
-    if (!connected_) {
-        return true;
+    std::unordered_map<std::thread::id, SQLConnectionPool::Lease> transactions;
+    std::shared_ptr<SQLConnectionPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        
+        if (!connected_) {
+            return true;
+        }
+        
+        connected_ = false;
+        transactions.swap(transactions_);
+        pool.swap(pool_);
     }
     
-    // In production, close actual database connection here
-    // Example: PQfinish(connection_);
-    
-    connection_->setOpen(false);
-    connected_ = false;
+    // Open transactions are rolled back when their connections close.
+    // Connections still leased by other threads close when they come back.
+    pool->close();
+    transactions.clear();
     
-    std::cout << "Disconnected from database" << std::endl;
+    logger.info() << "Disconnected from database";
     return true;
 }
 
 bool SQLDatabase::isConnected() const {
     std::lock_guard<std::mutex> lock(connectionMutex_);
-    return connected_ && connection_->isOpen();
+    return connected_;
+}
+
+SQLConnectionPool::Metrics SQLDatabase::getPoolMetrics() const {
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    return pool_ ? pool_->getMetrics() : SQLConnectionPool::Metrics();
 }
 
 std::string SQLDatabase::getConnectionString() const {
@@ -136,34 +662,38 @@ std::string SQLDatabase::getSQLTypeString() const {
 }
 
 bool SQLDatabase::initializeSchema() {
-    std::cout << "Initializing database schema..." << std::endl;
+    auto connection = acquireConnection();
+    return connection && initializeSchema(*connection);
+}
+
+bool SQLDatabase::initializeSchema(SQLConnection& connection) {
+    logger.info() << "Initializing database schema...";
     
     // Check if schema exists
-    int version = getSchemaVersion();
+    int version = readSchemaVersion(connection);
     if (version > 0) {
-        std::cout << "Schema already exists (version " << version << ")" << std::endl;
+        logger.info() << "Schema already exists (version " << version << ")";
         return true;
     }
     
     // Create tables
-    if (!createTables()) {
+    if (!createTables(connection)) {
         return false;
     }
     
     // Create indexes
-    if (!createIndexes()) {
+    if (!createIndexes(connection)) {
         return false;
     }
     
-    std::cout << "Schema initialized successfully" << std::endl;
+    logger.info() << "Schema initialized successfully";
     return true;
 }
 
-bool SQLDatabase::createTables() {
-    std::cout << "Creating database tables..." << std::endl;
+bool SQLDatabase::createTables(SQLConnection& connection) {
+    logger.info() << "Creating database tables...";
     
-    // In production, execute actual SQL CREATE TABLE statements
-    // This is a placeholder showing the schema design
+    // Timestamp columns written by this class hold milliseconds since the epoch
     
     std::vector<std::string> createStatements = {
         // Schema version table
@@ -278,373 +808,844 @@ bool SQLDatabase::createTables() {
         )"
     };
     
-    // In production, execute each statement
     for (const auto& statement : createStatements) {
-        // executeQuery(statement);
-        std::cout << "  - Created table" << std::endl;
+        if (!connection.execute(statement)) {
+            return false;
+        }
     }
     
-    // Set initial schema version
-    // executeQuery("INSERT INTO schema_version (version) VALUES (1)");
+    if (!connection.execute("INSERT OR IGNORE INTO schema_version (version) VALUES (1)")) {
+        return false;
+    }
     
-    std::cout << "Tables created successfully" << std::endl;
+    logger.info() << "Tables created successfully";
     return true;
 }
 
-bool SQLDatabase::createIndexes() {
-    std::cout << "Creating database indexes..." << std::endl;
+bool SQLDatabase::createIndexes(SQLConnection& connection) {
+    logger.info() << "Creating database indexes...";
     
     std::vector<std::string> indexStatements = {
-        "CREATE INDEX idx_items_name ON items(name)",
-        "CREATE INDEX idx_items_category ON items(category_id)",
-        "CREATE INDEX idx_items_container ON items(container_id)",
-        "CREATE INDEX idx_containers_location ON containers(location_id)",
-        "CREATE INDEX idx_containers_parent ON containers(parent_container_id)",
-        "CREATE INDEX idx_activity_logs_item ON activity_logs(item_id)",
-        "CREATE INDEX idx_activity_logs_timestamp ON activity_logs(timestamp DESC)",
-        "CREATE INDEX idx_categories_parent ON categories(parent_id)"
+        "CREATE INDEX IF NOT EXISTS idx_items_name ON items(name)",
+        "CREATE INDEX IF NOT EXISTS idx_items_category ON items(category_id)",
+        "CREATE INDEX IF NOT EXISTS idx_items_container ON items(container_id)",
+        "CREATE INDEX IF NOT EXISTS idx_containers_location ON containers(location_id)",
+        "CREATE INDEX IF NOT EXISTS idx_containers_parent ON containers(parent_container_id)",
+        "CREATE INDEX IF NOT EXISTS idx_activity_logs_item ON activity_logs(item_id, timestamp)",
+        "CREATE INDEX IF NOT EXISTS idx_activity_logs_timestamp ON activity_logs(timestamp DESC)",
+        "CREATE INDEX IF NOT EXISTS idx_categories_parent ON categories(parent_id)"
     };
     
-    // In production, execute each statement
     for (const auto& statement : indexStatements) {
-        // executeQuery(statement);
-        std::cout << "  - Created index" << std::endl;
+        if (!connection.execute(statement)) {
+            return false;
+        }
     }
     
-    std::cout << "Indexes created successfully" << std::endl;
+    logger.info() << "Indexes created successfully";
     return true;
 }
 
 int SQLDatabase::getSchemaVersion() {
-    if (!isConnected()) return 0;
-    
-    // In production, query the schema_version table
-    // Example: SELECT MAX(version) FROM schema_version
+    auto connection = acquireConnection();
+    return connection ? readSchemaVersion(*connection) : 0;
+}
+
+int SQLDatabase::readSchemaVersion(SQLConnection& connection) {
+    if (config_.type == SQLType::SQLITE) {
+        auto exists = connection.prepare(
+            "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'schema_version'");
+        if (!exists.next()) {
+            return 0;
+        }
+    }
     
-    return 0; // Placeholder
+    auto query = connection.prepare("SELECT MAX(version) FROM schema_version");
+    return query.next() ? query.integer(0) : 0;
 }
 
 bool SQLDatabase::executeQuery(const std::string& query) {
-    if (!isConnected()) return false;
-    
-    std::cout << "Executing query: " << query.substr(0, 50) << "..." << std::endl;
+    auto connection = acquireConnection();
+    if (!connection) return false;
     
-    // In production, execute actual SQL query
-    // Example for PostgreSQL:
-    // PGresult* res = PQexec(connection_, query.c_str());
-    // if (PQresultStatus(res) != PGRES_COMMAND_OK) {
-    //     std::cerr << "Query failed: " << PQerrorMessage(connection_) << std::endl;
-    //     PQclear(res);
-    //     return false;
-    // }
-    // PQclear(res);
-    
-    return true;
+    return connection->execute(query);
 }
 
 // Transaction support
 bool SQLDatabase::beginTransaction() {
-    return executeQuery("BEGIN TRANSACTION");
+    std::shared_ptr<SQLConnectionPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        if (!connected_) return false;
+        if (transactions_.count(std::this_thread::get_id())) {
+            logger.error() << "Transaction already open on this thread";
+            return false;
+        }
+        pool = pool_;
+    }
+    
+    auto connection = pool->acquire();
+    if (!connection) {
+        logger.error() << "Timed out waiting for a database connection";
+        return false;
+    }
+    if (!connection->execute("BEGIN TRANSACTION")) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    if (!connected_) return false;
+    transactions_.emplace(std::this_thread::get_id(), std::move(connection));
+    return true;
 }
 
 bool SQLDatabase::commitTransaction() {
-    return executeQuery("COMMIT");
+    return endTransaction("COMMIT");
 }
 
 bool SQLDatabase::rollbackTransaction() {
-    return executeQuery("ROLLBACK");
+    return endTransaction("ROLLBACK");
 }
 
-// Item operations (placeholder implementations)
+// Item operations
 bool SQLDatabase::saveItem(std::shared_ptr<Item> item) {
-    if (!isConnected() || !item) return false;
-    
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + item->getId().toString() + "'";
-    values["name"] = "'" + escapeString(item->getName()) + "'";
-    values["description"] = "'" + escapeString(item->getDescription()) + "'";
-    values["quantity"] = std::to_string(item->getQuantity());
-    
-    if (item->getCategory()) {
-        values["category_id"] = "'" + item->getCategory()->getId().toString() + "'";
-    }
-    
-    if (item->getCurrentContainer()) {
-        values["container_id"] = "'" + item->getCurrentContainer()->getId().toString() + "'";
-    }
-    
-    values["checked_out"] = item->isCheckedOut() ? "TRUE" : "FALSE";
-    
-    std::string query = buildInsertQuery("items", values);
-    return executeQuery(query);
+    if (!item) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    static const std::string sql = insertSql(kItemInsert, 1);
+    auto statement = connection->prepare(sql);
+    bindItem(statement, 0, *item);
+    return statement.run();
 }
 
 std::shared_ptr<Item> SQLDatabase::loadItem(const UUID& id) {
-    if (!isConnected()) return nullptr;
+    auto connection = acquireConnection();
+    if (!connection) return nullptr;
     
-    // In production, execute SELECT query and construct Item object
-    std::cout << "Loading item: " << id.toString() << std::endl;
-    
-    return nullptr; // Placeholder
+    auto query = connection->prepare(kSelectItem);
+    query.bind(1, id);
+    if (!query.next()) {
+        return nullptr;
+    }
+    return readItem(query);
 }
 
 bool SQLDatabase::deleteItem(const UUID& id) {
-    if (!isConnected()) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
     
-    std::string query = buildDeleteQuery("items", "id = '" + id.toString() + "'");
-    return executeQuery(query);
+    auto statement = connection->prepare(kDeleteItem);
+    statement.bind(1, id);
+    return statement.run();
 }
 
 std::vector<std::shared_ptr<Item>> SQLDatabase::loadAllItems() {
-    std::vector<std::shared_ptr<Item>> items;
-    if (!isConnected()) return items;
-    
-    // In production, execute SELECT query and construct Item objects
-    std::cout << "Loading all items..." << std::endl;
-    
-    return items; // Placeholder
+    EntitySnapshot snapshot;
+    loadSnapshot(snapshot);
+    return std::move(snapshot.items);
 }
 
-// Container operations (placeholder)
+// Container operations
 bool SQLDatabase::saveContainer(std::shared_ptr<Container> container) {
-    if (!isConnected() || !container) return false;
-    
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + container->getId().toString() + "'";
-    values["name"] = "'" + escapeString(container->getName()) + "'";
-    values["description"] = "'" + escapeString(container->getDescription()) + "'";
-    values["type"] = std::to_string(static_cast<int>(container->getType()));
-    
-    std::string query = buildInsertQuery("containers", values);
-    return executeQuery(query);
+    if (!container) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    static const std::string sql = insertSql(kContainerInsert, 1);
+    auto statement = connection->prepare(sql);
+    bindContainer(statement, 0, *container);
+    return statement.run();
 }
 
 std::shared_ptr<Container> SQLDatabase::loadContainer(const UUID& id) {
-    if (!isConnected()) return nullptr;
-    return nullptr; // Placeholder
+    auto connection = acquireConnection();
+    if (!connection) return nullptr;
+    
+    auto query = connection->prepare(kSelectContainer);
+    query.bind(1, id);
+    if (!query.next()) {
+        return nullptr;
+    }
+    return readContainer(query);
 }
 
 bool SQLDatabase::deleteContainer(const UUID& id) {
-    if (!isConnected()) return false;
-    std::string query = buildDeleteQuery("containers", "id = '" + id.toString() + "'");
-    return executeQuery(query);
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    auto statement = connection->prepare(kDeleteContainer);
+    statement.bind(1, id);
+    return statement.run();
 }
 
 std::vector<std::shared_ptr<Container>> SQLDatabase::loadAllContainers() {
-    std::vector<std::shared_ptr<Container>> containers;
-    if (!isConnected()) return containers;
-    return containers; // Placeholder
+    EntitySnapshot snapshot;
+    loadSnapshot(snapshot);
+    return std::move(snapshot.containers);
 }
 
-// Location operations (placeholder)
+// Location operations
 bool SQLDatabase::saveLocation(std::shared_ptr<Location> location) {
-    if (!isConnected() || !location) return false;
-    
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + location->getId().toString() + "'";
-    values["name"] = "'" + escapeString(location->getName()) + "'";
-    values["address"] = "'" + escapeString(location->getAddress()) + "'";
-    
-    std::string query = buildInsertQuery("locations", values);
-    return executeQuery(query);
+    if (!location) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    static const std::string sql = insertSql(kLocationInsert, 1);
+    auto statement = connection->prepare(sql);
+    bindLocation(statement, 0, *location);
+    return statement.run();
 }
 
 std::shared_ptr<Location> SQLDatabase::loadLocation(const UUID& id) {
-    if (!isConnected()) return nullptr;
-    return nullptr; // Placeholder
+    auto connection = acquireConnection();
+    if (!connection) return nullptr;
+    
+    auto query = connection->prepare(kSelectLocation);
+    query.bind(1, id);
+    if (!query.next()) {
+        return nullptr;
+    }
+    return readLocation(query);
 }
 
 bool SQLDatabase::deleteLocation(const UUID& id) {
-    if (!isConnected()) return false;
-    std::string query = buildDeleteQuery("locations", "id = '" + id.toString() + "'");
-    return executeQuery(query);
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    auto statement = connection->prepare(kDeleteLocation);
+    statement.bind(1, id);
+    return statement.run();
 }
 
 std::vector<std::shared_ptr<Location>> SQLDatabase::loadAllLocations() {
-    std::vector<std::shared_ptr<Location>> locations;
-    if (!isConnected()) return locations;
-    return locations; // Placeholder
+    EntitySnapshot snapshot;
+    loadSnapshot(snapshot);
+    return std::move(snapshot.locations);
 }
 
-// Project operations (placeholder)
+// Project operations
 bool SQLDatabase::saveProject(std::shared_ptr<Project> project) {
-    if (!isConnected() || !project) return false;
+    if (!project) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
     
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + project->getId().toString() + "'";
-    values["name"] = "'" + escapeString(project->getName()) + "'";
-    values["description"] = "'" + escapeString(project->getDescription()) + "'";
-    values["status"] = std::to_string(static_cast<int>(project->getStatus()));
+    // The project row and its container links change together
+    if (!savepoint(*connection, "save_project")) {
+        return false;
+    }
     
-    std::string query = buildInsertQuery("projects", values);
-    return executeQuery(query);
+    std::vector<std::shared_ptr<Project>> projects = {project};
+    return releaseSavepoint(*connection, "save_project", writeProjects(*connection, projects));
 }
 
 std::shared_ptr<Project> SQLDatabase::loadProject(const UUID& id) {
-    if (!isConnected()) return nullptr;
-    return nullptr; // Placeholder
+    auto connection = acquireConnection();
+    if (!connection) return nullptr;
+    
+    auto query = connection->prepare(kSelectProject);
+    query.bind(1, id);
+    if (!query.next()) {
+        return nullptr;
+    }
+    return readProject(query);
 }
 
 bool SQLDatabase::deleteProject(const UUID& id) {
-    if (!isConnected()) return false;
-    std::string query = buildDeleteQuery("projects", "id = '" + id.toString() + "'");
-    return executeQuery(query);
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    if (!savepoint(*connection, "delete_project")) {
+        return false;
+    }
+    
+    auto links = connection->prepare(kDeleteProjectContainers);
+    links.bind(1, id);
+    bool ok = links.run();
+    if (ok) {
+        auto statement = connection->prepare(kDeleteProject);
+        statement.bind(1, id);
+        ok = statement.run();
+    }
+    
+    return releaseSavepoint(*connection, "delete_project", ok);
 }
 
 std::vector<std::shared_ptr<Project>> SQLDatabase::loadAllProjects() {
-    std::vector<std::shared_ptr<Project>> projects;
-    if (!isConnected()) return projects;
-    return projects; // Placeholder
+    EntitySnapshot snapshot;
+    loadSnapshot(snapshot);
+    return std::move(snapshot.projects);
 }
 
-// Category operations (placeholder)
+// Category operations
 bool SQLDatabase::saveCategory(std::shared_ptr<Category> category) {
-    if (!isConnected() || !category) return false;
+    if (!category) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
     
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + category->getId().toString() + "'";
-    values["name"] = "'" + escapeString(category->getName()) + "'";
-    values["description"] = "'" + escapeString(category->getDescription()) + "'";
+    if (!savepoint(*connection, "save_category")) {
+        return false;
+    }
     
-    std::string query = buildInsertQuery("categories", values);
-    return executeQuery(query);
+    std::vector<std::shared_ptr<Category>> categories = {category};
+    return releaseSavepoint(*connection, "save_category", writeCategories(*connection, categories));
 }
 
 std::shared_ptr<Category> SQLDatabase::loadCategory(const UUID& id) {
-    if (!isConnected()) return nullptr;
-    return nullptr; // Placeholder
+    auto connection = acquireConnection();
+    if (!connection) return nullptr;
+    
+    auto query = connection->prepare(kSelectCategory);
+    query.bind(1, id);
+    if (!query.next()) {
+        return nullptr;
+    }
+    return readCategory(query);
 }
 
 bool SQLDatabase::deleteCategory(const UUID& id) {
-    if (!isConnected()) return false;
-    std::string query = buildDeleteQuery("categories", "id = '" + id.toString() + "'");
-    return executeQuery(query);
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    auto statement = connection->prepare(kDeleteCategory);
+    statement.bind(1, id);
+    return statement.run();
 }
 
 std::vector<std::shared_ptr<Category>> SQLDatabase::loadAllCategories() {
-    std::vector<std::shared_ptr<Category>> categories;
-    if (!isConnected()) return categories;
-    return categories; // Placeholder
+    EntitySnapshot snapshot;
+    loadSnapshot(snapshot);
+    return std::move(snapshot.categories);
 }
 
-// Activity log operations (placeholder)
+// Activity log operations
 bool SQLDatabase::saveActivityLog(std::shared_ptr<ActivityLog> log) {
-    if (!isConnected() || !log) return false;
-    
-    std::map<std::string, std::string> values;
-    values["id"] = "'" + log->getId().toString() + "'";
-    values["type"] = std::to_string(static_cast<int>(log->getType()));
-    values["description"] = "'" + escapeString(log->getDescription()) + "'";
-    values["user_id"] = "'" + escapeString(log->getUserId()) + "'";
-    
-    if (log->getItem()) {
-        values["item_id"] = "'" + log->getItem()->getId().toString() + "'";
-    }
-    
-    std::string query = buildInsertQuery("activity_logs", values);
-    return executeQuery(query);
+    if (!log) return false;
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    static const std::string sql = insertSql(kActivityLogInsert, 1);
+    auto statement = connection->prepare(sql);
+    bindActivityLog(statement, 0, *log);
+    return statement.run();
 }
 
 std::vector<std::shared_ptr<ActivityLog>> SQLDatabase::loadActivityLogsForItem(const UUID& itemId) {
-    std::vector<std::shared_ptr<ActivityLog>> logs;
-    if (!isConnected()) return logs;
-    return logs; // Placeholder
+    return readActivityLogs(std::string(kActivityLogColumns) + " WHERE item_id = ?1 ORDER BY timestamp DESC",
+                            itemId, 0);
 }
 
 std::vector<std::shared_ptr<ActivityLog>> SQLDatabase::loadRecentActivityLogs(int limit) {
-    std::vector<std::shared_ptr<ActivityLog>> logs;
-    if (!isConnected()) return logs;
-    return logs; // Placeholder
+    if (limit <= 0) return {};
+    return readActivityLogs(std::string(kActivityLogColumns) + " ORDER BY timestamp DESC LIMIT ?2", UUID::nil(), limit);
+}
+
+// Batch operations
+bool SQLDatabase::saveItems(const std::vector<std::shared_ptr<Item>>& items) {
+    return writeBatch("save_items", [&](SQLConnection& connection) {
+        return insertRows(connection, kItemInsert, items.size(), batchSize(),
+                          [&](SQLConnection::Statement& statement, int base, size_t row) {
+                              bindItem(statement, base, *items[row]);
+                          });
+    });
+}
+
+std::vector<std::shared_ptr<Item>> SQLDatabase::loadItems(const std::vector<UUID>& ids) {
+    auto connection = acquireConnection();
+    if (!connection) return {};
+    auto loaded = selectByIds<Item>(*connection, kSelectItems, ids, batchSize(), readItem);
+    linkItems(*connection, loaded, batchSize());
+    return loaded;
+}
+
+bool SQLDatabase::deleteItems(const std::vector<UUID>& ids) {
+    return writeBatch("delete_items", [&](SQLConnection& connection) {
+        return deleteByIds(connection, kDeleteItems, ids, batchSize());
+    });
+}
+
+bool SQLDatabase::saveContainers(const std::vector<std::shared_ptr<Container>>& containers) {
+    return writeBatch("save_containers", [&](SQLConnection& connection) {
+        return insertRows(connection, kContainerInsert, containers.size(), batchSize(),
+                          [&](SQLConnection::Statement& statement, int base, size_t row) {
+                              bindContainer(statement, base, *containers[row]);
+                          });
+    });
+}
+
+std::vector<std::shared_ptr<Container>> SQLDatabase::loadContainers(const std::vector<UUID>& ids) {
+    auto connection = acquireConnection();
+    if (!connection) return {};
+    auto loaded = selectByIds<Container>(*connection, kSelectContainers, ids, batchSize(), readContainer);
+    linkContainers(*connection, loaded, batchSize());
+    return loaded;
+}
+
+bool SQLDatabase::deleteContainers(const std::vector<UUID>& ids) {
+    return writeBatch("delete_containers", [&](SQLConnection& connection) {
+        return deleteByIds(connection, kDeleteContainers, ids, batchSize());
+    });
+}
+
+bool SQLDatabase::saveLocations(const std::vector<std::shared_ptr<Location>>& locations) {
+    return writeBatch("save_locations", [&](SQLConnection& connection) {
+        return insertRows(connection, kLocationInsert, locations.size(), batchSize(),
+                          [&](SQLConnection::Statement& statement, int base, size_t row) {
+                              bindLocation(statement, base, *locations[row]);
+                          });
+    });
+}
+
+std::vector<std::shared_ptr<Location>> SQLDatabase::loadLocations(const std::vector<UUID>& ids) {
+    auto connection = acquireConnection();
+    if (!connection) return {};
+    auto loaded = selectByIds<Location>(*connection, kSelectLocations, ids, batchSize(), readLocation);
+    linkLocations(*connection, loaded, batchSize());
+    return loaded;
+}
+
+bool SQLDatabase::deleteLocations(const std::vector<UUID>& ids) {
+    return writeBatch("delete_locations", [&](SQLConnection& connection) {
+        return deleteByIds(connection, kDeleteLocations, ids, batchSize());
+    });
+}
+
+bool SQLDatabase::saveProjects(const std::vector<std::shared_ptr<Project>>& projects) {
+    return writeBatch("save_projects", [&](SQLConnection& connection) {
+        return writeProjects(connection, projects);
+    });
+}
+
+std::vector<std::shared_ptr<Project>> SQLDatabase::loadProjects(const std::vector<UUID>& ids) {
+    auto connection = acquireConnection();
+    if (!connection) return {};
+    auto loaded = selectByIds<Project>(*connection, kSelectProjects, ids, batchSize(), readProject);
+    linkProjects(*connection, loaded, batchSize());
+    return loaded;
+}
+
+bool SQLDatabase::deleteProjects(const std::vector<UUID>& ids) {
+    return writeBatch("delete_projects", [&](SQLConnection& connection) {
+        return deleteByIds(connection, kDeleteProjectsContainers, ids, batchSize()) &&
+               deleteByIds(connection, kDeleteProjects, ids, batchSize());
+    });
+}
+
+bool SQLDatabase::saveCategories(const std::vector<std::shared_ptr<Category>>& categories) {
+    return writeBatch("save_categories", [&](SQLConnection& connection) {
+        return writeCategories(connection, categories);
+    });
+}
+
+std::vector<std::shared_ptr<Category>> SQLDatabase::loadCategories(const std::vector<UUID>& ids) {
+    auto connection = acquireConnection();
+    if (!connection) return {};
+    auto loaded = selectByIds<Category>(*connection, kSelectCategories, ids, batchSize(), readCategory);
+    linkCategories(*connection, loaded, batchSize());
+    return loaded;
+}
+
+bool SQLDatabase::deleteCategories(const std::vector<UUID>& ids) {
+    return writeBatch("delete_categories", [&](SQLConnection& connection) {
+        return deleteByIds(connection, kDeleteCategories, ids, batchSize());
+    });
+}
+
+bool SQLDatabase::saveActivityLogs(const std::vector<std::shared_ptr<ActivityLog>>& logs) {
+    return writeBatch("save_activity_logs", [&](SQLConnection& connection) {
+        return insertRows(connection, kActivityLogInsert, logs.size(), batchSize(),
+                          [&](SQLConnection::Statement& statement, int base, size_t row) {
+                              bindActivityLog(statement, base, *logs[row]);
+                          });
+    });
+}
+
+// Paged loads
+Page<Item> SQLDatabase::loadItemPage(const UUID& after, size_t limit) {
+    Page<Item> page;
+    auto connection = acquireConnection();
+    if (!connection) {
+        page.ok = false;
+        return page;
+    }
+    page = selectPage<Item>(*connection, kSelectItemPage, after, limit, readItem);
+    linkItems(*connection, page.entities, batchSize());
+    return page;
+}
+
+Page<Container> SQLDatabase::loadContainerPage(const UUID& after, size_t limit) {
+    Page<Container> page;
+    auto connection = acquireConnection();
+    if (!connection) {
+        page.ok = false;
+        return page;
+    }
+    page = selectPage<Container>(*connection, kSelectContainerPage, after, limit, readContainer);
+    linkContainers(*connection, page.entities, batchSize());
+    return page;
+}
+
+Page<Location> SQLDatabase::loadLocationPage(const UUID& after, size_t limit) {
+    Page<Location> page;
+    auto connection = acquireConnection();
+    if (!connection) {
+        page.ok = false;
+        return page;
+    }
+    page = selectPage<Location>(*connection, kSelectLocationPage, after, limit, readLocation);
+    linkLocations(*connection, page.entities, batchSize());
+    return page;
+}
+
+Page<Project> SQLDatabase::loadProjectPage(const UUID& after, size_t limit) {
+    Page<Project> page;
+    auto connection = acquireConnection();
+    if (!connection) {
+        page.ok = false;
+        return page;
+    }
+    page = selectPage<Project>(*connection, kSelectProjectPage, after, limit, readProject);
+    linkProjects(*connection, page.entities, batchSize());
+    return page;
 }
 
-// Helper methods
-std::string SQLDatabase::escapeString(const std::string& str) const {
-    // Basic SQL string escaping
-    std::string result = str;
-    size_t pos = 0;
-    while ((pos = result.find("'", pos)) != std::string::npos) {
-        result.replace(pos, 1, "''");
-        pos += 2;
+Page<Category> SQLDatabase::loadCategoryPage(const UUID& after, size_t limit) {
+    Page<Category> page;
+    auto connection = acquireConnection();
+    if (!connection) {
+        page.ok = false;
+        return page;
     }
-    return result;
+    page = selectPage<Category>(*connection, kSelectCategoryPage, after, limit, readCategory);
+    linkCategories(*connection, page.entities, batchSize());
+    return page;
 }
 
-std::string SQLDatabase::buildInsertQuery(const std::string& table, 
-                                         const std::map<std::string, std::string>& values) {
-    std::stringstream columns, vals;
-    bool first = true;
+// Bulk load
+bool SQLDatabase::loadSnapshot(EntitySnapshot& snapshot) {
+    auto connection = acquireConnection();
+    if (!connection) return false;
+    
+    EntityRegistry<Item> items;
+    EntityRegistry<Container> containers;
+    EntityRegistry<Location> locations;
+    EntityRegistry<Project> projects;
+    EntityRegistry<Category> categories;
+    
+    std::vector<std::pair<UUID, UUID>> categoryParents;
+    auto categoryRows = connection->prepare(kSelectAllCategories);
+    while (categoryRows.next()) {
+        auto category = std::make_shared<Category>(categoryRows.uuid(0), categoryRows.text(1), categoryRows.text(2));
+        if (!categoryRows.isNull(3)) {
+            categoryParents.emplace_back(category->getId(), categoryRows.uuid(3));
+        }
+        categories.add(category);
+    }
+    
+    auto locationRows = connection->prepare(kSelectAllLocations);
+    while (locationRows.next()) {
+        locations.add(std::make_shared<Location>(locationRows.uuid(0), locationRows.text(1), locationRows.text(2)));
+    }
+    
+    // (container, location, parent)
+    std::vector<std::tuple<std::shared_ptr<Container>, UUID, UUID>> containerLinks;
+    auto containerRows = connection->prepare(kSelectAllContainers);
+    while (containerRows.next()) {
+        auto container = std::make_shared<Container>(containerRows.uuid(0), containerRows.text(1),
+                                                     static_cast<ContainerType>(containerRows.integer(3)),
+                                                     containerRows.text(2));
+        containerLinks.emplace_back(container, containerRows.uuid(4), containerRows.uuid(5));
+        containers.add(container);
+    }
+    
+    // (item, category, container)
+    std::vector<std::tuple<std::shared_ptr<Item>, UUID, UUID>> itemLinks;
+    auto itemRows = connection->prepare(kSelectAllItems);
+    while (itemRows.next()) {
+        auto item = std::make_shared<Item>(itemRows.uuid(0), itemRows.text(1), nullptr,
+                                           itemRows.integer(3), itemRows.text(2));
+        itemLinks.emplace_back(item, itemRows.uuid(4), itemRows.uuid(5));
+        items.add(item);
+    }
+    
+    auto projectRows = connection->prepare(kSelectAllProjects);
+    while (projectRows.next()) {
+        auto project = std::make_shared<Project>(projectRows.uuid(0), projectRows.text(1), projectRows.text(2));
+        project->setStatus(static_cast<ProjectStatus>(projectRows.integer(3)));
+        project->setStartDate(fromMillis(projectRows.int64(4)));
+        project->setEndDate(fromMillis(projectRows.int64(5)));
+        projects.add(project);
+    }
     
-    for (const auto& pair : values) {
-        if (!first) {
-            columns << ", ";
-            vals << ", ";
+    // Link references; dangling IDs are dropped
+    for (const auto& link : categoryParents) {
+        if (auto parent = categories.get(link.second)) {
+            parent->addSubcategory(categories.get(link.first));
         }
-        columns << pair.first;
-        vals << pair.second;
-        first = false;
     }
     
-    return "INSERT INTO " + table + " (" + columns.str() + ") VALUES (" + vals.str() + ")";
-}
-
-std::string SQLDatabase::buildUpdateQuery(const std::string& table,
-                                         const std::map<std::string, std::string>& values,
-                                         const std::string& where) {
-    std::stringstream ss;
-    ss << "UPDATE " << table << " SET ";
+    for (const auto& link : containerLinks) {
+        const auto& container = std::get<0>(link);
+        if (auto location = locations.get(std::get<1>(link))) {
+            location->addContainer(container);
+        }
+        if (auto parent = containers.get(std::get<2>(link))) {
+            parent->addSubcontainer(container);
+        }
+    }
     
-    bool first = true;
-    for (const auto& pair : values) {
-        if (!first) ss << ", ";
-        ss << pair.first << " = " << pair.second;
-        first = false;
+    for (const auto& link : itemLinks) {
+        const auto& item = std::get<0>(link);
+        item->setCategory(categories.get(std::get<1>(link)));
+        if (auto container = containers.get(std::get<2>(link))) {
+            container->addItem(item);
+        }
     }
     
-    if (!where.empty()) {
-        ss << " WHERE " << where;
+    auto projectContainers = connection->prepare(kSelectAllProjectContainers);
+    while (projectContainers.next()) {
+        auto project = projects.get(projectContainers.uuid(0));
+        auto container = containers.get(projectContainers.uuid(1));
+        if (project && container) {
+            project->addContainer(container);
+        }
     }
     
-    return ss.str();
+    // Oldest first, so each item's history is in order
+    auto activityRows = connection->prepare(std::string(kActivityLogColumns) + " ORDER BY timestamp");
+    while (activityRows.next()) {
+        auto item = items.get(activityRows.uuid(5));
+        if (!item) {
+            continue;
+        }
+        auto log = std::make_shared<ActivityLog>(activityRows.uuid(0),
+                                                 static_cast<ActivityType>(activityRows.integer(1)),
+                                                 item, activityRows.text(2), activityRows.text(4),
+                                                 fromMillis(activityRows.int64(3)));
+        log->setFromContainer(containers.get(activityRows.uuid(6)));
+        log->setToContainer(containers.get(activityRows.uuid(7)));
+        log->setProject(projects.get(activityRows.uuid(8)));
+        log->setQuantityChange(activityRows.integer(9));
+        item->addActivity(log);
+    }
+    
+    snapshot.items = items.all();
+    snapshot.containers = containers.all();
+    snapshot.locations = locations.all();
+    snapshot.projects = projects.all();
+    snapshot.categories = categories.all();
+    return true;
 }
 
-std::string SQLDatabase::buildSelectQuery(const std::string& table,
-                                         const std::vector<std::string>& columns,
-                                         const std::string& where) {
-    std::stringstream ss;
-    ss << "SELECT ";
+// Private helper methods
+std::unique_ptr<SQLConnection> SQLDatabase::openConnection() const {
+    auto connection = std::make_unique<SQLConnection>(config_.type == SQLType::SQLITE
+                                                          ? SQLConnection::Backend::SQLITE
+                                                          : SQLConnection::Backend::LOGGING);
+    if (!connection->open(getConnectionString(), config_.connectionTimeout)) {
+        logger.error() << "Connection failed: " << connection->lastError();
+        return nullptr;
+    }
     
-    if (columns.empty()) {
-        ss << "*";
-    } else {
-        for (size_t i = 0; i < columns.size(); ++i) {
-            if (i > 0) ss << ", ";
-            ss << columns[i];
+    if (config_.type == SQLType::SQLITE) {
+        // Readers no longer block the writer, and commits skip the extra fsync.
+        // journal_mode sticks to the file; synchronous is per connection.
+        if (!connection->execute("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL")) {
+            return nullptr;
         }
     }
+    return connection;
+}
+
+SQLConnectionPool::Lease SQLDatabase::acquireConnection() {
+    std::shared_ptr<SQLConnectionPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        if (!connected_) {
+            return SQLConnectionPool::Lease();
+        }
+        auto transaction = transactions_.find(std::this_thread::get_id());
+        if (transaction != transactions_.end()) {
+            return SQLConnectionPool::Lease::borrow(transaction->second.get());
+        }
+        pool = pool_;
+    }
     
-    ss << " FROM " << table;
+    auto connection = pool->acquire();
+    if (!connection) {
+        logger.error() << "Timed out waiting for a database connection";
+    }
+    return connection;
+}
+
+bool SQLDatabase::endTransaction(const char* sql) {
+    SQLConnectionPool::Lease connection;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        auto transaction = transactions_.find(std::this_thread::get_id());
+        if (transaction == transactions_.end()) {
+            return false;
+        }
+        connection = std::move(transaction->second);
+        transactions_.erase(transaction);
+    }
+    
+    if (!connection->execute(sql)) {
+        // Never hand a connection with an open transaction back to the pool
+        connection->execute("ROLLBACK");
+        connection.discard();
+        return false;
+    }
+    return true;
+}
+
+bool SQLDatabase::writeBatch(const char* name, const std::function<bool(SQLConnection&)>& write) {
+    // Inside the caller's transaction the batch is a savepoint on its connection
+    bool nested;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        nested = transactions_.count(std::this_thread::get_id()) > 0;
+    }
+    if (nested) {
+        auto connection = acquireConnection();
+        if (!connection || !savepoint(*connection, name)) {
+            return false;
+        }
+        return releaseSavepoint(*connection, name, write(*connection));
+    }
     
-    if (!where.empty()) {
-        ss << " WHERE " << where;
+    if (!beginTransaction()) {
+        return false;
+    }
+    bool ok;
+    {
+        auto connection = acquireConnection();
+        ok = connection && write(*connection);
+    }
+    if (!ok) {
+        rollbackTransaction();
+        return false;
+    }
+    return commitTransaction();
+}
+
+bool SQLDatabase::writeProjects(SQLConnection& connection, const std::vector<std::shared_ptr<Project>>& projects) {
+    bool ok = insertRows(connection, kProjectInsert, projects.size(), batchSize(),
+                         [&](SQLConnection::Statement& statement, int base, size_t row) {
+                             bindProject(statement, base, *projects[row]);
+                         });
+    
+    // Each project's container links are replaced as a whole
+    std::vector<std::pair<UUID, UUID>> links;
+    for (const auto& project : projects) {
+        if (!ok) break;
+        auto clear = connection.prepare(kDeleteProjectContainers);
+        clear.bind(1, project->getId());
+        ok = clear.run();
+        for (const auto& container : project->getAllContainers()) {
+            links.emplace_back(project->getId(), container->getId());
+        }
     }
     
-    return ss.str();
+    return ok && insertRows(connection, kProjectContainerInsert, links.size(), batchSize(),
+                            [&](SQLConnection::Statement& statement, int base, size_t row) {
+                                statement.bind(base + 1, links[row].first).bind(base + 2, links[row].second);
+                            });
 }
 
-std::string SQLDatabase::buildDeleteQuery(const std::string& table, const std::string& where) {
-    std::stringstream ss;
-    ss << "DELETE FROM " << table;
+bool SQLDatabase::writeCategories(SQLConnection& connection, const std::vector<std::shared_ptr<Category>>& categories) {
+    bool ok = insertRows(connection, kCategoryInsert, categories.size(), batchSize(),
+                         [&](SQLConnection::Statement& statement, int base, size_t row) {
+                             bindCategory(statement, base, *categories[row]);
+                         });
+    
+    // Categories only know their children, so the parent writes the links.
+    // Subcategories saved after their parent are linked on its next save.
+    for (const auto& category : categories) {
+        if (!ok) break;
+        auto clear = connection.prepare(kClearSubcategories);
+        clear.bind(1, category->getId());
+        ok = clear.run();
+        
+        for (const auto& subcategory : category->getSubcategories()) {
+            if (!ok) break;
+            auto link = connection.prepare(kSetCategoryParent);
+            link.bind(1, category->getId()).bind(2, subcategory->getId());
+            ok = link.run();
+        }
+    }
+    return ok;
+}
+
+size_t SQLDatabase::batchSize() const {
+    return static_cast<size_t>(std::max(config_.batchSize, 1));
+}
+
+bool SQLDatabase::savepoint(SQLConnection& connection, const char* name) {
+    return connection.execute(std::string("SAVEPOINT ") + name);
+}
+
+bool SQLDatabase::releaseSavepoint(SQLConnection& connection, const char* name, bool ok) {
+    if (!ok) {
+        connection.execute(std::string("ROLLBACK TO ") + name);
+    }
+    connection.execute(std::string("RELEASE ") + name);
+    return ok;
+}
+
+std::vector<std::shared_ptr<ActivityLog>> SQLDatabase::readActivityLogs(const std::string& sql, const UUID& itemId,
+                                                                        int limit) {
+    std::vector<std::shared_ptr<ActivityLog>> logs;
     
-    if (!where.empty()) {
-        ss << " WHERE " << where;
+    // Rows first, and the connection goes back before items are resolved:
+    // loadItem() leases its own, and a pool of one has nothing else to give
+    struct Row {
+        UUID id;
+        ActivityType type;
+        std::string description;
+        int64_t timestamp;
+        std::string userId;
+        UUID itemId;
+        int quantityChange;
+    };
+    std::vector<Row> rows;
+    {
+        auto connection = acquireConnection();
+        if (!connection) return logs;
+        
+        auto query = connection->prepare(sql);
+        if (!itemId.isNil()) {
+            query.bind(1, itemId);
+        }
+        if (limit > 0) {
+            query.bind(2, limit);
+        }
+        while (query.next()) {
+            rows.push_back({query.uuid(0), static_cast<ActivityType>(query.integer(1)), query.text(2),
+                            query.int64(3), query.text(4), query.uuid(5), query.integer(9)});
+        }
     }
     
-    return ss.str();
+    // Each referenced item is read once per call
+    std::unordered_map<UUID, std::shared_ptr<Item>> itemCache;
+    logs.reserve(rows.size());
+    for (const auto& row : rows) {
+        auto item = itemCache.find(row.itemId);
+        if (item == itemCache.end()) {
+            item = itemCache.emplace(row.itemId, row.itemId.isNil() ? nullptr : loadItem(row.itemId)).first;
+        }
+        auto log = std::make_shared<ActivityLog>(row.id, row.type, item->second, row.description, row.userId,
+                                                 fromMillis(row.timestamp));
+        log->setQuantityChange(row.quantityChange);
+        logs.push_back(std::move(log));
+    }
+    
+    return logs;
 }
 
 bool SQLDatabase::migrateSchema(int fromVersion, int toVersion) {
-    std::cout << "Migrating schema from version " << fromVersion 
-              << " to " << toVersion << std::endl;
+    logger.info() << "Migrating schema from version " << fromVersion 
+                  << " to " << toVersion;
     
     // In production, implement actual schema migrations
     return true;
@@ -0,0 +1,266 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <mutex>
+
+namespace {
+    // Non-ASCII bytes are kept as token characters so UTF-8 words stay whole
+    bool isTokenChar(unsigned char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+               (c >= 'A' && c <= 'Z') || c >= 0x80;
+    }
+
+    char foldChar(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c);
+    }
+
+    void appendTrigrams(const std::string& term, std::unordered_set<std::string>& out) {
+        for (size_t i = 0; i + 3 <= term.size(); ++i) {
+            out.insert(term.substr(i, 3));
+        }
+    }
+
+    // 3 = exact token, 2 = prefix, 1 = substring (3+ character terms only)
+    int matchTerm(const std::string& docTerm, const std::string& term) {
+        if (docTerm.size() < term.size()) {
+            return 0;
+        }
+        if (docTerm.compare(0, term.size(), term) == 0) {
+            return docTerm.size() == term.size() ? 3 : 2;
+        }
+        if (term.size() >= 3 && docTerm.find(term) != std::string::npos) {
+            return 1;
+        }
+        return 0;
+    }
+
+    int bestMatch(const std::vector<std::string>& docTerms, const std::string& term) {
+        int best = 0;
+        for (const auto& docTerm : docTerms) {
+            best = std::max(best, matchTerm(docTerm, term));
+            if (best == 3) {
+                break;
+            }
+        }
+        return best;
+    }
+}
+
+std::string SearchIndex::fold(std::string_view text) {
+    std::string folded(text);
+    for (auto& c : folded) {
+        c = foldChar(static_cast<unsigned char>(c));
+    }
+    return folded;
+}
+
+std::vector<std::string> SearchIndex::tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string current;
+
+    for (char c : text) {
+        if (isTokenChar(static_cast<unsigned char>(c))) {
+            current += foldChar(static_cast<unsigned char>(c));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+    return tokens;
+}
+
+void SearchIndex::add(const UUID& id, const std::string& name, const std::string& description) {
+    Document document;
+    document.name = fold(name);
+    document.nameTerms = tokenize(name);
+    document.descriptionTerms = tokenize(description);
+
+    std::unordered_set<std::string> terms(document.nameTerms.begin(), document.nameTerms.end());
+    terms.insert(document.descriptionTerms.begin(), document.descriptionTerms.end());
+
+    std::unordered_set<std::string> trigrams;
+    for (const auto& term : terms) {
+        appendTrigrams(term, trigrams);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    removeLocked(id);
+
+    for (const auto& term : terms) {
+        terms_[term].insert(id);
+    }
+    for (const auto& trigram : trigrams) {
+        trigrams_[trigram].insert(id);
+    }
+    documents_.emplace(id, std::move(document));
+}
+
+void SearchIndex::remove(const UUID& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    removeLocked(id);
+}
+
+bool SearchIndex::contains(const UUID& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return documents_.find(id) != documents_.end();
+}
+
+size_t SearchIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return documents_.size();
+}
+
+void SearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    documents_.clear();
+    terms_.clear();
+    trigrams_.clear();
+}
+
+std::vector<SearchIndex::Hit> SearchIndex::search(const std::string& query, size_t limit) const {
+    std::vector<Hit> hits;
+    auto terms = tokenize(query);
+    if (terms.empty()) {
+        return hits;
+    }
+
+    std::string foldedQuery = fold(query);
+
+    // The longest term is usually the most selective, so it drives candidate lookup
+    const auto& driver = *std::max_element(terms.begin(), terms.end(),
+        [](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+
+    struct Ranked {
+        Hit hit;
+        const std::string* name;
+    };
+    std::vector<Ranked> ranked;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    for (const auto& id : candidatesFor(driver)) {
+        auto it = documents_.find(id);
+        if (it == documents_.end()) {
+            continue;
+        }
+
+        int score = scoreDocument(it->second, terms, foldedQuery);
+        if (score > 0) {
+            ranked.push_back({{id, score}, &it->second.name});
+        }
+    }
+
+    auto better = [](const Ranked& a, const Ranked& b) {
+        if (a.hit.score != b.hit.score) {
+            return a.hit.score > b.hit.score;
+        }
+        if (*a.name != *b.name) {
+            return *a.name < *b.name;
+        }
+        return a.hit.id < b.hit.id;
+    };
+
+    if (limit > 0 && limit < ranked.size()) {
+        std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(), better);
+        ranked.resize(limit);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), better);
+    }
+
+    hits.reserve(ranked.size());
+    for (const auto& entry : ranked) {
+        hits.push_back(entry.hit);
+    }
+
+    return hits;
+}
+
+void SearchIndex::removeLocked(const UUID& id) {
+    auto it = documents_.find(id);
+    if (it == documents_.end()) {
+        return;
+    }
+
+    const Document& document = it->second;
+    std::unordered_set<std::string> terms(document.nameTerms.begin(), document.nameTerms.end());
+    terms.insert(document.descriptionTerms.begin(), document.descriptionTerms.end());
+
+    std::unordered_set<std::string> trigrams;
+    for (const auto& term : terms) {
+        appendTrigrams(term, trigrams);
+
+        auto postings = terms_.find(term);
+        if (postings != terms_.end()) {
+            postings->second.erase(id);
+            if (postings->second.empty()) {
+                terms_.erase(postings);
+            }
+        }
+    }
+
+    for (const auto& trigram : trigrams) {
+        auto postings = trigrams_.find(trigram);
+        if (postings != trigrams_.end()) {
+            postings->second.erase(id);
+            if (postings->second.empty()) {
+                trigrams_.erase(postings);
+            }
+        }
+    }
+
+    documents_.erase(it);
+}
+
+int SearchIndex::scoreDocument(const Document& document, const std::vector<std::string>& terms,
+                               const std::string& foldedQuery) const {
+    int total = 0;
+
+    for (const auto& term : terms) {
+        int nameScore = bestMatch(document.nameTerms, term);
+        int descriptionScore = bestMatch(document.descriptionTerms, term);
+        if (nameScore == 0 && descriptionScore == 0) {
+            return 0;
+        }
+        total += nameScore * 3 + descriptionScore;
+    }
+
+    // Exact full-name matches come first
+    if (document.name == foldedQuery) {
+        total += 10;
+    }
+
+    return total;
+}
+
+SearchIndex::IdSet SearchIndex::candidatesFor(const std::string& term) const {
+    IdSet candidates;
+
+    if (term.size() < 3) {
+        // Prefix range scan over the ordered term dictionary
+        for (auto it = terms_.lower_bound(term);
+             it != terms_.end() && it->first.compare(0, term.size(), term) == 0; ++it) {
+            candidates.insert(it->second.begin(), it->second.end());
+        }
+        return candidates;
+    }
+
+    // Every trigram of the term must be present; the rarest one bounds the candidates
+    const IdSet* smallest = nullptr;
+    for (size_t i = 0; i + 3 <= term.size(); ++i) {
+        auto it = trigrams_.find(term.substr(i, 3));
+        if (it == trigrams_.end()) {
+            return candidates;
+        }
+        if (!smallest || it->second.size() < smallest->size()) {
+            smallest = &it->second;
+        }
+    }
+
+    candidates = *smallest;
+    return candidates;
+}
@@ -0,0 +1,105 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+ThreadPool::ThreadPool(size_t threads) : stopping_(false) {
+    if (threads == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers_.size();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                             size_t minShard) {
+    if (count == 0) return;
+
+    size_t shards = std::min(workers_.size() + 1, (count + minShard - 1) / std::max<size_t>(minShard, 1));
+    if (shards <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    size_t shardSize = (count + shards - 1) / shards;
+    size_t remaining = 0;
+    std::exception_ptr error;
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    // Records the first exception; later ones are dropped
+    auto fail = [&error, &doneMutex](std::exception_ptr thrown) {
+        std::lock_guard<std::mutex> doneLock(doneMutex);
+        if (!error) {
+            error = thrown;
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t begin = shardSize; begin < count; begin += shardSize) {
+            size_t end = std::min(begin + shardSize, count);
+            ++remaining;
+            tasks_.push([&, begin, end]() {
+                try {
+                    fn(begin, end);
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                std::lock_guard<std::mutex> doneLock(doneMutex);
+                if (--remaining == 0) {
+                    done.notify_one();
+                }
+            });
+        }
+    }
+    available_.notify_all();
+
+    try {
+        fn(0, std::min(shardSize, count));
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    // The queued shards refer to this frame, so wait for them even on failure
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&remaining]() { return remaining == 0; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Private helper methods
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            available_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
@@ -1,53 +1,197 @@
 #include "UUID.h"
+#include <atomic>
 #include <chrono>
+#include <random>
+#include <thread>
 
-UUID::UUID() {
-    uuid_ = generateUUIDv4();
+namespace {
+    // Two hex characters per byte value, so formatting is one lookup per byte
+    struct HexTable {
+        char pairs[256][2] = {};
+        constexpr HexTable() {
+            const char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 256; ++i) {
+                pairs[i][0] = digits[i >> 4];
+                pairs[i][1] = digits[i & 0xF];
+            }
+        }
+    };
+    constexpr HexTable kHexTable;
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Hyphen positions in the canonical 8-4-4-4-12 form
+    bool isHyphenPosition(size_t i) {
+        return i == 8 || i == 13 || i == 18 || i == 23;
+    }
+
+    uint64_t splitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256** - small, fast, and good enough statistically for identifiers.
+    // One instance per thread, so generation needs no locking.
+    class ThreadRandom {
+    public:
+        ThreadRandom() {
+            std::random_device rd;
+            uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+            seed ^= static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            seed ^= static_cast<uint64_t>(
+                std::chrono::high_resolution_clock::now().time_since_epoch().count());
+            for (auto& word : state_) {
+                word = splitMix64(seed);
+            }
+        }
+        
+        uint64_t next() {
+            const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+            const uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+        
+    private:
+        uint64_t state_[4];
+        
+        static uint64_t rotl(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+
+    ThreadRandom& threadRandom() {
+        thread_local ThreadRandom random;
+        return random;
+    }
+
+    std::atomic<UUID::Version> defaultVersion{UUID::Version::V4};
+
+    // Last issued V7 (unix_ms << 12 | sequence). Advancing it with a CAS keeps
+    // V7 IDs strictly increasing across threads without taking a lock.
+    std::atomic<uint64_t> lastV7Timestamp{0};
+
+    const uint64_t kVariantMask = 0x3FFFFFFFFFFFFFFFULL;
+    const uint64_t kVariantBits = 0x8000000000000000ULL;  // RFC 4122 variant
 }
 
-UUID::UUID(const std::string& uuid) : uuid_(uuid) {}
+UUID::UUID() : UUID(generate()) {}
+
+UUID::UUID(const std::string& uuid) : UUID(fromString(uuid)) {}
+
+UUID::UUID(uint64_t high, uint64_t low) : high_(high), low_(low) {}
 
 std::string UUID::toString() const {
-    return uuid_;
+    char buffer[kStringLength];
+    toChars(buffer);
+    return std::string(buffer, kStringLength);
 }
 
-bool UUID::operator==(const UUID& other) const {
-    return uuid_ == other.uuid_;
+void UUID::toChars(char* buffer) const {
+    size_t pos = 0;
+    
+    for (int i = 0; i < 16; ++i) {
+        if (isHyphenPosition(pos)) {
+            buffer[pos++] = '-';
+        }
+        uint64_t word = (i < 8) ? high_ : low_;
+        unsigned byte = static_cast<unsigned>((word >> (56 - 8 * (i % 8))) & 0xFF);
+        buffer[pos++] = kHexTable.pairs[byte][0];
+        buffer[pos++] = kHexTable.pairs[byte][1];
+    }
 }
 
-bool UUID::operator!=(const UUID& other) const {
-    return !(*this == other);
+std::size_t UUID::hash() const noexcept {
+    // Mix both words so time-ordered IDs with similar high words still spread well
+    uint64_t h = high_ * 0x9E3779B97F4A7C15ULL;
+    h ^= low_ + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+    h ^= h >> 32;
+    return static_cast<std::size_t>(h);
 }
 
 UUID UUID::generate() {
-    return UUID();
+    return defaultVersion.load(std::memory_order_relaxed) == Version::V7 ? generateV7() : generateV4();
 }
 
-UUID UUID::fromString(const std::string& uuid) {
-    return UUID(uuid);
+UUID UUID::generateV4() {
+    // Generate UUID v4 format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
+    ThreadRandom& random = threadRandom();
+    uint64_t high = random.next();
+    uint64_t low = random.next();
+    
+    high = (high & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+    low = (low & kVariantMask) | kVariantBits;
+    
+    return UUID(high, low);
 }
 
-std::string UUID::generateUUIDv4() {
-    static std::random_device rd;
-    static std::mt19937_64 gen(rd());
-    static std::uniform_int_distribution<uint64_t> dis;
+UUID UUID::generateV7() {
+    // Layout: 48-bit unix ms | version 7 | 12-bit sequence | variant | 62 random bits
+    uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    uint64_t candidate = (nowMs & 0xFFFFFFFFFFFFULL) << 12;
+    
+    uint64_t last = lastV7Timestamp.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        // Same millisecond (or clock went backwards): bump the sequence instead
+        next = (candidate > last) ? candidate : last + 1;
+    } while (!lastV7Timestamp.compare_exchange_weak(last, next, std::memory_order_relaxed));
+    
+    uint64_t high = ((next >> 12) << 16) | 0x7000ULL | (next & 0xFFFULL);
+    uint64_t low = (threadRandom().next() & kVariantMask) | kVariantBits;
+    
+    return UUID(high, low);
+}
 
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+void UUID::setDefaultVersion(Version version) {
+    defaultVersion.store(version, std::memory_order_relaxed);
+}
+
+UUID::Version UUID::getDefaultVersion() {
+    return defaultVersion.load(std::memory_order_relaxed);
+}
+
+UUID UUID::fromString(std::string_view uuid) {
+    if (uuid.size() != kStringLength) {
+        return nil();
+    }
     
-    // Generate UUID v4 format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
-    uint64_t part1 = dis(gen);
-    uint64_t part2 = dis(gen);
-    
-    ss << std::setw(8) << (part1 >> 32);
-    ss << "-";
-    ss << std::setw(4) << ((part1 >> 16) & 0xFFFF);
-    ss << "-";
-    ss << std::setw(4) << (0x4000 | ((part1 & 0x0FFF)));
-    ss << "-";
-    ss << std::setw(4) << (0x8000 | ((part2 >> 48) & 0x3FFF));
-    ss << "-";
-    ss << std::setw(12) << (part2 & 0xFFFFFFFFFFFF);
-    
-    return ss.str();
+    uint64_t words[2] = {0, 0};
+    int digit = 0;
+    
+    for (size_t i = 0; i < uuid.size(); ++i) {
+        if (isHyphenPosition(i)) {
+            if (uuid[i] != '-') {
+                return nil();
+            }
+            continue;
+        }
+        
+        int value = hexValue(uuid[i]);
+        if (value < 0) {
+            return nil();
+        }
+        
+        words[digit / 16] = (words[digit / 16] << 4) | static_cast<uint64_t>(value);
+        ++digit;
+    }
+    
+    return UUID(words[0], words[1]);
+}
+
+UUID UUID::nil() {
+    return UUID(0, 0);
 }
@@ -0,0 +1,332 @@
+#include "WriteAheadLog.h"
+#include "RecordEncoding.h"
+#include "Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    const Logger logger("WriteAheadLog");
+
+    // Header layout: length(4) op(1) typeLength(1) high(8) low(8) crc(4), then type, then payload
+    constexpr size_t kHeaderSize = 26;
+
+    int openForAppend(const std::string& path) {
+    #ifdef _WIN32
+        return _open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+    #else
+        return ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    #endif
+    }
+
+    bool writeAll(int fd, const char* data, size_t length) {
+        while (length > 0) {
+        #ifdef _WIN32
+            int written = _write(fd, data, static_cast<unsigned int>(length));
+        #else
+            ssize_t written = ::write(fd, data, length);
+        #endif
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool syncDescriptor(int fd) {
+    #ifdef _WIN32
+        return _commit(fd) == 0;
+    #else
+        return ::fsync(fd) == 0;
+    #endif
+    }
+
+    bool truncateDescriptor(int fd, uint64_t length) {
+    #ifdef _WIN32
+        return _chsize_s(fd, static_cast<__int64>(length)) == 0;
+    #else
+        return ::ftruncate(fd, static_cast<off_t>(length)) == 0;
+    #endif
+    }
+
+    void closeDescriptor(int fd) {
+    #ifdef _WIN32
+        _close(fd);
+    #else
+        ::close(fd);
+    #endif
+    }
+
+    void encodeRecord(std::string& out, const WriteAheadLog::Record& record) {
+        char header[kHeaderSize];
+        putU32(header, static_cast<uint32_t>(record.payload.size()));
+        header[4] = static_cast<char>(record.op);
+        header[5] = static_cast<char>(record.type.size());
+        putU64(header + 6, record.id.getHigh());
+        putU64(header + 14, record.id.getLow());
+        uint32_t crc = crc32(0, header + 4, 18);
+        crc = crc32(crc, record.type.data(), record.type.size());
+        crc = crc32(crc, record.payload.data(), record.payload.size());
+        putU32(header + 22, crc);
+
+        out.append(header, kHeaderSize);
+        out.append(record.type);
+        out.append(record.payload);
+    }
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& path, ApplyFn apply, SyncFn sync, uint64_t checkpointBytes)
+    : path_(path), apply_(std::move(apply)), sync_(std::move(sync)), checkpointBytes_(checkpointBytes),
+      fd_(-1), size_(0), open_(false), failed_(false), flushing_(false), syncCount_(0) {}
+
+WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+bool WriteAheadLog::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) return true;
+
+    if (!replay()) {
+        return false;
+    }
+
+    fd_ = openForAppend(path_);
+    if (fd_ < 0) {
+        logger.error() << "Failed to open write-ahead log: " << path_;
+        return false;
+    }
+
+    size_ = 0;
+    open_ = true;
+    failed_ = false;
+    return true;
+}
+
+void WriteAheadLog::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!open_) return;
+        flushed_.wait(lock, [this]() { return !flushing_ && queue_.empty(); });
+        open_ = false;
+    }
+
+    checkpoint();
+    closeDescriptor(fd_);
+    fd_ = -1;
+}
+
+bool WriteAheadLog::commit(Record record) {
+    std::vector<Record> records;
+    records.push_back(std::move(record));
+    return commit(std::move(records));
+}
+
+bool WriteAheadLog::commit(std::vector<Record> records) {
+    if (records.empty()) return true;
+
+    std::vector<std::shared_ptr<Pending>> pending;
+    pending.reserve(records.size());
+    for (auto& record : records) {
+        pending.push_back(std::make_shared<Pending>());
+        pending.back()->record = std::move(record);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_ || failed_) return false;
+    // Queued together, so one leader takes them all in the same batch
+    queue_.insert(queue_.end(), pending.begin(), pending.end());
+
+    while (!pending.back()->done) {
+        if (flushing_) {
+            flushed_.wait(lock);
+            continue;
+        }
+
+        // Become the leader for everything queued so far
+        flushing_ = true;
+        std::vector<std::shared_ptr<Pending>> batch;
+        batch.swap(queue_);
+        bool failed = failed_;
+        lock.unlock();
+
+        bool durable = !failed && writeBatch(batch);
+        for (auto& entry : batch) {
+            entry->ok = durable && apply_(entry->record);
+        }
+        if (durable && size_ >= checkpointBytes_) {
+            checkpoint();
+        }
+
+        lock.lock();
+        for (auto& entry : batch) {
+            entry->done = true;
+        }
+        flushing_ = false;
+        flushed_.notify_all();
+    }
+
+    bool ok = true;
+    for (const auto& entry : pending) {
+        ok &= entry->ok;
+    }
+    return ok;
+}
+
+uint64_t WriteAheadLog::syncCount() const {
+    return syncCount_.load();
+}
+
+size_t WriteAheadLog::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+bool WriteAheadLog::syncPath(const std::string& path) {
+#ifdef _WIN32
+    if (std::filesystem::is_directory(path)) {
+        return true;
+    }
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+#endif
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = syncDescriptor(fd);
+    closeDescriptor(fd);
+    return ok;
+}
+
+// Private helper methods
+bool WriteAheadLog::replay() {
+    if (!std::filesystem::exists(path_)) {
+        return true;
+    }
+
+    std::string contents;
+    {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file.is_open()) {
+            logger.error() << "Failed to read write-ahead log: " << path_;
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+    }
+
+    size_t offset = 0;
+    size_t replayed = 0;
+    while (offset + kHeaderSize <= contents.size()) {
+        const char* header = contents.data() + offset;
+        uint32_t payloadLength = getU32(header);
+        uint8_t op = static_cast<uint8_t>(header[4]);
+        size_t typeLength = static_cast<uint8_t>(header[5]);
+        if (offset + kHeaderSize + typeLength + payloadLength > contents.size()) {
+            break;  // Torn write at the tail
+        }
+
+        const char* body = header + kHeaderSize;
+        uint32_t crc = crc32(0, header + 4, 18);
+        crc = crc32(crc, body, typeLength + payloadLength);
+        if (crc != getU32(header + 22) ||
+            (op != static_cast<uint8_t>(Op::PUT) && op != static_cast<uint8_t>(Op::REMOVE))) {
+            break;
+        }
+
+        Record record;
+        record.op = static_cast<Op>(op);
+        record.type.assign(body, typeLength);
+        record.id = UUID(getU64(header + 6), getU64(header + 14));
+        record.payload.assign(body + typeLength, payloadLength);
+
+        if (!apply_(record)) {
+            logger.error() << "Failed to replay write-ahead log record for " << record.type << "/"
+                           << record.id.toString();
+            return false;
+        }
+
+        offset += kHeaderSize + typeLength + payloadLength;
+        ++replayed;
+    }
+
+    if (offset < contents.size()) {
+        logger.warn() << "Discarding damaged tail of write-ahead log at offset " << offset;
+    }
+    if (replayed > 0) {
+        logger.info() << "Replayed " << replayed << " write-ahead log records";
+    }
+
+    // Everything valid is applied; make it durable before dropping the log
+    if (!sync_()) {
+        logger.error() << "Failed to sync data files after write-ahead log replay";
+        return false;
+    }
+
+    try {
+        std::filesystem::resize_file(path_, 0);
+    } catch (const std::exception& e) {
+        logger.error() << "Error truncating write-ahead log: " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
+bool WriteAheadLog::writeBatch(const std::vector<std::shared_ptr<Pending>>& batch) {
+    std::string buffer;
+    for (const auto& entry : batch) {
+        encodeRecord(buffer, entry->record);
+    }
+
+    if (!writeAll(fd_, buffer.data(), buffer.size()) || !syncDescriptor(fd_)) {
+        logger.error() << "Failed to write to write-ahead log: " << path_;
+        // Cut off whatever part of the batch reached the file: replay stops
+        // at the first bad record, so later batches appended after it would
+        // be lost in a crash
+        if (!truncateDescriptor(fd_, size_)) {
+            logger.error() << "Failed to truncate write-ahead log after a failed write, "
+                           << "refusing further commits: " << path_;
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = true;
+        }
+        return false;
+    }
+
+    ++syncCount_;
+    size_ += buffer.size();
+    return true;
+}
+
+bool WriteAheadLog::checkpoint() {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    if (!sync_()) {
+        logger.error() << "Failed to sync data files at checkpoint";
+        return false;
+    }
+
+    if (!truncateDescriptor(fd_, 0)) {
+        logger.error() << "Failed to truncate write-ahead log: " << path_;
+        return false;
+    }
+
+    size_ = 0;
+    return true;
+}
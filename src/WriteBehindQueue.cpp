@@ -0,0 +1,291 @@
+#include "WriteBehindQueue.h"
+#include "Item.h"
+#include "Container.h"
+#include "Location.h"
+#include "Project.h"
+#include "Category.h"
+#include "ActivityLog.h"
+#include "Logger.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    const Logger logger("WriteBehindQueue");
+
+    template <typename T>
+    std::vector<std::shared_ptr<T>> valuesOf(const std::unordered_map<UUID, std::shared_ptr<T>>& saves) {
+        std::vector<std::shared_ptr<T>> values;
+        values.reserve(saves.size());
+        for (const auto& entry : saves) {
+            values.push_back(entry.second);
+        }
+        return values;
+    }
+
+    std::vector<UUID> idsOf(const std::unordered_set<UUID>& deletes) {
+        return std::vector<UUID>(deletes.begin(), deletes.end());
+    }
+}
+
+WriteBehindQueue::WriteBehindQueue(std::shared_ptr<IDatabase> database, const Options& options)
+    : database_(std::move(database)), options_(options), pendingCount_(0),
+      queuedSeq_(0), writtenSeq_(0), flushSeq_(0), stopping_(false) {
+    options_.capacity = std::max<size_t>(options_.capacity, 1);
+    worker_ = std::thread([this]() { run(); });
+}
+
+WriteBehindQueue::WriteBehindQueue(std::shared_ptr<IDatabase> database)
+    : WriteBehindQueue(std::move(database), Options()) {}
+
+WriteBehindQueue::~WriteBehindQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_.notify_all();
+    space_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void WriteBehindQueue::save(std::shared_ptr<Item> item) {
+    queueSave(&Batch::items, std::move(item));
+}
+
+void WriteBehindQueue::save(std::shared_ptr<Container> container) {
+    queueSave(&Batch::containers, std::move(container));
+}
+
+void WriteBehindQueue::save(std::shared_ptr<Location> location) {
+    queueSave(&Batch::locations, std::move(location));
+}
+
+void WriteBehindQueue::save(std::shared_ptr<Project> project) {
+    queueSave(&Batch::projects, std::move(project));
+}
+
+void WriteBehindQueue::save(std::shared_ptr<Category> category) {
+    queueSave(&Batch::categories, std::move(category));
+}
+
+void WriteBehindQueue::save(std::shared_ptr<ActivityLog> log) {
+    if (!log) return;
+
+    // Logs are immutable once written, so they never coalesce
+    std::unique_lock<std::mutex> lock(mutex_);
+    waitForSpace(lock);
+    pending_.activity.push_back(std::move(log));
+    ++pendingCount_;
+    ++queuedSeq_;
+    ++stats_.queued;
+    work_.notify_one();
+}
+
+void WriteBehindQueue::removeItem(const UUID& id) {
+    queueRemove(&Batch::items, id);
+}
+
+void WriteBehindQueue::removeContainer(const UUID& id) {
+    queueRemove(&Batch::containers, id);
+}
+
+void WriteBehindQueue::removeLocation(const UUID& id) {
+    queueRemove(&Batch::locations, id);
+}
+
+void WriteBehindQueue::removeProject(const UUID& id) {
+    queueRemove(&Batch::projects, id);
+}
+
+void WriteBehindQueue::removeCategory(const UUID& id) {
+    queueRemove(&Batch::categories, id);
+}
+
+bool WriteBehindQueue::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = queuedSeq_;
+    if (writtenSeq_ >= target) {
+        return true;
+    }
+
+    uint64_t failures = stats_.failedBatches;
+    flushSeq_ = std::max(flushSeq_, target);
+    work_.notify_one();
+    written_.wait(lock, [&]() {
+        return writtenSeq_ >= target || stats_.failedBatches != failures || stopping_;
+    });
+    return writtenSeq_ >= target;
+}
+
+WriteBehindQueue::Stats WriteBehindQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.pending = pendingCount_;
+    return stats;
+}
+
+const WriteBehindQueue::Options& WriteBehindQueue::getOptions() const {
+    return options_;
+}
+
+// Private helper methods
+template <typename T>
+void WriteBehindQueue::queueSave(Writes<T> Batch::*writes, std::shared_ptr<T> entity) {
+    if (!entity) return;
+    UUID id = entity->getId();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto queued = [&]() {
+        const Writes<T>& current = pending_.*writes;
+        return current.saves.count(id) > 0 || current.deletes.count(id) > 0;
+    };
+    if (!queued()) {
+        waitForSpace(lock);
+    }
+
+    // Re-checked: the pending batch may have been taken while waiting
+    if (queued()) {
+        ++stats_.coalesced;
+    } else {
+        ++pendingCount_;
+    }
+    Writes<T>& current = pending_.*writes;
+    current.deletes.erase(id);
+    current.saves[id] = std::move(entity);
+    ++queuedSeq_;
+    ++stats_.queued;
+    work_.notify_one();
+}
+
+template <typename T>
+void WriteBehindQueue::queueRemove(Writes<T> Batch::*writes, const UUID& id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto queued = [&]() {
+        const Writes<T>& current = pending_.*writes;
+        return current.saves.count(id) > 0 || current.deletes.count(id) > 0;
+    };
+    if (!queued()) {
+        waitForSpace(lock);
+    }
+
+    if (queued()) {
+        ++stats_.coalesced;
+    } else {
+        ++pendingCount_;
+    }
+    Writes<T>& current = pending_.*writes;
+    current.saves.erase(id);
+    current.deletes.insert(id);
+    ++queuedSeq_;
+    ++stats_.queued;
+    work_.notify_one();
+}
+
+void WriteBehindQueue::waitForSpace(std::unique_lock<std::mutex>& lock) {
+    if (pendingCount_ < options_.capacity) {
+        return;
+    }
+
+    ++stats_.blockedProducers;
+    work_.notify_one();
+    space_.wait(lock, [this]() { return pendingCount_ < options_.capacity || stopping_; });
+}
+
+void WriteBehindQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_.wait(lock, [this]() { return pendingCount_ > 0 || stopping_; });
+        if (pendingCount_ == 0) {
+            break;
+        }
+
+        // Let writes accumulate, and coalesce, unless someone is waiting
+        work_.wait_for(lock, options_.maxDelay, [this]() {
+            return stopping_ || flushSeq_ > writtenSeq_ || pendingCount_ * 2 >= options_.capacity;
+        });
+
+        Batch batch = std::move(pending_);
+        pending_ = Batch();
+        size_t count = pendingCount_;
+        pendingCount_ = 0;
+        uint64_t seq = queuedSeq_;
+        space_.notify_all();
+
+        lock.unlock();
+        bool ok = writeBatch(batch);
+        lock.lock();
+
+        ++stats_.batches;
+        if (ok) {
+            stats_.written += count;
+            writtenSeq_ = seq;
+        } else {
+            ++stats_.failedBatches;
+            if (stopping_) {
+                logger.error() << "Write-behind queue stopped; dropping " << count << " unwritten entities";
+            } else {
+                requeue(batch);
+            }
+        }
+        written_.notify_all();
+
+        if (!ok && !stopping_) {
+            work_.wait_for(lock, options_.retryDelay, [this]() { return stopping_; });
+        }
+    }
+}
+
+bool WriteBehindQueue::writeBatch(const Batch& batch) {
+    UnitOfWork work(*database_);
+    bool ok = true;
+
+    // Referenced entities first, for backends that enforce foreign keys
+    if (!batch.categories.saves.empty()) ok &= database_->saveCategories(valuesOf(batch.categories.saves));
+    if (!batch.locations.saves.empty()) ok &= database_->saveLocations(valuesOf(batch.locations.saves));
+    if (!batch.containers.saves.empty()) ok &= database_->saveContainers(valuesOf(batch.containers.saves));
+    if (!batch.items.saves.empty()) ok &= database_->saveItems(valuesOf(batch.items.saves));
+    if (!batch.projects.saves.empty()) ok &= database_->saveProjects(valuesOf(batch.projects.saves));
+    if (!batch.activity.empty()) ok &= database_->saveActivityLogs(batch.activity);
+
+    // Delete results are not checked: the default batch deletes report an
+    // ID that is already gone as a failure, which would retry forever
+    if (!batch.projects.deletes.empty()) database_->deleteProjects(idsOf(batch.projects.deletes));
+    if (!batch.items.deletes.empty()) database_->deleteItems(idsOf(batch.items.deletes));
+    if (!batch.containers.deletes.empty()) database_->deleteContainers(idsOf(batch.containers.deletes));
+    if (!batch.locations.deletes.empty()) database_->deleteLocations(idsOf(batch.locations.deletes));
+    if (!batch.categories.deletes.empty()) database_->deleteCategories(idsOf(batch.categories.deletes));
+
+    if (!ok) {
+        logger.warn() << "Write-behind batch failed; retrying in " << options_.retryDelay.count() << " ms";
+        return false;
+    }
+    return !work.isActive() || work.commit();
+}
+
+void WriteBehindQueue::requeue(Batch& failed) {
+    // Newer writes queued while the batch ran take precedence
+    auto restore = [this](auto& from, auto& into) {
+        for (auto& entry : from.saves) {
+            if (!into.saves.count(entry.first) && !into.deletes.count(entry.first)) {
+                into.saves.emplace(entry.first, std::move(entry.second));
+                ++pendingCount_;
+            }
+        }
+        for (const auto& id : from.deletes) {
+            if (!into.saves.count(id) && !into.deletes.count(id)) {
+                into.deletes.insert(id);
+                ++pendingCount_;
+            }
+        }
+    };
+    restore(failed.items, pending_.items);
+    restore(failed.containers, pending_.containers);
+    restore(failed.locations, pending_.locations);
+    restore(failed.projects, pending_.projects);
+    restore(failed.categories, pending_.categories);
+
+    pending_.activity.insert(pending_.activity.begin(), std::make_move_iterator(failed.activity.begin()),
+                             std::make_move_iterator(failed.activity.end()));
+    pendingCount_ += failed.activity.size();
+}
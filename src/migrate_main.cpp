@@ -0,0 +1,44 @@
+#include "LocalDatabase.h"
+#include <iostream>
+#include <string>
+
+// Converts a LocalDatabase directory between the flat and sharded
+// file-per-entity layouts. Stop the server before running it.
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <dataDirectory> <flat|sharded>" << std::endl;
+    std::cout << "\nMoves every record file into the chosen layout:" << std::endl;
+    std::cout << "  flat      <type>/<uuid>.json" << std::endl;
+    std::cout << "  sharded   <type>/ab/cd/<uuid>.json" << std::endl;
+    std::cout << "\nAn interrupted run can simply be started again." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string dataDirectory = argv[1];
+    std::string layout = argv[2];
+    LocalDatabase::StorageMode mode;
+    if (layout == "flat") {
+        mode = LocalDatabase::StorageMode::FILE_PER_ENTITY;
+    } else if (layout == "sharded") {
+        mode = LocalDatabase::StorageMode::SHARDED_FILES;
+    } else {
+        std::cerr << "Unknown layout: " << layout << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    size_t moved = 0;
+    if (!LocalDatabase::migrateLayout(dataDirectory, mode, &moved)) {
+        std::cerr << "Migration failed after moving " << moved << " records; the directory may be partly "
+                  << "converted. Run again to finish." << std::endl;
+        return 1;
+    }
+    std::cout << "Moved " << moved << " records in " << dataDirectory << " to the " << layout << " layout"
+              << std::endl;
+    return 0;
+}
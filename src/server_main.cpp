@@ -2,6 +2,7 @@
 #include "ServerConfig.h"
 #include "LocalDatabase.h"
 #include "SQLDatabase.h"
+#include "Logger.h"
 #include <iostream>
 #include <string>
 #include <csignal>
@@ -30,7 +31,18 @@ void printUsage(const char* programName) {
     std::cout << "  --cors                  Enable CORS support" << std::endl;
     std::cout << "  --max-request <size>    Set max request size in bytes (default: 10485760)" << std::endl;
     std::cout << "  --timeout <seconds>     Set request timeout in seconds (default: 300)" << std::endl;
+    std::cout << "  --threads <n>           Worker threads (default: one per hardware thread, at least 8)" << std::endl;
+    std::cout << "  --max-queued <n>        Connections waiting for a worker before new ones get 503 (default: 256)" << std::endl;
+    std::cout << "  --keep-alive <n>        Requests per connection before it is closed (default: 100)" << std::endl;
+    std::cout << "  --keep-alive-timeout <seconds>  Idle time before a kept-alive connection is closed (default: 5)" << std::endl;
+    std::cout << "  --log-level <level>     debug, info, warn, error or off (default: info)" << std::endl;
+    std::cout << "  --access-log <n>        Log 1 in n requests; 0 turns the access log off (default: 1)" << std::endl;
     std::cout << "  --local <path>          Use local file-based database" << std::endl;
+    std::cout << "  --storage <engine>      Local storage engine: files (one file per entity, default)," << std::endl;
+    std::cout << "                          sharded (files under ab/cd/ subdirectories)" << std::endl;
+    std::cout << "                          or log (one append-only log per entity type)" << std::endl;
+    std::cout << "  --encoding <format>     Local record encoding: pretty, json, cbor or msgpack" << std::endl;
+    std::cout << "                          (default: pretty for files, json for log)" << std::endl;
     std::cout << "  --postgres <conn>       Use PostgreSQL database (connection string)" << std::endl;
     std::cout << "  --mysql <conn>          Use MySQL database (connection string)" << std::endl;
     std::cout << "  --sqlite <path>         Use SQLite database" << std::endl;
@@ -57,6 +69,8 @@ int main(int argc, char* argv[]) {
     std::string dbType = "local";
     std::string dbPath = "./data";
     std::string dbConnectionString;
+    LocalDatabase::StorageMode storageMode = LocalDatabase::StorageMode::FILE_PER_ENTITY;
+    std::string encoding;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -85,10 +99,65 @@ int main(int argc, char* argv[]) {
         else if (arg == "--timeout" && i + 1 < argc) {
             config.timeoutSeconds = std::stoi(argv[++i]);
         }
+        else if (arg == "--threads" && i + 1 < argc) {
+            config.workerThreads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--max-queued" && i + 1 < argc) {
+            config.maxQueuedConnections = std::stoi(argv[++i]);
+        }
+        else if (arg == "--keep-alive" && i + 1 < argc) {
+            config.keepAliveMaxCount = std::stoi(argv[++i]);
+        }
+        else if (arg == "--keep-alive-timeout" && i + 1 < argc) {
+            config.keepAliveTimeoutSeconds = std::stoi(argv[++i]);
+        }
+        else if (arg == "--log-level" && i + 1 < argc) {
+            std::string level = argv[++i];
+            if (level == "debug") {
+                LogSink::instance().setLevel(LogLevel::DEBUG);
+            } else if (level == "info") {
+                LogSink::instance().setLevel(LogLevel::INFO);
+            } else if (level == "warn") {
+                LogSink::instance().setLevel(LogLevel::WARN);
+            } else if (level == "error") {
+                LogSink::instance().setLevel(LogLevel::ERROR);
+            } else if (level == "off") {
+                LogSink::instance().setLevel(LogLevel::OFF);
+            } else {
+                std::cerr << "Unknown log level: " << level << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--access-log" && i + 1 < argc) {
+            config.accessLogSampling = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
         else if (arg == "--local" && i + 1 < argc) {
             dbType = "local";
             dbPath = argv[++i];
         }
+        else if (arg == "--storage" && i + 1 < argc) {
+            std::string engine = argv[++i];
+            if (engine == "log") {
+                storageMode = LocalDatabase::StorageMode::APPEND_LOG;
+            } else if (engine == "files") {
+                storageMode = LocalDatabase::StorageMode::FILE_PER_ENTITY;
+            } else if (engine == "sharded") {
+                storageMode = LocalDatabase::StorageMode::SHARDED_FILES;
+            } else {
+                std::cerr << "Unknown storage engine: " << engine << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--encoding" && i + 1 < argc) {
+            encoding = argv[++i];
+            if (encoding != "pretty" && encoding != "json" && encoding != "cbor" && encoding != "msgpack") {
+                std::cerr << "Unknown encoding: " << encoding << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
         else if (arg == "--postgres" && i + 1 < argc) {
             dbType = "postgres";
             dbConnectionString = argv[++i];
@@ -113,8 +182,21 @@ int main(int argc, char* argv[]) {
     
     try {
         if (dbType == "local") {
-            std::cout << "Initializing local file-based database at: " << dbPath << std::endl;
-            database = std::make_shared<LocalDatabase>(dbPath);
+            std::cout << "Initializing local file-based database at: " << dbPath
+                      << (storageMode == LocalDatabase::StorageMode::APPEND_LOG ? " (append-only log)" :
+                          storageMode == LocalDatabase::StorageMode::SHARDED_FILES ? " (sharded)" : "")
+                      << std::endl;
+            auto localDatabase = std::make_shared<LocalDatabase>(dbPath, storageMode);
+            if (encoding == "pretty") {
+                localDatabase->setEncoding(LocalDatabase::Encoding::PRETTY_JSON);
+            } else if (encoding == "json") {
+                localDatabase->setEncoding(LocalDatabase::Encoding::COMPACT_JSON);
+            } else if (encoding == "cbor") {
+                localDatabase->setEncoding(LocalDatabase::Encoding::CBOR);
+            } else if (encoding == "msgpack") {
+                localDatabase->setEncoding(LocalDatabase::Encoding::MESSAGEPACK);
+            }
+            database = localDatabase;
         }
         else if (dbType == "postgres") {
             std::cout << "Initializing PostgreSQL database..." << std::endl;
@@ -183,6 +265,10 @@ int main(int argc, char* argv[]) {
     std::cout << "CORS: " << (config.enableCORS ? "Enabled" : "Disabled") << std::endl;
     std::cout << "Max Request Size: " << config.maxRequestSize << " bytes" << std::endl;
     std::cout << "Timeout: " << config.timeoutSeconds << " seconds" << std::endl;
+    std::cout << "Worker Threads: " << (config.workerThreads > 0 ? std::to_string(config.workerThreads) : "auto") << std::endl;
+    std::cout << "Max Queued Connections: " << config.maxQueuedConnections << std::endl;
+    std::cout << "Keep-Alive: " << config.keepAliveMaxCount << " requests, "
+              << config.keepAliveTimeoutSeconds << " seconds" << std::endl;
     std::cout << "========================================\n" << std::endl;
     
     try {
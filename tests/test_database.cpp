@@ -1,13 +1,34 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "LocalDatabase.h"
+#include "SQLDatabase.h"
+#include "SQLConnection.h"
+#include "SQLConnectionPool.h"
 #include "Item.h"
 #include "Container.h"
 #include "Location.h"
 #include "Category.h"
 #include "Project.h"
 #include "ActivityLog.h"
+#include "ActivityLogStore.h"
+#include "LogRecordStore.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include "WriteAheadLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
 #include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -395,6 +416,784 @@ TEST_F(LocalDatabaseTest, DataPersistsAcrossConnections) {
     db2->disconnect();
 }
 
+// ============================================================================
+// Parallel Loading
+// ============================================================================
+
+TEST(ThreadPoolTest, ParallelForCoversEveryIndexOnce) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++hits[i];
+        }
+    }, 10);
+    
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsAfterEveryShardFinishes) {
+    ThreadPool pool(3);
+    for (size_t failing : {size_t(0), size_t(500)}) {   // Caller's shard, then a worker's
+        std::atomic<int> finished{0};
+        EXPECT_THROW(pool.parallelFor(1000, [&](size_t begin, size_t end) {
+            if (begin <= failing && failing < end) {
+                throw std::runtime_error("shard failed");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++finished;
+        }, 10), std::runtime_error);
+        EXPECT_EQ(finished.load(), 3);
+    }
+
+    // The pool is still usable afterwards
+    std::atomic<size_t> covered{0};
+    pool.parallelFor(100, [&](size_t begin, size_t end) { covered += end - begin; });
+    EXPECT_EQ(covered.load(), 100u);
+}
+
+TEST_F(LocalDatabaseTest, ParallelLoadMatchesSequential) {
+    std::set<std::string> saved;
+    for (int i = 0; i < 500; ++i) {
+        auto item = std::make_shared<Item>("Part " + std::to_string(i), nullptr, i);
+        ASSERT_TRUE(db->saveItem(item));
+        saved.insert(item->getName());
+    }
+    db->disconnect();
+    
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        db->setLoadThreads(threads);
+        ASSERT_TRUE(db->connect());
+        
+        std::set<std::string> loaded;
+        for (const auto& item : db->loadAllItems()) {
+            loaded.insert(item->getName());
+        }
+        EXPECT_EQ(loaded, saved);
+        db->disconnect();
+    }
+}
+
+TEST_F(LocalDatabaseTest, SnapshotRestoresReferences) {
+    auto category = std::make_shared<Category>("Passives", "");
+    auto subcategory = std::make_shared<Category>("Resistors", "");
+    category->addSubcategory(subcategory);
+    auto location = std::make_shared<Location>("Lab", "Building 4");
+    auto shelf = std::make_shared<Container>("Shelf", ContainerType::INVENTORY);
+    auto drawer = std::make_shared<Container>("Drawer", ContainerType::SUBCONTAINER);
+    location->addContainer(shelf);
+    shelf->addSubcontainer(drawer);
+    auto item = std::make_shared<Item>("Resistor 1k", subcategory, 100);
+    drawer->addItem(item);
+    auto log = std::make_shared<ActivityLog>(ActivityType::CREATED, item, "Created", "user1");
+    item->addActivity(log);
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(shelf);
+    
+    db->saveCategory(category);
+    db->saveCategory(subcategory);
+    db->saveLocation(location);
+    db->saveContainer(shelf);
+    db->saveContainer(drawer);
+    db->saveItem(item);
+    db->saveActivityLog(log);
+    db->saveProject(project);
+    db->disconnect();
+    
+    auto reopened = std::make_shared<LocalDatabase>(testDbPath);
+    ASSERT_TRUE(reopened->connect());
+    EntitySnapshot snapshot;
+    ASSERT_TRUE(reopened->loadSnapshot(snapshot));
+    ASSERT_EQ(snapshot.items.size(), 1u);
+    ASSERT_EQ(snapshot.containers.size(), 2u);
+    ASSERT_EQ(snapshot.projects.size(), 1u);
+    
+    auto loadedItem = snapshot.items[0];
+    EXPECT_EQ(loadedItem->getId(), item->getId());
+    ASSERT_NE(loadedItem->getCategory(), nullptr);
+    EXPECT_EQ(loadedItem->getCategory()->getId(), subcategory->getId());
+    ASSERT_NE(loadedItem->getCurrentContainer(), nullptr);
+    EXPECT_EQ(loadedItem->getCurrentContainer()->getId(), drawer->getId());
+    ASSERT_EQ(loadedItem->activityCount(), 1u);
+    EXPECT_EQ(loadedItem->getActivityHistory()[0]->getId(), log->getId());
+    EXPECT_EQ(loadedItem->getActivityHistory()[0]->getItem(), loadedItem);
+    
+    // The same instances are shared across the graph, not copies
+    auto loadedDrawer = loadedItem->getCurrentContainer();
+    ASSERT_NE(loadedDrawer->getParentContainer(), nullptr);
+    auto loadedShelf = loadedDrawer->getParentContainer();
+    EXPECT_EQ(loadedShelf->getId(), shelf->getId());
+    EXPECT_EQ(loadedShelf->getSubcontainer(drawer->getId()), loadedDrawer);
+    ASSERT_NE(loadedShelf->getLocation(), nullptr);
+    EXPECT_EQ(loadedShelf->getLocation()->getContainer(shelf->getId()), loadedShelf);
+    EXPECT_EQ(snapshot.projects[0]->getContainer(shelf->getId()), loadedShelf);
+    
+    for (const auto& loadedCategory : snapshot.categories) {
+        if (loadedCategory->getId() == category->getId()) {
+            ASSERT_EQ(loadedCategory->subcategoryCount(), 1u);
+            EXPECT_EQ(loadedCategory->getSubcategories()[0], loadedItem->getCategory());
+        }
+    }
+    reopened->disconnect();
+}
+
+TEST_F(LocalDatabaseTest, LoadAllLinksOneLevelOfReferences) {
+    auto category = std::make_shared<Category>("Passives", "");
+    auto location = std::make_shared<Location>("Lab", "");
+    auto shelf = std::make_shared<Container>("Shelf", ContainerType::INVENTORY);
+    auto drawer = std::make_shared<Container>("Drawer", ContainerType::SUBCONTAINER);
+    location->addContainer(shelf);
+    shelf->addSubcontainer(drawer);
+    auto loose = std::make_shared<Item>("Loose", nullptr, 1);
+    auto resistor = std::make_shared<Item>("Resistor", category, 100);
+    shelf->addItem(loose);
+    drawer->addItem(resistor);
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(shelf);
+
+    ASSERT_TRUE(db->saveCategory(category));
+    ASSERT_TRUE(db->saveLocation(location));
+    ASSERT_TRUE(db->saveContainers({shelf, drawer}));
+    ASSERT_TRUE(db->saveItems({loose, resistor}));
+    ASSERT_TRUE(db->saveProject(project));
+
+    for (const auto& item : db->loadAllItems()) {
+        ASSERT_NE(item->getCurrentContainer(), nullptr);
+        if (item->getId() == resistor->getId()) {
+            ASSERT_NE(item->getCategory(), nullptr);
+            EXPECT_EQ(item->getCategory()->getName(), "Passives");
+            EXPECT_EQ(item->getCurrentContainer()->getName(), "Drawer");
+        } else {
+            EXPECT_EQ(item->getCategory(), nullptr);
+            EXPECT_EQ(item->getCurrentContainer()->getName(), "Shelf");
+        }
+    }
+
+    auto containers = db->loadAllContainers();
+    ASSERT_EQ(containers.size(), 2u);
+    for (const auto& container : containers) {
+        EXPECT_EQ(container->itemCount(), 1u);
+        if (container->getId() == shelf->getId()) {
+            ASSERT_NE(container->getLocation(), nullptr);
+            EXPECT_EQ(container->getLocation()->getName(), "Lab");
+            EXPECT_EQ(container->subcontainerCount(), 1u);
+        } else {
+            ASSERT_NE(container->getParentContainer(), nullptr);
+            EXPECT_EQ(container->getParentContainer()->getId(), shelf->getId());
+        }
+    }
+
+    auto locations = db->loadAllLocations();
+    ASSERT_EQ(locations.size(), 1u);
+    EXPECT_EQ(locations[0]->containerCount(), 1u);
+
+    auto projects = db->loadAllProjects();
+    ASSERT_EQ(projects.size(), 1u);
+    EXPECT_EQ(projects[0]->containerCount(), 1u);
+    EXPECT_EQ(projects[0]->getTotalItemCount(), 2);
+    
+    // Batch loads link the same references
+    auto drawers = db->loadContainers({drawer->getId()});
+    ASSERT_EQ(drawers.size(), 1u);
+    ASSERT_NE(drawers[0]->getParentContainer(), nullptr);
+    EXPECT_EQ(drawers[0]->getParentContainer()->getName(), "Shelf");
+    EXPECT_EQ(drawers[0]->itemCount(), 1u);
+    auto resistors = db->loadItems({resistor->getId()});
+    ASSERT_EQ(resistors.size(), 1u);
+    ASSERT_NE(resistors[0]->getCategory(), nullptr);
+    EXPECT_EQ(resistors[0]->getCategory()->getName(), "Passives");
+    EXPECT_EQ(db->loadProjects({project->getId()})[0]->getTotalItemCount(), 2);
+}
+
+// ============================================================================
+// Record Encoding
+// ============================================================================
+
+TEST_F(LocalDatabaseTest, EncodingsCanBeMixedInOneDirectory) {
+    using Encoding = LocalDatabase::Encoding;
+    EXPECT_EQ(db->getEncoding(), Encoding::PRETTY_JSON);
+    
+    // Existing pretty JSON records stay readable after switching encodings
+    auto legacy = std::make_shared<Item>("Legacy", nullptr, 1, "Saved as indented JSON");
+    ASSERT_TRUE(db->saveItem(legacy));
+    
+    std::vector<std::pair<Encoding, char>> encodings = {
+        {Encoding::COMPACT_JSON, '{'}, {Encoding::CBOR, '\x01'}, {Encoding::MESSAGEPACK, '\x02'}
+    };
+    std::vector<std::shared_ptr<Item>> saved;
+    for (const auto& encoding : encodings) {
+        db->setEncoding(encoding.first);
+        auto item = std::make_shared<Item>("Item " + std::to_string(saved.size()), nullptr, 5, "Binary-safe");
+        ASSERT_TRUE(db->saveItem(item));
+        
+        std::string payload;
+        ASSERT_TRUE(db->getRecordStore()->get("items", item->getId(), payload));
+        EXPECT_EQ(payload[0], encoding.second);
+        saved.push_back(item);
+    }
+    
+    db->disconnect();
+    ASSERT_TRUE(db->connect());
+    EXPECT_EQ(db->loadAllItems().size(), 4u);
+    EXPECT_EQ(db->loadItem(legacy->getId())->getDescription(), "Saved as indented JSON");
+    for (const auto& item : saved) {
+        auto loaded = db->loadItem(item->getId());
+        ASSERT_NE(loaded, nullptr);
+        EXPECT_EQ(loaded->getName(), item->getName());
+        EXPECT_EQ(loaded->getQuantity(), 5);
+    }
+}
+
+// ============================================================================
+// File Layout
+// ============================================================================
+
+TEST_F(LocalDatabaseTest, MigratesBetweenFlatAndShardedLayouts) {
+    auto category = std::make_shared<Category>("Parts", "");
+    ASSERT_TRUE(db->saveCategory(category));
+    std::vector<UUID> ids;
+    for (int i = 0; i < 50; ++i) {
+        auto item = std::make_shared<Item>("Item " + std::to_string(i), category, i);
+        ASSERT_TRUE(db->saveItem(item));
+        ids.push_back(item->getId());
+    }
+    db->disconnect();
+    
+    size_t moved = 0;
+    ASSERT_TRUE(LocalDatabase::migrateLayout(testDbPath, LocalDatabase::StorageMode::SHARDED_FILES, &moved));
+    EXPECT_EQ(moved, 51u);
+    std::string name = ids[0].toString();
+    EXPECT_TRUE(fs::exists(testDbPath + "/items/" + name.substr(32, 2) + "/" + name.substr(34, 2) + "/" + name + ".json"));
+    EXPECT_FALSE(fs::exists(testDbPath + "/items/" + name + ".json"));
+    
+    auto sharded = std::make_shared<LocalDatabase>(testDbPath, LocalDatabase::StorageMode::SHARDED_FILES);
+    sharded->setLoadThreads(4);
+    ASSERT_TRUE(sharded->connect());
+    EXPECT_EQ(sharded->loadAllItems().size(), 50u);
+    auto added = std::make_shared<Item>("Added while sharded", category, 1);
+    ASSERT_TRUE(sharded->saveItem(added));
+    ASSERT_NE(sharded->loadItem(ids[7]), nullptr);
+    sharded->disconnect();
+    
+    ASSERT_TRUE(LocalDatabase::migrateLayout(testDbPath, LocalDatabase::StorageMode::FILE_PER_ENTITY, &moved));
+    EXPECT_EQ(moved, 52u);
+    EXPECT_TRUE(fs::exists(testDbPath + "/items/" + name + ".json"));
+    
+    ASSERT_TRUE(db->connect());
+    EXPECT_EQ(db->loadAllItems().size(), 51u);
+    EXPECT_NE(db->loadItem(added->getId()), nullptr);
+}
+
+// ============================================================================
+// Append-Only Log Storage
+// ============================================================================
+
+TEST_F(LocalDatabaseTest, AppendLogPersistsAcrossConnections) {
+    std::string logDbPath = testDbPath + "/log";
+    auto logDb = std::make_shared<LocalDatabase>(logDbPath, LocalDatabase::StorageMode::APPEND_LOG);
+    ASSERT_TRUE(logDb->connect());
+    EXPECT_TRUE(fs::exists(logDbPath + "/items.log"));
+    
+    auto kept = std::make_shared<Item>("Kept", nullptr, 5);
+    auto removed = std::make_shared<Item>("Removed", nullptr, 1);
+    EXPECT_TRUE(logDb->saveItem(kept));
+    EXPECT_TRUE(logDb->saveItem(removed));
+    kept->setQuantity(7);
+    EXPECT_TRUE(logDb->saveItem(kept));
+    EXPECT_TRUE(logDb->deleteItem(removed->getId()));
+    EXPECT_FALSE(logDb->deleteItem(removed->getId()));
+    logDb->disconnect();
+    
+    // Index is rebuilt from the log on open
+    auto reopened = std::make_shared<LocalDatabase>(logDbPath, LocalDatabase::StorageMode::APPEND_LOG);
+    ASSERT_TRUE(reopened->connect());
+    auto loaded = reopened->loadItem(kept->getId());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getQuantity(), 7);
+    EXPECT_EQ(reopened->loadItem(removed->getId()), nullptr);
+    EXPECT_EQ(reopened->loadAllItems().size(), 1);
+}
+
+TEST_F(LocalDatabaseTest, BatchOperationsAndUnitsOfWork) {
+    for (auto mode : {LocalDatabase::StorageMode::FILE_PER_ENTITY, LocalDatabase::StorageMode::APPEND_LOG}) {
+        std::string path = testDbPath + (mode == LocalDatabase::StorageMode::APPEND_LOG ? "/log" : "/files");
+        LocalDatabase batchDb(path, mode);
+        ASSERT_TRUE(batchDb.connect());
+        
+        std::vector<std::shared_ptr<Item>> items;
+        std::vector<UUID> ids;
+        for (int i = 0; i < 200; ++i) {
+            items.push_back(std::make_shared<Item>("Part " + std::to_string(i), nullptr, i));
+            ids.push_back(items.back()->getId());
+        }
+        ASSERT_TRUE(batchDb.saveItems(items));
+        EXPECT_EQ(batchDb.loadItems({ids[3], ids[150], UUID::generate()}).size(), 2u);
+        ASSERT_TRUE(batchDb.deleteItems({ids[0], ids[1]}));
+        EXPECT_EQ(batchDb.loadAllItems().size(), 198u);
+        
+        // Staged writes stay invisible and are dropped without a commit
+        auto staged = std::make_shared<Item>("Staged", nullptr, 1);
+        {
+            UnitOfWork work(batchDb);
+            ASSERT_TRUE(work.isActive());
+            EXPECT_FALSE(UnitOfWork(batchDb).isActive());
+            EXPECT_TRUE(batchDb.saveItem(staged));
+            EXPECT_TRUE(batchDb.deleteItems({ids[2]}));
+            EXPECT_EQ(batchDb.loadItem(staged->getId()), nullptr);
+        }
+        EXPECT_EQ(batchDb.loadItem(staged->getId()), nullptr);
+        EXPECT_NE(batchDb.loadItem(ids[2]), nullptr);
+        
+        {
+            UnitOfWork work(batchDb);
+            EXPECT_TRUE(batchDb.saveItem(staged));
+            EXPECT_TRUE(batchDb.deleteItem(ids[2]));
+            EXPECT_TRUE(batchDb.saveActivityLog(
+                std::make_shared<ActivityLog>(ActivityType::CREATED, staged, "Created", "alice")));
+            EXPECT_TRUE(batchDb.loadActivityLogsForItem(staged->getId()).empty());
+            EXPECT_TRUE(work.commit());
+        }
+        EXPECT_NE(batchDb.loadItem(staged->getId()), nullptr);
+        EXPECT_EQ(batchDb.loadItem(ids[2]), nullptr);
+        EXPECT_EQ(batchDb.loadActivityLogsForItem(staged->getId()).size(), 1u);
+        batchDb.disconnect();
+        
+        LocalDatabase reopened(path, mode);
+        ASSERT_TRUE(reopened.connect());
+        EXPECT_EQ(reopened.loadAllItems().size(), 198u);
+    }
+}
+
+TEST_F(LocalDatabaseTest, LoadItemPagesInIdOrder) {
+    std::vector<UUID> ids;
+    for (int i = 0; i < 25; ++i) {
+        auto item = std::make_shared<Item>("Part " + std::to_string(i), nullptr, i);
+        ASSERT_TRUE(db->saveItem(item));
+        ids.push_back(item->getId());
+    }
+    std::sort(ids.begin(), ids.end());
+    
+    // Walk the pages with each one's cursor until none remains
+    std::vector<UUID> seen;
+    UUID cursor = UUID::nil();
+    int pages = 0;
+    do {
+        auto page = db->loadItemPage(cursor, 10);
+        EXPECT_LE(page.entities.size(), 10u);
+        for (const auto& item : page.entities) {
+            seen.push_back(item->getId());
+        }
+        cursor = page.next;
+        ++pages;
+    } while (!cursor.isNil() && pages < 10);
+    
+    EXPECT_EQ(pages, 3);
+    EXPECT_EQ(seen, ids);
+    EXPECT_TRUE(db->loadItemPage(ids.back(), 10).entities.empty());
+}
+
+TEST_F(LocalDatabaseTest, ItemPagesFollowWritesAndLinkReferences) {
+    auto category = std::make_shared<Category>("Fasteners", "");
+    ASSERT_TRUE(db->saveCategory(category));
+    std::vector<UUID> ids;
+    for (int i = 0; i < 5; ++i) {
+        auto item = std::make_shared<Item>("Bolt " + std::to_string(i), category, i);
+        ASSERT_TRUE(db->saveItem(item));
+        ids.push_back(item->getId());
+    }
+    
+    // The first page builds the index; later writes must show up in it
+    ASSERT_EQ(db->loadItemPage(UUID::nil(), 10).entities.size(), 5u);
+    auto added = std::make_shared<Item>("Nut", category, 1);
+    ASSERT_TRUE(db->saveItem(added));
+    ids.push_back(added->getId());
+    ASSERT_TRUE(db->deleteItem(ids[0]));
+    ids.erase(ids.begin());
+    auto batched = std::make_shared<Item>("Washer", nullptr, 1);
+    ASSERT_TRUE(db->saveItems({batched}));
+    ids.push_back(batched->getId());
+    ASSERT_TRUE(db->beginTransaction());
+    ASSERT_TRUE(db->deleteItem(ids[0]));
+    ASSERT_TRUE(db->commitTransaction());
+    ids.erase(ids.begin());
+    std::sort(ids.begin(), ids.end());
+    
+    auto page = db->loadItemPage(UUID::nil(), 10);
+    ASSERT_TRUE(page.ok);
+    std::vector<UUID> seen;
+    for (const auto& item : page.entities) {
+        seen.push_back(item->getId());
+        if (item->getId() == added->getId()) {
+            ASSERT_NE(item->getCategory(), nullptr);
+            EXPECT_EQ(item->getCategory()->getName(), "Fasteners");
+        }
+    }
+    EXPECT_EQ(seen, ids);
+    EXPECT_TRUE(page.next.isNil());
+    
+    db->disconnect();
+    page = db->loadItemPage(UUID::nil(), 10);
+    EXPECT_FALSE(page.ok);
+    EXPECT_TRUE(page.entities.empty());
+}
+
+TEST(LogRecordStoreTest, CompactionAndTornTailRecovery) {
+    std::string path = "./test_log_store";
+    fs::remove_all(path);
+    
+    UUID first = UUID::generate();
+    UUID second = UUID::generate();
+    {
+        LogRecordStore store(path, {"items"});
+        ASSERT_TRUE(store.open());
+        for (int i = 0; i < 10; ++i) {
+            store.put("items", first, "version " + std::to_string(i));
+        }
+        store.put("items", second, "second");
+        EXPECT_GT(store.garbageBytes("items"), 0u);
+        
+        uint64_t before = store.logSize("items");
+        ASSERT_TRUE(store.compact("items"));
+        EXPECT_LT(store.logSize("items"), before);
+        EXPECT_EQ(store.garbageBytes("items"), 0u);
+        
+        std::string payload;
+        ASSERT_TRUE(store.get("items", first, payload));
+        EXPECT_EQ(payload, "version 9");
+    }
+    
+    // Simulate a crash in the middle of an append
+    {
+        std::ofstream log(path + "/items.log", std::ios::binary | std::ios::app);
+        log.write("\x40\x00\x00\x00\x01garbage", 12);
+    }
+    
+    LogRecordStore store(path, {"items"});
+    ASSERT_TRUE(store.open());
+    EXPECT_EQ(store.list("items").size(), 2u);
+    EXPECT_TRUE(store.put("items", second, "after recovery"));
+    store.close();
+    
+    ASSERT_TRUE(store.open());
+    std::string payload;
+    ASSERT_TRUE(store.get("items", second, payload));
+    EXPECT_EQ(payload, "after recovery");
+    store.close();
+    fs::remove_all(path);
+}
+
+TEST(LogRecordStoreTest, MappedReadsSeeLaterAppends) {
+    std::string path = "./test_log_store";
+    fs::remove_all(path);
+    
+    UUID first = UUID::generate();
+    UUID second = UUID::generate();
+    LogRecordStore store(path, {"items"});
+    ASSERT_TRUE(store.open());
+    store.put("items", second, "written first");
+    store.put("items", first, "written second");
+    
+    std::string payload;
+    auto capture = [&payload](const char* data, size_t size) { payload.assign(data, size); };
+    ASSERT_TRUE(store.read("items", first, capture));
+    EXPECT_EQ(payload, "written second");
+    
+    // Lands past the end of the current mapping
+    store.put("items", first, "rewritten");
+    ASSERT_TRUE(store.read("items", first, capture));
+    EXPECT_EQ(payload, "rewritten");
+    EXPECT_FALSE(store.read("items", UUID::generate(), capture));
+    
+    // Log order, not hash order
+    auto ids = store.list("items");
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids[0], second);
+    EXPECT_EQ(ids[1], first);
+    
+    MappedFile empty;
+    { std::ofstream touch(path + "/empty.bin"); }
+    ASSERT_TRUE(empty.open(path + "/empty.bin"));
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_FALSE(empty.open(path + "/missing.bin"));
+    
+    store.close();
+    fs::remove_all(path);
+}
+
+TEST_F(LocalDatabaseTest, ReadModesLoadTheSameRecords) {
+    auto category = std::make_shared<Category>("Parts", "");
+    auto item = std::make_shared<Item>("Resistor 10k", category, 42, "Metal film");
+    ASSERT_TRUE(db->saveItem(item));
+    
+    EXPECT_EQ(db->getReadMode(), LocalDatabase::ReadMode::MEMORY_MAP);
+    auto mapped = db->loadItem(item->getId());
+    db->setReadMode(LocalDatabase::ReadMode::STREAM);
+    auto streamed = db->loadItem(item->getId());
+    
+    ASSERT_NE(mapped, nullptr);
+    ASSERT_NE(streamed, nullptr);
+    EXPECT_EQ(mapped->getName(), streamed->getName());
+    EXPECT_EQ(mapped->getQuantity(), 42);
+    EXPECT_EQ(streamed->getQuantity(), 42);
+}
+
+// ============================================================================
+// Activity Log Store
+// ============================================================================
+
+TEST(ActivityLogStoreTest, PartitionsByDayAndServesIndexedQueries) {
+    std::string path = "./test_activity_store";
+    fs::remove_all(path);
+    
+    const int64_t day = 24LL * 60 * 60 * 1000;
+    const int64_t base = 1714521600000LL;  // 2024-05-01T00:00:00Z
+    UUID item = UUID::generate();
+    UUID other = UUID::generate();
+    
+    auto makeEntry = [](int64_t timestamp, const UUID& itemId, const std::string& user) {
+        ActivityLogStore::Entry entry;
+        entry.id = UUID::generate();
+        entry.timestamp = timestamp;
+        entry.itemId = itemId;
+        entry.userId = user;
+        entry.payload = "at " + std::to_string(timestamp);
+        return entry;
+    };
+    
+    ActivityLogStore::Entry blank;
+    EXPECT_TRUE(blank.id.isNil());
+    EXPECT_TRUE(blank.itemId.isNil());
+    
+    {
+        ActivityLogStore store(path);
+        ASSERT_TRUE(store.open());
+        ASSERT_TRUE(store.append(makeEntry(base + 1000, item, "alice")));
+        ASSERT_TRUE(store.append(makeEntry(base + day + 1000, other, "bob")));
+        ASSERT_TRUE(store.append(makeEntry(base + 2 * day + 1000, item, "bob")));
+        // Arrives late, into an older segment
+        auto late = makeEntry(base + 5000, item, "alice");
+        ASSERT_TRUE(store.append(late));
+        EXPECT_TRUE(store.append(late));
+        
+        EXPECT_EQ(store.size(), 4u);
+        EXPECT_EQ(store.segmentCount(), 3u);
+        EXPECT_TRUE(fs::exists(path + "/2024-05-01.seg"));
+    }
+    
+    // Simulate a crash in the middle of an append
+    {
+        std::ofstream segment(path + "/2024-05-03.seg", std::ios::binary | std::ios::app);
+        segment.write("\x40\x00\x00\x00\x01garbage", 12);
+    }
+    
+    ActivityLogStore store(path);
+    ASSERT_TRUE(store.open());
+    EXPECT_EQ(store.size(), 4u);
+    
+    auto recent = store.recent(2);
+    ASSERT_EQ(recent.size(), 2u);
+    EXPECT_EQ(recent[0].timestamp, base + 2 * day + 1000);
+    EXPECT_EQ(recent[1].timestamp, base + day + 1000);
+    
+    auto history = store.forItem(item);
+    ASSERT_EQ(history.size(), 3u);
+    EXPECT_EQ(history[0].timestamp, base + 2 * day + 1000);
+    EXPECT_EQ(history[1].payload, "at " + std::to_string(base + 5000));
+    EXPECT_EQ(history[2].timestamp, base + 1000);
+    
+    EXPECT_EQ(store.forUser("bob").size(), 2u);
+    EXPECT_EQ(store.between(base, base + day).size(), 2u);
+    
+    EXPECT_EQ(store.dropBefore(base + day), 1u);
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.forItem(item).size(), 1u);
+    EXPECT_FALSE(fs::exists(path + "/2024-05-01.seg"));
+    store.close();
+    fs::remove_all(path);
+}
+
+TEST_F(LocalDatabaseTest, RecentActivityLogsAreNewestFirst) {
+    auto category = std::make_shared<Category>("Parts", "");
+    auto item = std::make_shared<Item>("Test Item", category, 10);
+    db->saveItem(item);
+    
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        auto log = std::make_shared<ActivityLog>(UUID::generate(), ActivityType::MODIFIED, item,
+                                                 "Change " + std::to_string(i), "user1",
+                                                 now + std::chrono::seconds(i));
+        log->setQuantityChange(i);
+        ASSERT_TRUE(db->saveActivityLog(log));
+    }
+    
+    db->disconnect();
+    ASSERT_TRUE(db->connect());
+    
+    auto logs = db->loadRecentActivityLogs(3);
+    ASSERT_EQ(logs.size(), 3u);
+    EXPECT_EQ(logs[0]->getDescription(), "Change 4");
+    EXPECT_EQ(logs[2]->getDescription(), "Change 2");
+    EXPECT_EQ(logs[0]->getQuantityChange(), 4);
+    ASSERT_NE(logs[0]->getItem(), nullptr);
+    EXPECT_EQ(logs[0]->getItem()->getId(), item->getId());
+}
+
+// ============================================================================
+// Write-Ahead Log
+// ============================================================================
+
+TEST(WriteAheadLogTest, ConcurrentCommitsShareOneSync) {
+    std::string path = "./test_wal.log";
+    fs::remove(path);
+    
+    const size_t writers = 8;
+    std::atomic<bool> leaderApplying{false};
+    std::atomic<bool> release{false};
+    std::vector<UUID> applied;
+    
+    WriteAheadLog wal(path,
+        [&](const WriteAheadLog::Record& record) {
+            // Hold the first leader so every other writer queues up behind it
+            if (!leaderApplying.exchange(true)) {
+                while (!release) {
+                    std::this_thread::yield();
+                }
+            }
+            applied.push_back(record.id);
+            return true;
+        },
+        []() { return true; });
+    ASSERT_TRUE(wal.open());
+    
+    std::vector<std::thread> threads;
+    std::atomic<size_t> succeeded{0};
+    auto writer = [&]() {
+        if (wal.commit({WriteAheadLog::Op::PUT, "items", UUID::generate(), "payload"})) {
+            ++succeeded;
+        }
+    };
+    
+    threads.emplace_back(writer);
+    while (!leaderApplying) {
+        std::this_thread::yield();
+    }
+    for (size_t i = 1; i < writers; ++i) {
+        threads.emplace_back(writer);
+    }
+    while (wal.pendingCount() < writers - 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    // One sync for the first record, one for the whole queued batch
+    EXPECT_EQ(succeeded.load(), writers);
+    EXPECT_EQ(applied.size(), writers);
+    EXPECT_EQ(wal.syncCount(), 2u);
+    wal.close();
+    fs::remove(path);
+}
+
+TEST(WriteAheadLogTest, ReplaysUnsyncedRecordsOnOpen) {
+    std::string path = "./test_wal_replay.log";
+    fs::remove(path);
+    UUID kept = UUID::generate();
+    UUID removed = UUID::generate();
+    
+    {
+        WriteAheadLog wal(path, [](const WriteAheadLog::Record&) { return true; }, []() { return true; });
+        ASSERT_TRUE(wal.open());
+        ASSERT_TRUE(wal.commit({WriteAheadLog::Op::PUT, "items", kept, "payload"}));
+        ASSERT_TRUE(wal.commit({WriteAheadLog::Op::REMOVE, "items", removed, ""}));
+        
+        // Capture the log as a crash would leave it (close() checkpoints and truncates)
+        fs::copy_file(path, path + ".crash", fs::copy_options::overwrite_existing);
+    }
+    fs::rename(path + ".crash", path);
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn.write("\x10\x00\x00\x00\x01", 5);
+    }
+    
+    std::vector<WriteAheadLog::Record> replayed;
+    WriteAheadLog wal(path,
+        [&](const WriteAheadLog::Record& record) { replayed.push_back(record); return true; },
+        []() { return true; });
+    ASSERT_TRUE(wal.open());
+    ASSERT_EQ(replayed.size(), 2u);
+    EXPECT_EQ(replayed[0].id, kept);
+    EXPECT_EQ(replayed[0].payload, "payload");
+    EXPECT_EQ(replayed[1].op, WriteAheadLog::Op::REMOVE);
+    EXPECT_EQ(fs::file_size(path), 0u);
+    wal.close();
+    fs::remove(path);
+}
+
+#ifndef _WIN32
+TEST(WriteAheadLogTest, FailedWriteDoesNotHideLaterCommits) {
+    std::string path = "./test_wal_short_write.log";
+    fs::remove(path);
+    UUID before = UUID::generate();
+    UUID after = UUID::generate();
+    
+    {
+        WriteAheadLog wal(path, [](const WriteAheadLog::Record&) { return true; }, []() { return true; });
+        ASSERT_TRUE(wal.open());
+        ASSERT_TRUE(wal.commit({WriteAheadLog::Op::PUT, "items", before, "payload"}));
+        
+        // Cap the file size a few bytes past the log, so the next batch is
+        // written in part and then fails, as it would on a full disk
+        struct rlimit original;
+        ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &original), 0);
+        struct rlimit capped = original;
+        capped.rlim_cur = fs::file_size(path) + 10;
+        auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+        ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &capped), 0);
+        bool failedCommit = wal.commit({WriteAheadLog::Op::PUT, "items", UUID::generate(), std::string(1000, 'x')});
+        setrlimit(RLIMIT_FSIZE, &original);
+        std::signal(SIGXFSZ, previousHandler);
+        EXPECT_FALSE(failedCommit);
+        
+        ASSERT_TRUE(wal.commit({WriteAheadLog::Op::REMOVE, "items", after, ""}));
+        fs::copy_file(path, path + ".crash", fs::copy_options::overwrite_existing);
+    }
+    fs::rename(path + ".crash", path);
+    
+    std::vector<WriteAheadLog::Record> replayed;
+    WriteAheadLog wal(path,
+        [&](const WriteAheadLog::Record& record) { replayed.push_back(record); return true; },
+        []() { return true; });
+    ASSERT_TRUE(wal.open());
+    ASSERT_EQ(replayed.size(), 2u);
+    EXPECT_EQ(replayed[0].id, before);
+    EXPECT_EQ(replayed[1].id, after);
+    wal.close();
+    fs::remove(path);
+}
+#endif
+
+TEST_F(LocalDatabaseTest, AtomicWritesIgnoreLeftoverTempFiles) {
+    auto item = std::make_shared<Item>("Original", nullptr, 1);
+    ASSERT_TRUE(db->saveItem(item));
+    
+    // A crash between writing the temp file and renaming it
+    std::string filePath = testDbPath + "/items/" + item->getId().toString() + ".json";
+    {
+        std::ofstream partial(filePath + ".tmp");
+        partial << "{\"name\": \"Trunc";
+    }
+    
+    auto loaded = db->loadItem(item->getId());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getName(), "Original");
+    EXPECT_EQ(db->loadAllItems().size(), 1);
+    EXPECT_TRUE(fs::exists(testDbPath + "/wal.log"));
+}
+
 // ============================================================================
 // Error Handling Tests
 // ============================================================================
@@ -422,3 +1221,468 @@ TEST_F(LocalDatabaseTest, InvalidPathHandling) {
     // It should either succeed (create in current dir) or fail gracefully
     EXPECT_TRUE(result || !result);  // Just ensure it doesn't crash
 }
+
+// ============================================================================
+// SQLConnectionPool
+// ============================================================================
+
+TEST(SQLConnectionPoolTest, BoundsCheckoutsAndReplacesUnhealthyConnections) {
+    std::atomic<int> opened{0};
+    bool healthy = true;
+    SQLConnectionPool::Options options;
+    options.maxConnections = 2;
+    options.healthCheckAfter = std::chrono::milliseconds(0);
+    auto pool = std::make_shared<SQLConnectionPool>(
+        [&opened]() {
+            auto connection = std::make_unique<SQLConnection>(SQLConnection::Backend::LOGGING);
+            connection->open("pool-test");
+            ++opened;
+            return connection;
+        },
+        [&healthy](SQLConnection&) { return healthy; },
+        options);
+    
+    auto first = pool->acquire();
+    auto second = pool->acquire();
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_NE(first.get(), second.get());
+    
+    // Exhausted: a third caller waits out its timeout
+    EXPECT_FALSE(pool->acquire(std::chrono::milliseconds(20)));
+    auto metrics = pool->getMetrics();
+    EXPECT_EQ(metrics.inUse, 2u);
+    EXPECT_EQ(metrics.timeouts, 1u);
+    EXPECT_GE(metrics.maxWaitMicros, 20000u);
+    
+    // A waiter gets the connection as soon as it is returned
+    SQLConnection* returned = first.get();
+    std::thread releaser([&first]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        first.release();
+    });
+    auto third = pool->acquire(std::chrono::seconds(5));
+    releaser.join();
+    ASSERT_TRUE(third);
+    EXPECT_EQ(third.get(), returned);
+    EXPECT_EQ(opened.load(), 2);
+    
+    // A connection that fails its check is replaced rather than handed out
+    third.release();
+    healthy = false;
+    auto fourth = pool->acquire();
+    ASSERT_TRUE(fourth);
+    EXPECT_EQ(opened.load(), 3);
+    
+    metrics = pool->getMetrics();
+    EXPECT_EQ(metrics.healthCheckFailures, 1u);
+    EXPECT_EQ(metrics.open, 2u);
+    EXPECT_EQ(metrics.peakInUse, 2u);
+    EXPECT_EQ(metrics.checkouts, 4u);
+    
+    // Leases returned after close() are closed, not pooled
+    pool->close();
+    EXPECT_FALSE(pool->acquire());
+    second.release();
+    fourth.release();
+    EXPECT_EQ(pool->getMetrics().open, 0u);
+}
+
+// ============================================================================
+// SQLDatabase (SQLite)
+// ============================================================================
+
+#ifdef USE_SQLITE
+class SQLiteDatabaseTest : public ::testing::Test {
+protected:
+    std::string testDbFile = "./test_sqlite.db";
+    std::shared_ptr<SQLDatabase> db;
+    
+    void removeFiles() {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            fs::remove(testDbFile + suffix);
+        }
+    }
+    
+    void SetUp() override {
+        removeFiles();
+        SQLDatabase::ConnectionConfig config;
+        config.type = SQLDatabase::SQLType::SQLITE;
+        config.database = testDbFile;
+        db = std::make_shared<SQLDatabase>(config);
+        ASSERT_TRUE(db->connect());
+    }
+    
+    void TearDown() override {
+        db->disconnect();
+        removeFiles();
+    }
+};
+
+TEST_F(SQLiteDatabaseTest, CreatesSchemaInWalMode) {
+    EXPECT_EQ(db->getSchemaVersion(), 1);
+    EXPECT_TRUE(fs::exists(testDbFile + "-wal"));
+    
+    // Reconnecting keeps the existing schema
+    db->disconnect();
+    ASSERT_TRUE(db->connect());
+    EXPECT_EQ(db->getSchemaVersion(), 1);
+}
+
+TEST_F(SQLiteDatabaseTest, SaveLoadUpdateDelete) {
+    auto category = std::make_shared<Category>("Passives", "R, C, L");
+    auto item = std::make_shared<Item>("Resistor 10k", category, 100, "1/4W");
+    ASSERT_TRUE(db->saveCategory(category));
+    ASSERT_TRUE(db->saveItem(item));
+    
+    auto loaded = db->loadItem(item->getId());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getId(), item->getId());
+    EXPECT_EQ(loaded->getName(), "Resistor 10k");
+    EXPECT_EQ(loaded->getQuantity(), 100);
+    
+    // Saving again updates the same row
+    item->setQuantity(42);
+    item->setName("Resistor 10k 'metal film'");
+    ASSERT_TRUE(db->saveItem(item));
+    loaded = db->loadItem(item->getId());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getQuantity(), 42);
+    EXPECT_EQ(loaded->getName(), "Resistor 10k 'metal film'");
+    
+    EXPECT_TRUE(db->deleteItem(item->getId()));
+    EXPECT_EQ(db->loadItem(item->getId()), nullptr);
+    EXPECT_EQ(db->loadCategory(category->getId())->getName(), "Passives");
+}
+
+TEST_F(SQLiteDatabaseTest, MissingReferencesAreStoredAsNull) {
+    auto item = std::make_shared<Item>("Loose part", nullptr, 1);
+    auto container = std::make_shared<Container>("Bin", ContainerType::INVENTORY, "");
+    auto log = std::make_shared<ActivityLog>(ActivityType::MODIFIED, nullptr, "Note", "user");
+    ASSERT_TRUE(db->saveItem(item));
+    ASSERT_TRUE(db->saveContainer(container));
+    ASSERT_TRUE(db->saveActivityLog(log));
+
+    // Read the raw columns through a second connection
+    SQLConnection raw;
+    ASSERT_TRUE(raw.open(testDbFile));
+    auto itemRow = raw.prepare("SELECT category_id, container_id FROM items WHERE id = ?1");
+    itemRow.bind(1, item->getId());
+    ASSERT_TRUE(itemRow.next());
+    EXPECT_TRUE(itemRow.isNull(0));
+    EXPECT_TRUE(itemRow.isNull(1));
+    EXPECT_TRUE(itemRow.uuid(0).isNil());
+
+    auto containerRow = raw.prepare("SELECT location_id, parent_container_id FROM containers WHERE id = ?1");
+    containerRow.bind(1, container->getId());
+    ASSERT_TRUE(containerRow.next());
+    EXPECT_TRUE(containerRow.isNull(0));
+    EXPECT_TRUE(containerRow.isNull(1));
+
+    auto logRow = raw.prepare("SELECT item_id, from_container_id, to_container_id, project_id "
+                              "FROM activity_logs WHERE id = ?1");
+    logRow.bind(1, log->getId());
+    ASSERT_TRUE(logRow.next());
+    for (int column = 0; column < 4; ++column) {
+        EXPECT_TRUE(logRow.isNull(column));
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, SnapshotLinksReferencesAcrossTables) {
+    auto parentCategory = std::make_shared<Category>("Electronics", "");
+    auto category = std::make_shared<Category>("Passives", "");
+    parentCategory->addSubcategory(category);
+    auto location = std::make_shared<Location>("Lab", "1 Main St");
+    auto shelf = std::make_shared<Container>("Shelf", ContainerType::INVENTORY, "");
+    auto bin = std::make_shared<Container>("Bin", ContainerType::SUBCONTAINER, "");
+    location->addContainer(shelf);
+    shelf->addSubcontainer(bin);
+    auto item = std::make_shared<Item>("Capacitor", category, 5);
+    bin->addItem(item);
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(bin);
+    
+    auto now = std::chrono::system_clock::now();
+    auto older = std::make_shared<ActivityLog>(UUID::generate(), ActivityType::CREATED, item, "Created", "alice",
+                                               now - std::chrono::seconds(10));
+    auto newer = std::make_shared<ActivityLog>(UUID::generate(), ActivityType::MODIFIED, item, "Counted", "bob", now);
+    newer->setQuantityChange(-2);
+    
+    ASSERT_TRUE(db->saveCategory(category));
+    ASSERT_TRUE(db->saveCategory(parentCategory));
+    ASSERT_TRUE(db->saveLocation(location));
+    ASSERT_TRUE(db->saveContainer(shelf));
+    ASSERT_TRUE(db->saveContainer(bin));
+    ASSERT_TRUE(db->saveItem(item));
+    ASSERT_TRUE(db->saveProject(project));
+    ASSERT_TRUE(db->saveActivityLog(newer));
+    ASSERT_TRUE(db->saveActivityLog(older));
+    
+    EntitySnapshot snapshot;
+    ASSERT_TRUE(db->loadSnapshot(snapshot));
+    ASSERT_EQ(snapshot.items.size(), 1u);
+    ASSERT_EQ(snapshot.containers.size(), 2u);
+    ASSERT_EQ(snapshot.projects.size(), 1u);
+    
+    auto loadedItem = snapshot.items[0];
+    ASSERT_NE(loadedItem->getCategory(), nullptr);
+    EXPECT_EQ(loadedItem->getCategory()->getId(), category->getId());
+    ASSERT_NE(loadedItem->getCurrentContainer(), nullptr);
+    EXPECT_EQ(loadedItem->getCurrentContainer()->getId(), bin->getId());
+    ASSERT_NE(loadedItem->getCurrentContainer()->getParentContainer(), nullptr);
+    EXPECT_EQ(loadedItem->getCurrentContainer()->getParentContainer()->getId(), shelf->getId());
+    EXPECT_EQ(snapshot.projects[0]->containerCount(), 1u);
+    
+    ASSERT_EQ(loadedItem->activityCount(), 2u);
+    EXPECT_EQ(loadedItem->getActivityHistory()[0]->getId(), older->getId());
+    
+    for (const auto& loaded : snapshot.categories) {
+        if (loaded->getId() == parentCategory->getId()) {
+            ASSERT_EQ(loaded->getSubcategories().size(), 1u);
+            EXPECT_EQ(loaded->getSubcategories()[0]->getId(), category->getId());
+        }
+    }
+    
+    auto history = db->loadActivityLogsForItem(item->getId());
+    ASSERT_EQ(history.size(), 2u);
+    EXPECT_EQ(history[0]->getId(), newer->getId());
+    EXPECT_EQ(history[0]->getQuantityChange(), -2);
+    ASSERT_NE(history[0]->getItem(), nullptr);
+    EXPECT_EQ(history[0]->getItem()->getId(), item->getId());
+    
+    auto recent = db->loadRecentActivityLogs(1);
+    ASSERT_EQ(recent.size(), 1u);
+    EXPECT_EQ(recent[0]->getId(), newer->getId());
+}
+
+TEST_F(SQLiteDatabaseTest, PooledConnectionsServeThreadsAndPinTransactions) {
+    auto category = std::make_shared<Category>("Passives", "");
+    ASSERT_TRUE(db->saveCategory(category));
+    
+    std::vector<std::shared_ptr<Item>> items;
+    for (int i = 0; i < 200; ++i) {
+        items.push_back(std::make_shared<Item>("Part " + std::to_string(i), category, i));
+    }
+    
+    std::atomic<size_t> next{0};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < items.size(); i = next++) {
+                if (!db->saveItem(items[i]) || !db->loadItem(items[i]->getId())) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(db->loadAllItems().size(), items.size());
+    
+    auto metrics = db->getPoolMetrics();
+    EXPECT_EQ(metrics.inUse, 0u);
+    EXPECT_LE(metrics.peakInUse, 10u);
+    EXPECT_GE(metrics.checkouts, 400u);
+    EXPECT_EQ(metrics.timeouts, 0u);
+    
+    // Operations inside a transaction run on its connection, so they roll back together
+    auto extra = std::make_shared<Item>("Rolled back", category, 1);
+    ASSERT_TRUE(db->beginTransaction());
+    EXPECT_FALSE(db->beginTransaction());
+    ASSERT_TRUE(db->saveItem(extra));
+    EXPECT_NE(db->loadItem(extra->getId()), nullptr);
+    EXPECT_EQ(db->getPoolMetrics().inUse, 1u);
+    ASSERT_TRUE(db->rollbackTransaction());
+    EXPECT_EQ(db->loadItem(extra->getId()), nullptr);
+    EXPECT_FALSE(db->commitTransaction());
+}
+
+TEST_F(SQLiteDatabaseTest, BatchSavesUpsertManyRowsPerStatement) {
+    db->disconnect();
+    SQLDatabase::ConnectionConfig config;
+    config.type = SQLDatabase::SQLType::SQLITE;
+    config.database = testDbFile;
+    config.batchSize = 64;
+    db = std::make_shared<SQLDatabase>(config);
+    ASSERT_TRUE(db->connect());
+    
+    auto category = std::make_shared<Category>("Passives", "");
+    auto subcategory = std::make_shared<Category>("Resistors", "");
+    category->addSubcategory(subcategory);
+    auto location = std::make_shared<Location>("Lab", "");
+    auto bin = std::make_shared<Container>("Bin", ContainerType::INVENTORY, "");
+    location->addContainer(bin);
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(bin);
+    
+    // 64-row batches plus a 32/4/1 tail
+    std::vector<std::shared_ptr<Item>> items;
+    std::vector<std::shared_ptr<ActivityLog>> logs;
+    for (int i = 0; i < 1000; ++i) {
+        auto item = std::make_shared<Item>("Part " + std::to_string(i), subcategory, i);
+        bin->addItem(item);
+        items.push_back(item);
+        logs.push_back(std::make_shared<ActivityLog>(ActivityType::CREATED, item, "Created", "alice"));
+    }
+    
+    ASSERT_TRUE(db->saveCategories({subcategory, category}));
+    ASSERT_TRUE(db->saveLocations({location}));
+    ASSERT_TRUE(db->saveContainers({bin}));
+    ASSERT_TRUE(db->saveProjects({project}));
+    ASSERT_TRUE(db->saveItems(items));
+    ASSERT_TRUE(db->saveActivityLogs(logs));
+    ASSERT_TRUE(db->saveActivityLogs(logs));  // Already stored: ignored
+    
+    // Saving again updates the rows in place
+    items[999]->setQuantity(7);
+    ASSERT_TRUE(db->saveItems(items));
+    
+    EntitySnapshot snapshot;
+    ASSERT_TRUE(db->loadSnapshot(snapshot));
+    ASSERT_EQ(snapshot.items.size(), 1000u);
+    ASSERT_EQ(snapshot.containers.size(), 1u);
+    EXPECT_EQ(snapshot.containers[0]->itemCount(), 1000u);
+    EXPECT_EQ(snapshot.projects[0]->containerCount(), 1u);
+    EXPECT_EQ(db->loadItem(items[999]->getId())->getQuantity(), 7);
+    EXPECT_EQ(db->loadRecentActivityLogs(2000).size(), 1000u);
+    for (const auto& loaded : snapshot.items) {
+        ASSERT_NE(loaded->getCategory(), nullptr);
+        EXPECT_EQ(loaded->getCategory()->getId(), subcategory->getId());
+    }
+    
+    // Inside an open transaction a batch rolls back with it
+    std::vector<std::shared_ptr<Item>> extra = {std::make_shared<Item>("Extra", subcategory, 1)};
+    ASSERT_TRUE(db->beginTransaction());
+    ASSERT_TRUE(db->saveItems(extra));
+    ASSERT_TRUE(db->rollbackTransaction());
+    EXPECT_EQ(db->loadItem(extra[0]->getId()), nullptr);
+}
+
+TEST_F(SQLiteDatabaseTest, BatchLoadsLinkOneLevelOfReferences) {
+    auto category = std::make_shared<Category>("Passives", "");
+    auto small = std::make_shared<Category>("Small", "");
+    category->addSubcategory(small);
+    auto location = std::make_shared<Location>("Lab", "");
+    auto shelf = std::make_shared<Container>("Shelf", ContainerType::INVENTORY);
+    auto drawer = std::make_shared<Container>("Drawer", ContainerType::SUBCONTAINER);
+    location->addContainer(shelf);
+    shelf->addSubcontainer(drawer);
+    auto loose = std::make_shared<Item>("Loose", nullptr, 1);
+    auto resistor = std::make_shared<Item>("Resistor", category, 100);
+    shelf->addItem(loose);
+    drawer->addItem(resistor);
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(shelf);
+    
+    ASSERT_TRUE(db->saveCategories({small, category}));
+    ASSERT_TRUE(db->saveLocations({location}));
+    ASSERT_TRUE(db->saveContainers({shelf, drawer}));
+    ASSERT_TRUE(db->saveItems({loose, resistor}));
+    ASSERT_TRUE(db->saveProjects({project}));
+    
+    auto items = db->loadItems({resistor->getId()});
+    ASSERT_EQ(items.size(), 1u);
+    ASSERT_NE(items[0]->getCategory(), nullptr);
+    EXPECT_EQ(items[0]->getCategory()->getName(), "Passives");
+    ASSERT_NE(items[0]->getCurrentContainer(), nullptr);
+    EXPECT_EQ(items[0]->getCurrentContainer()->getName(), "Drawer");
+    
+    // Both in one batch: the drawer's parent is the shelf that was loaded
+    auto containers = db->loadContainers({shelf->getId(), drawer->getId()});
+    ASSERT_EQ(containers.size(), 2u);
+    for (const auto& container : containers) {
+        EXPECT_EQ(container->itemCount(), 1u);
+        if (container->getId() == shelf->getId()) {
+            ASSERT_NE(container->getLocation(), nullptr);
+            EXPECT_EQ(container->getLocation()->getName(), "Lab");
+            ASSERT_EQ(container->subcontainerCount(), 1u);
+            EXPECT_EQ(container->getAllSubcontainers()[0]->getName(), "Drawer");
+        } else {
+            ASSERT_NE(container->getParentContainer(), nullptr);
+            EXPECT_EQ(container->getParentContainer()->getName(), "Shelf");
+            EXPECT_EQ(container->getAllItems()[0]->getName(), "Resistor");
+        }
+    }
+    
+    auto locations = db->loadLocations({location->getId()});
+    ASSERT_EQ(locations.size(), 1u);
+    ASSERT_EQ(locations[0]->containerCount(), 1u);
+    EXPECT_EQ(locations[0]->getAllContainers()[0]->getName(), "Shelf");
+    
+    auto projects = db->loadProjects({project->getId()});
+    ASSERT_EQ(projects.size(), 1u);
+    EXPECT_EQ(projects[0]->containerCount(), 1u);
+    EXPECT_EQ(projects[0]->getTotalItemCount(), 2);
+    
+    auto categories = db->loadCategories({category->getId()});
+    ASSERT_EQ(categories.size(), 1u);
+    ASSERT_EQ(categories[0]->getSubcategories().size(), 1u);
+    EXPECT_EQ(categories[0]->getSubcategories()[0]->getName(), "Small");
+    
+    // Pages are linked the same way
+    auto page = db->loadItemPage(UUID::nil(), 10);
+    ASSERT_TRUE(page.ok);
+    ASSERT_EQ(page.entities.size(), 2u);
+    for (const auto& item : page.entities) {
+        ASSERT_NE(item->getCurrentContainer(), nullptr);
+        if (item->getId() == resistor->getId()) {
+            ASSERT_NE(item->getCategory(), nullptr);
+            EXPECT_EQ(item->getCategory()->getName(), "Passives");
+        }
+    }
+    auto containerPage = db->loadContainerPage(UUID::nil(), 10);
+    ASSERT_EQ(containerPage.entities.size(), 2u);
+    for (const auto& container : containerPage.entities) {
+        EXPECT_EQ(container->itemCount(), 1u);
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, BatchLoadsAndDeletesById) {
+    auto location = std::make_shared<Location>("Lab", "");
+    auto bin = std::make_shared<Container>("Bin", ContainerType::INVENTORY, "");
+    auto project = std::make_shared<Project>("Robot", "");
+    project->addContainer(bin);
+    
+    std::vector<std::shared_ptr<Item>> items;
+    std::vector<UUID> ids;
+    for (int i = 0; i < 300; ++i) {
+        items.push_back(std::make_shared<Item>("Part " + std::to_string(i), nullptr, i));
+        ids.push_back(items.back()->getId());
+    }
+    ASSERT_TRUE(db->saveItems(items));
+    ASSERT_TRUE(db->saveLocations({location}));
+    ASSERT_TRUE(db->saveContainers({bin}));
+    ASSERT_TRUE(db->saveProjects({project}));
+    
+    std::vector<UUID> wanted(ids.begin(), ids.begin() + 250);
+    wanted.push_back(UUID::generate());
+    auto loaded = db->loadItems(wanted);
+    ASSERT_EQ(loaded.size(), 250u);
+    std::set<std::string> names;
+    for (const auto& item : loaded) {
+        names.insert(item->getName());
+    }
+    EXPECT_EQ(names.count("Part 249"), 1u);
+    EXPECT_EQ(db->loadLocations({location->getId()}).size(), 1u);
+    
+    // Unit of work: committed as one transaction
+    {
+        UnitOfWork work(*db);
+        ASSERT_TRUE(work.isActive());
+        EXPECT_TRUE(db->deleteItems(std::vector<UUID>(ids.begin(), ids.begin() + 100)));
+        EXPECT_TRUE(db->deleteProjects({project->getId()}));
+        EXPECT_TRUE(work.commit());
+    }
+    EXPECT_EQ(db->loadAllItems().size(), 200u);
+    EXPECT_TRUE(db->loadProjects({project->getId()}).empty());
+    
+    {
+        UnitOfWork work(*db);
+        EXPECT_TRUE(db->deleteItems(ids));
+    }
+    EXPECT_EQ(db->loadAllItems().size(), 200u);
+}
+#endif
@@ -5,6 +5,7 @@
 #include "Item.h"
 #include "Project.h"
 #include "ActivityLog.h"
+#include "EntityObserver.h"
 
 // ============================================================================
 // Category Tests
@@ -125,6 +126,23 @@ TEST(ContainerTest, ItemManagement) {
     EXPECT_EQ(items.size(), 0);
 }
 
+TEST(ContainerTest, ViewsDoNotCopy) {
+    auto container = std::make_shared<Container>("Box", ContainerType::INVENTORY);
+    auto item = std::make_shared<Item>("Resistor", nullptr, 100);
+    container->addItem(item);
+    
+    long references = item.use_count();
+    const auto& items = container->getAllItems();
+    EXPECT_EQ(item.use_count(), references);
+    EXPECT_EQ(&items, &container->getAllItems());
+    EXPECT_EQ(container->itemCount(), 1);
+    EXPECT_EQ(container->subcontainerCount(), 0);
+    
+    container->removeItem(item->getId());
+    EXPECT_TRUE(items.empty());  // Live view of the container's contents
+    EXPECT_EQ(container->itemCount(), 0);
+}
+
 TEST(ContainerTest, SubcontainerHierarchy) {
     auto parent = std::make_shared<Container>("Parent", ContainerType::INVENTORY);
     auto child = std::make_shared<Container>("Child", ContainerType::SUBCONTAINER);
@@ -233,6 +251,37 @@ TEST(ItemTest, ActivityTracking) {
     EXPECT_EQ(logs[0], activity);
 }
 
+TEST(ItemTest, SnapshotCopiesOwnFieldsOnly) {
+    struct RenameCounter : EntityObserver {
+        int renames = 0;
+        void onItemNameChanged(const Item&, const std::string&) override { ++renames; }
+    };
+    RenameCounter observer;
+    
+    auto category = std::make_shared<Category>("Parts", "");
+    auto container = std::make_shared<Container>("Box", ContainerType::INVENTORY);
+    auto item = std::make_shared<Item>("Item", category, 10, "Spare");
+    item->setContainer(container);
+    item->addActivity(std::make_shared<ActivityLog>(ActivityType::CREATED, item, "Item created", "user1"));
+    item->setObserver(&observer);
+    
+    auto copy = item->snapshot();
+    EXPECT_NE(copy, item);
+    EXPECT_EQ(copy->getId(), item->getId());
+    EXPECT_EQ(copy->getName(), "Item");
+    EXPECT_EQ(copy->getDescription(), "Spare");
+    EXPECT_EQ(copy->getQuantity(), 10);
+    EXPECT_EQ(copy->getCategory(), category);
+    EXPECT_EQ(copy->getCurrentContainer(), container);
+    EXPECT_EQ(copy->getVersion(), item->getVersion());
+    EXPECT_EQ(copy->activityCount(), 0u);
+    
+    // Changing the snapshot does not notify the original's observer
+    copy->setName("Renamed");
+    EXPECT_EQ(observer.renames, 0);
+    EXPECT_EQ(item->getName(), "Item");
+}
+
 // ============================================================================
 // Project Tests
 // ============================================================================
@@ -6,7 +6,10 @@
 #include "Location.h"
 #include "Category.h"
 #include "Project.h"
+#include "EntityRegistry.h"
+#include "SearchIndex.h"
 #include <filesystem>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -307,6 +310,52 @@ TEST_F(InventoryManagerTest, SearchItemsByName) {
     }
 }
 
+TEST_F(InventoryManagerTest, SearchItemsCaseInsensitiveAndRanked) {
+    manager->createItem("Wire Stripper", nullptr, 1, "Cuts resistor leads");
+    auto exact = manager->createItem("resistor", nullptr, 1);
+    manager->createItem("Resistor Kit", nullptr, 1);
+    
+    auto results = manager->searchItems("RESISTOR");
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results[0], exact);
+    EXPECT_EQ(results[2]->getName(), "Wire Stripper");  // Description-only match ranks last
+    
+    EXPECT_EQ(manager->searchItems("resistor", 1).size(), 1);
+    EXPECT_EQ(manager->searchItems("sist").size(), 3);   // Substring via trigrams
+    EXPECT_EQ(manager->searchItems("ki").size(), 1);     // Short terms match prefixes
+    EXPECT_EQ(manager->searchItems("resistor kit").size(), 1);
+    EXPECT_TRUE(manager->searchItems("capacitor").empty());
+}
+
+TEST_F(InventoryManagerTest, SearchIndexFollowsUpdates) {
+    auto item = manager->createItem("Drill", nullptr, 1);
+    
+    item->setName("Impact Driver");
+    item->setDescription("Cordless 18V");
+    EXPECT_TRUE(manager->searchItems("drill").empty());
+    EXPECT_EQ(manager->searchItems("driver").size(), 1);
+    EXPECT_EQ(manager->searchItems("cordless").size(), 1);
+    
+    manager->deleteItem(item->getId());
+    EXPECT_TRUE(manager->searchItems("driver").empty());
+}
+
+TEST(SearchIndexTest, ReplaceAndRemove) {
+    SearchIndex index;
+    UUID id = UUID::generate();
+    
+    index.add(id, "Solder Wire", "");
+    index.add(id, "Flux Pen", "");
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_TRUE(index.search("solder").empty());
+    EXPECT_EQ(index.search("flux").size(), 1);
+    
+    index.remove(id);
+    EXPECT_FALSE(index.contains(id));
+    EXPECT_TRUE(index.search("flux").empty());
+    EXPECT_TRUE(index.search("").empty());
+}
+
 TEST_F(InventoryManagerTest, FindItemsByCategory) {
     auto category1 = manager->createCategory("Resistors", "");
     auto category2 = manager->createCategory("Capacitors", "");
@@ -394,6 +443,248 @@ TEST_F(InventoryManagerTest, GetActivityLogs) {
     EXPECT_GE(logs.size(), 1);
 }
 
+// ============================================================================
+// Entity Index Tests
+// ============================================================================
+
+TEST_F(InventoryManagerTest, DeleteKeepsIndexConsistent) {
+    auto category = manager->createCategory("Parts", "");
+    std::vector<std::shared_ptr<Item>> items;
+    for (int i = 0; i < 10; ++i) {
+        items.push_back(manager->createItem("Item" + std::to_string(i), category, i));
+    }
+    
+    // Delete from the front, middle and back of the registry
+    EXPECT_TRUE(manager->deleteItem(items[0]->getId()));
+    EXPECT_TRUE(manager->deleteItem(items[5]->getId()));
+    EXPECT_TRUE(manager->deleteItem(items[9]->getId()));
+    EXPECT_FALSE(manager->deleteItem(items[5]->getId()));
+    
+    EXPECT_EQ(manager->getAllItems().size(), 7);
+    EXPECT_EQ(manager->getItem(items[0]->getId()), nullptr);
+    EXPECT_EQ(manager->getItem(items[9]->getId()), nullptr);
+    for (int i : {1, 2, 3, 4, 6, 7, 8}) {
+        EXPECT_EQ(manager->getItem(items[i]->getId()), items[i]);
+    }
+}
+
+TEST_F(InventoryManagerTest, DeleteOtherEntities) {
+    auto container = manager->createContainer("Box", ContainerType::INVENTORY);
+    auto location = manager->createLocation("Lab", "");
+    auto project = manager->createProject("Project", "");
+    auto category = manager->createCategory("Parts", "");
+    
+    EXPECT_TRUE(manager->deleteContainer(container->getId()));
+    EXPECT_TRUE(manager->deleteLocation(location->getId()));
+    EXPECT_TRUE(manager->deleteProject(project->getId()));
+    EXPECT_TRUE(manager->deleteCategory(category->getId()));
+    
+    EXPECT_EQ(manager->getContainer(container->getId()), nullptr);
+    EXPECT_EQ(manager->getLocation(location->getId()), nullptr);
+    EXPECT_EQ(manager->getProject(project->getId()), nullptr);
+    EXPECT_EQ(manager->getCategory(category->getId()), nullptr);
+}
+
+TEST_F(InventoryManagerTest, IndexesFollowEntityMutations) {
+    auto tools = manager->createCategory("Tools", "");
+    auto parts = manager->createCategory("Parts", "");
+    auto item = manager->createItem("Hammer", tools, 1);
+    
+    // Mutating the entity directly must keep the indexes current
+    item->setName("Mallet");
+    item->setCategory(parts);
+    
+    EXPECT_EQ(manager->findItemByName("Hammer"), nullptr);
+    EXPECT_EQ(manager->findItemByName("Mallet"), item);
+    EXPECT_TRUE(manager->findItemsByCategory(tools->getId()).empty());
+    ASSERT_EQ(manager->findItemsByCategory(parts->getId()).size(), 1);
+    
+    EXPECT_TRUE(manager->deleteItem(item->getId()));
+    EXPECT_EQ(manager->findItemByName("Mallet"), nullptr);
+    EXPECT_TRUE(manager->findItemsByCategory(parts->getId()).empty());
+}
+
+TEST_F(InventoryManagerTest, FindItemByNamePrefersTheFirstItem) {
+    std::vector<std::shared_ptr<Item>> items;
+    for (int i = 0; i < 20; ++i) {
+        items.push_back(manager->createItem("Screw", nullptr, i));
+    }
+    EXPECT_EQ(manager->findItemByName("Screw"), items[0]);
+
+    // A rename does not make an item the first one
+    auto renamed = manager->createItem("Bolt", nullptr, 1);
+    renamed->setName("Screw");
+    EXPECT_EQ(manager->findItemByName("Screw"), items[0]);
+
+    EXPECT_TRUE(manager->deleteItem(items[0]->getId()));
+    EXPECT_EQ(manager->findItemByName("Screw"), items[1]);
+}
+
+TEST_F(InventoryManagerTest, LocationIndexFollowsContainerMoves) {
+    auto lab = manager->createLocation("Lab", "");
+    auto shop = manager->createLocation("Shop", "");
+    auto container = manager->createContainer("Bin", ContainerType::INVENTORY);
+    auto item = manager->createItem("Screw", nullptr, 10);
+    
+    container->addItem(item);
+    container->setLocation(lab);
+    EXPECT_EQ(manager->findItemsInLocation(lab->getId()).size(), 1);
+    
+    container->setLocation(shop);
+    EXPECT_TRUE(manager->findItemsInLocation(lab->getId()).empty());
+    EXPECT_EQ(manager->findItemsInLocation(shop->getId()).size(), 1);
+    
+    container->removeItem(item->getId());
+    EXPECT_TRUE(manager->findItemsInLocation(shop->getId()).empty());
+}
+
+// Counts what reaches the batch saves
+class CountingDatabase : public LocalDatabase {
+public:
+    using LocalDatabase::LocalDatabase;
+    
+    size_t itemsSaved = 0;
+    size_t containersSaved = 0;
+    
+    bool saveItems(const std::vector<std::shared_ptr<Item>>& items) override {
+        itemsSaved += items.size();
+        return LocalDatabase::saveItems(items);
+    }
+    
+    bool saveContainers(const std::vector<std::shared_ptr<Container>>& containers) override {
+        containersSaved += containers.size();
+        return LocalDatabase::saveContainers(containers);
+    }
+};
+
+TEST_F(InventoryManagerTest, FlushWritesOnlyDirtyEntities) {
+    auto counting = std::make_shared<CountingDatabase>(testDbPath + "/counting");
+    auto tracked = std::make_shared<InventoryManager>(counting);
+    ASSERT_TRUE(tracked->initialize());
+    
+    auto bin = tracked->createContainer("Bin", ContainerType::INVENTORY);
+    auto screw = tracked->createItem("Screw", nullptr, 10);
+    tracked->createItem("Nut", nullptr, 10);
+    EXPECT_EQ(tracked->dirtyCount(), 0u);
+    
+    // Direct mutation makes just that entity dirty
+    screw->setQuantity(5);
+    EXPECT_TRUE(screw->isDirty());
+    EXPECT_EQ(tracked->dirtyCount(), 1u);
+    ASSERT_TRUE(tracked->flush());
+    EXPECT_EQ(counting->itemsSaved, 1u);
+    EXPECT_EQ(counting->containersSaved, 0u);
+    EXPECT_EQ(tracked->dirtyCount(), 0u);
+    
+    ASSERT_TRUE(tracked->flush());
+    EXPECT_EQ(counting->itemsSaved, 1u);
+    
+    // moveItem writes the item through; the container is left dirty
+    ASSERT_TRUE(tracked->moveItem(screw->getId(), bin->getId()));
+    EXPECT_TRUE(bin->isDirty());
+    EXPECT_FALSE(screw->isDirty());
+    ASSERT_TRUE(tracked->shutdown());
+    EXPECT_EQ(counting->itemsSaved, 1u);
+    EXPECT_EQ(counting->containersSaved, 1u);
+    
+    // What was loaded starts clean
+    auto reloaded = std::make_shared<InventoryManager>(std::make_shared<LocalDatabase>(testDbPath + "/counting"));
+    ASSERT_TRUE(reloaded->initialize());
+    EXPECT_EQ(reloaded->dirtyCount(), 0u);
+    ASSERT_NE(reloaded->getItem(screw->getId()), nullptr);
+    EXPECT_EQ(reloaded->getItem(screw->getId())->getQuantity(), 5);
+    EXPECT_EQ(reloaded->getContainer(bin->getId())->itemCount(), 1u);
+}
+
+TEST_F(InventoryManagerTest, BackgroundFlushWritesDirtyEntities) {
+    auto item = manager->createItem("Washer", nullptr, 1);
+    manager->startBackgroundFlush(std::chrono::milliseconds(10));
+    {
+        auto lock = manager->lock();
+        item->setQuantity(42);
+    }
+    
+    for (int i = 0; i < 500 && manager->dirtyCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    manager->stopBackgroundFlush();
+    EXPECT_EQ(manager->dirtyCount(), 0u);
+    EXPECT_EQ(db->loadItem(item->getId())->getQuantity(), 42);
+}
+
+TEST_F(InventoryManagerTest, WriteBehindCoalescesUntilFlush) {
+    auto counting = std::make_shared<CountingDatabase>(testDbPath + "/write_behind");
+    auto queued = std::make_shared<InventoryManager>(counting);
+    ASSERT_TRUE(queued->initialize());
+    
+    WriteBehindQueue::Options options;
+    options.maxDelay = std::chrono::seconds(10);
+    queued->enableWriteBehind(options);
+    
+    // Applied in memory at once, written only on flush
+    auto item = queued->createItem("Drill", nullptr, 1);
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(queued->checkOutItem(item->getId(), "user1"));
+        ASSERT_TRUE(queued->checkInItem(item->getId(), "user1"));
+    }
+    EXPECT_EQ(queued->dirtyCount(), 0u);
+    EXPECT_EQ(counting->loadItem(item->getId()), nullptr);
+    
+    ASSERT_TRUE(queued->flush());
+    EXPECT_EQ(counting->itemsSaved, 1u);
+    ASSERT_NE(counting->loadItem(item->getId()), nullptr);
+    EXPECT_EQ(queued->getRecentActivity(200).size(), 101u);
+    
+    auto stats = queued->getWriteBehindQueue()->getStats();
+    EXPECT_EQ(stats.coalesced, 100u);
+    EXPECT_EQ(stats.written, 102u);
+    EXPECT_EQ(stats.pending, 0u);
+    
+    // Deletes coalesce with the saves before them
+    item->setQuantity(7);
+    queued->flush();
+    ASSERT_TRUE(queued->deleteItem(item->getId()));
+    ASSERT_TRUE(queued->disableWriteBehind());
+    EXPECT_EQ(queued->getWriteBehindQueue(), nullptr);
+    EXPECT_EQ(counting->loadItem(item->getId()), nullptr);
+    ASSERT_TRUE(queued->shutdown());
+}
+
+TEST_F(InventoryManagerTest, WriteBehindBlocksProducersWhenFull) {
+    WriteBehindQueue::Options options;
+    options.capacity = 4;
+    options.maxDelay = std::chrono::seconds(10);
+    manager->enableWriteBehind(options);
+    
+    std::vector<UUID> ids;
+    for (int i = 0; i < 20; ++i) {
+        ids.push_back(manager->createCategory("Category " + std::to_string(i))->getId());
+    }
+    ASSERT_TRUE(manager->flush());
+    
+    // No batch can hold more than capacity entities
+    auto stats = manager->getWriteBehindQueue()->getStats();
+    EXPECT_GE(stats.batches, 5u);
+    EXPECT_EQ(stats.written, 20u);
+    for (const auto& id : ids) {
+        EXPECT_NE(db->loadCategory(id), nullptr);
+    }
+}
+
+TEST(EntityRegistryTest, RejectsDuplicatesAndNull) {
+    EntityRegistry<Category> registry;
+    auto category = std::make_shared<Category>("Parts", "");
+    
+    EXPECT_TRUE(registry.add(category));
+    EXPECT_FALSE(registry.add(category));
+    EXPECT_FALSE(registry.add(nullptr));
+    EXPECT_EQ(registry.size(), 1);
+    
+    registry.assign({category, nullptr, category});
+    EXPECT_EQ(registry.size(), 1);
+    EXPECT_TRUE(registry.contains(category->getId()));
+}
+
 // ============================================================================
 // Error Handling Tests
 // ============================================================================
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "Logger.h"
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(LoggerTest, WritesLeveledRecordsFromEveryThread) {
+    std::ostringstream out;
+    LogSink::instance().flush();
+    LogSink::instance().setOutput(&out);
+    LogSink::instance().setLevel(LogLevel::INFO);
+    // The dropped count is process-wide and never reset
+    uint64_t droppedBefore = LogSink::instance().getDroppedCount();
+    
+    Logger logger("LoggerTest");
+    logger.debug() << "not written";
+    EXPECT_FALSE(logger.isEnabled(LogLevel::DEBUG));
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&logger, t]() {
+            for (int i = 0; i < 100; ++i) {
+                logger.info() << "thread " << t << " record " << i;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.error() << "last";
+    
+    // Records of exited threads are still written
+    LogSink::instance().flush();
+    LogSink::instance().setOutput(nullptr);
+    
+    std::istringstream lines(out.str());
+    std::string line;
+    size_t info = 0;
+    size_t errors = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(line.find("not written"), std::string::npos);
+        if (line.find("INFO  [LoggerTest] thread ") != std::string::npos) ++info;
+        if (line.find("ERROR [LoggerTest] last") != std::string::npos) ++errors;
+    }
+    EXPECT_EQ(info + LogSink::instance().getDroppedCount() - droppedBefore, 400u);
+    EXPECT_EQ(errors, 1u);
+}
@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+#include "http/BoundedTaskQueue.h"
+#include "http/Router.h"
+#include "routes/RouteHelpers.h"
+#include "Item.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace {
+    // Each route answers with its name, so tests can tell which one matched
+    RouteHandler answer(const std::string& name) {
+        return [name](const HTTPRequest&) { return HTTPResponse(200, name); };
+    }
+
+    HTTPRequest request(const std::string& method, const std::string& path) {
+        HTTPRequest req;
+        req.method = method;
+        req.path = path;
+        return req;
+    }
+
+    std::string route(const Router& router, HTTPRequest& req) {
+        const RouteHandler* handler = router.match(req);
+        return handler ? (*handler)(req).body : "";
+    }
+    
+    // A collection of items with IDs 1..count that records each page asked for
+    struct FakeCollection {
+        std::vector<std::shared_ptr<Item>> items;
+        std::vector<std::pair<UUID, size_t>> calls;
+        size_t failAtCall = SIZE_MAX;
+        
+        explicit FakeCollection(size_t count) {
+            for (size_t i = 1; i <= count; ++i) {
+                items.push_back(std::make_shared<Item>(UUID(0, i), "Item " + std::to_string(i), nullptr));
+            }
+        }
+        
+        Page<Item> load(const UUID& after, size_t limit) {
+            calls.emplace_back(after, limit);
+            Page<Item> page;
+            if (calls.size() - 1 == failAtCall) {
+                page.ok = false;
+                return page;
+            }
+            size_t start = after.isNil() ? 0 : after.getLow();
+            for (size_t i = start; i < items.size() && page.entities.size() < limit; ++i) {
+                page.entities.push_back(items[i]);
+            }
+            if (start + page.entities.size() < items.size()) {
+                page.next = page.entities.back()->getId();
+            }
+            return page;
+        }
+    };
+    
+    HTTPResponse list(FakeCollection& collection, HTTPRequest::Fields query) {
+        HTTPRequest req = request("GET", "/api/items");
+        req.queryParams = std::move(query);
+        return RouteHelpers::listCollection<Item>(
+            req, [&collection](const UUID& after, size_t limit) { return collection.load(after, limit); });
+    }
+    
+    // Pulls every chunk of a streamed response
+    std::string drain(const HTTPResponse& response) {
+        std::string body;
+        while (response.stream(body)) {
+        }
+        return body;
+    }
+}
+
+// ============================================================================
+// Router
+// ============================================================================
+
+TEST(RouterTest, LiteralSegmentsWinOverParameters) {
+    Router router;
+    ASSERT_TRUE(router.add("GET", "/api/items/:id", answer("item")));
+    ASSERT_TRUE(router.add("GET", "/api/items/batch", answer("batch")));
+    ASSERT_TRUE(router.add("POST", "/api/items/:id", answer("post")));
+    EXPECT_EQ(router.size(), 3u);
+
+    auto batch = request("GET", "/api/items/batch");
+    EXPECT_EQ(route(router, batch), "batch");
+    EXPECT_EQ(batch.pathParamCount, 0u);
+
+    auto item = request("GET", "/api/items/42");
+    EXPECT_EQ(route(router, item), "item");
+    EXPECT_EQ(item.getPathParam("id"), "42");
+
+    // Methods have separate tries; trailing and repeated slashes are ignored
+    auto post = request("POST", "//api/items/batch/");
+    EXPECT_EQ(route(router, post), "post");
+    EXPECT_EQ(post.getPathParam("id"), "batch");
+
+    auto missing = request("DELETE", "/api/items/42");
+    EXPECT_EQ(router.match(missing), nullptr);
+    auto tooDeep = request("GET", "/api/items/42/extra");
+    EXPECT_EQ(router.match(tooDeep), nullptr);
+}
+
+TEST(RouterTest, BacktracksFromDeadEndLiteralBranch) {
+    Router router;
+    ASSERT_TRUE(router.add("GET", "/api/containers/recent", answer("recent")));
+    ASSERT_TRUE(router.add("GET", "/api/containers/:id/items", answer("items")));
+
+    // "recent" matches a literal child that has no "items" below it
+    auto req = request("GET", "/api/containers/recent/items");
+    EXPECT_EQ(route(router, req), "items");
+    EXPECT_EQ(req.getPathParam("id"), "recent");
+
+    auto recent = request("GET", "/api/containers/recent");
+    EXPECT_EQ(route(router, recent), "recent");
+}
+
+TEST(RouterTest, BindsParametersInPathOrder) {
+    Router router;
+    ASSERT_TRUE(router.add("PUT", "/api/projects/:project/containers/:container", answer("link")));
+    ASSERT_TRUE(router.add("GET", "/legacy/.*/view", answer("legacy")));
+
+    auto req = request("PUT", "/api/projects/p-1/containers/c-22");
+    EXPECT_EQ(route(router, req), "link");
+    ASSERT_EQ(req.pathParamCount, 2u);
+    EXPECT_EQ(req.getPathParam("project"), "p-1");
+    EXPECT_EQ(req.getPathParam("container"), "c-22");
+    EXPECT_TRUE(req.hasPathParam("container"));
+    EXPECT_FALSE(req.hasPathParam("item"));
+    EXPECT_EQ(req.getPathParam("item"), "");
+
+    // Values are offsets into the path, so a copy reads its own path
+    HTTPRequest copy = req;
+    req.path.clear();
+    EXPECT_EQ(copy.getPathParam("container"), "c-22");
+
+    // Unnamed parameters still match but bind nothing by name
+    auto legacy = request("GET", "/legacy/anything/view");
+    EXPECT_EQ(route(router, legacy), "legacy");
+    EXPECT_EQ(legacy.pathParamCount, 1u);
+}
+
+TEST(RouterTest, RejectsPatternsWithTooManyParameters) {
+    Router router;
+    std::string pattern;
+    for (size_t i = 0; i < HTTPRequest::kMaxPathParams; ++i) {
+        pattern += "/:p" + std::to_string(i);
+    }
+    EXPECT_TRUE(router.add("GET", pattern, answer("max")));
+    EXPECT_FALSE(router.add("GET", pattern + "/:extra", answer("over")));
+    EXPECT_EQ(router.size(), 1u);
+
+    std::string path;
+    for (size_t i = 0; i < HTTPRequest::kMaxPathParams; ++i) {
+        path += "/v" + std::to_string(i);
+    }
+    auto req = request("GET", path);
+    EXPECT_EQ(route(router, req), "max");
+    EXPECT_EQ(req.pathParamCount, HTTPRequest::kMaxPathParams);
+    std::string last = std::to_string(HTTPRequest::kMaxPathParams - 1);
+    EXPECT_EQ(req.getPathParam("p" + last), "v" + last);
+
+    auto over = request("GET", path + "/extra");
+    EXPECT_EQ(router.match(over), nullptr);
+
+    EXPECT_TRUE(router.remove("GET", pattern));
+    EXPECT_FALSE(router.remove("GET", pattern));
+    EXPECT_EQ(router.match(req), nullptr);
+}
+
+// ============================================================================
+// Connection Queue
+// ============================================================================
+
+TEST(BoundedTaskQueueTest, ShedsToOverflowThenRejects) {
+    std::atomic<uint64_t> rejected{0};
+    BoundedTaskQueue queue(1, 1, rejected);
+
+    // Hold the worker so the next connection has to wait in the queue
+    std::promise<void> workerBusy;
+    std::promise<void> releaseWorker;
+    std::shared_future<void> workerReleased = releaseWorker.get_future().share();
+    ASSERT_TRUE(queue.enqueue([&]() {
+        workerBusy.set_value();
+        workerReleased.wait();
+    }));
+    workerBusy.get_future().wait();
+
+    std::promise<bool> queuedShedding;
+    ASSERT_TRUE(queue.enqueue([&]() { queuedShedding.set_value(BoundedTaskQueue::isShedding()); }));
+    EXPECT_EQ(rejected.load(), 0u);
+
+    // The queue is full, so this one goes to the overflow thread; hold that too
+    std::promise<bool> overflowShedding;
+    std::promise<void> releaseOverflow;
+    std::shared_future<void> overflowReleased = releaseOverflow.get_future().share();
+    ASSERT_TRUE(queue.enqueue([&]() {
+        overflowShedding.set_value(BoundedTaskQueue::isShedding());
+        overflowReleased.wait();
+    }));
+    auto shed = overflowShedding.get_future();
+    ASSERT_EQ(shed.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_TRUE(shed.get());
+    EXPECT_EQ(rejected.load(), 1u);
+
+    // One more fits in the overflow lane; after that connections are refused
+    std::atomic<bool> lastRan{false};
+    EXPECT_TRUE(queue.enqueue([&]() { lastRan = true; }));
+    EXPECT_FALSE(queue.enqueue([]() {}));
+    EXPECT_EQ(rejected.load(), 3u);
+
+    releaseOverflow.set_value();
+    releaseWorker.set_value();
+    auto queued = queuedShedding.get_future();
+    ASSERT_EQ(queued.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_FALSE(queued.get());
+
+    // Shutdown runs what was accepted, then refuses new work
+    queue.shutdown();
+    EXPECT_TRUE(lastRan.load());
+    EXPECT_FALSE(queue.enqueue([]() {}));
+    EXPECT_EQ(rejected.load(), 3u);
+}
+
+TEST(BoundedTaskQueueTest, ZeroMaxQueuedNeverSheds) {
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<int> ran{0};
+    {
+        BoundedTaskQueue queue(2, 0, rejected);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(queue.enqueue([&]() {
+                if (!BoundedTaskQueue::isShedding()) {
+                    ++ran;
+                }
+            }));
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+    EXPECT_EQ(rejected.load(), 0u);
+}
+
+// ============================================================================
+// Collection Listing
+// ============================================================================
+
+TEST(ListCollectionTest, RejectsInvalidLimitsAndClampsLargeOnes) {
+    FakeCollection collection(3);
+    for (const char* limit : {"abc", "0", "-1", "", "10x"}) {
+        EXPECT_EQ(list(collection, {{"limit", limit}}).statusCode, 400) << limit;
+    }
+    EXPECT_TRUE(collection.calls.empty());
+    
+    HTTPResponse response = list(collection, {{"limit", "5000"}});
+    EXPECT_EQ(response.statusCode, 200);
+    ASSERT_EQ(collection.calls.size(), 1u);
+    EXPECT_EQ(collection.calls[0].second, RouteHelpers::kMaxPageSize);
+    EXPECT_EQ(nlohmann::json::parse(response.body).size(), 3u);
+}
+
+TEST(ListCollectionTest, PagesByCursorWithFieldProjection) {
+    FakeCollection collection(5);
+    HTTPResponse first = list(collection, {{"limit", "2"}, {"fields", "id,name"}});
+    ASSERT_EQ(first.statusCode, 200);
+    auto json = nlohmann::json::parse(first.body);
+    ASSERT_EQ(json.size(), 2u);
+    EXPECT_EQ(json[0].size(), 2u);
+    EXPECT_EQ(json[0]["name"], "Item 1");
+    EXPECT_FALSE(json[0].contains("quantity"));
+    const std::string* cursor = first.getHeader("X-Next-Cursor");
+    ASSERT_NE(cursor, nullptr);
+    EXPECT_EQ(*cursor, UUID(0, 2).toString());
+    
+    HTTPResponse last = list(collection, {{"limit", "10"}, {"cursor", *cursor}});
+    ASSERT_EQ(last.statusCode, 200);
+    EXPECT_EQ(collection.calls.back().first, UUID(0, 2));
+    json = nlohmann::json::parse(last.body);
+    ASSERT_EQ(json.size(), 3u);
+    EXPECT_EQ(json[0]["name"], "Item 3");
+    EXPECT_EQ(last.getHeader("X-Next-Cursor"), nullptr);
+    
+    EXPECT_EQ(list(collection, {{"limit", "2"}, {"cursor", "not-a-uuid"}}).statusCode, 400);
+}
+
+TEST(ListCollectionTest, StreamsEveryPageAsOneArray) {
+    FakeCollection collection(2 * RouteHelpers::kStreamPageSize + 10);
+    HTTPResponse response = list(collection, {{"fields", "id"}});
+    ASSERT_EQ(response.statusCode, 200);
+    ASSERT_TRUE(response.stream);
+    
+    auto json = nlohmann::json::parse(drain(response));
+    ASSERT_EQ(json.size(), collection.items.size());
+    EXPECT_EQ(json.back()["id"], collection.items.back()->getId().toString());
+    EXPECT_EQ(collection.calls.size(), 3u);
+    
+    FakeCollection empty(0);
+    EXPECT_EQ(drain(list(empty, {})), "[]");
+}
+
+TEST(ListCollectionTest, ReportsFailedPages) {
+    FakeCollection paged(3);
+    paged.failAtCall = 0;
+    EXPECT_EQ(list(paged, {{"limit", "2"}}).statusCode, 500);
+    
+    // The first streamed page fails before the status is sent
+    FakeCollection streamed(3);
+    streamed.failAtCall = 0;
+    EXPECT_EQ(list(streamed, {}).statusCode, 500);
+    
+    // A later one aborts the stream rather than ending the array early
+    FakeCollection truncated(RouteHelpers::kStreamPageSize + 1);
+    truncated.failAtCall = 1;
+    HTTPResponse response = list(truncated, {});
+    ASSERT_EQ(response.statusCode, 200);
+    EXPECT_THROW(drain(response), std::runtime_error);
+}
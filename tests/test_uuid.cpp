@@ -3,6 +3,9 @@
 #include <set>
 #include <unordered_set>
 #include <chrono>
+#include <type_traits>
+#include <thread>
+#include <vector>
 
 // Test UUID generation
 TEST(UUIDTest, GenerateUnique) {
@@ -191,3 +194,99 @@ TEST(UUIDTest, GenerationPerformance) {
     // Should be able to generate 10,000 UUIDs in less than 1 second
     EXPECT_LT(duration.count(), 1000) << "UUID generation took " << duration.count() << "ms for " << count << " UUIDs";
 }
+
+// Test binary representation (two 64-bit words, trivially copyable)
+TEST(UUIDTest, BinaryRepresentation) {
+    EXPECT_EQ(sizeof(UUID), 16u);
+    EXPECT_TRUE(std::is_trivially_copyable<UUID>::value);
+    
+    UUID uuid = UUID::fromString("0123abcd-4567-89ef-0123-456789abcdef");
+    EXPECT_EQ(uuid.getHigh(), 0x0123abcd456789efULL);
+    EXPECT_EQ(uuid.getLow(), 0x0123456789abcdefULL);
+    EXPECT_EQ(uuid.toString(), "0123abcd-4567-89ef-0123-456789abcdef");
+}
+
+// Test parsing is case-insensitive and output is canonical lowercase
+TEST(UUIDTest, FromUppercaseString) {
+    UUID upper = UUID::fromString("0123ABCD-4567-89EF-0123-456789ABCDEF");
+    EXPECT_EQ(upper.toString(), "0123abcd-4567-89ef-0123-456789abcdef");
+    
+    // Misplaced hyphens are rejected
+    EXPECT_TRUE(UUID::fromString("0123abcd4-567-89ef-0123-456789abcdef").isNil());
+}
+
+// Test ordering and hashing so UUID can key ordered and hashed containers
+TEST(UUIDTest, OrderingAndHashing) {
+    UUID low = UUID::fromString("00000000-0000-0000-0000-000000000001");
+    UUID high = UUID::fromString("00000000-0000-0001-0000-000000000000");
+    
+    EXPECT_LT(low, high);
+    EXPECT_GT(high, low);
+    EXPECT_LE(low, low);
+    EXPECT_GE(high, high);
+    
+    std::set<UUID> ordered = {high, low};
+    EXPECT_EQ(*ordered.begin(), low);
+    
+    std::unordered_set<UUID> hashed;
+    for (int i = 0; i < 1000; ++i) {
+        hashed.insert(UUID::generate());
+    }
+    hashed.insert(*hashed.begin());
+    EXPECT_EQ(hashed.size(), 1000u);
+    EXPECT_EQ(std::hash<UUID>{}(low), std::hash<UUID>{}(UUID::fromString(low.toString())));
+}
+
+// Test time-ordered UUIDv7 generation
+TEST(UUIDTest, Version7Monotonic) {
+    UUID previous = UUID::generateV7();
+    EXPECT_EQ(previous.getVersion(), 7);
+    
+    std::string str = previous.toString();
+    EXPECT_EQ(str[14], '7');
+    char variant = str[19];
+    EXPECT_TRUE(variant == '8' || variant == '9' || variant == 'a' || variant == 'b');
+    
+    // IDs generated later must always sort after earlier ones
+    for (int i = 0; i < 10000; ++i) {
+        UUID next = UUID::generateV7();
+        EXPECT_LT(previous, next);
+        previous = next;
+    }
+}
+
+// Test switching the default generator version
+TEST(UUIDTest, DefaultVersion) {
+    EXPECT_EQ(UUID::getDefaultVersion(), UUID::Version::V4);
+    
+    UUID::setDefaultVersion(UUID::Version::V7);
+    EXPECT_EQ(UUID::generate().getVersion(), 7);
+    
+    UUID::setDefaultVersion(UUID::Version::V4);
+    EXPECT_EQ(UUID::generate().getVersion(), 4);
+}
+
+// Test concurrent generation yields unique IDs (per-thread generator state)
+TEST(UUIDTest, ConcurrentGeneration) {
+    const int threadCount = 4;
+    const int perThread = 5000;
+    std::vector<std::vector<UUID>> results(threadCount);
+    std::vector<std::thread> threads;
+    
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&results, t, perThread]() {
+            for (int i = 0; i < perThread; ++i) {
+                results[t].push_back((i % 2 == 0) ? UUID::generateV4() : UUID::generateV7());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    std::unordered_set<UUID> all;
+    for (const auto& ids : results) {
+        all.insert(ids.begin(), ids.end());
+    }
+    EXPECT_EQ(all.size(), static_cast<size_t>(threadCount * perThread));
+}